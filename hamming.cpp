@@ -0,0 +1,2438 @@
+/**
+    @file    hamming.cpp
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Packed-bit core of the hamming method shared by all the tools.
+
+    @section DESCRIPTION
+
+    The bits of a group of 7 are kept in an "unsigned" with the bit of the
+    hamming position "p" (7~1) at "1 << (p - 1)". That way the first bit of
+    the group in the file (D7) is the most significant one and the position
+    of a bit is just its index plus one, which makes the parity and the
+    correction plain bit operations.
+
+    The work is done in blocks of 4 original bytes, which are exactly 7 bytes
+    (8 groups of 7 bits) in the hamming format, accumulated in an "uint64_t".
+    The last incomplete block is completed with zeros in a small local buffer,
+    so there is no reallocation at all and the only memory used is the input
+    and output buffers.
+
+    With the code (8,4) each group is one byte, so every kernel just looks
+    bytes up (or computes them) one by one, without shifting bits across
+    bytes. The parity of the 8 bits tells a single error (odd, corrected)
+    from a double one (even with a non-zero syndrome, only counted).
+
+    The code (7,4) is given by the rows of its generator and parity-check
+    matrices, and every table is filled in from them by the compiler (see
+    "hamming_tables.h"), so none is computed when a tool starts.
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#include <math.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <random>
+
+#include "hamming.h"
+#include "hamming_codes.h"
+#include "hamming_kernels.h"
+#include "hamming_tables.h"
+
+namespace hamming {
+
+using kernels::BLOCK_BYTES;
+using kernels::BLOCK_HAMMING_BYTES;
+using kernels::SLICED_BYTES;
+using kernels::SLICED_HAMMING_BYTES;
+
+namespace {
+
+// Rows of the generator matrix of the code (7,4): the group of each data bit
+// alone (D7, D6, D5, D3), so a group is the XOR of the rows of its odd bits.
+constexpr unsigned GENERATOR_7_4[4] = {0x4B, 0x2A, 0x19, 0x07};
+
+// Rows of the parity-check matrix of the code (7,4): the positions checked by
+// each parity bit (P4, P2, P1), which are the bits of the syndrome.
+constexpr unsigned PARITY_CHECK_7_4[3] = {0x78, 0x66, 0x55};
+
+/**
+    @brief Parity of the bits of a group of 7.
+
+    @param unsigned bits: Bits to be checked (8 at most).
+    @return unsigned: 1 - odd; 0 - even.
+*/
+constexpr unsigned parity7(unsigned bits){
+
+    // 0x6996 has the parity of each nibble at its bit.
+    return (0x6996u >> ((bits ^ (bits >> 4)) & 0x0F)) & 1;
+}
+
+/**
+    @brief Assemble a group of 7 bits (4 data and 3 parity).
+
+    @param unsigned nibble: 4 original bits, D7 being the most significant.
+    @return unsigned: Group D7 D6 D5 P4 D3 P2 P1, D7 being the most
+        significant.
+*/
+constexpr unsigned encodeNibble(unsigned nibble){
+    return (((nibble >> 3) & 1) * GENERATOR_7_4[0]) ^
+           (((nibble >> 2) & 1) * GENERATOR_7_4[1]) ^
+           (((nibble >> 1) & 1) * GENERATOR_7_4[2]) ^
+           ((nibble & 1) * GENERATOR_7_4[3]);
+}
+
+/**
+    @brief Syndrome of a group of 7 bits.
+
+    @param unsigned group: Group D7 D6 D5 P4 D3 P2 P1, D7 being the most
+        significant.
+    @return unsigned: Position (7~1) of the bit to be inverted, 0 if none.
+*/
+constexpr unsigned groupSyndrome(unsigned group){
+
+    // The XOR of the positions of the odd bits is the position of the bit
+    // to be inverted/corrected (zero if there are no fixes to be made).
+    return (parity7(group & PARITY_CHECK_7_4[0]) << 2) |
+           (parity7(group & PARITY_CHECK_7_4[1]) << 1) |
+           parity7(group & PARITY_CHECK_7_4[2]);
+}
+
+/**
+    @brief Data bits of a group of 7 bits, as they are.
+
+    @param unsigned group: Group D7 D6 D5 P4 D3 P2 P1, D7 being the most
+        significant.
+    @return unsigned: 4 original bits, D7 being the most significant.
+*/
+constexpr unsigned groupNibble(unsigned group){
+    return (((group >> 6) & 1) << 3) |
+           (((group >> 5) & 1) << 2) |
+           (((group >> 4) & 1) << 1) |
+           ((group >> 2) & 1);
+}
+
+/**
+    @brief Correct a group of 7 bits by applying the hamming method.
+
+    @param unsigned group: Group D7 D6 D5 P4 D3 P2 P1, D7 being the most
+        significant.
+    @return unsigned: 4 original bits, D7 being the most significant.
+*/
+constexpr unsigned decodeGroup(unsigned group){
+
+    return groupSyndrome(group) > 0 ? groupNibble(group ^ (1u << (groupSyndrome(group) - 1))) :
+                                      groupNibble(group);
+}
+
+/**
+    @brief Assemble a group of 8 bits of the code (8,4).
+
+    @param unsigned nibble: 4 original bits, D7 being the most significant.
+    @return unsigned: Group D7 D6 D5 P4 D3 P2 P1 P8, D7 being the most
+        significant, P8 being the parity of the other 7.
+*/
+constexpr unsigned encodeSecdedNibble(unsigned nibble){
+    return (encodeNibble(nibble) << 1) | parity7(encodeNibble(nibble));
+}
+
+/**
+    @brief What the extended hamming method finds in a group of 8 bits.
+
+    @param unsigned group: Group D7 D6 D5 P4 D3 P2 P1 P8, D7 being the most
+        significant.
+    @return unsigned: 1 if a bit is to be corrected, 2 if two bits were
+        inverted (detected, nothing is changed), 0 if clean.
+*/
+constexpr unsigned secdedStatus(unsigned group){
+
+    // An odd number of inverted bits is taken as one: at the syndrome, or P8
+    // itself when the syndrome is zero.
+    return (parity7(group >> 1) ^ (group & 1)) != 0 ? 1 :
+           (groupSyndrome(group >> 1) > 0 ? 2 : 0);
+}
+
+/**
+    @brief Correct a group of 8 bits by applying the extended hamming method.
+
+    @param unsigned group: Group D7 D6 D5 P4 D3 P2 P1 P8, D7 being the most
+        significant.
+    @return unsigned: 4 original bits, D7 being the most significant.
+*/
+constexpr unsigned secdedNibble(unsigned group){
+    return secdedStatus(group) == 1 ? decodeGroup(group >> 1) : groupNibble(group >> 1);
+}
+
+/**
+    @brief Correct a group of 8 bits by applying the extended hamming method.
+
+    @param unsigned group: Group D7 D6 D5 P4 D3 P2 P1 P8, D7 being the most
+        significant.
+    @param unsigned* status: Receives 1 if a bit was corrected, 2 if two
+        bits were inverted (detected, nothing is changed), 0 if clean.
+    @return unsigned: 4 original bits, D7 being the most significant.
+*/
+inline unsigned decodeSecdedGroup(unsigned group, unsigned* status){
+    *status = secdedStatus(group);
+    return secdedNibble(group);
+}
+
+/**
+    @brief The two groups of 7 bits (14 bits, the high nibble first) of each
+        of the 256 possible bytes.
+*/
+struct EncodeTable {
+    uint16_t bits14[256];
+};
+
+/**
+    @brief Entry of "EncodeTable".
+
+    @param unsigned z: Byte.
+    @return uint16_t: Its two groups.
+*/
+constexpr uint16_t encodeTableEntry(unsigned z){
+    return (uint16_t)((encodeNibble(z >> 4) << 7) | encodeNibble(z & 0x0F));
+}
+
+/**
+    @brief Fill in "EncodeTable".
+
+    @param IndexSequence<Z...>: The 256 bytes.
+    @return EncodeTable: The table.
+*/
+template<size_t... Z>
+constexpr EncodeTable makeEncodeTable(tables::IndexSequence<Z...>){
+    return EncodeTable{{encodeTableEntry(Z)...}};
+}
+
+constexpr EncodeTable encodeTable = makeEncodeTable(tables::MakeIndexSequence<256>::Type());
+
+/**
+    @brief Correction of each of the 128 possible groups of 7 bits: the 4
+        original bits (bits 0~3), the position of the inverted bit (bits 4~6,
+        zero when there is none) and whether it was corrected (bit 7).
+*/
+struct SyndromeTable {
+    uint8_t corrections[128];
+};
+
+/**
+    @brief Entry of "SyndromeTable".
+
+    @param unsigned z: Group of 7 bits.
+    @return uint8_t: Its correction.
+*/
+constexpr uint8_t syndromeTableEntry(unsigned z){
+    return (uint8_t)(decodeGroup(z) |
+                     (groupSyndrome(z) << 4) |
+                     (groupSyndrome(z) > 0 ? 0x80 : 0));
+}
+
+/**
+    @brief Fill in "SyndromeTable".
+
+    @param IndexSequence<Z...>: The 128 groups.
+    @return SyndromeTable: The table.
+*/
+template<size_t... Z>
+constexpr SyndromeTable makeSyndromeTable(tables::IndexSequence<Z...>){
+    return SyndromeTable{{syndromeTableEntry(Z)...}};
+}
+
+constexpr SyndromeTable syndromeTable = makeSyndromeTable(tables::MakeIndexSequence<128>::Type());
+
+/**
+    @brief The group of each of the 16 possible nibbles and the correction of
+        each of the 256 possible groups of the code (8,4): the 4 original
+        bits (bits 0~3), whether two bits were inverted (bit 6) and whether
+        one was corrected (bit 7).
+*/
+struct SecdedTable {
+    uint8_t groups[16];
+    uint8_t corrections[256];
+};
+
+/**
+    @brief Correction of "SecdedTable".
+
+    @param unsigned z: Group of 8 bits.
+    @return uint8_t: Its correction.
+*/
+constexpr uint8_t secdedTableEntry(unsigned z){
+    return (uint8_t)(secdedNibble(z) |
+                     (secdedStatus(z) == 2 ? 0x40 : 0) |
+                     (secdedStatus(z) == 1 ? 0x80 : 0));
+}
+
+/**
+    @brief Fill in "SecdedTable".
+
+    @param IndexSequence<G...>: The 16 nibbles.
+    @param IndexSequence<Z...>: The 256 groups.
+    @return SecdedTable: The table.
+*/
+template<size_t... G, size_t... Z>
+constexpr SecdedTable makeSecdedTable(tables::IndexSequence<G...>, tables::IndexSequence<Z...>){
+    return SecdedTable{{(uint8_t)encodeSecdedNibble(G)...}, {secdedTableEntry(Z)...}};
+}
+
+constexpr SecdedTable secdedTable = makeSecdedTable(tables::MakeIndexSequence<16>::Type(),
+                                                    tables::MakeIndexSequence<256>::Type());
+
+// Polynomial of the CRC32C (Castagnoli), reflected.
+constexpr uint32_t CRC32C_POLYNOMIAL = 0x82F63B78;
+
+/**
+    @brief Shift bits through the CRC32C.
+
+    @param uint32_t crc: CRC so far.
+    @param unsigned count: Number of zero bits.
+    @return uint32_t: The CRC after them.
+*/
+constexpr uint32_t crcShift(uint32_t crc, unsigned count){
+    return count == 0 ? crc : crcShift((crc >> 1) ^ ((crc & 1) ? CRC32C_POLYNOMIAL : 0), count - 1);
+}
+
+/**
+    @brief CRC32C after one more zero byte.
+
+    @param uint32_t crc: CRC so far.
+    @return uint32_t: The CRC after the byte.
+*/
+constexpr uint32_t crcZeroByte(uint32_t crc){
+    return (crc >> 8) ^ crcShift(crc & 0xFF, 8);
+}
+
+/**
+    @brief Entry of "CrcTable".
+
+    @param unsigned zeros: Number of zero bytes after the byte (0~7).
+    @param uint32_t z: Byte.
+    @return uint32_t: CRC32C of it.
+*/
+constexpr uint32_t crcTableEntry(unsigned zeros, uint32_t z){
+    return zeros == 0 ? crcShift(z, 8) : crcZeroByte(crcTableEntry(zeros - 1, z));
+}
+
+/**
+    @brief CRC32C of each byte, and of each byte followed by 1~7 zero bytes,
+        to take 8 bytes at a time.
+*/
+struct CrcTable {
+    uint32_t crcs[8][256];
+};
+
+/**
+    @brief Fill in "CrcTable", row after row.
+
+    @param IndexSequence<Z...>: The 8 * 256 entries.
+    @return CrcTable: The table.
+*/
+template<size_t... Z>
+constexpr CrcTable makeCrcTable(tables::IndexSequence<Z...>){
+    return CrcTable{{crcTableEntry(Z / 256, Z % 256)...}};
+}
+
+constexpr CrcTable crcTable = makeCrcTable(tables::MakeIndexSequence<8 * 256>::Type());
+
+/**
+    @brief Read 8 bytes as a little-endian number (written out, so that it is
+        compiled to a single load).
+
+    @param const uint8_t* bytes: Bytes.
+    @return uint64_t: Number.
+*/
+inline uint64_t loadLittleEndian(const uint8_t* bytes){
+    return (uint64_t)bytes[0] | ((uint64_t)bytes[1] << 8) | ((uint64_t)bytes[2] << 16) |
+           ((uint64_t)bytes[3] << 24) | ((uint64_t)bytes[4] << 32) | ((uint64_t)bytes[5] << 40) |
+           ((uint64_t)bytes[6] << 48) | ((uint64_t)bytes[7] << 56);
+}
+
+/**
+    @brief Write a number as 8 bytes little-endian (written out, so that it
+        is compiled to a single store).
+
+    @param uint8_t* bytes: Receives the bytes.
+    @param uint64_t value: Number.
+    @return void.
+*/
+inline void storeLittleEndian(uint8_t* bytes, uint64_t value){
+    bytes[0] = (uint8_t)value;
+    bytes[1] = (uint8_t)(value >> 8);
+    bytes[2] = (uint8_t)(value >> 16);
+    bytes[3] = (uint8_t)(value >> 24);
+    bytes[4] = (uint8_t)(value >> 32);
+    bytes[5] = (uint8_t)(value >> 40);
+    bytes[6] = (uint8_t)(value >> 48);
+    bytes[7] = (uint8_t)(value >> 56);
+}
+
+/**
+    @brief Transpose a matrix of 8x8 bits: the bit "c" of the byte "r" (both
+        counted from the most significant) becomes the bit "r" of the byte
+        "c", swapping blocks of 1x1, 2x2 and 4x4 bits.
+
+    @param uint64_t bits: The matrix, the byte 0 the most significant.
+    @return uint64_t: The transposed matrix.
+*/
+inline uint64_t transposeBits(uint64_t bits){
+    uint64_t swap = (bits ^ (bits >> 7)) & 0x00AA00AA00AA00AAULL;
+    bits ^= swap ^ (swap << 7);
+    swap = (bits ^ (bits >> 14)) & 0x0000CCCC0000CCCCULL;
+    bits ^= swap ^ (swap << 14);
+    swap = (bits ^ (bits >> 28)) & 0x00000000F0F0F0F0ULL;
+    return bits ^ swap ^ (swap << 28);
+}
+
+// Bytes of the largest group ((72,64)), and so of 8 groups in bits.
+const size_t MAX_GROUP_BYTES = 72;
+// Bytes after a frame that "interleaveTiles" can read (their bits are not
+// used).
+const size_t TILE_SLACK_BYTES = 16;
+// Bytes in the hamming format that "addInterleavedParity" encodes aside at a
+// time (at least a frame), before interleaving them.
+const size_t INTERLEAVE_BATCH_BYTES = 4096;
+
+/**
+    @brief Read 8 bytes as a big-endian number (written out, so that it is
+        compiled to a single load).
+
+    @param const uint8_t* bytes: Bytes.
+    @return uint64_t: Number.
+*/
+inline uint64_t loadBigEndian(const uint8_t* bytes){
+    return ((uint64_t)bytes[0] << 56) | ((uint64_t)bytes[1] << 48) | ((uint64_t)bytes[2] << 40) |
+           ((uint64_t)bytes[3] << 32) | ((uint64_t)bytes[4] << 24) | ((uint64_t)bytes[5] << 16) |
+           ((uint64_t)bytes[6] << 8) | (uint64_t)bytes[7];
+}
+
+/**
+    @brief Write a number as 8 bytes big-endian (written out, so that it is
+        compiled to a single store).
+
+    @param uint8_t* bytes: Receives the bytes.
+    @param uint64_t value: Number.
+    @return void.
+*/
+inline void storeBigEndian(uint8_t* bytes, uint64_t value){
+    bytes[0] = (uint8_t)(value >> 56);
+    bytes[1] = (uint8_t)(value >> 48);
+    bytes[2] = (uint8_t)(value >> 40);
+    bytes[3] = (uint8_t)(value >> 32);
+    bytes[4] = (uint8_t)(value >> 24);
+    bytes[5] = (uint8_t)(value >> 16);
+    bytes[6] = (uint8_t)(value >> 8);
+    bytes[7] = (uint8_t)value;
+}
+
+/**
+    @brief Swap the bits "mask" of a word with the bits "shift" higher of
+        another one.
+
+    @param uint64_t* words: Words.
+    @param unsigned masked: Index of the word of the bits "mask".
+    @param unsigned shifted: Index of the other word.
+    @param unsigned shift: Distance between the bits swapped.
+    @param uint64_t mask: Bits of the word "masked" that are swapped.
+    @return void.
+*/
+inline void swapBitBlocks(uint64_t* words, unsigned masked, unsigned shifted, unsigned shift,
+                          uint64_t mask){
+    uint64_t swap = (words[masked] ^ (words[shifted] >> shift)) & mask;
+    words[masked] ^= swap;
+    words[shifted] ^= swap << shift;
+}
+
+/**
+    @brief Transpose the 8 matrices of 8x8 bits of 8 words at once: the bit
+        "c" (from the most significant) of the byte "b" of the word "r"
+        becomes the bit "r" of the byte "b" of the word "c". The blocks of
+        4x4, 2x2 and then 1x1 bits are swapped; the swaps are written out so
+        that the words stay in registers.
+
+    @param uint64_t* words: 8 words, transposed in place.
+    @return void.
+*/
+inline void transposeWords(uint64_t* words){
+    swapBitBlocks(words, 0, 4, 4, 0x0F0F0F0F0F0F0F0FULL);
+    swapBitBlocks(words, 1, 5, 4, 0x0F0F0F0F0F0F0F0FULL);
+    swapBitBlocks(words, 2, 6, 4, 0x0F0F0F0F0F0F0F0FULL);
+    swapBitBlocks(words, 3, 7, 4, 0x0F0F0F0F0F0F0F0FULL);
+    swapBitBlocks(words, 0, 2, 2, 0x3333333333333333ULL);
+    swapBitBlocks(words, 1, 3, 2, 0x3333333333333333ULL);
+    swapBitBlocks(words, 4, 6, 2, 0x3333333333333333ULL);
+    swapBitBlocks(words, 5, 7, 2, 0x3333333333333333ULL);
+    swapBitBlocks(words, 0, 1, 1, 0x5555555555555555ULL);
+    swapBitBlocks(words, 2, 3, 1, 0x5555555555555555ULL);
+    swapBitBlocks(words, 4, 5, 1, 0x5555555555555555ULL);
+    swapBitBlocks(words, 6, 7, 1, 0x5555555555555555ULL);
+}
+
+/**
+    @brief Exchange the index of 8 words with 3 bits of the positions of
+        their bits: the bit "p + (c * unit)" of the word "r" becomes the bit
+        "p + (r * unit)" of the word "c" ("p" having those 3 bits zero).
+        Like "transposeWords", one bit of the index at a time.
+
+    @param uint64_t* words: 8 words, exchanged in place.
+    @param unsigned unit: 1 for the bits of each byte, 8 for the bytes.
+    @return void.
+*/
+inline void exchangeWordBits(uint64_t* words, unsigned unit){
+    uint64_t fours = unit == 1 ? 0x0F0F0F0F0F0F0F0FULL : 0x00000000FFFFFFFFULL;
+    uint64_t twos = unit == 1 ? 0x3333333333333333ULL : 0x0000FFFF0000FFFFULL;
+    uint64_t ones = unit == 1 ? 0x5555555555555555ULL : 0x00FF00FF00FF00FFULL;
+    swapBitBlocks(words, 4, 0, unit * 4, fours);
+    swapBitBlocks(words, 5, 1, unit * 4, fours);
+    swapBitBlocks(words, 6, 2, unit * 4, fours);
+    swapBitBlocks(words, 7, 3, unit * 4, fours);
+    swapBitBlocks(words, 2, 0, unit * 2, twos);
+    swapBitBlocks(words, 3, 1, unit * 2, twos);
+    swapBitBlocks(words, 6, 4, unit * 2, twos);
+    swapBitBlocks(words, 7, 5, unit * 2, twos);
+    swapBitBlocks(words, 1, 0, unit, ones);
+    swapBitBlocks(words, 3, 2, unit, ones);
+    swapBitBlocks(words, 5, 4, unit, ones);
+    swapBitBlocks(words, 7, 6, unit, ones);
+}
+
+/**
+    @brief Read the first 64 bits of a group of a tile as a word, the first
+        bit the most significant. The bits after a group shorter than 64
+        bits are those that follow it.
+
+    @param const uint8_t* tile: Tile, followed by 8 bytes that can be read.
+    @param unsigned group: Group of the tile (0~7).
+    @return uint64_t: Word.
+*/
+template<unsigned GROUP_BITS>
+inline uint64_t loadGroup(const uint8_t* tile, unsigned group){
+    const uint8_t* bytes = tile + ((group * GROUP_BITS) / 8);
+    unsigned shift = (group * GROUP_BITS) % 8;
+    return (loadBigEndian(bytes) << shift) | (bytes[8] >> (8 - shift));
+}
+
+/**
+    @brief Write the bytes of a word (the most significant first) to bytes
+        at a regular distance.
+
+    @param uint64_t word: Word.
+    @param unsigned count: Number of bytes written (0~8).
+    @param uint8_t* bytes: Receives the bytes.
+    @param size_t stride: Distance between the bytes.
+    @return void.
+*/
+inline void storeColumn(uint64_t word, unsigned count, uint8_t* bytes, size_t stride){
+    for(unsigned b = 0; b < count; b++){
+        bytes[b * stride] = (uint8_t)(word >> 56);
+        word <<= 8;
+    }
+}
+
+/**
+    @brief Inverse of "storeColumn".
+
+    @param const uint8_t* bytes: Bytes at a regular distance.
+    @param unsigned count: Number of bytes read (0~8).
+    @param size_t stride: Distance between the bytes.
+    @return uint64_t: Word, completed with zeros.
+*/
+inline uint64_t loadColumn(const uint8_t* bytes, unsigned count, size_t stride){
+    uint64_t word = 0;
+    for(unsigned b = 0; b < count; b++){
+        word |= (uint64_t)bytes[b * stride] << (56 - (b * 8));
+    }
+    return word;
+}
+
+/**
+    @brief Write the 8 groups of a tile interleaved, given as words: the
+        words are transposed together ("transposeWords"), after which the
+        byte "b" of the word "c" has the bit "8b + c" of the 8 groups.
+
+    @param uint64_t* words: The first 64 bits of each group, the first bit
+        the most significant, and with 72 bits the last byte of the 8 groups
+        as a ninth word (the group 0 the most significant), changed.
+    @param size_t tiles: Number of tiles of the frame.
+    @param uint8_t* output: Receives the bit "b" of the tile in the byte
+        "b * tiles".
+    @return void.
+*/
+template<unsigned GROUP_BITS>
+inline void interleaveWords(uint64_t* words, size_t tiles, uint8_t* output){
+    const unsigned wordBits = GROUP_BITS < 64 ? GROUP_BITS : 64;
+    transposeWords(words);
+    for(unsigned c = 0; c < 8; c++){
+        storeColumn(words[c], (wordBits + 7 - c) / 8, output + (c * tiles), 8 * tiles);
+    }
+    if(GROUP_BITS > 64){
+        storeColumn(transposeBits(words[8]), 8, output + (64 * tiles), tiles);
+    }
+}
+
+/**
+    @brief Interleave a frame of groups of "GROUP_BITS" bits, 8 groups (a
+        tile of "GROUP_BITS" bytes) at a time. The 8 bytes of (8,4) are one
+        8x8 matrix. Other groups are read as one word each, and the words
+        are transposed together ("interleaveWords"); the last byte of the
+        groups of (72,64) is one more matrix.
+
+    @param const uint8_t* frame: "tiles * GROUP_BITS" bytes, followed by
+        "TILE_SLACK_BYTES" that can be read.
+    @param size_t tiles: Number of tiles of the frame.
+    @param uint8_t* output: Receives the bit "b" of the tile "t" in the byte
+        "b * tiles + t".
+    @return void.
+*/
+template<unsigned GROUP_BITS>
+void interleaveTilesOf(const uint8_t* frame, size_t tiles, uint8_t* output){
+    for(size_t t = 0; t < tiles; t++){
+        const uint8_t* tile = frame + (t * GROUP_BITS);
+        if(GROUP_BITS == 8){
+            storeColumn(transposeBits(loadBigEndian(tile)), 8, output + t, tiles);
+            continue;
+        }
+        uint64_t words[9] = {loadGroup<GROUP_BITS>(tile, 0), loadGroup<GROUP_BITS>(tile, 1),
+                             loadGroup<GROUP_BITS>(tile, 2), loadGroup<GROUP_BITS>(tile, 3),
+                             loadGroup<GROUP_BITS>(tile, 4), loadGroup<GROUP_BITS>(tile, 5),
+                             loadGroup<GROUP_BITS>(tile, 6), loadGroup<GROUP_BITS>(tile, 7), 0};
+        if(GROUP_BITS > 64){
+            for(unsigned r = 0; r < 8; r++){
+                words[8] = (words[8] << 8) | tile[(r * 9) + 8];
+            }
+        }
+        interleaveWords<GROUP_BITS>(words, tiles, output + t);
+    }
+}
+
+/**
+    @brief Inverse of "interleaveTilesOf". The words of the groups shorter
+        than 64 bits are joined 64 bits at a time.
+
+    @param const uint8_t* input: "tiles * GROUP_BITS" interleaved bytes.
+    @param size_t tiles: Number of tiles of the frame.
+    @param uint8_t* frame: Receives the groups in order.
+    @return void.
+*/
+template<unsigned GROUP_BITS>
+void deinterleaveTilesOf(const uint8_t* input, size_t tiles, uint8_t* frame){
+    const unsigned wordBits = GROUP_BITS < 64 ? GROUP_BITS : 64;
+    for(size_t t = 0; t < tiles; t++){
+        if(GROUP_BITS == 8){
+            storeBigEndian(frame + (t * 8), transposeBits(loadColumn(input + t, 8, tiles)));
+            continue;
+        }
+        uint64_t words[8];
+        for(unsigned c = 0; c < 8; c++){
+            words[c] = loadColumn(input + (c * tiles) + t, (wordBits + 7 - c) / 8, 8 * tiles);
+        }
+        transposeWords(words);
+        uint8_t tile[MAX_GROUP_BYTES];
+        if(GROUP_BITS > 64){
+            uint64_t extra = transposeBits(loadColumn(input + (64 * tiles) + t, 8, tiles));
+            for(unsigned r = 0; r < 8; r++){
+                storeBigEndian(tile + (r * 9), words[r]);
+                tile[(r * 9) + 8] = (uint8_t)(extra >> (56 - (r * 8)));
+            }
+        }else{
+
+            // The bits after each group are zeros.
+            uint64_t joined[MAX_GROUP_BYTES / 8] = {0};
+            for(unsigned r = 0; r < 8; r++){
+                unsigned shift = (r * GROUP_BITS) % 64;
+                joined[(r * GROUP_BITS) / 64] |= words[r] >> shift;
+                if(shift + GROUP_BITS > 64){
+                    joined[((r * GROUP_BITS) / 64) + 1] |= words[r] << (64 - shift);
+                }
+            }
+            for(unsigned z = 0; z < (GROUP_BITS + 7) / 8; z++){
+                storeBigEndian(tile + (z * 8), joined[z]);
+            }
+        }
+        memcpy(frame + (t * GROUP_BITS), tile, GROUP_BITS);
+    }
+}
+
+/**
+    @brief Interleave a frame of groups of any size of the codes (see
+        "interleaveTilesOf").
+
+    @param const uint8_t* frame: "tiles * groupBits" bytes, followed by
+        "TILE_SLACK_BYTES" that can be read.
+    @param size_t tiles: Number of tiles of the frame.
+    @param unsigned groupBits: Bits of each group (7, 8, 15, 31, 63 or 72).
+    @param uint8_t* output: Receives the bit "b" of the tile "t" in the byte
+        "b * tiles + t".
+    @return void.
+*/
+void interleaveTiles(const uint8_t* frame, size_t tiles, unsigned groupBits, uint8_t* output){
+    switch(groupBits){
+        case 7:
+            interleaveTilesOf<7>(frame, tiles, output);
+            break;
+        case 8:
+            interleaveTilesOf<8>(frame, tiles, output);
+            break;
+        case 15:
+            interleaveTilesOf<15>(frame, tiles, output);
+            break;
+        case 31:
+            interleaveTilesOf<31>(frame, tiles, output);
+            break;
+        case 63:
+            interleaveTilesOf<63>(frame, tiles, output);
+            break;
+        default:
+            interleaveTilesOf<72>(frame, tiles, output);
+    }
+}
+
+/**
+    @brief Inverse of "interleaveTiles".
+
+    @param const uint8_t* input: "tiles * groupBits" interleaved bytes.
+    @param size_t tiles: Number of tiles of the frame.
+    @param unsigned groupBits: Bits of each group.
+    @param uint8_t* frame: Receives the groups in order.
+    @return void.
+*/
+void deinterleaveTiles(const uint8_t* input, size_t tiles, unsigned groupBits, uint8_t* frame){
+    switch(groupBits){
+        case 7:
+            deinterleaveTilesOf<7>(input, tiles, frame);
+            break;
+        case 8:
+            deinterleaveTilesOf<8>(input, tiles, frame);
+            break;
+        case 15:
+            deinterleaveTilesOf<15>(input, tiles, frame);
+            break;
+        case 31:
+            deinterleaveTilesOf<31>(input, tiles, frame);
+            break;
+        case 63:
+            deinterleaveTilesOf<63>(input, tiles, frame);
+            break;
+        default:
+            deinterleaveTilesOf<72>(input, tiles, frame);
+    }
+}
+
+/**
+    @brief Interleave a frame of groups of "GROUP_BITS" bits (15, 31, 63 or
+        72) from the words of its groups, a tile at a time.
+
+    @param const uint64_t* words: The words of the groups, in rows of 4 tiles
+        ("kernels::InterleaveWordsFn").
+    @param size_t tiles: Number of tiles of the frame.
+    @param uint8_t* output: Receives the bit "b" of the tile "t" in the byte
+        "b * tiles + t".
+    @return void.
+*/
+template<unsigned GROUP_BITS>
+void interleaveTileWordsOf(const uint64_t* words, size_t tiles, uint8_t* output){
+    for(size_t t = 0; t < tiles; t++){
+        const uint64_t* quad = words + ((t / 4) * kernels::QUAD_WORDS) + (t % 4);
+        uint64_t tileWords[9] = {quad[0], quad[4], quad[8], quad[12], quad[16], quad[20],
+                                 quad[24], quad[28], GROUP_BITS > 64 ? quad[32] : 0};
+        interleaveWords<GROUP_BITS>(tileWords, tiles, output + t);
+    }
+}
+
+// Plane of the bit-sliced layout of each bit of the nibbles (D3 D5 D6 D7)
+// and of each parity bit (P1 P2 P4).
+const unsigned SLICED_DATA_PLANES[4] = {4, 2, 1, 0};
+const unsigned SLICED_P1 = 6;
+const unsigned SLICED_P2 = 5;
+const unsigned SLICED_P4 = 3;
+
+/**
+    @brief Transpose 64 bytes into the 8 planes of their bits, as
+        "exchangeWordBits" does to the bytes of 8 words and then to their
+        bits.
+
+    @param const uint8_t* bytes: 64 bytes.
+    @param uint64_t* planes: Receives the bit "k" of the byte "i" as the bit
+        "i" of the word "k".
+    @return void.
+*/
+inline void sliceBytes(const uint8_t* bytes, uint64_t* planes){
+    for(unsigned z = 0; z < 8; z++){
+        planes[z] = loadLittleEndian(bytes + (z * 8));
+    }
+    exchangeWordBits(planes, 8);
+    exchangeWordBits(planes, 1);
+}
+
+/**
+    @brief Inverse of "sliceBytes".
+
+    @param uint64_t* planes: 8 planes, changed.
+    @param uint8_t* bytes: Receives 64 bytes.
+    @return void.
+*/
+inline void unsliceBytes(uint64_t* planes, uint8_t* bytes){
+    exchangeWordBits(planes, 1);
+    exchangeWordBits(planes, 8);
+    for(unsigned z = 0; z < 8; z++){
+        storeLittleEndian(bytes + (z * 8), planes[z]);
+    }
+}
+
+/**
+    @brief Write one word of each plane of a slab: the 4 data planes and the
+        3 parity planes.
+
+    @param uint8_t* hammingBytes: Slab in the hamming format.
+    @param unsigned w: Word of the planes (0~3).
+    @param const uint64_t* data: Bits 0~3 of 64 nibbles (D3 D5 D6 D7).
+    @return void.
+*/
+inline void storeSlicedWord(uint8_t* hammingBytes, unsigned w, const uint64_t* data){
+    for(unsigned n = 0; n < 4; n++){
+        storeLittleEndian(hammingBytes + (SLICED_DATA_PLANES[n] * 32) + (w * 8), data[n]);
+    }
+    storeLittleEndian(hammingBytes + (SLICED_P4 * 32) + (w * 8), data[3] ^ data[2] ^ data[1]);
+    storeLittleEndian(hammingBytes + (SLICED_P2 * 32) + (w * 8), data[3] ^ data[2] ^ data[0]);
+    storeLittleEndian(hammingBytes + (SLICED_P1 * 32) + (w * 8), data[3] ^ data[1] ^ data[0]);
+}
+
+/**
+    @brief Inverse of "storeSlicedWord", correcting the groups.
+
+    @param const uint8_t* hammingBytes: Slab in the hamming format.
+    @param unsigned w: Word of the planes (0~3).
+    @param bool correct: false to take the data planes as they are.
+    @param uint64_t* data: Receives the bits 0~3 of the 64 nibbles.
+    @return unsigned: Number of groups that had a bit corrected.
+*/
+inline unsigned loadSlicedWord(const uint8_t* hammingBytes, unsigned w, bool correct,
+                               uint64_t* data){
+    uint64_t planes[7];
+    for(unsigned z = 0; z < 7; z++){
+        planes[z] = loadLittleEndian(hammingBytes + (z * 32) + (w * 8));
+    }
+    uint64_t d7 = planes[SLICED_DATA_PLANES[3]];
+    uint64_t d6 = planes[SLICED_DATA_PLANES[2]];
+    uint64_t d5 = planes[SLICED_DATA_PLANES[1]];
+    uint64_t d3 = planes[SLICED_DATA_PLANES[0]];
+    unsigned corrected = 0;
+    if(correct){
+        uint64_t s4 = d7 ^ d6 ^ d5 ^ planes[SLICED_P4];
+        uint64_t s2 = d7 ^ d6 ^ d3 ^ planes[SLICED_P2];
+        uint64_t s1 = d7 ^ d5 ^ d3 ^ planes[SLICED_P1];
+        d7 ^= s4 & s2 & s1;
+        d6 ^= s4 & s2 & ~s1;
+        d5 ^= s4 & ~s2 & s1;
+        d3 ^= ~s4 & s2 & s1;
+        corrected = (unsigned)__builtin_popcountll(s4 | s2 | s1);
+    }
+    data[0] = d3;
+    data[1] = d5;
+    data[2] = d6;
+    data[3] = d7;
+    return corrected;
+}
+
+/**
+    @brief Decode slabs of the bit-sliced layout 64 groups at a time.
+
+    @param const uint8_t* hammingBytes: "slabs * 224" bytes in the hamming
+        format.
+    @param size_t slabs: Number of slabs.
+    @param uint8_t* bytes: Receives "slabs * 128" original bytes.
+    @param bool correct: false to take the data planes as they are.
+    @return uint64_t: Number of groups that had a bit corrected.
+*/
+uint64_t unsliceBitwise(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes, bool correct){
+    uint64_t corrected = 0;
+    for( ; slabs > 0; slabs--){
+
+        // The words 0~1 have the high nibbles of each half of 64 bytes and
+        // the words 2~3 their low nibbles: the planes of the bits 4~7 and
+        // 0~3 of the half.
+        for(unsigned w = 0; w < 2; w++){
+            uint64_t planes[8];
+            corrected += loadSlicedWord(hammingBytes, w + 2, correct, planes);
+            corrected += loadSlicedWord(hammingBytes, w, correct, planes + 4);
+            unsliceBytes(planes, bytes + (w * 64));
+        }
+        hammingBytes += SLICED_HAMMING_BYTES;
+        bytes += SLICED_BYTES;
+    }
+    return corrected;
+}
+
+} // namespace
+
+namespace kernels {
+
+/**
+    @brief Apply hamming parity to blocks of 4 bytes computing each group.
+
+    @param const uint8_t* bytes: "blocks * 4" original bytes.
+    @param size_t blocks: Number of blocks.
+    @param uint8_t* hammingBytes: "blocks * 7" bytes in the hamming format.
+    @return void.
+*/
+void encodeBlocksBitwise(const uint8_t* bytes, size_t blocks, uint8_t* hammingBytes){
+    for( ; blocks > 0; blocks--){
+        uint64_t bits = 0;
+        for(size_t z = 0; z < BLOCK_BYTES; z++){
+            bits = (bits << 14) |
+                   (encodeNibble(bytes[z] >> 4) << 7) |
+                   encodeNibble(bytes[z] & 0x0F);
+        }
+        for(size_t z = 0; z < BLOCK_HAMMING_BYTES; z++){
+            hammingBytes[z] = (uint8_t)(bits >> (48 - (z * 8)));
+        }
+        bytes += BLOCK_BYTES;
+        hammingBytes += BLOCK_HAMMING_BYTES;
+    }
+}
+
+/**
+    @brief Correct and remove hamming parity from blocks of 7 bytes computing
+        each group.
+
+    @param const uint8_t* hammingBytes: "blocks * 7" bytes in the hamming
+        format.
+    @param size_t blocks: Number of blocks.
+    @param uint8_t* bytes: "blocks * 4" original bytes.
+    @return uint64_t: Number of groups that had a bit corrected.
+*/
+uint64_t decodeBlocksBitwise(const uint8_t* hammingBytes, size_t blocks, uint8_t* bytes){
+    uint64_t corrected = 0;
+    for( ; blocks > 0; blocks--){
+        uint64_t bits = 0;
+        for(size_t z = 0; z < BLOCK_HAMMING_BYTES; z++){
+            bits = (bits << 8) | hammingBytes[z];
+        }
+        for(size_t z = 0; z < BLOCK_BYTES; z++){
+            unsigned bits14 = (unsigned)(bits >> (42 - (z * 14))) & 0x3FFF;
+            bytes[z] = (uint8_t)((decodeGroup(bits14 >> 7) << 4) |
+                                 decodeGroup(bits14 & 0x7F));
+            corrected += (groupSyndrome(bits14 >> 7) != 0) + (groupSyndrome(bits14 & 0x7F) != 0);
+        }
+        hammingBytes += BLOCK_HAMMING_BYTES;
+        bytes += BLOCK_BYTES;
+    }
+    return corrected;
+}
+
+/**
+    @brief Apply hamming parity to blocks of 4 bytes with one table lookup
+        per byte.
+
+    @param const uint8_t* bytes: "blocks * 4" original bytes.
+    @param size_t blocks: Number of blocks.
+    @param uint8_t* hammingBytes: "blocks * 7" bytes in the hamming format.
+    @return void.
+*/
+void encodeBlocksTable(const uint8_t* bytes, size_t blocks, uint8_t* hammingBytes){
+    const uint16_t* bits14 = encodeTable.bits14;
+    for( ; blocks > 0; blocks--){
+        uint64_t bits = ((uint64_t)bits14[bytes[0]] << 42) |
+                        ((uint64_t)bits14[bytes[1]] << 28) |
+                        ((uint64_t)bits14[bytes[2]] << 14) |
+                        bits14[bytes[3]];
+        hammingBytes[0] = (uint8_t)(bits >> 48);
+        hammingBytes[1] = (uint8_t)(bits >> 40);
+        hammingBytes[2] = (uint8_t)(bits >> 32);
+        hammingBytes[3] = (uint8_t)(bits >> 24);
+        hammingBytes[4] = (uint8_t)(bits >> 16);
+        hammingBytes[5] = (uint8_t)(bits >> 8);
+        hammingBytes[6] = (uint8_t)bits;
+        bytes += BLOCK_BYTES;
+        hammingBytes += BLOCK_HAMMING_BYTES;
+    }
+}
+
+/**
+    @brief Correct and remove hamming parity from blocks of 7 bytes with one
+        table lookup per group.
+
+    @param const uint8_t* hammingBytes: "blocks * 7" bytes in the hamming
+        format.
+    @param size_t blocks: Number of blocks.
+    @param uint8_t* bytes: "blocks * 4" original bytes.
+    @return uint64_t: Number of groups that had a bit corrected.
+*/
+uint64_t decodeBlocksTable(const uint8_t* hammingBytes, size_t blocks, uint8_t* bytes){
+    const uint8_t* corrections = syndromeTable.corrections;
+    uint64_t corrected = 0;
+    for( ; blocks > 0; blocks--){
+        uint64_t bits = ((uint64_t)hammingBytes[0] << 48) |
+                        ((uint64_t)hammingBytes[1] << 40) |
+                        ((uint64_t)hammingBytes[2] << 32) |
+                        ((uint64_t)hammingBytes[3] << 24) |
+                        ((uint64_t)hammingBytes[4] << 16) |
+                        ((uint64_t)hammingBytes[5] << 8) |
+                        hammingBytes[6];
+        for(size_t z = 0; z < BLOCK_BYTES; z++){
+            unsigned shift = 42 - (unsigned)(z * 14);
+            uint8_t high = corrections[(bits >> (shift + 7)) & 0x7F];
+            uint8_t low = corrections[(bits >> shift) & 0x7F];
+            bytes[z] = (uint8_t)(((high & 0x0F) << 4) | (low & 0x0F));
+            corrected += (high >> 7) + (low >> 7);
+        }
+        hammingBytes += BLOCK_HAMMING_BYTES;
+        bytes += BLOCK_BYTES;
+    }
+    return corrected;
+}
+
+/**
+    @brief Apply the code (8,4) to bytes computing each group.
+
+    @param const uint8_t* bytes: Original bytes.
+    @param size_t bytesCount: Number of original bytes.
+    @param uint8_t* hammingBytes: "bytesCount * 2" groups.
+    @return void.
+*/
+void encodeSecdedBitwise(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes){
+    for(size_t z = 0; z < bytesCount; z++){
+        hammingBytes[z * 2] = (uint8_t)encodeSecdedNibble(bytes[z] >> 4);
+        hammingBytes[(z * 2) + 1] = (uint8_t)encodeSecdedNibble(bytes[z] & 0x0F);
+    }
+}
+
+/**
+    @brief Correct and remove the code (8,4) from groups computing each one.
+
+    @param const uint8_t* hammingBytes: "bytesCount * 2" groups.
+    @param size_t bytesCount: Number of original bytes.
+    @param uint8_t* bytes: Original bytes.
+    @param uint64_t* detected: Gets the groups with two inverted bits added.
+    @return uint64_t: Number of groups that had a bit corrected.
+*/
+uint64_t decodeSecdedBitwise(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes,
+                             uint64_t* detected){
+    uint64_t corrected = 0;
+    for(size_t z = 0; z < bytesCount; z++){
+        unsigned highStatus;
+        unsigned lowStatus;
+        unsigned high = decodeSecdedGroup(hammingBytes[z * 2], &highStatus);
+        unsigned low = decodeSecdedGroup(hammingBytes[(z * 2) + 1], &lowStatus);
+        bytes[z] = (uint8_t)((high << 4) | low);
+        corrected += (highStatus == 1) + (lowStatus == 1);
+        *detected += (highStatus == 2) + (lowStatus == 2);
+    }
+    return corrected;
+}
+
+/**
+    @brief Apply the code (8,4) to bytes with one table lookup per group.
+
+    @param const uint8_t* bytes: Original bytes.
+    @param size_t bytesCount: Number of original bytes.
+    @param uint8_t* hammingBytes: "bytesCount * 2" groups.
+    @return void.
+*/
+void encodeSecdedTable(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes){
+    const uint8_t* groups = secdedTable.groups;
+    for(size_t z = 0; z < bytesCount; z++){
+        hammingBytes[z * 2] = groups[bytes[z] >> 4];
+        hammingBytes[(z * 2) + 1] = groups[bytes[z] & 0x0F];
+    }
+}
+
+/**
+    @brief Correct and remove the code (8,4) from groups with one table
+        lookup per group.
+
+    @param const uint8_t* hammingBytes: "bytesCount * 2" groups.
+    @param size_t bytesCount: Number of original bytes.
+    @param uint8_t* bytes: Original bytes.
+    @param uint64_t* detected: Gets the groups with two inverted bits added.
+    @return uint64_t: Number of groups that had a bit corrected.
+*/
+uint64_t decodeSecdedTable(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes,
+                           uint64_t* detected){
+    const uint8_t* corrections = secdedTable.corrections;
+    uint64_t corrected = 0;
+    uint64_t doubles = 0;
+    for(size_t z = 0; z < bytesCount; z++){
+        uint8_t high = corrections[hammingBytes[z * 2]];
+        uint8_t low = corrections[hammingBytes[(z * 2) + 1]];
+        bytes[z] = (uint8_t)(((high & 0x0F) << 4) | (low & 0x0F));
+        corrected += (high >> 7) + (low >> 7);
+        doubles += ((high >> 6) & 1) + ((low >> 6) & 1);
+    }
+    *detected += doubles;
+    return corrected;
+}
+
+/**
+    @brief Remove hamming parity from blocks of 7 bytes with no inverted bit,
+        taking the data bits of each group.
+
+    @param const uint8_t* hammingBytes: "blocks * 7" bytes in the hamming
+        format.
+    @param size_t blocks: Number of blocks.
+    @param uint8_t* bytes: Receives "blocks * 4" original bytes.
+    @return void.
+*/
+void extractBlocksBitwise(const uint8_t* hammingBytes, size_t blocks, uint8_t* bytes){
+    for( ; blocks > 0; blocks--){
+        uint64_t bits = 0;
+        for(size_t z = 0; z < BLOCK_HAMMING_BYTES; z++){
+            bits = (bits << 8) | hammingBytes[z];
+        }
+
+        // D7 D6 D5 of each group, then D3.
+        for(size_t z = 0; z < BLOCK_BYTES; z++){
+            unsigned shift = 42 - (unsigned)(z * 14);
+            bytes[z] = (uint8_t)(((bits >> (shift + 6)) & 0xE0) | ((bits >> (shift + 5)) & 0x10) |
+                                 ((bits >> (shift + 3)) & 0x0E) | ((bits >> (shift + 2)) & 0x01));
+        }
+        hammingBytes += BLOCK_HAMMING_BYTES;
+        bytes += BLOCK_BYTES;
+    }
+}
+
+/**
+    @brief Remove the code (8,4) from groups with no inverted bit, taking
+        the data bits of each group.
+
+    @param const uint8_t* hammingBytes: "bytesCount * 2" groups.
+    @param size_t bytesCount: Number of original bytes.
+    @param uint8_t* bytes: Receives the original bytes.
+    @return void.
+*/
+void extractSecdedBitwise(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes){
+    for(size_t z = 0; z < bytesCount; z++){
+        unsigned high = hammingBytes[z * 2];
+        unsigned low = hammingBytes[(z * 2) + 1];
+        bytes[z] = (uint8_t)((high & 0xE0) | ((high << 1) & 0x10) |
+                             ((low >> 4) & 0x0E) | ((low >> 3) & 0x01));
+    }
+}
+
+uint32_t crc32cTable(uint32_t crc, const uint8_t* bytes, size_t bytesCount){
+    const uint32_t (*crcs)[256] = crcTable.crcs;
+    for( ; bytesCount >= 8; bytesCount -= 8){
+        uint32_t low = crc ^ ((uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) |
+                              ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24));
+        crc = crcs[7][low & 0xFF] ^ crcs[6][(low >> 8) & 0xFF] ^
+              crcs[5][(low >> 16) & 0xFF] ^ crcs[4][low >> 24] ^
+              crcs[3][bytes[4]] ^ crcs[2][bytes[5]] ^ crcs[1][bytes[6]] ^ crcs[0][bytes[7]];
+        bytes += 8;
+    }
+    for( ; bytesCount > 0; bytesCount--){
+        crc = (crc >> 8) ^ crcs[0][(crc ^ *bytes++) & 0xFF];
+    }
+    return crc;
+}
+
+/**
+    @brief Interleave a frame of groups of 7 bits, transposing the 8x8 bits
+        of each block.
+
+    @param const uint8_t* frame: "blocks * 7" bytes, followed by
+        "TILE_SLACK_BYTES" that can be read.
+    @param size_t blocks: Number of blocks of the frame.
+    @param uint8_t* output: Receives the bit "b" of the block "z" in the byte
+        "b * blocks + z".
+    @return void.
+*/
+void interleaveBlocksBitwise(const uint8_t* frame, size_t blocks, uint8_t* output){
+    interleaveTiles(frame, blocks, 7, output);
+}
+
+/**
+    @brief Inverse of "interleaveBlocksBitwise".
+
+    @param const uint8_t* input: "blocks * 7" interleaved bytes.
+    @param size_t blocks: Number of blocks of the frame.
+    @param uint8_t* frame: Receives the groups in order.
+    @return void.
+*/
+void deinterleaveBlocksBitwise(const uint8_t* input, size_t blocks, uint8_t* frame){
+    deinterleaveTiles(input, blocks, 7, frame);
+}
+
+/**
+    @brief Interleave a frame of groups of 8 bits, transposing the 8x8 bits
+        of each block.
+
+    @param const uint8_t* frame: "blocks * 8" bytes.
+    @param size_t blocks: Number of blocks of the frame.
+    @param uint8_t* output: Receives the bit "b" of the block "z" in the byte
+        "b * blocks + z".
+    @return void.
+*/
+void interleaveSecdedBitwise(const uint8_t* frame, size_t blocks, uint8_t* output){
+    interleaveTiles(frame, blocks, 8, output);
+}
+
+/**
+    @brief Inverse of "interleaveSecdedBitwise".
+
+    @param const uint8_t* input: "blocks * 8" interleaved bytes.
+    @param size_t blocks: Number of blocks of the frame.
+    @param uint8_t* frame: Receives the groups in order.
+    @return void.
+*/
+void deinterleaveSecdedBitwise(const uint8_t* input, size_t blocks, uint8_t* frame){
+    deinterleaveTiles(input, blocks, 8, frame);
+}
+
+/**
+    @brief Interleave a frame of the larger codes from the words of its
+        groups, transposing those of each tile together.
+
+    @param const uint64_t* words: The words of the groups, in rows of 4 tiles
+        ("InterleaveWordsFn").
+    @param size_t tiles: Number of tiles of the frame.
+    @param unsigned groupBits: Bits of a group (15, 31, 63 or 72).
+    @param uint8_t* output: Receives the bit "b" of the tile "t" in the byte
+        "b * tiles + t".
+    @return void.
+*/
+void interleaveWordsBitwise(const uint64_t* words, size_t tiles, unsigned groupBits,
+                            uint8_t* output){
+    switch(groupBits){
+        case 15:
+            interleaveTileWordsOf<15>(words, tiles, output);
+            break;
+        case 31:
+            interleaveTileWordsOf<31>(words, tiles, output);
+            break;
+        case 63:
+            interleaveTileWordsOf<63>(words, tiles, output);
+            break;
+        default:
+            interleaveTileWordsOf<72>(words, tiles, output);
+    }
+}
+
+/**
+    @brief Apply hamming parity to slabs of 128 bytes in the bit-sliced
+        layout, transposing the words of 64 bytes into the planes of their
+        bits ("sliceBytes").
+
+    @param const uint8_t* bytes: "slabs * 128" original bytes.
+    @param size_t slabs: Number of slabs.
+    @param uint8_t* hammingBytes: "slabs * 224" bytes in the hamming format.
+    @return void.
+*/
+void encodeSlicedBitwise(const uint8_t* bytes, size_t slabs, uint8_t* hammingBytes){
+    for( ; slabs > 0; slabs--){
+        for(unsigned w = 0; w < 2; w++){
+            uint64_t planes[8];
+            sliceBytes(bytes + (w * 64), planes);
+            storeSlicedWord(hammingBytes, w, planes + 4);
+            storeSlicedWord(hammingBytes, w + 2, planes);
+        }
+        bytes += SLICED_BYTES;
+        hammingBytes += SLICED_HAMMING_BYTES;
+    }
+}
+
+/**
+    @brief Correct and remove hamming parity from slabs of the bit-sliced
+        layout, 64 groups at a time.
+
+    @param const uint8_t* hammingBytes: "slabs * 224" bytes in the hamming
+        format.
+    @param size_t slabs: Number of slabs.
+    @param uint8_t* bytes: "slabs * 128" original bytes.
+    @return uint64_t: Number of groups that had a bit corrected.
+*/
+uint64_t decodeSlicedBitwise(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes){
+    return unsliceBitwise(hammingBytes, slabs, bytes, true);
+}
+
+/**
+    @brief Remove hamming parity from slabs of the bit-sliced layout with no
+        inverted bit, taking their data planes.
+
+    @param const uint8_t* hammingBytes: "slabs * 224" bytes in the hamming
+        format.
+    @param size_t slabs: Number of slabs.
+    @param uint8_t* bytes: Receives "slabs * 128" original bytes.
+    @return void.
+*/
+void extractSlicedBitwise(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes){
+    unsliceBitwise(hammingBytes, slabs, bytes, false);
+}
+
+} // namespace kernels
+
+namespace {
+
+/**
+    @brief Functions of each kernel that process whole blocks.
+*/
+struct KernelFns {
+    Kernel kernel;
+    const char* name;
+    bool (*supported)();
+    kernels::EncodeBlocksFn encodeBlocks;
+    kernels::DecodeBlocksFn decodeBlocks;
+    kernels::EncodeSecdedFn encodeSecded;
+    kernels::DecodeSecdedFn decodeSecded;
+    kernels::EncodeSlicedFn encodeSliced;
+    kernels::DecodeSlicedFn decodeSliced;
+    kernels::EncodeInterleavedFn encodeBlocksInterleaved; /**< NULL - encoded aside. */
+    kernels::EncodeInterleavedFn encodeSecdedInterleaved;
+};
+
+bool alwaysSupported(){
+    return true;
+}
+
+// From the slowest to the fastest. The bit-sliced layout only needs XORs
+// of whole words, which the table kernel has no use for, so it uses the
+// bitwise one.
+const KernelFns allKernels[] = {
+    {KERNEL_BITWISE, "bitwise", alwaysSupported,         kernels::encodeBlocksBitwise, kernels::decodeBlocksBitwise,
+                                                         kernels::encodeSecdedBitwise, kernels::decodeSecdedBitwise,
+                                                         kernels::encodeSlicedBitwise, kernels::decodeSlicedBitwise,
+                                                         NULL,                         NULL},
+    {KERNEL_TABLE,   "table",   alwaysSupported,         kernels::encodeBlocksTable,   kernels::decodeBlocksTable,
+                                                         kernels::encodeSecdedTable,   kernels::decodeSecdedTable,
+                                                         kernels::encodeSlicedBitwise, kernels::decodeSlicedBitwise,
+                                                         NULL,                         NULL},
+    {KERNEL_SSSE3,   "ssse3",   kernels::ssse3Supported, kernels::encodeBlocksSsse3,   kernels::decodeBlocksSsse3,
+                                                         kernels::encodeSecdedSsse3,   kernels::decodeSecdedSsse3,
+                                                         kernels::encodeSlicedSsse3,   kernels::decodeSlicedSsse3,
+                                                         NULL,                         NULL},
+    {KERNEL_AVX2,    "avx2",    kernels::avx2Supported,  kernels::encodeBlocksAvx2,    kernels::decodeBlocksAvx2,
+                                                         kernels::encodeSecdedAvx2,    kernels::decodeSecdedAvx2,
+                                                         kernels::encodeSlicedAvx2,    kernels::decodeSlicedAvx2,
+                                                         kernels::encodeBlocksInterleavedAvx2,
+                                                         kernels::encodeSecdedInterleavedAvx2},
+    {KERNEL_NEON,    "neon",    kernels::neonSupported,  kernels::encodeBlocksNeon,    kernels::decodeBlocksNeon,
+                                                         kernels::encodeSecdedNeon,    kernels::decodeSecdedNeon,
+                                                         kernels::encodeSlicedNeon,    kernels::decodeSlicedNeon,
+                                                         NULL,                         NULL},
+};
+
+const size_t KERNELS_COUNT = sizeof(allKernels) / sizeof(allKernels[0]);
+
+/**
+    @brief Find the fastest kernel supported by the CPU.
+
+    @return KernelFns*: The fastest kernel.
+*/
+const KernelFns* findBestKernel(){
+    const KernelFns* best = &allKernels[0];
+    for(size_t z = 0; z < KERNELS_COUNT; z++){
+        if(allKernels[z].supported()){
+            best = &allKernels[z];
+        }
+    }
+    return best;
+}
+
+/**
+    @brief Kernel used when none is chosen, detected on the first call.
+
+    @return KernelFns*: The fastest kernel supported by the CPU.
+*/
+const KernelFns* bestKernel(){
+    static const KernelFns* best = findBestKernel();
+    return best;
+}
+
+// Kernel chosen with "setKernel" (NULL - the best one).
+const KernelFns* currentKernel = NULL;
+
+/**
+    @brief Kernel in use.
+
+    @return KernelFns*: The chosen kernel or the best one.
+*/
+inline const KernelFns* activeKernel(){
+    return currentKernel != NULL ? currentKernel : bestKernel();
+}
+
+// Bytes in the hamming format that "scrubHamming" decodes at a time (a page
+// of most systems).
+const size_t SCRUB_PIECE_BYTES = 4096;
+
+/**
+    @brief Functions that do not correct anything, so do not depend on the
+        kernel chosen: the fastest ones the CPU has.
+*/
+struct CheckFns {
+    kernels::ExtractBlocksFn extractBlocks;
+    kernels::ExtractSecdedFn extractSecded;
+    kernels::ExtractSlicedFn extractSliced;
+    kernels::InterleaveBlocksFn interleaveBlocks;
+    kernels::DeinterleaveBlocksFn deinterleaveBlocks;
+    kernels::InterleaveBlocksFn interleaveSecded;
+    kernels::DeinterleaveBlocksFn deinterleaveSecded;
+    kernels::InterleaveWordsFn interleaveWords;
+    kernels::Crc32cFn crc32c;
+
+    CheckFns(){
+        bool bmi2 = kernels::bmi2Supported();
+        extractBlocks = bmi2 ? kernels::extractBlocksBmi2 : kernels::extractBlocksBitwise;
+        extractSecded = bmi2 ? kernels::extractSecdedBmi2 : kernels::extractSecdedBitwise;
+        extractSliced = kernels::avx2Supported() ? kernels::extractSlicedAvx2 :
+                        kernels::ssse3Supported() ? kernels::extractSlicedSsse3 :
+                        kernels::neonSupported() ? kernels::extractSlicedNeon :
+                                                   kernels::extractSlicedBitwise;
+        bool avx2 = bmi2 && kernels::avx2Supported();
+        interleaveBlocks = avx2 ? kernels::interleaveBlocksAvx2 :
+                           bmi2 ? kernels::interleaveBlocksBmi2 :
+                                  kernels::interleaveBlocksBitwise;
+        deinterleaveBlocks = avx2 ? kernels::deinterleaveBlocksAvx2 :
+                             bmi2 ? kernels::deinterleaveBlocksBmi2 :
+                                    kernels::deinterleaveBlocksBitwise;
+        interleaveSecded = kernels::avx2Supported() ? kernels::interleaveSecdedAvx2 :
+                                                      kernels::interleaveSecdedBitwise;
+        deinterleaveSecded = kernels::avx2Supported() ? kernels::deinterleaveSecdedAvx2 :
+                                                        kernels::deinterleaveSecdedBitwise;
+        interleaveWords = kernels::avx2Supported() ? kernels::interleaveWordsAvx2 :
+                                                     kernels::interleaveWordsBitwise;
+        crc32c = kernels::sse42Supported() ? kernels::crc32cSse42 :
+                 kernels::armCrcSupported() ? kernels::crc32cArm : kernels::crc32cTable;
+    }
+};
+
+/**
+    @brief The functions of "CheckFns", detected on the first call.
+
+    @return CheckFns&: The functions.
+*/
+inline const CheckFns& checkFns(){
+    static const CheckFns fns;
+    return fns;
+}
+
+/**
+    @brief Interleave a frame with the fastest functions for its groups.
+
+    @param const uint8_t* frame: "tiles * groupBits" bytes, followed by
+        "TILE_SLACK_BYTES" that can be read.
+    @param size_t tiles: Number of tiles of the frame.
+    @param unsigned groupBits: Bits of each group.
+    @param uint8_t* output: Receives the bit "b" of the tile "t" in the byte
+        "b * tiles + t".
+    @return void.
+*/
+inline void interleaveFrame(const uint8_t* frame, size_t tiles, unsigned groupBits,
+                            uint8_t* output){
+    if(groupBits == 7){
+        checkFns().interleaveBlocks(frame, tiles, output);
+    }else if(groupBits == 8){
+        checkFns().interleaveSecded(frame, tiles, output);
+    }else{
+        interleaveTiles(frame, tiles, groupBits, output);
+    }
+}
+
+/**
+    @brief Size in the bit-sliced layout of (7,4): whole slabs, then the rest
+        packed as (7,4).
+
+    @param size_t bytesCount: Number of original bytes.
+    @return size_t: Number of bytes in the hamming format.
+*/
+size_t slicedEncodedSize(size_t bytesCount){
+    return ((bytesCount / SLICED_BYTES) * SLICED_HAMMING_BYTES) +
+           encodedSize(bytesCount % SLICED_BYTES);
+}
+
+/**
+    @brief Original size of bytes in the bit-sliced layout of (7,4).
+
+    @param size_t bytesCount: Number of bytes in the hamming format.
+    @return size_t: Number of original bytes.
+*/
+size_t slicedDecodedSize(size_t bytesCount){
+    return ((bytesCount / SLICED_HAMMING_BYTES) * SLICED_BYTES) +
+           decodedSize(bytesCount % SLICED_HAMMING_BYTES);
+}
+
+/**
+    @brief Apply hamming parity in the bit-sliced layout of (7,4).
+
+    @param const uint8_t* bytes: Original bytes.
+    @param size_t bytesCount: Number of original bytes.
+    @param uint8_t* hammingBytes: Receives "slicedEncodedSize(bytesCount)"
+        bytes.
+    @return void.
+*/
+void encodeSliced(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes){
+    size_t slabs = bytesCount / SLICED_BYTES;
+    activeKernel()->encodeSliced(bytes, slabs, hammingBytes);
+    addHammingParity(bytes + (slabs * SLICED_BYTES), bytesCount % SLICED_BYTES,
+                     hammingBytes + (slabs * SLICED_HAMMING_BYTES));
+}
+
+/**
+    @brief Correct and remove hamming parity in the bit-sliced layout of
+        (7,4).
+
+    @param const uint8_t* hammingBytes: Bytes in the hamming format.
+    @param size_t bytesCount: Number of bytes in the hamming format.
+    @param uint8_t* bytes: Receives "slicedDecodedSize(bytesCount)" bytes.
+    @param DecodeStats* stats: Gets the groups added (NULL - none).
+    @return size_t: Number of original bytes.
+*/
+size_t decodeSliced(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes,
+                    DecodeStats* stats){
+    size_t slabs = bytesCount / SLICED_HAMMING_BYTES;
+    uint64_t corrected = activeKernel()->decodeSliced(hammingBytes, slabs, bytes);
+    if(stats != NULL){
+        stats->groups += (uint64_t)slabs * SLICED_BYTES * 2;
+        stats->corrected += corrected;
+    }
+    return (slabs * SLICED_BYTES) +
+           removeHammingParity(hammingBytes + (slabs * SLICED_HAMMING_BYTES),
+                               bytesCount % SLICED_HAMMING_BYTES, bytes + (slabs * SLICED_BYTES),
+                               stats);
+}
+
+/**
+    @brief Take the data bits of the bit-sliced layout of (7,4) with no
+        inverted bit.
+
+    @param const uint8_t* hammingBytes: Bytes in the hamming format.
+    @param size_t bytesCount: Number of bytes in the hamming format.
+    @param uint8_t* bytes: Receives "slicedDecodedSize(bytesCount)" bytes.
+    @param DecodeStats* stats: Gets the groups added (NULL - none).
+    @return size_t: Number of original bytes.
+*/
+size_t extractSliced(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes,
+                     DecodeStats* stats){
+    size_t slabs = bytesCount / SLICED_HAMMING_BYTES;
+    checkFns().extractSliced(hammingBytes, slabs, bytes);
+    if(stats != NULL){
+        stats->groups += (uint64_t)slabs * SLICED_BYTES * 2;
+    }
+    return (slabs * SLICED_BYTES) +
+           extractData(hammingBytes + (slabs * SLICED_HAMMING_BYTES),
+                       bytesCount % SLICED_HAMMING_BYTES, bytes + (slabs * SLICED_BYTES),
+                       CODE_7_4, stats);
+}
+
+/**
+    @brief Apply one of the larger codes to whole frames and interleave them
+        ("addInterleavedParity"): the words of the groups of each frame
+        ("BlockCode::encodeWords") are written aside in the L1 cache and
+        transposed from there ("CheckFns::interleaveWords").
+
+    @param const uint8_t* bytes: "frames * tiles * BLOCK_BYTES" original
+        bytes.
+    @param size_t frames: Number of frames.
+    @param size_t tiles: Blocks of each frame (a tile each).
+    @param uint8_t* output: Receives the frames interleaved.
+    @return void.
+*/
+template<typename BlockCodeT>
+void encodeInterleavedOf(const uint8_t* bytes, size_t frames, size_t tiles, uint8_t* output){
+    const size_t blockBytes = BlockCodeT::BLOCK_BYTES;
+    uint64_t words[(MAX_INTERLEAVE_DEPTH / 32) * kernels::QUAD_WORDS];
+    for(size_t f = 0; f < frames; f++){
+        for(size_t t = 0; t < tiles; t++){
+            const uint8_t* block = bytes + (((f * tiles) + t) * blockBytes);
+
+            // The last block is read from a copy, so that nothing after the
+            // bytes is read.
+            uint8_t lastBlock[blockBytes + 8];
+            if((f + 1 == frames) && (t + 1 == tiles)){
+                memset(lastBlock, 0, sizeof(lastBlock));
+                memcpy(lastBlock, block, blockBytes);
+                block = lastBlock;
+            }
+            BlockCodeT::encodeWords(block, words + ((t / 4) * kernels::QUAD_WORDS) + (t % 4), 4);
+        }
+        checkFns().interleaveWords(words, tiles, BlockCodeT::GROUP_BITS, output);
+        output += tiles * BlockCodeT::BLOCK_HAMMING_BYTES;
+    }
+}
+
+/**
+    @brief A code of the hamming format. The larger ones are a "BlockCode"
+        (see "hamming_codes.h"), (7,4) and (8,4) go through the kernels.
+*/
+struct CodeInfo {
+    Code code;
+    const char* name;
+    CodeBlocks blocks;
+    size_t (*encodedSize)(size_t); /**< NULL for (7,4) and (8,4). */
+    size_t (*decodedSize)(size_t);
+    void (*encode)(const uint8_t*, size_t, uint8_t*);
+    size_t (*decode)(const uint8_t*, size_t, uint8_t*, DecodeStats*);
+    size_t (*extract)(const uint8_t*, size_t, uint8_t*, DecodeStats*);
+    kernels::EncodeInterleavedFn encodeInterleaved;
+};
+
+/**
+    @brief Describe one of the larger codes.
+
+    @param Code code: Code.
+    @param const char* name: Its name.
+    @return CodeInfo: Its sizes and the functions of "BlockCodeT".
+*/
+template<typename BlockCodeT>
+constexpr CodeInfo blockCodeInfo(Code code, const char* name){
+    return CodeInfo{code, name, {BlockCodeT::BLOCK_BYTES, BlockCodeT::BLOCK_HAMMING_BYTES,
+                                 BlockCodeT::GROUP_BITS},
+                    BlockCodeT::encodedSize, BlockCodeT::decodedSize, BlockCodeT::encode,
+                    BlockCodeT::decode, BlockCodeT::extract, encodeInterleavedOf<BlockCodeT>};
+}
+
+const CodeInfo allCodes[] = {
+    {CODE_7_4, "7,4", {BLOCK_BYTES, BLOCK_HAMMING_BYTES, 7}, NULL, NULL, NULL, NULL,
+     NULL, NULL},
+    {CODE_8_4, "8,4", {1, 2, 8}, NULL, NULL, NULL, NULL, NULL, NULL},
+    blockCodeInfo<codes::Code15_11>(CODE_15_11, "15,11"),
+    blockCodeInfo<codes::Code31_26>(CODE_31_26, "31,26"),
+    blockCodeInfo<codes::Code63_57>(CODE_63_57, "63,57"),
+    blockCodeInfo<codes::Code72_64>(CODE_72_64, "72,64"),
+    {CODE_7_4_SLICED, "7,4-sliced", {SLICED_BYTES, SLICED_HAMMING_BYTES, 7}, slicedEncodedSize,
+     slicedDecodedSize, encodeSliced, decodeSliced, extractSliced, NULL}
+};
+
+const size_t CODES_COUNT = sizeof(allCodes) / sizeof(allCodes[0]);
+
+/**
+    @brief Get a code.
+
+    @param Code code: Code.
+    @return CodeInfo&: Its sizes and functions ((7,4) if unknown).
+*/
+inline const CodeInfo& codeInfo(Code code){
+    for(size_t z = 0; z < CODES_COUNT; z++){
+        if(allCodes[z].code == code){
+            return allCodes[z];
+        }
+    }
+    return allCodes[0];
+}
+
+/**
+    @brief Random value number "counter" of the sequence of a seed (SplitMix64
+        taken at any position). As each value depends only on the seed and
+        the counter, any part of a file gets the same values no matter which
+        thread computes it or in which order.
+
+    @param uint64_t seed: Seed of the sequence.
+    @param uint64_t counter: Position in the sequence.
+    @return uint64_t: Random value.
+*/
+inline uint64_t randomAt(uint64_t seed, uint64_t counter){
+    uint64_t z = seed + ((counter + 1) * 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+    @brief The masks of a group with each number of bits set, the first bit
+        of the group being the most significant.
+*/
+struct ExactMasks {
+    uint8_t masks[9][70];
+    unsigned counts[9];
+};
+
+/**
+    @brief Number of ways to choose bits.
+
+    @param unsigned bits: Bits to choose from.
+    @param unsigned chosen: Bits chosen.
+    @return unsigned: Number of ways.
+*/
+constexpr unsigned binomial(unsigned bits, unsigned chosen){
+    return chosen == 0 ? 1 :
+           bits == 0 ? 0 : binomial(bits - 1, chosen - 1) + binomial(bits - 1, chosen);
+}
+
+/**
+    @brief Entry of "ExactMasks::masks".
+
+    @param unsigned groupBits: Bits of the group (7 or 8).
+    @param unsigned flips: Number of bits set.
+    @param unsigned index: Mask wanted, in ascending order.
+    @param unsigned mask: First mask to look at.
+    @return uint8_t: The mask (0 if there are not so many).
+*/
+constexpr uint8_t exactMask(unsigned groupBits, unsigned flips, unsigned index,
+                            unsigned mask=0){
+    return mask == (1u << groupBits) ? 0 :
+           (unsigned)__builtin_popcount(mask) != flips ?
+               exactMask(groupBits, flips, index, mask + 1) :
+           index == 0 ? (uint8_t)mask : exactMask(groupBits, flips, index - 1, mask + 1);
+}
+
+/**
+    @brief Fill in "ExactMasks".
+
+    @param unsigned groupBits: Bits of the group (7 or 8).
+    @param IndexSequence<M...>: The 9 * 70 masks.
+    @param IndexSequence<C...>: The 9 numbers of bits set.
+    @return ExactMasks: The masks.
+*/
+template<size_t... M, size_t... C>
+constexpr ExactMasks makeExactMasks(unsigned groupBits, tables::IndexSequence<M...>,
+                                    tables::IndexSequence<C...>){
+    return ExactMasks{{exactMask(groupBits, M / 70, M % 70)...}, {binomial(groupBits, C)...}};
+}
+
+constexpr ExactMasks exactMasks7 = makeExactMasks(7, tables::MakeIndexSequence<9 * 70>::Type(),
+                                                  tables::MakeIndexSequence<9>::Type());
+constexpr ExactMasks exactMasks8 = makeExactMasks(8, tables::MakeIndexSequence<9 * 70>::Type(),
+                                                  tables::MakeIndexSequence<9>::Type());
+
+/**
+    @brief Bits of each group of an error model (7 unless they are 8~72).
+
+    @param ErrorModel& model: Model of the errors.
+    @return unsigned: 7~72.
+*/
+inline unsigned modelGroupBits(const ErrorModel& model){
+    return (model.groupBits >= 8) && (model.groupBits <= 72) ? model.groupBits : 7;
+}
+
+/**
+    @brief Bits to be inverted in one block of 56 bits (7 bytes, 8 groups of
+        7 bits or 7 groups of 8 bits) by the models that work group by group.
+
+    Each group takes 32 random bits. With "ERRORS_GROUP" they are mapped to
+    0~(G * G - 1) ("* G * G >> 32", "G" being "model.groupBits"): below "G"
+    is the position of the bit to invert, a chance in "G", with every
+    position equally likely. With "ERRORS_EXACT" they pick one of the masks
+    with "model.flips" bits set, all of them equally likely.
+
+    @param ErrorModel& model: Model of the errors.
+    @param uint64_t seed: Seed of the errors.
+    @param uint64_t block: Index of the block in the file.
+    @param unsigned groups: Number of groups of the block that get errors
+        (all of them, less only for the last incomplete block).
+    @return uint64_t: Mask of the 56 bits of the block in its 56 upper bits,
+        the first bit of the block being the most significant (bit 63).
+*/
+inline uint64_t errorMask(const ErrorModel& model, uint64_t seed, uint64_t block, unsigned groups){
+    unsigned groupBits = modelGroupBits(model);
+    const ExactMasks& exactMasks = groupBits == 8 ? exactMasks8 : exactMasks7;
+    uint64_t mask = 0;
+    for(unsigned z = 0; z < groups; z += 2){
+        uint64_t randomBits = randomAt(seed, (block * 4) + (z / 2));
+        for(unsigned y = z; (y < (z + 2)) && (y < groups); y++){
+            uint32_t groupRandom = (uint32_t)(randomBits >> ((y - z) * 32));
+            if(model.kind == ERRORS_EXACT){
+                unsigned flips = model.flips < groupBits ? model.flips : groupBits;
+                unsigned pick = (unsigned)(((uint64_t)groupRandom * exactMasks.counts[flips]) >> 32);
+                mask |= (uint64_t)exactMasks.masks[flips][pick] << (64 - ((y + 1) * groupBits));
+            }else{
+                unsigned draw = (unsigned)(((uint64_t)groupRandom * (groupBits * groupBits)) >> 32);
+
+                // "& 7" only keeps the shift valid when there is no error.
+                unsigned bit = (y * groupBits) + (draw & 7);
+                mask |= (uint64_t)(draw < groupBits) << (63 - bit);
+            }
+        }
+    }
+    return mask;
+}
+
+/**
+    @brief Position in the bit-sliced layout of a bit of the groups of 7 bits
+        the same bytes have in (7,4), so each group of the layout gets the
+        errors of one group of (7,4).
+
+    @param uint64_t bit: Position in the groups of (7,4), from the start of a
+        slab.
+    @return uint64_t: Position in the planes, from the start of the same
+        slab.
+*/
+inline uint64_t slicedBit(uint64_t bit){
+    const unsigned slabBits = SLICED_HAMMING_BYTES * 8;
+    uint64_t slab = bit / slabBits;
+    unsigned group = (unsigned)(bit % slabBits) / 7;
+    unsigned plane = (unsigned)(bit % slabBits) % 7;
+
+    // The groups 2n and 2n + 1 are the nibbles of the byte n: the bits n and
+    // 128 + n of the planes, each byte of a plane starting at its least
+    // significant bit.
+    unsigned position = ((group % 2) * SLICED_BYTES) + (group / 2);
+    return (slab * slabBits) + (plane * 256) + (position & ~7u) + 7 - (position & 7);
+}
+
+/**
+    @brief Call a function for each bit inverted by "ERRORS_GROUP" and
+        "ERRORS_EXACT" in one group of more than 8 bits (too many for the
+        blocks of "errorMask"), in increasing order.
+
+    "ERRORS_GROUP" draws its bit like "errorMask". "ERRORS_EXACT" takes each
+    bit with the chance of the bits still to be inverted among the bits left
+    (selection sampling), so every set of "model.flips" bits is equally
+    likely.
+
+    @param ErrorModel& model: Model of the errors.
+    @param uint64_t seed: Seed of the errors.
+    @param uint64_t group: Index of the group in the file.
+    @param unsigned groupBits: Bits of each group.
+    @param FlipFn flip: Called with the position of each bit in the group.
+    @return void.
+*/
+template<typename FlipFn>
+void forEachGroupFlip(const ErrorModel& model, uint64_t seed, uint64_t group,
+                      unsigned groupBits, FlipFn flip){
+    uint64_t groupRandom = randomAt(seed, group);
+    if(model.kind != ERRORS_EXACT){
+        unsigned draw = (unsigned)(((groupRandom & 0xFFFFFFFF) * (groupBits * groupBits)) >> 32);
+        if(draw < groupBits){
+            flip(draw);
+        }
+        return;
+    }
+    unsigned flips = model.flips < groupBits ? model.flips : groupBits;
+    for(unsigned bit = 0; (bit < groupBits) && (flips > 0); bit++){
+        uint64_t bitsLeft = groupBits - bit;
+        if((((randomAt(groupRandom, bit) >> 32) * bitsLeft) >> 32) < flips){
+            flip(bit);
+            flips--;
+        }
+    }
+}
+
+// Bits of a segment of the file with its own sequence for the models that
+// skip between errors (4096 blocks, 28 KiB).
+const uint64_t SEGMENT_BITS = 4096 * 56;
+
+/**
+    @brief Number of bits until the next error (geometric distribution).
+
+    @param double logKeep: "log(1 - rate)" (negative).
+    @param uint64_t randomBits: Random value.
+    @return uint64_t: Bits kept before the next error ("SEGMENT_BITS" if
+        more than that).
+*/
+inline uint64_t geometricGap(double logKeep, uint64_t randomBits){
+
+    // Uniform in (0, 1], so the log is never infinite.
+    double uniform = (double)((randomBits >> 11) + 1) * (1.0 / 9007199254740992.0);
+    double gap = log(uniform) / logKeep;
+    return gap < (double)SEGMENT_BITS ? (uint64_t)gap : SEGMENT_BITS;
+}
+
+/**
+    @brief Call a function for each bit inverted by "ERRORS_RATE" and
+        "ERRORS_BURST" in a range of bits, in increasing order.
+
+    The file is split in segments of "SEGMENT_BITS", each one with its own
+    sequence, and the distance between the errors is drawn from their
+    geometric distribution, so the cost is one random value per error (or
+    per segment) instead of one per bit. A burst ends at the segment end, so
+    each segment is independent of the others and any range of bits gets the
+    same errors however the file is split.
+
+    @param ErrorModel& model: Model of the errors.
+    @param uint64_t seed: Seed of the errors.
+    @param uint64_t firstBit: First bit of the range in the file.
+    @param uint64_t endBit: End of the range in the file.
+    @param FlipFn flip: Called with the position of each bit in the file.
+    @return void.
+*/
+template<typename FlipFn>
+void forEachSkipFlip(const ErrorModel& model, uint64_t seed, uint64_t firstBit,
+                     uint64_t endBit, FlipFn flip){
+    if((firstBit >= endBit) || !(model.rate > 0)){
+        return;
+    }
+    uint64_t length = model.kind == ERRORS_BURST ? model.length : 1;
+    double logKeep = model.rate < 1 ? log1p(-model.rate) : 0;
+    for(uint64_t segment = firstBit / SEGMENT_BITS; (segment * SEGMENT_BITS) < endBit; segment++){
+        uint64_t segmentSeed = randomAt(seed, segment);
+        uint64_t segmentEnd = (segment + 1) * SEGMENT_BITS;
+        uint64_t bit = segment * SEGMENT_BITS;
+        for(uint64_t counter = 0; ; counter++){
+            if(model.rate < 1){
+                bit += geometricGap(logKeep, randomAt(segmentSeed, counter));
+            }
+            if((bit >= segmentEnd) || (bit >= endBit)){
+                break;
+            }
+            uint64_t burstEnd = bit + length < segmentEnd ? bit + length : segmentEnd;
+            for(uint64_t z = bit < firstBit ? firstBit : bit; (z < burstEnd) && (z < endBit); z++){
+                flip(z);
+            }
+            bit = burstEnd;
+        }
+    }
+}
+
+/**
+    @brief Number of bits of the complete groups inside some bytes, the only
+        ones that get errors.
+
+    @param size_t bytesCount: Number of bytes in the hamming format (from the
+        start of a block).
+    @param unsigned groupBits: Bits of each group.
+    @return uint64_t: Number of bits.
+*/
+inline uint64_t groupedBits(size_t bytesCount, unsigned groupBits){
+    return (((uint64_t)bytesCount * 8) / groupBits) * groupBits;
+}
+
+} // namespace
+
+bool setKernel(Kernel kernel){
+    if(kernel == KERNEL_AUTO){
+        currentKernel = NULL;
+        return true;
+    }
+    for(size_t z = 0; z < KERNELS_COUNT; z++){
+        if((allKernels[z].kernel == kernel) && allKernels[z].supported()){
+            currentKernel = &allKernels[z];
+            return true;
+        }
+    }
+    return false;
+}
+
+Kernel getKernel(){
+    return activeKernel()->kernel;
+}
+
+const char* kernelName(Kernel kernel){
+    for(size_t z = 0; z < KERNELS_COUNT; z++){
+        if(allKernels[z].kernel == kernel){
+            return allKernels[z].name;
+        }
+    }
+    return "auto";
+}
+
+bool parseKernel(const char* name, Kernel* kernel){
+    if(strcmp(name, "auto") == 0){
+        *kernel = KERNEL_AUTO;
+        return true;
+    }
+    for(size_t z = 0; z < KERNELS_COUNT; z++){
+        if(strcmp(name, allKernels[z].name) == 0){
+            *kernel = allKernels[z].kernel;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* codeName(Code code){
+    return codeInfo(code).name;
+}
+
+bool parseCode(const char* name, Code* code){
+    for(size_t z = 0; z < CODES_COUNT; z++){
+        if(strcmp(name, allCodes[z].name) == 0){
+            *code = allCodes[z].code;
+            return true;
+        }
+    }
+    return false;
+}
+
+CodeBlocks codeBlocks(Code code){
+    return codeInfo(code).blocks;
+}
+
+GroupCorrection hammingCorrection(unsigned group){
+    uint8_t correction = syndromeTable.corrections[group & 0x7F];
+    GroupCorrection groupCorrection;
+    groupCorrection.nibble = correction & 0x0F;
+    groupCorrection.position = (correction >> 4) & 0x07;
+    groupCorrection.corrected = (correction & 0x80) != 0;
+    groupCorrection.detected = false;
+    return groupCorrection;
+}
+
+GroupCorrection secdedCorrection(unsigned group){
+    unsigned status;
+    unsigned syndrome = groupSyndrome((group >> 1) & 0x7F);
+    GroupCorrection groupCorrection;
+    groupCorrection.nibble = (uint8_t)decodeSecdedGroup(group & 0xFF, &status);
+    groupCorrection.position = (uint8_t)(status != 1 ? 0 : (syndrome > 0 ? syndrome : 8));
+    groupCorrection.corrected = status == 1;
+    groupCorrection.detected = status == 2;
+    return groupCorrection;
+}
+
+size_t encodedSize(size_t bytesCount){
+
+    // 14 bits for each byte, completed with zeros to be a multiple of 8.
+    return ((bytesCount * 14) + 7) / 8;
+}
+
+size_t decodedSize(size_t bytesCount){
+
+    // One original byte for every 2 complete groups of 7 bits. A group left
+    // without a pair (never produced by "addHammingParity") is ignored.
+    return ((bytesCount / BLOCK_HAMMING_BYTES) * BLOCK_BYTES) +
+           ((((bytesCount % BLOCK_HAMMING_BYTES) * 8) / 7) / 2);
+}
+
+size_t encodedSize(size_t bytesCount, Code code){
+    const CodeInfo& info = codeInfo(code);
+    if(info.encodedSize != NULL){
+        return info.encodedSize(bytesCount);
+    }
+    return code == CODE_8_4 ? bytesCount * 2 : encodedSize(bytesCount);
+}
+
+size_t decodedSize(size_t bytesCount, Code code){
+    const CodeInfo& info = codeInfo(code);
+    if(info.decodedSize != NULL){
+        return info.decodedSize(bytesCount);
+    }
+
+    // A last group without a pair is ignored.
+    return code == CODE_8_4 ? bytesCount / 2 : decodedSize(bytesCount);
+}
+
+void addHammingParity(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes){
+    size_t blocks = bytesCount / BLOCK_BYTES;
+    activeKernel()->encodeBlocks(bytes, blocks, hammingBytes);
+
+    // The rest is completed with zeros, whose groups are also all zeros.
+    size_t rest = bytesCount % BLOCK_BYTES;
+    if(rest > 0){
+        uint8_t lastBytes[BLOCK_BYTES] = {0, 0, 0, 0};
+        uint8_t lastHammingBytes[BLOCK_HAMMING_BYTES];
+        memcpy(lastBytes, bytes + (blocks * BLOCK_BYTES), rest);
+        activeKernel()->encodeBlocks(lastBytes, 1, lastHammingBytes);
+        memcpy(hammingBytes + (blocks * BLOCK_HAMMING_BYTES), lastHammingBytes,
+               encodedSize(rest));
+    }
+}
+
+size_t removeHammingParity(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes,
+                           DecodeStats* stats){
+    size_t blocks = bytesCount / BLOCK_HAMMING_BYTES;
+    uint64_t corrected = activeKernel()->decodeBlocks(hammingBytes, blocks, bytes);
+
+    size_t rest = bytesCount % BLOCK_HAMMING_BYTES;
+    size_t restBytes = decodedSize(rest);
+    if(restBytes > 0){
+        uint8_t lastHammingBytes[BLOCK_HAMMING_BYTES] = {0, 0, 0, 0, 0, 0, 0};
+        uint8_t lastBytes[BLOCK_BYTES];
+        memcpy(lastHammingBytes, hammingBytes + (blocks * BLOCK_HAMMING_BYTES), rest);
+
+        // Only the groups that give original bytes are decoded (and
+        // counted), the others are zeros.
+        size_t usedBits = restBytes * 14;
+        lastHammingBytes[usedBits / 8] &= (uint8_t)(0xFF00 >> (usedBits % 8));
+        memset(lastHammingBytes + (usedBits / 8) + 1, 0,
+               BLOCK_HAMMING_BYTES - (usedBits / 8) - 1);
+        corrected += activeKernel()->decodeBlocks(lastHammingBytes, 1, lastBytes);
+        memcpy(bytes + (blocks * BLOCK_BYTES), lastBytes, restBytes);
+    }
+    if(stats != NULL){
+        stats->groups += ((uint64_t)blocks * 8) + (restBytes * 2);
+        stats->corrected += corrected;
+    }
+    return (blocks * BLOCK_BYTES) + restBytes;
+}
+
+void addHammingParity(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes, Code code){
+    const CodeInfo& info = codeInfo(code);
+    if(info.encode != NULL){
+        info.encode(bytes, bytesCount, hammingBytes);
+    }else if(code == CODE_8_4){
+        activeKernel()->encodeSecded(bytes, bytesCount, hammingBytes);
+    }else{
+        addHammingParity(bytes, bytesCount, hammingBytes);
+    }
+}
+
+size_t removeHammingParity(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes,
+                           Code code, DecodeStats* stats){
+    const CodeInfo& info = codeInfo(code);
+    if(info.decode != NULL){
+        return info.decode(hammingBytes, bytesCount, bytes, stats);
+    }
+    if(code != CODE_8_4){
+        return removeHammingParity(hammingBytes, bytesCount, bytes, stats);
+    }
+    size_t size = decodedSize(bytesCount, code);
+    uint64_t detected = 0;
+    uint64_t corrected = activeKernel()->decodeSecded(hammingBytes, size, bytes, &detected);
+    if(stats != NULL){
+        stats->groups += (uint64_t)size * 2;
+        stats->corrected += corrected;
+        stats->detected += detected;
+    }
+    return size;
+}
+
+size_t encode(Span<const uint8_t> bytes, Span<uint8_t> hammingBytes){
+    size_t size = encodedSize(bytes.size());
+    if(hammingBytes.size() < size){
+        return 0;
+    }
+    addHammingParity(bytes.data(), bytes.size(), hammingBytes.data());
+    return size;
+}
+
+size_t decode(Span<const uint8_t> hammingBytes, Span<uint8_t> bytes, DecodeStats* stats){
+    if(bytes.size() < decodedSize(hammingBytes.size())){
+        return 0;
+    }
+    return removeHammingParity(hammingBytes.data(), hammingBytes.size(), bytes.data(), stats);
+}
+
+size_t encode(Span<const uint8_t> bytes, Span<uint8_t> hammingBytes, Code code){
+    size_t size = encodedSize(bytes.size(), code);
+    if(hammingBytes.size() < size){
+        return 0;
+    }
+    addHammingParity(bytes.data(), bytes.size(), hammingBytes.data(), code);
+    return size;
+}
+
+size_t decode(Span<const uint8_t> hammingBytes, Span<uint8_t> bytes, Code code,
+              DecodeStats* stats){
+    if(bytes.size() < decodedSize(hammingBytes.size(), code)){
+        return 0;
+    }
+    return removeHammingParity(hammingBytes.data(), hammingBytes.size(), bytes.data(), code,
+                               stats);
+}
+
+size_t extractData(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes, Code code,
+                   DecodeStats* stats){
+    const CodeInfo& info = codeInfo(code);
+    if(info.extract != NULL){
+        return info.extract(hammingBytes, bytesCount, bytes, stats);
+    }
+    size_t size = decodedSize(bytesCount, code);
+    if(code == CODE_8_4){
+        checkFns().extractSecded(hammingBytes, size, bytes);
+        if(stats != NULL){
+            stats->groups += (uint64_t)size * 2;
+        }
+        return size;
+    }
+
+    // The bits after the last group are not looked at, so the rest needs no
+    // zeros.
+    size_t blocks = bytesCount / BLOCK_HAMMING_BYTES;
+    checkFns().extractBlocks(hammingBytes, blocks, bytes);
+    size_t restBytes = size - (blocks * BLOCK_BYTES);
+    if(restBytes > 0){
+        uint8_t lastHammingBytes[BLOCK_HAMMING_BYTES] = {0, 0, 0, 0, 0, 0, 0};
+        uint8_t lastBytes[BLOCK_BYTES];
+        memcpy(lastHammingBytes, hammingBytes + (blocks * BLOCK_HAMMING_BYTES),
+               bytesCount % BLOCK_HAMMING_BYTES);
+        checkFns().extractBlocks(lastHammingBytes, 1, lastBytes);
+        memcpy(bytes + (blocks * BLOCK_BYTES), lastBytes, restBytes);
+    }
+    if(stats != NULL){
+        stats->groups += (uint64_t)size * 2;
+    }
+    return size;
+}
+
+size_t scrubHamming(uint8_t* hammingBytes, size_t bytesCount, Code code, DecodeStats* stats){
+
+    // In pieces of about 4 KiB, decoded in a local buffer and encoded again
+    // over themselves when one of their groups was corrected.
+    CodeBlocks blocks = codeBlocks(code);
+    size_t pieceBytes = (SCRUB_PIECE_BYTES / blocks.hammingBytes) * blocks.hammingBytes;
+    uint8_t bytes[SCRUB_PIECE_BYTES];
+    size_t rewritten = 0;
+    for(size_t from = 0; from < bytesCount; from += pieceBytes){
+        uint8_t* piece = hammingBytes + from;
+        size_t size = bytesCount - from < pieceBytes ? bytesCount - from : pieceBytes;
+        DecodeStats pieceStats;
+        size_t decoded = removeHammingParity(piece, size, bytes, code, &pieceStats);
+        if(stats != NULL){
+            *stats += pieceStats;
+        }
+        if(pieceStats.corrected == 0){
+            continue;
+        }
+        if(pieceStats.detected == 0){
+            addHammingParity(bytes, decoded, piece, code);
+            rewritten += encodedSize(decoded, code);
+            continue;
+        }
+
+        // Block by block, keeping the ones that cannot be corrected.
+        for(size_t block = 0; block < size; block += blocks.hammingBytes){
+            size_t blockSize = size - block < blocks.hammingBytes ? size - block :
+                                                                    blocks.hammingBytes;
+            DecodeStats blockStats;
+            size_t blockDecoded = removeHammingParity(piece + block, blockSize, bytes, code,
+                                                      &blockStats);
+            if((blockStats.corrected > 0) && (blockStats.detected == 0)){
+                addHammingParity(bytes, blockDecoded, piece + block, code);
+                rewritten += encodedSize(blockDecoded, code);
+            }
+        }
+    }
+    return rewritten;
+}
+
+bool validInterleave(Code code, unsigned depth){
+    return (depth >= 8) && (depth <= MAX_INTERLEAVE_DEPTH) && ((depth % 8) == 0) &&
+           (code != CODE_7_4_SLICED);
+}
+
+bool interleave(uint8_t* hammingBytes, size_t bytesCount, Code code, unsigned depth){
+    if(!validInterleave(code, depth)){
+        return false;
+    }
+
+    // Each frame is copied aside (it fits in the L1 cache) and transposed
+    // back over itself.
+    unsigned groupBits = codeBlocks(code).groupBits;
+    size_t tiles = depth / 8;
+    size_t frameBytes = tiles * groupBits;
+    uint8_t frame[MAX_INTERLEAVE_DEPTH / 8 * MAX_GROUP_BYTES + TILE_SLACK_BYTES];
+    memset(frame + frameBytes, 0, TILE_SLACK_BYTES);
+    for(size_t from = 0; bytesCount - from >= frameBytes; from += frameBytes){
+        memcpy(frame, hammingBytes + from, frameBytes);
+        interleaveFrame(frame, tiles, groupBits, hammingBytes + from);
+    }
+    return true;
+}
+
+bool addInterleavedParity(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes,
+                          Code code, unsigned depth){
+    if(!validInterleave(code, depth)){
+        return false;
+    }
+    const CodeInfo& info = codeInfo(code);
+    unsigned groupBits = info.blocks.groupBits;
+    size_t tiles = depth / 8;
+    size_t frameBytes = tiles * groupBits;
+    size_t frameDataBytes = (frameBytes / info.blocks.hammingBytes) * info.blocks.bytes;
+    size_t frames = bytesCount / frameDataBytes;
+    kernels::EncodeInterleavedFn encodeFrames =
+        info.encodeInterleaved != NULL ? info.encodeInterleaved :
+        groupBits == 7 ? activeKernel()->encodeBlocksInterleaved :
+                         activeKernel()->encodeSecdedInterleaved;
+    if(encodeFrames != NULL){
+        encodeFrames(bytes, frames, tiles, hammingBytes);
+    }else{
+
+        // The frames are encoded aside a few at a time, and interleaved from
+        // there while they are in the L1 cache.
+        size_t batchFrames = INTERLEAVE_BATCH_BYTES / frameBytes;
+        batchFrames = batchFrames > 0 ? batchFrames : 1;
+        uint8_t batch[MAX_INTERLEAVE_DEPTH / 8 * MAX_GROUP_BYTES + TILE_SLACK_BYTES];
+        for(size_t f = 0; f < frames; f += batchFrames){
+            size_t count = frames - f < batchFrames ? frames - f : batchFrames;
+            addHammingParity(bytes + (f * frameDataBytes), count * frameDataBytes, batch, code);
+            memset(batch + (count * frameBytes), 0, TILE_SLACK_BYTES);
+            for(size_t z = 0; z < count; z++){
+                interleaveFrame(batch + (z * frameBytes), tiles, groupBits,
+                                hammingBytes + ((f + z) * frameBytes));
+            }
+        }
+    }
+
+    // The rest starts at a block, so it is encoded as with the frames.
+    addHammingParity(bytes + (frames * frameDataBytes), bytesCount - (frames * frameDataBytes),
+                     hammingBytes + (frames * frameBytes), code);
+    return true;
+}
+
+bool deinterleave(uint8_t* hammingBytes, size_t bytesCount, Code code, unsigned depth){
+    if(!validInterleave(code, depth)){
+        return false;
+    }
+    unsigned groupBits = codeBlocks(code).groupBits;
+    size_t tiles = depth / 8;
+    size_t frameBytes = tiles * groupBits;
+    uint8_t frame[MAX_INTERLEAVE_DEPTH / 8 * MAX_GROUP_BYTES];
+    for(size_t from = 0; bytesCount - from >= frameBytes; from += frameBytes){
+        memcpy(frame, hammingBytes + from, frameBytes);
+        if(groupBits == 7){
+            checkFns().deinterleaveBlocks(frame, tiles, hammingBytes + from);
+        }else if(groupBits == 8){
+            checkFns().deinterleaveSecded(frame, tiles, hammingBytes + from);
+        }else{
+            deinterleaveTiles(frame, tiles, groupBits, hammingBytes + from);
+        }
+    }
+    return true;
+}
+
+uint32_t crc32c(const uint8_t* bytes, size_t bytesCount, uint32_t crc){
+    return ~checkFns().crc32c(~crc, bytes, bytesCount);
+}
+
+size_t decodeRange(Span<const uint8_t> hammingBytes, uint64_t offset, Span<uint8_t> bytes,
+                   Code code, DecodeStats* stats){
+    size_t size = decodedSize(hammingBytes.size(), code);
+    if(offset >= size){
+        return 0;
+    }
+    size_t count = size - (size_t)offset < bytes.size() ? size - (size_t)offset : bytes.size();
+    CodeBlocks blocks = codeBlocks(code);
+
+    // Decodes "blocksCount" blocks from "block" on (fewer at the end).
+    auto decodeBlocks = [&](size_t block, size_t blocksCount, uint8_t* output){
+        size_t from = block * blocks.hammingBytes;
+        size_t restBytes = hammingBytes.size() - from;
+        size_t blocksBytes = blocksCount * blocks.hammingBytes;
+        removeHammingParity(hammingBytes.data() + from,
+                            blocksBytes < restBytes ? blocksBytes : restBytes, output, code, stats);
+    };
+
+    // The blocks cut by the range are decoded aside, the others straight
+    // into "bytes".
+    uint8_t blockBytes[MAX_CODE_BLOCK_BYTES];
+    size_t block = (size_t)(offset / blocks.bytes);
+    size_t skipped = (size_t)(offset % blocks.bytes);
+    size_t done = 0;
+    if((skipped > 0) || (count < blocks.bytes)){
+        decodeBlocks(block, 1, blockBytes);
+        done = blocks.bytes - skipped < count ? blocks.bytes - skipped : count;
+        memcpy(bytes.data(), blockBytes + skipped, done);
+        block++;
+    }
+    size_t wholeBlocks = (count - done) / blocks.bytes;
+    if(wholeBlocks > 0){
+        decodeBlocks(block, wholeBlocks, bytes.data() + done);
+        done += wholeBlocks * blocks.bytes;
+        block += wholeBlocks;
+    }
+    if(done < count){
+        decodeBlocks(block, 1, blockBytes);
+        memcpy(bytes.data() + done, blockBytes, count - done);
+    }
+    return count;
+}
+
+uint64_t randomSeed(){
+    std::random_device device;
+    uint64_t seed = ((uint64_t)device() << 32) | device();
+    return randomAt(seed, (uint64_t)time(NULL));
+}
+
+void hammingError(uint8_t* hammingBytes, size_t bytesCount, uint64_t seed, uint64_t offset){
+    hammingError(hammingBytes, bytesCount, ErrorModel(), seed, offset);
+}
+
+void hammingError(uint8_t* hammingBytes, size_t bytesCount, const ErrorModel& model,
+                  uint64_t seed, uint64_t offset){
+    if((model.kind == ERRORS_RATE) || (model.kind == ERRORS_BURST)){
+        uint64_t firstBit = offset * 8;
+        uint64_t endBit = firstBit + groupedBits(bytesCount, modelGroupBits(model));
+        forEachSkipFlip(model, seed, firstBit, endBit, [&](uint64_t bit){
+            uint64_t localBit = bit - firstBit;
+            hammingBytes[localBit / 8] ^= (uint8_t)(0x80 >> (localBit % 8));
+        });
+        return;
+    }
+
+    unsigned groupBits = modelGroupBits(model);
+    if(groupBits > 8){
+        uint64_t firstGroup = (offset * 8) / groupBits;
+        uint64_t groups = groupedBits(bytesCount, groupBits) / groupBits;
+        for(uint64_t z = 0; z < groups; z++){
+            forEachGroupFlip(model, seed, firstGroup + z, groupBits, [&](unsigned bit){
+                uint64_t localBit = (z * groupBits) + bit;
+                hammingBytes[localBit / 8] ^= (uint8_t)(0x80 >> (localBit % 8));
+            });
+        }
+        return;
+    }
+
+    // Only the complete groups that "fit" inside the bytes, 8 (or 7 of 8
+    // bits) for each block of 7 bytes. In the whole slabs of the bit-sliced
+    // layout each bit goes to its plane.
+    uint64_t firstBlock = offset / BLOCK_HAMMING_BYTES;
+    size_t blocks = bytesCount / BLOCK_HAMMING_BYTES;
+    size_t slicedBlocks = model.sliced ? (bytesCount / SLICED_HAMMING_BYTES) *
+                                         (SLICED_HAMMING_BYTES / BLOCK_HAMMING_BYTES) : 0;
+    for(size_t z = 0; z < blocks; z++){
+        uint64_t mask = errorMask(model, seed, firstBlock + z, 56 / groupBits);
+        if(z < slicedBlocks){
+            for( ; mask != 0; mask &= mask - 1){
+                uint64_t bit = slicedBit((z * 56) + 63 - (unsigned)__builtin_ctzll(mask));
+                hammingBytes[bit / 8] ^= (uint8_t)(0x80 >> (bit % 8));
+            }
+            continue;
+        }
+        uint8_t* block = hammingBytes + (z * BLOCK_HAMMING_BYTES);
+        for(size_t y = 0; y < BLOCK_HAMMING_BYTES; y++){
+            block[y] ^= (uint8_t)(mask >> (56 - (y * 8)));
+        }
+    }
+
+    size_t rest = bytesCount % BLOCK_HAMMING_BYTES;
+    uint64_t mask = errorMask(model, seed, firstBlock + blocks, (unsigned)((rest * 8) / groupBits));
+    uint8_t* block = hammingBytes + (blocks * BLOCK_HAMMING_BYTES);
+    for(size_t y = 0; y < rest; y++){
+        block[y] ^= (uint8_t)(mask >> (56 - (y * 8)));
+    }
+}
+
+void errorFlips(size_t bytesCount, const ErrorModel& model, uint64_t seed, uint64_t offset,
+                std::vector<uint64_t>* flips){
+    uint64_t firstBit = offset * 8;
+    if((model.kind == ERRORS_RATE) || (model.kind == ERRORS_BURST)){
+        uint64_t endBit = firstBit + groupedBits(bytesCount, modelGroupBits(model));
+        forEachSkipFlip(model, seed, firstBit, endBit, [&](uint64_t bit){
+            flips->push_back(bit);
+        });
+        return;
+    }
+
+    unsigned groupBits = modelGroupBits(model);
+    if(groupBits > 8){
+        uint64_t firstGroup = firstBit / groupBits;
+        uint64_t groups = groupedBits(bytesCount, groupBits) / groupBits;
+        for(uint64_t z = 0; z < groups; z++){
+            forEachGroupFlip(model, seed, firstGroup + z, groupBits, [&](unsigned bit){
+                flips->push_back(firstBit + (z * groupBits) + bit);
+            });
+        }
+        return;
+    }
+
+    unsigned blockGroups = 56 / groupBits;
+    uint64_t firstBlock = offset / BLOCK_HAMMING_BYTES;
+    uint64_t groups = groupedBits(bytesCount, groupBits) / groupBits;
+    size_t slicedBlocks = model.sliced ? (bytesCount / SLICED_HAMMING_BYTES) *
+                                         (SLICED_HAMMING_BYTES / BLOCK_HAMMING_BYTES) : 0;
+    size_t slicedFrom = flips->size();
+    for(uint64_t z = 0; (z * blockGroups) < groups; z++){
+        uint64_t restGroups = groups - (z * blockGroups);
+        unsigned maskGroups = restGroups < blockGroups ? (unsigned)restGroups : blockGroups;
+        uint64_t mask = errorMask(model, seed, firstBlock + z, maskGroups);
+        uint64_t blockBit = firstBit + (z * 56);
+        if(z < slicedBlocks){
+            for( ; mask != 0; mask &= mask - 1){
+                flips->push_back(firstBit +
+                                 slicedBit((z * 56) + 63 - (unsigned)__builtin_ctzll(mask)));
+            }
+
+            // The planes of each slab come after all of its groups.
+            if(((z + 1) * BLOCK_HAMMING_BYTES) % SLICED_HAMMING_BYTES == 0){
+                std::sort(flips->begin() + slicedFrom, flips->end());
+                slicedFrom = flips->size();
+            }
+            continue;
+        }
+        while(mask != 0){
+            unsigned leading = (unsigned)__builtin_clzll(mask);
+            flips->push_back(blockBit + leading);
+            mask &= ~(0x8000000000000000ULL >> leading);
+        }
+    }
+}
+
+} // namespace hamming
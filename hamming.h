@@ -0,0 +1,647 @@
+/**
+    @file    hamming.h
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Packed-bit core of the hamming method shared by all the tools.
+
+    @section DESCRIPTION
+
+    The bits of the file are taken 4 out of 4 (the high nibble of each byte
+    first) and every nibble becomes a group of 7 bits in the order
+    D7 D6 D5 P4 D3 P2 P1. The groups are written one after the other, most
+    significant bit first, and the last byte is completed with zeros. So every
+    4 bytes of the file become exactly 7 bytes in the hamming format.
+
+    The extended code (8,4) ("CODE_8_4") adds to each group the parity of its
+    7 bits (P8), so every nibble becomes exactly one byte
+    D7 D6 D5 P4 D3 P2 P1 P8 and a group with two inverted bits is detected
+    instead of being miscorrected (SECDED: single error correction, double
+    error detection).
+
+    The larger codes (15,11), (31,26), (63,57) and (72,64) (the SECDED of ECC
+    memories, one 64-bit word with 8 check bits) protect more data bits with
+    each group, at a lower cost but with more chances of two errors in the
+    same group (see "hamming_codes.h" for their layout).
+
+    The bit-sliced layout of (7,4) ("CODE_7_4_SLICED") has the same groups,
+    but stores the bits of 256 of them (128 original bytes, a slab) as 7
+    planes of 256 bits, one for each position of the group, so encoding and
+    correcting are a handful of XORs of whole words for 256 groups at once
+    (see "hamming_kernels.h"). The bytes after the last whole slab are
+    packed as (7,4).
+
+    Everything here works directly over bytes, without ever expanding them
+    into one "bool" per bit, and runs in linear time. "encode" and "decode"
+    are the entry points of the library (libhamming): they write into buffers
+    given by the caller and never allocate memory.
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#ifndef HAMMING_H
+#define HAMMING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace hamming {
+
+/**
+    @brief View of a contiguous sequence of elements owned by someone else
+        (like C++20 "std::span", which cannot be used with C++11).
+*/
+template<typename T>
+class Span {
+public:
+    Span() : ptr(NULL), count(0){}
+    Span(T* data, size_t size) : ptr(data), count(size){}
+
+    template<size_t N>
+    Span(T (&array)[N]) : ptr(array), count(N){}
+
+    template<typename U, typename A>
+    Span(std::vector<U, A>& vector) : ptr(vector.data()), count(vector.size()){}
+
+    template<typename U, typename A>
+    Span(const std::vector<U, A>& vector) : ptr(vector.data()), count(vector.size()){}
+
+    // A view of "uint8_t" is also a view of "const uint8_t".
+    template<typename U>
+    Span(const Span<U>& other) : ptr(other.data()), count(other.size()){}
+
+    T* data() const{
+        return ptr;
+    }
+
+    size_t size() const{
+        return count;
+    }
+
+    bool empty() const{
+        return count == 0;
+    }
+
+    T& operator[](size_t index) const{
+        return ptr[index];
+    }
+
+    /**
+        @brief View of part of the elements.
+
+        @param size_t offset: First element.
+        @param size_t size: Number of elements (at most up to the end).
+        @return Span<T>: The part.
+    */
+    Span<T> subspan(size_t offset, size_t size=(size_t)-1) const{
+        if(offset > count){
+            offset = count;
+        }
+        if(size > (count - offset)){
+            size = count - offset;
+        }
+        return Span<T>(ptr + offset, size);
+    }
+
+private:
+    T* ptr;
+    size_t count;
+};
+
+/**
+    @brief Ways of computing the hamming format. All of them give exactly the
+        same bits.
+*/
+enum Kernel {
+    KERNEL_AUTO,    /**< The fastest one available (default). */
+    KERNEL_BITWISE, /**< Computes the parity of each group (reference). */
+    KERNEL_TABLE,   /**< Looks up bytes and groups in tables. */
+    KERNEL_SSSE3,   /**< Table lookups 16 bytes at a time (x86). */
+    KERNEL_AVX2,    /**< Table lookups 32 bytes at a time (x86). */
+    KERNEL_NEON     /**< Table lookups 16 bytes at a time (AArch64). */
+};
+
+/**
+    @brief Choose the kernel used by "addHammingParity" and
+        "removeHammingParity".
+
+    @param Kernel kernel: Kernel to be used.
+    @return bool: false if the CPU does not support it (nothing changes).
+*/
+bool setKernel(Kernel kernel);
+
+/**
+    @brief Kernel in use.
+
+    @return Kernel: Kernel in use (never "KERNEL_AUTO").
+*/
+Kernel getKernel();
+
+/**
+    @brief Name of a kernel as accepted by "parseKernel".
+
+    @param Kernel kernel: Kernel.
+    @return const char*: Its name.
+*/
+const char* kernelName(Kernel kernel);
+
+/**
+    @brief Get a kernel by its name ("auto", "bitwise", "table", "ssse3",
+        "avx2", "neon").
+
+    @param const char* name: Name of the kernel.
+    @param Kernel* kernel: Receives the kernel.
+    @return bool: false if there is no kernel with that name.
+*/
+bool parseKernel(const char* name, Kernel* kernel);
+
+/**
+    @brief Codes of the hamming format.
+*/
+enum Code {
+    CODE_7_4,  /**< Hamming(7,4): groups of 7 bits packed one after the other
+                    (default). */
+    CODE_8_4,  /**< Extended Hamming(8,4) (SECDED): one byte for each group,
+                    which also detects two inverted bits. */
+    CODE_15_11, /**< Hamming(15,11): 11 data bits and 4 parity bits. */
+    CODE_31_26, /**< Hamming(31,26): 26 data bits and 5 parity bits. */
+    CODE_63_57, /**< Hamming(63,57): 57 data bits and 6 parity bits. */
+    CODE_72_64, /**< Extended Hamming(72,64) (SECDED): 64 data bits, 7
+                     parity bits and the parity of the group. */
+    CODE_7_4_SLICED /**< Hamming(7,4) in the bit-sliced layout: the groups of
+                         128 bytes stored as 7 planes of 256 bits. */
+};
+
+/**
+    @brief Name of a code as accepted by "parseCode".
+
+    @param Code code: Code.
+    @return const char*: Its name ("7,4", "8,4", "15,11", "31,26", "63,57",
+        "72,64", "7,4-sliced").
+*/
+const char* codeName(Code code);
+
+/**
+    @brief Get a code by its name ("7,4", "8,4", "15,11", "31,26", "63,57",
+        "72,64", "7,4-sliced").
+
+    @param const char* name: Name of the code.
+    @param Code* code: Receives the code.
+    @return bool: false if there is no code with that name.
+*/
+bool parseCode(const char* name, Code* code);
+
+/**
+    @brief Sizes of the blocks of a code. Any range of whole blocks is
+        encoded, decoded and gets errors by itself.
+*/
+struct CodeBlocks {
+    size_t bytes;        /**< Original bytes of a block. */
+    size_t hammingBytes; /**< Bytes of a block in the hamming format. */
+    unsigned groupBits;  /**< Bits of each group. */
+};
+
+// Largest "CodeBlocks::bytes" of all the codes (a slab of the bit-sliced
+// layout).
+const size_t MAX_CODE_BLOCK_BYTES = 128;
+
+/**
+    @brief Sizes of the blocks of a code.
+
+    @param Code code: Code.
+    @return CodeBlocks: Its sizes.
+*/
+CodeBlocks codeBlocks(Code code);
+
+/**
+    @brief Result of correcting one group.
+*/
+struct GroupCorrection {
+    uint8_t nibble;   /**< The 4 original bits, D7 being the most significant. */
+    uint8_t position; /**< Hamming position (7~1, 8 for P8) of the inverted
+                           bit, 0 if none. */
+    bool corrected;   /**< Whether a bit had to be inverted. */
+    bool detected;    /**< Whether two bits were inverted, which only the
+                           extended codes detect (the bits are then left as
+                           they are). */
+};
+
+/**
+    @brief Correct one group of 7 bits by applying the hamming method.
+
+    @param unsigned group: Group D7 D6 D5 P4 D3 P2 P1, D7 being the most
+        significant (only the 7 lower bits are used).
+    @return GroupCorrection: The original bits and the correction made.
+*/
+GroupCorrection hammingCorrection(unsigned group);
+
+/**
+    @brief Correct one group of 8 bits by applying the extended hamming
+        method (8,4).
+
+    @param unsigned group: Group D7 D6 D5 P4 D3 P2 P1 P8, D7 being the most
+        significant (only the 8 lower bits are used).
+    @return GroupCorrection: The original bits and the correction made.
+*/
+GroupCorrection secdedCorrection(unsigned group);
+
+/**
+    @brief Counters of the groups decoded.
+*/
+struct DecodeStats {
+    uint64_t groups;    /**< Groups decoded. */
+    uint64_t corrected; /**< Groups that had a bit corrected. */
+    uint64_t detected;  /**< Groups with two inverted bits, detected but not
+                             corrected (the extended codes, or a syndrome
+                             that no bit of a shortened group has). The
+                             others were clean. */
+
+    DecodeStats() : groups(0), corrected(0), detected(0){}
+
+    DecodeStats& operator+=(const DecodeStats& other){
+        groups += other.groups;
+        corrected += other.corrected;
+        detected += other.detected;
+        return *this;
+    }
+};
+
+/**
+    @brief Size of a file after applying the hamming method.
+
+    @param size_t bytesCount: Size of the original file in bytes.
+    @return size_t: Size of the file in the hamming format in bytes.
+*/
+size_t encodedSize(size_t bytesCount);
+
+/**
+    @brief Size of a file after recovering it from the hamming format.
+
+    @param size_t bytesCount: Size of the file in the hamming format in bytes.
+    @return size_t: Size of the recovered file in bytes.
+*/
+size_t decodedSize(size_t bytesCount);
+
+/**
+    @brief Size of a file after applying the hamming method with a code.
+
+    @param size_t bytesCount: Size of the original file in bytes.
+    @param Code code: Code of the hamming format.
+    @return size_t: Size of the file in the hamming format in bytes.
+*/
+size_t encodedSize(size_t bytesCount, Code code);
+
+/**
+    @brief Size of a file after recovering it from the hamming format with a
+        code.
+
+    @param size_t bytesCount: Size of the file in the hamming format in bytes.
+    @param Code code: Code of the hamming format.
+    @return size_t: Size of the recovered file in bytes.
+*/
+size_t decodedSize(size_t bytesCount, Code code);
+
+/**
+    @brief Apply hamming parity to bytes.
+
+    @param const uint8_t* bytes: Original bytes.
+    @param size_t bytesCount: Number of original bytes.
+    @param uint8_t* hammingBytes: Receives "encodedSize(bytesCount)" bytes in
+        the hamming format.
+    @return void.
+*/
+void addHammingParity(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes);
+
+/**
+    @brief Correct and remove hamming parity from bytes.
+
+    @param const uint8_t* hammingBytes: Bytes in the hamming format. The bits
+        are taken 7-by-7.
+    @param size_t bytesCount: Number of bytes in the hamming format.
+    @param uint8_t* bytes: Receives "decodedSize(bytesCount)" original bytes.
+    @param DecodeStats* stats: Gets the groups decoded and corrected added
+        (can be NULL). They are counted anyway, at almost no cost.
+    @return size_t: Number of bytes written to "bytes".
+*/
+size_t removeHammingParity(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes,
+                           DecodeStats* stats=NULL);
+
+/**
+    @brief Apply hamming parity to bytes with a code.
+
+    @param const uint8_t* bytes: Original bytes.
+    @param size_t bytesCount: Number of original bytes.
+    @param uint8_t* hammingBytes: Receives "encodedSize(bytesCount, code)"
+        bytes in the hamming format.
+    @param Code code: Code of the hamming format.
+    @return void.
+*/
+void addHammingParity(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes, Code code);
+
+/**
+    @brief Correct and remove hamming parity from bytes with a code.
+
+    @param const uint8_t* hammingBytes: Bytes in the hamming format.
+    @param size_t bytesCount: Number of bytes in the hamming format.
+    @param uint8_t* bytes: Receives "decodedSize(bytesCount, code)" original
+        bytes.
+    @param Code code: Code of the hamming format.
+    @param DecodeStats* stats: Gets the groups decoded, corrected and detected
+        added (can be NULL).
+    @return size_t: Number of bytes written to "bytes".
+*/
+size_t removeHammingParity(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes,
+                           Code code, DecodeStats* stats=NULL);
+
+/**
+    @brief Apply hamming parity to bytes, writing into a buffer of the caller.
+
+    @param Span<const uint8_t> bytes: Original bytes.
+    @param Span<uint8_t> hammingBytes: Receives the bytes in the hamming
+        format. Must hold at least "encodedSize(bytes.size())" bytes.
+    @return size_t: Number of bytes written to "hammingBytes" (0 if it is too
+        small, and nothing is written).
+*/
+size_t encode(Span<const uint8_t> bytes, Span<uint8_t> hammingBytes);
+
+/**
+    @brief Correct and remove hamming parity from bytes, writing into a buffer
+        of the caller.
+
+    @param Span<const uint8_t> hammingBytes: Bytes in the hamming format.
+    @param Span<uint8_t> bytes: Receives the original bytes. Must hold at
+        least "decodedSize(hammingBytes.size())" bytes.
+    @param DecodeStats* stats: Gets the groups decoded and corrected added
+        (can be NULL).
+    @return size_t: Number of bytes written to "bytes" (0 if it is too small,
+        and nothing is written).
+*/
+size_t decode(Span<const uint8_t> hammingBytes, Span<uint8_t> bytes, DecodeStats* stats=NULL);
+
+/**
+    @brief Same as "encode" with a code.
+
+    @param Span<const uint8_t> bytes: Original bytes.
+    @param Span<uint8_t> hammingBytes: Receives the bytes in the hamming
+        format. Must hold at least "encodedSize(bytes.size(), code)" bytes.
+    @param Code code: Code of the hamming format.
+    @return size_t: Number of bytes written to "hammingBytes" (0 if it is too
+        small, and nothing is written).
+*/
+size_t encode(Span<const uint8_t> bytes, Span<uint8_t> hammingBytes, Code code);
+
+/**
+    @brief Same as "decode" with a code.
+
+    @param Span<const uint8_t> hammingBytes: Bytes in the hamming format.
+    @param Span<uint8_t> bytes: Receives the original bytes. Must hold at
+        least "decodedSize(hammingBytes.size(), code)" bytes.
+    @param Code code: Code of the hamming format.
+    @param DecodeStats* stats: Gets the groups decoded, corrected and detected
+        added (can be NULL).
+    @return size_t: Number of bytes written to "bytes" (0 if it is too small,
+        and nothing is written).
+*/
+size_t decode(Span<const uint8_t> hammingBytes, Span<uint8_t> bytes, Code code,
+              DecodeStats* stats=NULL);
+
+/**
+    @brief Recover only a range of the original bytes. The position of each
+        block is computed from the code, so only the blocks the range
+        touches are read and decoded, however large the file is.
+
+    @param Span<const uint8_t> hammingBytes: The whole file in the hamming
+        format.
+    @param uint64_t offset: Position of the first original byte wanted.
+    @param Span<uint8_t> bytes: Receives the original bytes from "offset",
+        as many as it holds.
+    @param Code code: Code of the hamming format.
+    @param DecodeStats* stats: Gets the groups decoded, corrected and detected
+        added (can be NULL).
+    @return size_t: Number of bytes written to "bytes" (less than its size
+        only at the end of the file, 0 from there on).
+*/
+size_t decodeRange(Span<const uint8_t> hammingBytes, uint64_t offset, Span<uint8_t> bytes,
+                   Code code, DecodeStats* stats=NULL);
+
+/**
+    @brief Remove the code from bytes known to have no inverted bit (their
+        checksum matched), taking the data bits of each group without
+        computing any syndrome. Gives the same bytes as "removeHammingParity"
+        when no bit was inverted, and garbage otherwise.
+
+    @param const uint8_t* hammingBytes: Bytes in the hamming format.
+    @param size_t bytesCount: Number of bytes in the hamming format.
+    @param uint8_t* bytes: Receives "decodedSize(bytesCount, code)" original
+        bytes.
+    @param Code code: Code of the hamming format.
+    @param DecodeStats* stats: Gets the groups decoded added, all of them
+        clean (can be NULL).
+    @return size_t: Number of bytes written to "bytes".
+*/
+size_t extractData(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes, Code code,
+                   DecodeStats* stats=NULL);
+
+/**
+    @brief Correct bytes in the hamming format in place, without keeping the
+        original bytes: a block with a group that had a bit corrected is
+        encoded again, so it is written back exactly as it was encoded. A
+        block with a group whose errors cannot be corrected (only detected)
+        is left as it is, and so are the clean ones, which are not written
+        at all.
+
+    @param uint8_t* hammingBytes: Bytes in the hamming format, corrected in
+        place.
+    @param size_t bytesCount: Number of bytes in the hamming format.
+    @param Code code: Code of the hamming format.
+    @param DecodeStats* stats: Gets the groups decoded, corrected and detected
+        added (can be NULL).
+    @return size_t: Number of bytes written again.
+*/
+size_t scrubHamming(uint8_t* hammingBytes, size_t bytesCount, Code code,
+                    DecodeStats* stats=NULL);
+
+// Largest depth of "interleave".
+const unsigned MAX_INTERLEAVE_DEPTH = 2048;
+
+/**
+    @brief Whether "interleave" takes a depth with a code.
+
+    @param Code code: Code of the hamming format.
+    @param unsigned depth: Groups of each frame.
+    @return bool: true for a multiple of 8 from 8 to "MAX_INTERLEAVE_DEPTH"
+        with any code but "CODE_7_4_SLICED" (whose slabs are already
+        interleaved).
+*/
+bool validInterleave(Code code, unsigned depth);
+
+/**
+    @brief Interleave the groups of bytes in the hamming format, so that a
+        burst of up to "depth" inverted bits inverts at most one bit of each
+        group.
+
+    The groups are taken "depth" at a time (a frame of "depth * groupBits / 8"
+    bytes), and the bit "b" of the group "g" of a frame goes to the position
+    "b * depth + g": first the first bit of every group, then the second one,
+    and so on. The groups after the last whole frame are left as they are.
+
+    @param uint8_t* hammingBytes: Bytes in the hamming format, changed in
+        place.
+    @param size_t bytesCount: Number of bytes in the hamming format (taken
+        from the start of a frame).
+    @param Code code: Code of the hamming format.
+    @param unsigned depth: Groups of each frame (see "validInterleave").
+    @return bool: false if the depth is not valid for the code (nothing is
+        changed).
+*/
+bool interleave(uint8_t* hammingBytes, size_t bytesCount, Code code, unsigned depth);
+
+/**
+    @brief Apply hamming parity to bytes and interleave the groups, giving
+        the same bytes as "addHammingParity" followed by "interleave" in one
+        pass: each frame is transposed as it is encoded, while its groups are
+        still in registers (or, with the kernels that cannot, in the L1
+        cache).
+
+    @param const uint8_t* bytes: Original bytes.
+    @param size_t bytesCount: Number of original bytes (taken from the start
+        of a frame).
+    @param uint8_t* hammingBytes: Receives "encodedSize(bytesCount, code)"
+        bytes.
+    @param Code code: Code of the hamming format.
+    @param unsigned depth: Groups of each frame (see "validInterleave").
+    @return bool: false if the depth is not valid for the code (nothing is
+        written).
+*/
+bool addInterleavedParity(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes,
+                          Code code, unsigned depth);
+
+/**
+    @brief Put back in order the groups given by "interleave".
+
+    @param uint8_t* hammingBytes: Interleaved bytes, changed in place.
+    @param size_t bytesCount: Number of bytes (taken from the start of a
+        frame).
+    @param Code code: Code of the hamming format.
+    @param unsigned depth: Groups of each frame, as given to "interleave".
+    @return bool: false if the depth is not valid for the code (nothing is
+        changed).
+*/
+bool deinterleave(uint8_t* hammingBytes, size_t bytesCount, Code code, unsigned depth);
+
+/**
+    @brief CRC32C (Castagnoli) of bytes, with the CRC instructions of the
+        CPU when it has them (SSE4.2, ARMv8).
+
+    @param const uint8_t* bytes: Bytes.
+    @param size_t bytesCount: Number of bytes.
+    @param uint32_t crc: CRC of the bytes before them, to compute it in
+        parts (0 - none).
+    @return uint32_t: CRC of all the bytes.
+*/
+uint32_t crc32c(const uint8_t* bytes, size_t bytesCount, uint32_t crc=0);
+
+/**
+    @brief Seed for "hammingError" that is different on every call.
+
+    @return uint64_t: Seed.
+*/
+uint64_t randomSeed();
+
+/**
+    @brief How the errors are generated.
+*/
+enum ErrorKind {
+    ERRORS_GROUP, /**< Each group has a chance in "groupBits" of getting one
+                       of its bits inverted (default). */
+    ERRORS_RATE,  /**< Each bit is inverted with the chance "rate". */
+    ERRORS_BURST, /**< Bursts of "length" bits are inverted, each bit having
+                       the chance "rate" of starting one. */
+    ERRORS_EXACT  /**< Each group gets exactly "flips" of its bits inverted. */
+};
+
+/**
+    @brief Model of the errors generated by "hammingError".
+*/
+struct ErrorModel {
+    ErrorKind kind;  /**< How the errors are generated. */
+    double rate;     /**< Chance of each bit ("ERRORS_RATE", "ERRORS_BURST"). */
+    unsigned length; /**< Bits of each burst ("ERRORS_BURST"). */
+    unsigned flips;  /**< Bits inverted in each group, 0~"groupBits"
+                          ("ERRORS_EXACT"). */
+    unsigned groupBits; /**< Bits of each group: 7~72 (see "codeBlocks", 7
+                             for (7,4)). */
+    bool sliced;     /**< The groups of 7 bits are in the bit-sliced layout
+                          ("CODE_7_4_SLICED"), so "ERRORS_GROUP" and
+                          "ERRORS_EXACT" give each of them the errors of the
+                          same group of (7,4), spread over its planes. */
+
+    ErrorModel() : kind(ERRORS_GROUP), rate(0), length(1), flips(1), groupBits(7),
+                   sliced(false){}
+};
+
+/**
+    @brief Generate error in bytes according to the limitations of hamming.
+
+    Each group of 7 bits has a chance in 7 of getting one of its bits
+    inverted. The errors of each group depend only on the seed and on the
+    position of the group in the file, so the same seed always gives the same
+    errors, even when the file is split among threads.
+
+    @param uint8_t* hammingBytes: Bytes in the hamming format, changed in
+        place.
+    @param size_t bytesCount: Number of bytes in the hamming format.
+    @param uint64_t seed: Seed of the errors.
+    @param uint64_t offset: Position of "hammingBytes" in the file (a multiple
+        of 7).
+    @return void.
+*/
+void hammingError(uint8_t* hammingBytes, size_t bytesCount, uint64_t seed, uint64_t offset=0);
+
+/**
+    @brief Generate error in bytes following a model. Only the bits of the
+        complete groups get errors. Like the model "ERRORS_GROUP", the
+        errors depend only on the seed and on the position of each bit in the
+        file.
+
+    @param uint8_t* hammingBytes: Bytes in the hamming format, changed in
+        place.
+    @param size_t bytesCount: Number of bytes in the hamming format.
+    @param ErrorModel& model: Model of the errors.
+    @param uint64_t seed: Seed of the errors.
+    @param uint64_t offset: Position of "hammingBytes" in the file (a multiple
+        of 7, of "model.groupBits" for groups of more than 8 bits, or of a
+        slab (224 bytes) with "model.sliced").
+    @return void.
+*/
+void hammingError(uint8_t* hammingBytes, size_t bytesCount, const ErrorModel& model,
+                  uint64_t seed, uint64_t offset=0);
+
+/**
+    @brief Positions of the bits that "hammingError" inverts, without
+        touching any byte.
+
+    @param size_t bytesCount: Number of bytes in the hamming format.
+    @param ErrorModel& model: Model of the errors.
+    @param uint64_t seed: Seed of the errors.
+    @param uint64_t offset: Position of the bytes in the file (a multiple of
+        7, of "model.groupBits" for groups of more than 8 bits, or of a slab
+        (224 bytes) with "model.sliced").
+    @param std::vector<uint64_t>* flips: Receives (appended) the position in
+        the file of each bit inverted, in increasing order (bit 0 is the most
+        significant bit of the first byte).
+    @return void.
+*/
+void errorFlips(size_t bytesCount, const ErrorModel& model, uint64_t seed, uint64_t offset,
+                std::vector<uint64_t>* flips);
+
+} // namespace hamming
+
+#endif
@@ -0,0 +1,122 @@
+/**
+    @file    hamming_arena.cpp
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Buffers reused from one chunk, and one call, to the next.
+
+    @section DESCRIPTION
+
+    A new block is at least as large as all the blocks before it, so an
+    arena that keeps growing allocates only a few times, and joining them
+    when it is released to its start makes the next conversion fit in the
+    first block.
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#include <utility>
+
+#include "hamming_arena.h"
+
+namespace hamming {
+
+namespace {
+
+// Arena given to "setThreadArena" by each thread.
+thread_local Arena* givenArena = NULL;
+
+} // namespace
+
+Arena::Arena(size_t blockBytes) :
+    blockBytes(blockBytes),
+    current(0),
+    offset(0){
+}
+
+uint8_t* Arena::fit(size_t block, size_t size, size_t alignment){
+    uint8_t* bytes = blocks[block].bytes.get();
+    size_t used = block == current ? offset : 0;
+    uintptr_t address = ((uintptr_t)(bytes + used) + (alignment - 1)) &
+                        ~(uintptr_t)(alignment - 1);
+    size_t end = (size_t)(address - (uintptr_t)bytes) + size;
+    if(end > blocks[block].size){
+        return NULL;
+    }
+    current = block;
+    offset = end;
+    return (uint8_t*)address;
+}
+
+uint8_t* Arena::allocate(size_t size, size_t alignment){
+    for(size_t z = current; z < blocks.size(); z++){
+        uint8_t* buffer = fit(z, size, alignment);
+        if(buffer != NULL){
+            return buffer;
+        }
+    }
+    Block block;
+    block.size = capacity();
+    if(block.size < blockBytes){
+        block.size = blockBytes;
+    }
+    if(block.size < size + alignment){
+        block.size = size + alignment;
+    }
+    block.bytes.reset(new uint8_t[block.size]);
+    blocks.push_back(std::move(block));
+    return fit(blocks.size() - 1, size, alignment);
+}
+
+Arena::Mark Arena::mark() const{
+    Mark mark;
+    mark.block = current;
+    mark.offset = offset;
+    return mark;
+}
+
+void Arena::release(const Mark& mark){
+    current = mark.block;
+    offset = mark.offset;
+    if((current == 0) && (offset == 0) && (blocks.size() > 1)){
+        Block block;
+        block.size = capacity();
+        blocks.clear();
+        block.bytes.reset(new uint8_t[block.size]);
+        blocks.push_back(std::move(block));
+    }
+}
+
+void Arena::clear(){
+    blocks.clear();
+    current = 0;
+    offset = 0;
+}
+
+size_t Arena::capacity() const{
+    size_t total = 0;
+    for(size_t z = 0; z < blocks.size(); z++){
+        total += blocks[z].size;
+    }
+    return total;
+}
+
+Arena& threadArena(){
+    if(givenArena != NULL){
+        return *givenArena;
+    }
+    static thread_local Arena arena;
+    return arena;
+}
+
+void setThreadArena(Arena* arena){
+    givenArena = arena;
+}
+
+} // namespace hamming
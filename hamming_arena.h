@@ -0,0 +1,182 @@
+/**
+    @file    hamming_arena.h
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Buffers reused from one chunk, and one call, to the next.
+
+    @section DESCRIPTION
+
+    An "Arena" gives aligned buffers out of a few large blocks, moving a
+    position forward, and takes them all back at once when the
+    "ArenaScope" that was open when they were given ends. So a buffer
+    costs an addition, and once the blocks are as large as the largest
+    conversion nothing is allocated any more.
+
+    Each thread has an arena of its own, kept while the thread lives (the
+    threads of a "ThreadPool" live as long as the pool), which the
+    conversions use for their chunks. A caller can give the arena a thread
+    uses instead, to keep or release its memory when it wants.
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#ifndef HAMMING_ARENA_H
+#define HAMMING_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <vector>
+
+namespace hamming {
+
+// Alignment of the buffers of an arena, enough for the loads of any kernel
+// (and a whole cache line).
+const size_t ARENA_ALIGNMENT = 64;
+
+class Arena {
+public:
+
+    /**
+        @brief Position of an arena, to give back what was allocated after
+            it.
+    */
+    struct Mark {
+        size_t block;  /**< Block being used. */
+        size_t offset; /**< Bytes used of it. */
+    };
+
+    /**
+        @brief Create an arena, without any block yet.
+
+        @param size_t blockBytes: Smallest block allocated.
+    */
+    explicit Arena(size_t blockBytes=64 * 1024);
+
+    /**
+        @brief Allocate a buffer, until the scope open ends. Its bytes are
+            not set.
+
+        @param size_t size: Number of bytes.
+        @param size_t alignment: Alignment of its address (a power of 2).
+        @return uint8_t*: The buffer.
+    */
+    uint8_t* allocate(size_t size, size_t alignment=ARENA_ALIGNMENT);
+
+    /**
+        @brief Where the arena is.
+
+        @return Mark: Given to "release" to take back what is allocated after.
+    */
+    Mark mark() const;
+
+    /**
+        @brief Take back the buffers allocated after a mark. Released back to
+            the start, the blocks are joined in a single one if there are
+            more, so that the next time they are all in one block.
+
+        @param Mark& mark: Given by "mark".
+        @return void.
+    */
+    void release(const Mark& mark);
+
+    /**
+        @brief Free the blocks. No buffer can be in use.
+
+        @return void.
+    */
+    void clear();
+
+    /**
+        @brief Bytes in the blocks.
+
+        @return size_t: Sum of the size of the blocks.
+    */
+    size_t capacity() const;
+
+private:
+    Arena(const Arena&);
+    Arena& operator=(const Arena&);
+
+    /**
+        @brief One allocation of the arena.
+    */
+    struct Block {
+        std::unique_ptr<uint8_t[]> bytes;
+        size_t size;
+    };
+
+    uint8_t* fit(size_t block, size_t size, size_t alignment);
+
+    std::vector<Block> blocks;
+    size_t blockBytes;
+    size_t current; /**< Block being used. */
+    size_t offset;  /**< Bytes used of it. */
+};
+
+/**
+    @brief Buffers of an arena taken back when it ends.
+*/
+class ArenaScope {
+public:
+
+    /**
+        @brief Open the scope.
+
+        @param Arena& arena: Arena of the buffers.
+    */
+    explicit ArenaScope(Arena& arena) : arena(arena), start(arena.mark()){}
+
+    /**
+        @brief Take back the buffers allocated in the scope.
+    */
+    ~ArenaScope(){
+        arena.release(start);
+    }
+
+    /**
+        @brief Allocate a buffer until the scope ends.
+
+        @param size_t size: Number of bytes.
+        @param size_t alignment: Alignment of its address (a power of 2).
+        @return uint8_t*: The buffer (its bytes are not set).
+    */
+    uint8_t* allocate(size_t size, size_t alignment=ARENA_ALIGNMENT){
+        return arena.allocate(size, alignment);
+    }
+
+private:
+    ArenaScope(const ArenaScope&);
+    ArenaScope& operator=(const ArenaScope&);
+
+    Arena& arena;
+    Arena::Mark start;
+};
+
+/**
+    @brief The arena of the thread that calls it.
+
+    @return Arena&: The one given to "setThreadArena", or the one of the
+        thread.
+*/
+Arena& threadArena();
+
+/**
+    @brief Give the arena that the thread that calls it uses.
+
+    @param Arena* arena: Arena, which must outlive its use (NULL - the one
+        of the thread again).
+    @return void.
+*/
+void setThreadArena(Arena* arena);
+
+} // namespace hamming
+
+#endif
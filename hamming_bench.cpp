@@ -0,0 +1,385 @@
+/**
+    @file    hamming_bench.cpp
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Measures how fast the hamming method is applied, errors are
+        generated and files are recovered.
+
+    @section DESCRIPTION
+
+    For each buffer size (doubling from "--min" to "--max") the operations
+    of "applyHamming", "hammingError" and "recoverHamming" are run over
+    random bytes in memory, without touching any file: first with the
+    original "std::vector<bool>" functions (only up to "--legacy-max", as
+    they are quadratic), then with each kernel the CPU supports (the errors,
+    which do not depend on it, just once), again with the code (8,4) and
+    with the bit-sliced layout of (7,4), with the larger codes (15,11) ~
+    (72,64), the interleaving alone and at last with the fastest kernel
+    split among "-j" threads. Each one is repeated until it takes at least
+    "--time" seconds and reported as MB/s and cycles per byte of the
+    original data, together with the peak memory of the process.
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <functional>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAMMING_TSC 1
+#endif
+
+#if !defined(_WIN32) || defined(__CYGWIN__)
+#include <sys/resource.h>
+#define HAMMING_RUSAGE 1
+#endif
+
+#include "hamming.h"
+#include "hamming_legacy.h"
+#include "hamming_pool.h"
+
+namespace {
+
+/**
+    @brief Options of the benchmark.
+*/
+struct BenchOptions {
+    size_t minBytes;    /**< Smallest buffer. */
+    size_t maxBytes;    /**< Largest buffer. */
+    size_t legacyMax;   /**< Largest buffer for the legacy functions. */
+    unsigned threads;   /**< Threads of the multithreaded run (0 - one for
+                             each CPU). */
+    double minSeconds;  /**< Shortest time of each measurement. */
+
+    BenchOptions() : minBytes(4 * 1024),
+                     maxBytes(64 * 1024 * 1024),
+                     legacyMax(64 * 1024),
+                     threads(0),
+                     minSeconds(0.5){}
+};
+
+/**
+    @brief Read a size in bytes, with an optional "K", "M" or "G" (KiB, MiB,
+        GiB).
+
+    @param const char* text: Size.
+    @param size_t* bytes: Receives the size.
+    @return bool: false if it is not a size.
+*/
+bool parseSize(const char* text, size_t* bytes){
+    char* end;
+    unsigned long long value = strtoull(text, &end, 10);
+    if(end == text){
+        return false;
+    }
+    switch(*end){
+        case 'K': case 'k':
+            value <<= 10;
+            end++;
+            break;
+        case 'M': case 'm':
+            value <<= 20;
+            end++;
+            break;
+        case 'G': case 'g':
+            value <<= 30;
+            end++;
+            break;
+    }
+    if(*end != '\0'){
+        return false;
+    }
+    *bytes = (size_t)value;
+    return true;
+}
+
+/**
+    @brief Time stamp counter of the CPU, used to count cycles.
+
+    @return unsigned long long: Cycles since some point (0 where there is no
+        counter).
+*/
+unsigned long long cycles(){
+#if HAMMING_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/**
+    @brief Largest memory used by the process so far.
+
+    @return double: Peak resident set size in MiB (0 if unknown).
+*/
+double peakRssMiB(){
+#if HAMMING_RUSAGE
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) == 0){
+
+        // Kibibytes on Linux.
+        return usage.ru_maxrss / 1024.0;
+    }
+#endif
+    return 0;
+}
+
+/**
+    @brief Run an operation until it takes at least "minSeconds" and print a
+        line with its speed.
+
+    @param const char* engine: What runs the operation.
+    @param const char* operation: Name of the operation.
+    @param size_t bytesCount: Original bytes handled on each run.
+    @param double minSeconds: Shortest time to measure.
+    @param std::function<void()>& run: The operation.
+    @return void.
+*/
+void measure(const char* engine, const char* operation, size_t bytesCount,
+             double minSeconds, const std::function<void()>& run){
+    typedef std::chrono::steady_clock Clock;
+    size_t runs = 0;
+    double seconds = 0;
+    unsigned long long firstCycle = cycles();
+    Clock::time_point start = Clock::now();
+    do{
+        run();
+        runs++;
+        seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    }while(seconds < minSeconds);
+    unsigned long long cycleCount = cycles() - firstCycle;
+
+    double totalBytes = (double)bytesCount * runs;
+    printf("%12zu  %-24s %-8s %10.1f ", bytesCount, engine, operation,
+           totalBytes / seconds / 1e6);
+    if(cycleCount > 0){
+        printf("%12.2f", cycleCount / totalBytes);
+    }else{
+        printf("%12s", "-");
+    }
+    printf(" %10.1f\n", peakRssMiB());
+    fflush(stdout);
+}
+
+/**
+    @brief Measure the three operations over one buffer size.
+
+    @param size_t bytesCount: Size of the original buffer.
+    @param BenchOptions& options: Options of the benchmark.
+    @param hamming::ThreadPool& pool: Threads of the multithreaded run.
+    @return void.
+*/
+void benchSize(size_t bytesCount, const BenchOptions& options, hamming::ThreadPool& pool){
+    std::vector<uint8_t> bytes(bytesCount);
+    for(size_t z = 0; z < bytesCount; z++){
+        bytes[z] = (uint8_t)rand();
+    }
+    std::vector<uint8_t> hammingBytes(hamming::encodedSize(bytesCount));
+    std::vector<uint8_t> errorBytes(hammingBytes.size());
+    std::vector<uint8_t> recovered(bytesCount);
+    std::vector<uint8_t> secdedBytes(hamming::encodedSize(bytesCount, hamming::CODE_8_4));
+
+    // What is recovered has the errors "hamming_err" would generate.
+    hamming::encode(bytes, hammingBytes);
+    errorBytes = hammingBytes;
+    hamming::hammingError(errorBytes.data(), errorBytes.size(), 1);
+    hamming::ErrorModel secdedModel;
+    secdedModel.groupBits = 8;
+    hamming::encode(bytes, secdedBytes, hamming::CODE_8_4);
+    hamming::hammingError(secdedBytes.data(), secdedBytes.size(), secdedModel, 1);
+
+    if(bytesCount <= options.legacyMax){
+        std::vector<unsigned char> legacyBytes(bytes.begin(), bytes.end());
+        std::vector<unsigned char> legacyHamming(hammingBytes.begin(), hammingBytes.end());
+        std::vector<unsigned char> legacyError(errorBytes.begin(), errorBytes.end());
+        measure("legacy", "apply", bytesCount, options.minSeconds, [&](){
+            legacy::bitsToBytes(legacy::addHammingParity(legacy::bytesToBits(legacyBytes)), 1);
+        });
+        measure("legacy", "error", bytesCount, options.minSeconds, [&](){
+            legacy::bitsToBytes(legacy::hammingError(legacy::bytesToBits(legacyHamming)));
+        });
+        measure("legacy", "recover", bytesCount, options.minSeconds, [&](){
+            legacy::bitsToBytes(legacy::removeHammingParity(legacy::bytesToBits(legacyError)));
+        });
+    }
+
+    // The errors do not depend on the kernel. A new seed on every run, so
+    // that the bytes do not go back and forth between the same two values.
+    uint64_t seed = 1;
+    measure("packed", "error", bytesCount, options.minSeconds, [&](){
+        hamming::hammingError(hammingBytes.data(), hammingBytes.size(), seed++);
+    });
+
+    const hamming::Kernel kernels[] = {hamming::KERNEL_BITWISE, hamming::KERNEL_TABLE,
+                                       hamming::KERNEL_SSSE3, hamming::KERNEL_AVX2,
+                                       hamming::KERNEL_NEON};
+    for(size_t z = 0; z < (sizeof(kernels) / sizeof(kernels[0])); z++){
+        if(!hamming::setKernel(kernels[z])){
+            continue;
+        }
+        const char* name = hamming::kernelName(kernels[z]);
+        measure(name, "apply", bytesCount, options.minSeconds, [&](){
+            hamming::encode(bytes, hammingBytes);
+        });
+        measure(name, "recover", bytesCount, options.minSeconds, [&](){
+            hamming::decode(errorBytes, recovered);
+        });
+    }
+
+    // The code (8,4), whose errors are given back in place by the decoding.
+    for(size_t z = 0; z < (sizeof(kernels) / sizeof(kernels[0])); z++){
+        if(!hamming::setKernel(kernels[z])){
+            continue;
+        }
+        char name[32];
+        snprintf(name, sizeof(name), "%s-8,4", hamming::kernelName(kernels[z]));
+        std::vector<uint8_t> secdedOutput(secdedBytes.size());
+        measure(name, "apply", bytesCount, options.minSeconds, [&](){
+            hamming::encode(bytes, secdedOutput, hamming::CODE_8_4);
+        });
+        measure(name, "recover", bytesCount, options.minSeconds, [&](){
+            hamming::decode(secdedBytes, recovered, hamming::CODE_8_4);
+        });
+    }
+
+    // The bit-sliced layout of (7,4), with the errors of each group of (7,4)
+    // spread over its planes.
+    std::vector<uint8_t> slicedBytes(hamming::encodedSize(bytesCount,
+                                                          hamming::CODE_7_4_SLICED));
+    hamming::encode(bytes, slicedBytes, hamming::CODE_7_4_SLICED);
+    hamming::ErrorModel slicedModel;
+    slicedModel.sliced = true;
+    std::vector<uint8_t> slicedErrors(slicedBytes);
+    hamming::hammingError(slicedErrors.data(), slicedErrors.size(), slicedModel, 1);
+    for(size_t z = 0; z < (sizeof(kernels) / sizeof(kernels[0])); z++){
+        if(!hamming::setKernel(kernels[z])){
+            continue;
+        }
+        char name[32];
+        snprintf(name, sizeof(name), "%s-7,4-sliced", hamming::kernelName(kernels[z]));
+        measure(name, "apply", bytesCount, options.minSeconds, [&](){
+            hamming::encode(bytes, slicedBytes, hamming::CODE_7_4_SLICED);
+        });
+        measure(name, "recover", bytesCount, options.minSeconds, [&](){
+            hamming::decode(slicedErrors, recovered, hamming::CODE_7_4_SLICED);
+        });
+    }
+
+    // The larger codes, the same with any kernel.
+    const hamming::Code codes[] = {hamming::CODE_15_11, hamming::CODE_31_26,
+                                   hamming::CODE_63_57, hamming::CODE_72_64};
+    for(size_t z = 0; z < (sizeof(codes) / sizeof(codes[0])); z++){
+        char name[32];
+        snprintf(name, sizeof(name), "code-%s", hamming::codeName(codes[z]));
+        std::vector<uint8_t> codeBytes(hamming::encodedSize(bytesCount, codes[z]));
+        hamming::encode(bytes, codeBytes, codes[z]);
+        hamming::ErrorModel codeModel;
+        codeModel.groupBits = hamming::codeBlocks(codes[z]).groupBits;
+        std::vector<uint8_t> codeErrors(codeBytes);
+        hamming::hammingError(codeErrors.data(), codeErrors.size(), codeModel, 1);
+        measure(name, "apply", bytesCount, options.minSeconds, [&](){
+            hamming::encode(bytes, codeBytes, codes[z]);
+        });
+        measure(name, "recover", bytesCount, options.minSeconds, [&](){
+            hamming::decode(codeErrors, recovered, codes[z]);
+        });
+    }
+
+    // The interleaving alone, over (7,4), (8,4) and (72,64), to be compared
+    // with the encoding and decoding of the code, and the encoding that
+    // interleaves as it goes ("addInterleavedParity").
+    hamming::setKernel(hamming::KERNEL_AUTO);
+    const hamming::Code interleaveCodes[] = {hamming::CODE_7_4, hamming::CODE_8_4,
+                                             hamming::CODE_72_64};
+    const unsigned depths[] = {64, 2048};
+    for(size_t z = 0; z < (sizeof(interleaveCodes) / sizeof(interleaveCodes[0])); z++){
+        hamming::Code code = interleaveCodes[z];
+        std::vector<uint8_t> codeBytes(hamming::encodedSize(bytesCount, code));
+        hamming::encode(bytes, codeBytes, code);
+        for(size_t y = 0; y < (sizeof(depths) / sizeof(depths[0])); y++){
+
+            // Less than a frame is left as it is, so nothing would be
+            // measured.
+            size_t frameBytes = depths[y] * hamming::codeBlocks(code).groupBits / 8;
+            if(codeBytes.size() < frameBytes){
+                continue;
+            }
+            char name[32];
+            snprintf(name, sizeof(name), "interleave-%s-d%u", hamming::codeName(code), depths[y]);
+            measure(name, "apply", bytesCount, options.minSeconds, [&](){
+                hamming::interleave(codeBytes.data(), codeBytes.size(), code, depths[y]);
+            });
+            measure(name, "recover", bytesCount, options.minSeconds, [&](){
+                hamming::deinterleave(codeBytes.data(), codeBytes.size(), code, depths[y]);
+            });
+            measure(name, "encode", bytesCount, options.minSeconds, [&](){
+                hamming::addInterleavedParity(bytes.data(), bytes.size(), codeBytes.data(), code,
+                                              depths[y]);
+            });
+        }
+    }
+
+    if(pool.size() > 1){
+        char name[32];
+        snprintf(name, sizeof(name), "%s-j%u", hamming::kernelName(hamming::getKernel()),
+                 pool.size());
+        measure(name, "apply", bytesCount, options.minSeconds, [&](){
+            hamming::encode(bytes, hammingBytes, pool);
+        });
+        measure(name, "recover", bytesCount, options.minSeconds, [&](){
+            hamming::decode(errorBytes, recovered, pool);
+        });
+        measure(name, "error", bytesCount, options.minSeconds, [&](){
+            hamming::hammingError(hammingBytes, seed++, pool);
+        });
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[]){
+
+    BenchOptions options;
+    for(int argCount = 1; argCount < argc; argCount++){
+        bool ok = (argCount + 1) < argc;
+        if(ok && (strcmp(argv[argCount], "--min") == 0)){
+            ok = parseSize(argv[++argCount], &options.minBytes);
+        }else if(ok && (strcmp(argv[argCount], "--max") == 0)){
+            ok = parseSize(argv[++argCount], &options.maxBytes);
+        }else if(ok && (strcmp(argv[argCount], "--legacy-max") == 0)){
+            ok = parseSize(argv[++argCount], &options.legacyMax);
+        }else if(ok && (strcmp(argv[argCount], "-j") == 0)){
+            options.threads = (unsigned)atoi(argv[++argCount]);
+        }else if(ok && (strcmp(argv[argCount], "--time") == 0)){
+            options.minSeconds = atof(argv[++argCount]);
+        }else{
+            ok = false;
+        }
+        if(!ok || (options.minBytes == 0)){
+            fprintf(stderr, "Usage: %s [--min bytes] [--max bytes] [--legacy-max bytes] [-j threads] [--time seconds]\n"
+                            "       (sizes can end with K, M or G)\n", argv[0]);
+            return 1;
+        }
+    }
+
+    hamming::ThreadPool pool(options.threads);
+    printf("%12s  %-24s %-8s %10s %12s %10s\n", "bytes", "engine", "op", "MB/s",
+           "cycles/byte", "peak MiB");
+    for(size_t bytesCount = options.minBytes; bytesCount <= options.maxBytes; bytesCount *= 2){
+        benchSize(bytesCount, options, pool);
+    }
+
+    return 0;
+}
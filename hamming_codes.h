@@ -0,0 +1,929 @@
+/**
+    @file    hamming_codes.h
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Hamming codes with larger groups (internal).
+
+    @section DESCRIPTION
+
+    "BlockCode" is a Hamming code with "PARITY_BITS" parity bits, for any
+    number of data bits up to 64 (fewer than the "2^r - r - 1" the parity
+    bits can protect gives a shortened code), optionally extended with the
+    parity of the whole group (SECDED).
+
+    The data bits take the Hamming positions that are not powers of 2, the
+    first one the highest, and each parity bit "Pp" is the XOR of the data
+    bits whose position has the bit "p" set. Unlike (7,4), a group is written
+    systematically: its data bits first, then "P(2^(r-1))" ~ "P1" and at last
+    the parity of the group (extended codes), most significant bit first. So
+    the data bits are one "uint64_t", whose parity bits (the XOR of the
+    positions of its odd bits) are looked up byte by byte in a table, without
+    moving bits around (with a popcount instruction, those of (72,64) are the
+    parities of the data bits of each parity bit instead). There are up to 7
+    parity bits, so a position always fits in 7 bits.
+
+    A block is 8 groups, which are exactly "DATA_BITS" original bytes and
+    "GROUP_BITS" bytes in the hamming format. The last group of a file that
+    does not fill a block only has the data bits it needs (the others count
+    as zeros), followed by its parity bits, so each size of the rest of a
+    file gives a different size in the hamming format and the decoder knows
+    exactly how many bytes there were, without trailing zeros. Whole blocks
+    are read and written in place, 64 bits at a time (the groups of (72,64)
+    being an "uint64_t" and a byte); only the last ones, whose reads would
+    pass the end of the bytes, are copied first. The 8 groups of a block are
+    written out one after the other by templates, so the position of each
+    bit is known when compiled, and a group is corrected without branches:
+    its syndrome looks up the bit to invert and what to count.
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#ifndef HAMMING_CODES_H
+#define HAMMING_CODES_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hamming.h"
+#include "hamming_tables.h"
+
+namespace hamming {
+namespace codes {
+
+/**
+    @brief Read 8 bytes as a big-endian number.
+
+    @param const uint8_t* bytes: Bytes.
+    @return uint64_t: Number, the first byte being the most significant.
+*/
+inline uint64_t loadBigEndian(const uint8_t* bytes){
+    uint64_t value;
+    memcpy(&value, bytes, 8);
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    return value;
+#else
+    return __builtin_bswap64(value);
+#endif
+}
+
+/**
+    @brief Write a number as 8 big-endian bytes.
+
+    @param uint8_t* bytes: Receives the bytes.
+    @param uint64_t value: Number, the first byte being the most significant.
+    @return void.
+*/
+inline void storeBigEndian(uint8_t* bytes, uint64_t value){
+#if !defined(__BYTE_ORDER__) || (__BYTE_ORDER__ != __ORDER_BIG_ENDIAN__)
+    value = __builtin_bswap64(value);
+#endif
+    memcpy(bytes, &value, 8);
+}
+
+/**
+    @brief Read bits, most significant first.
+
+    @param const uint8_t* bytes: Bytes, with at least 8 readable bytes from
+        the one of "bit".
+    @param uint64_t bit: First bit.
+    @param unsigned count: Number of bits (1~64, "count + bit % 8" at most
+        64).
+    @return uint64_t: The bits, the last one being bit 0.
+*/
+inline uint64_t loadBits(const uint8_t* bytes, uint64_t bit, unsigned count){
+    return (loadBigEndian(bytes + (bit / 8)) << (bit % 8)) >> (64 - count);
+}
+
+/**
+    @brief Add bits to bytes that are zero there, most significant first.
+
+    @param uint8_t* bytes: Bytes, with at least 8 writable bytes from the one
+        of "bit".
+    @param uint64_t bit: First bit.
+    @param uint64_t value: The bits, the last one being bit 0.
+    @param unsigned count: Number of bits (1~64, "count + bit % 8" at most
+        64).
+    @return void.
+*/
+inline void storeBits(uint8_t* bytes, uint64_t bit, uint64_t value, unsigned count){
+    uint8_t* to = bytes + (bit / 8);
+    storeBigEndian(to, loadBigEndian(to) | ((value << (64 - count)) >> (bit % 8)));
+}
+
+/**
+    @brief Bits written most significant first, 64 at a time, so that only
+        the bytes of the bits added are written (none is read).
+*/
+class BitWriter {
+public:
+
+    /**
+        @brief Start writing.
+
+        @param uint8_t* bytes: Receives the bits.
+    */
+    explicit BitWriter(uint8_t* bytes) : bytes(bytes), pending(0), pendingCount(0){}
+
+    /**
+        @brief Add bits.
+
+        @param uint64_t value: The bits, the last one being bit 0 (none set
+            above them).
+        @param unsigned count: Number of bits (1~64).
+        @return void.
+    */
+    void add(uint64_t value, unsigned count){
+        unsigned total = pendingCount + count;
+        if(total < 64){
+            pending = (pending << count) | value;
+            pendingCount = total;
+            return;
+        }
+        unsigned written = pendingCount;
+        pendingCount = total - 64;
+        storeBigEndian(bytes, written == 0 ? value >> pendingCount :
+                              (pending << (64 - written)) | (value >> pendingCount));
+        bytes += 8;
+
+        // The bits above "pendingCount" are shifted out when written.
+        pending = value;
+    }
+
+    /**
+        @brief Write the bits that are left.
+
+        @return void: The bits added must be whole bytes.
+    */
+    void finish(){
+        for( ; pendingCount > 0; pendingCount -= 8){
+            *bytes++ = (uint8_t)(pending >> (pendingCount - 8));
+        }
+    }
+
+private:
+    uint8_t* bytes;        /**< Next byte to write. */
+    uint64_t pending;      /**< Bits added but not written yet. */
+    unsigned pendingCount; /**< Number of them. */
+};
+
+/**
+    @brief Whether a Hamming position is that of a parity bit (or 0).
+
+    @param unsigned position: Position.
+    @return bool: true if it is 0 or a power of 2.
+*/
+constexpr bool isParityPosition(unsigned position){
+    return (position & (position - 1)) == 0;
+}
+
+/**
+    @brief Hamming position of a data bit.
+
+    @param unsigned dataBit: Data bit (0 - the first one, the highest).
+    @param unsigned position: First position to look at.
+    @return unsigned: Its position.
+*/
+constexpr unsigned dataPosition(unsigned dataBit, unsigned position=3){
+    return isParityPosition(position) ? dataPosition(dataBit, position + 1) :
+           dataBit == 0 ? position : dataPosition(dataBit - 1, position + 1);
+}
+
+/**
+    @brief Position of the highest bit set.
+
+    @param unsigned value: Number (not 0).
+    @return unsigned: Its base 2 logarithm, rounded down.
+*/
+constexpr unsigned floorLog2(unsigned value){
+    return value < 2 ? 0 : 1 + floorLog2(value / 2);
+}
+
+// Entries of "BlockCodeTables::outcomes".
+const uint8_t GROUP_CORRECTED = 1;
+const uint8_t GROUP_DETECTED = 2;
+
+/**
+    @brief Data bit at a position.
+
+    @param unsigned dataBits: Data bits of the code.
+    @param unsigned position: Position.
+    @return int8_t: Its data bit (0 - the last one), -1 for the parity bits,
+        -2 if none.
+*/
+constexpr int8_t dataBitAt(unsigned dataBits, unsigned position){
+
+    // "floorLog2(position) + 1" parity positions come before the data bit.
+    return isParityPosition(position) ? -1 :
+           position - floorLog2(position) - 2 < dataBits ?
+               (int8_t)(position - floorLog2(position) - 2) : -2;
+}
+
+/**
+    @brief Entry of "BlockCodeTables::corrections".
+
+    @param unsigned dataBits: Data bits of the code.
+    @param unsigned parityBits: Parity bits of the code.
+    @param unsigned index: Syndrome of a group, with the bit "parityBits"
+        set when it has an odd number of inverted bits.
+    @return uint64_t: The data bit to invert alone, 0 if none.
+*/
+constexpr uint64_t correctionFlip(unsigned dataBits, unsigned parityBits, unsigned index){
+    return ((index >> parityBits) & 1) != 0 &&
+           dataBitAt(dataBits, index & ((1u << parityBits) - 1)) >= 0 ?
+               1ULL << dataBitAt(dataBits, index & ((1u << parityBits) - 1)) : 0;
+}
+
+/**
+    @brief Entry of "BlockCodeTables::outcomes".
+
+    @param unsigned dataBits: Data bits of the code.
+    @param unsigned parityBits: Parity bits of the code.
+    @param bool extended: Whether the code is extended.
+    @param unsigned index: As "correctionFlip".
+    @return uint8_t: "GROUP_CORRECTED", "GROUP_DETECTED" or 0 (clean).
+*/
+constexpr uint8_t correctionOutcome(unsigned dataBits, unsigned parityBits, bool extended,
+                                    unsigned index){
+
+    // Without a syndrome, only the parity of the group can be inverted. An
+    // even number of inverted bits with a syndrome is two of them, and a
+    // position no bit has (shortened codes) cannot be a single error.
+    return (index & ((1u << parityBits) - 1)) == 0 ?
+               (extended && ((index >> parityBits) & 1) != 0 ? GROUP_CORRECTED : 0) :
+           ((index >> parityBits) & 1) == 0 ? GROUP_DETECTED :
+           dataBitAt(dataBits, index & ((1u << parityBits) - 1)) == -2 ? GROUP_DETECTED :
+                                                                         GROUP_CORRECTED;
+}
+
+/**
+    @brief Entry of "BlockCodeTables::syndromes".
+
+    @param unsigned dataBits: Data bits of the code.
+    @param unsigned byte: Byte of the data bits (0 - the last one).
+    @param unsigned value: Value of the byte.
+    @param unsigned bit: First bit of the byte to take.
+    @return uint8_t: XOR of the positions of its odd bits, with their parity
+        in bit 7.
+*/
+constexpr uint8_t byteSyndrome(unsigned dataBits, unsigned byte, unsigned value,
+                               unsigned bit=0){
+    return bit == 8 ? 0 :
+           (uint8_t)((((value >> bit) & 1) == 0 ? 0 :
+                      ((byte * 8) + bit < dataBits ? dataPosition((byte * 8) + bit) : 0) | 0x80) ^
+                     byteSyndrome(dataBits, byte, value, bit + 1));
+}
+
+/**
+    @brief Entry of "BlockCodeTables::parityMasks".
+
+    @param unsigned dataBits: Data bits of the code.
+    @param unsigned parityBit: Parity bit (0 - "P1").
+    @param unsigned bit: First data bit to take (0 - the last one).
+    @return uint64_t: The data bits whose position has the bit "parityBit"
+        set.
+*/
+constexpr uint64_t parityMask(unsigned dataBits, unsigned parityBit, unsigned bit=0){
+    return bit == dataBits ? 0 :
+           (((dataPosition(bit) >> parityBit) & 1) != 0 ? 1ULL << bit : 0) |
+           parityMask(dataBits, parityBit, bit + 1);
+}
+
+/**
+    @brief Entry of "BlockCodeTables::restSizes".
+
+    @param unsigned dataBits: Data bits of the code.
+    @param unsigned tailBits: Bits after the data bits of a group.
+    @param unsigned restBytes: Original bytes left after the blocks.
+    @return size_t: Their bytes in the hamming format.
+*/
+constexpr size_t restSize(unsigned dataBits, unsigned tailBits, unsigned restBytes){
+    return (((restBytes * 8 / dataBits) * (dataBits + tailBits)) +
+            ((restBytes * 8) % dataBits > 0 ? ((restBytes * 8) % dataBits) + tailBits : 0) +
+            7) / 8;
+}
+
+/**
+    @brief Syndrome of each byte of the data bits, the data bits of each
+        parity bit, the correction of each syndrome and the size of each rest
+        of a file, of a "BlockCode".
+*/
+template<unsigned DATA_BITS, unsigned PARITY_BITS, unsigned TAIL_BITS>
+struct BlockCodeTables {
+    static const unsigned DATA_BYTES = (DATA_BITS + 7) / 8;
+
+    uint8_t syndromes[DATA_BYTES][256]; /**< XOR of the positions of the odd
+                                             bits of each value of each byte
+                                             (the last one first), with
+                                             their parity in bit 7. */
+    uint64_t parityMasks[PARITY_BITS];  /**< Data bits of each parity bit
+                                             ("P1" first). */
+    uint64_t corrections[2u << PARITY_BITS]; /**< Data bit to invert for
+                                                  each syndrome, with the bit
+                                                  "PARITY_BITS" set for an
+                                                  odd number of inverted
+                                                  bits (0 if none). */
+    uint8_t outcomes[2u << PARITY_BITS];     /**< "GROUP_CORRECTED",
+                                                  "GROUP_DETECTED" or 0 for
+                                                  each of them. */
+    size_t restSizes[DATA_BITS];        /**< Bytes in the hamming format of
+                                             each number of original bytes
+                                             left after the blocks. */
+};
+
+template<unsigned DATA_BITS, unsigned PARITY_BITS, unsigned TAIL_BITS>
+const unsigned BlockCodeTables<DATA_BITS, PARITY_BITS, TAIL_BITS>::DATA_BYTES;
+
+/**
+    @brief Fill in "BlockCodeTables".
+
+    @param IndexSequence<S...>: The bytes of the data bits times their 256
+        values.
+    @param IndexSequence<M...>: The parity bits.
+    @param IndexSequence<C...>: The syndromes, odd and even.
+    @param IndexSequence<R...>: The sizes of the rest of a file.
+    @return BlockCodeTables: The tables.
+*/
+template<unsigned DATA_BITS, unsigned PARITY_BITS, unsigned TAIL_BITS, size_t... S, size_t... M,
+         size_t... C, size_t... R>
+constexpr BlockCodeTables<DATA_BITS, PARITY_BITS, TAIL_BITS> makeBlockCodeTables(
+    tables::IndexSequence<S...>, tables::IndexSequence<M...>, tables::IndexSequence<C...>,
+    tables::IndexSequence<R...>){
+    return BlockCodeTables<DATA_BITS, PARITY_BITS, TAIL_BITS>{
+        {byteSyndrome(DATA_BITS, S / 256, S % 256)...},
+        {parityMask(DATA_BITS, M)...},
+        {correctionFlip(DATA_BITS, PARITY_BITS, C)...},
+        {correctionOutcome(DATA_BITS, PARITY_BITS, TAIL_BITS > PARITY_BITS, C)...},
+        {restSize(DATA_BITS, TAIL_BITS, R)...}};
+}
+
+template<unsigned DATA_BITS, unsigned PARITY_BITS, bool EXTENDED>
+class BlockCode {
+public:
+    static const unsigned TAIL_BITS = PARITY_BITS + (EXTENDED ? 1 : 0);
+    static const unsigned GROUP_BITS = DATA_BITS + TAIL_BITS;
+
+    // 8 groups.
+    static const size_t BLOCK_BYTES = DATA_BITS;
+    static const size_t BLOCK_HAMMING_BYTES = GROUP_BITS;
+
+    /**
+        @brief Size of bytes in the hamming format.
+
+        @param size_t bytesCount: Number of original bytes.
+        @return size_t: Number of bytes in the hamming format.
+    */
+    static size_t encodedSize(size_t bytesCount){
+        return ((bytesCount / BLOCK_BYTES) * BLOCK_HAMMING_BYTES) +
+               TABLES.restSizes[bytesCount % BLOCK_BYTES];
+    }
+
+    /**
+        @brief Size of the bytes recovered from the hamming format.
+
+        @param size_t bytesCount: Number of bytes in the hamming format.
+        @return size_t: Number of original bytes (for a rest that no size
+            gives, the largest one that fits in it).
+    */
+    static size_t decodedSize(size_t bytesCount){
+        size_t rest = bytesCount % BLOCK_HAMMING_BYTES;
+        size_t restBytes = 0;
+        while(((restBytes + 1) < BLOCK_BYTES) && (TABLES.restSizes[restBytes + 1] <= rest)){
+            restBytes++;
+        }
+        return ((bytesCount / BLOCK_HAMMING_BYTES) * BLOCK_BYTES) + restBytes;
+    }
+
+    /**
+        @brief Apply the code to bytes.
+
+        @param const uint8_t* bytes: Original bytes.
+        @param size_t bytesCount: Number of original bytes.
+        @param uint8_t* hammingBytes: Receives "encodedSize(bytesCount)"
+            bytes.
+        @return void.
+    */
+    static void encode(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes){
+        const Tables& codeTables = TABLES;
+        size_t blocks = bytesCount / BLOCK_BYTES;
+
+        // Whole blocks are read straight from "bytes" while it has the
+        // bytes read after them.
+        size_t directBlocks = bytesCount < ENCODE_READ_AFTER ? 0 :
+                              (bytesCount - ENCODE_READ_AFTER) / BLOCK_BYTES;
+        directBlocks = directBlocks < blocks ? directBlocks : blocks;
+        for(size_t z = 0; z < directBlocks; z++){
+            encodeBlock(codeTables, bytes + (z * BLOCK_BYTES),
+                        hammingBytes + (z * BLOCK_HAMMING_BYTES));
+        }
+        for(size_t z = directBlocks; z <= blocks; z++){
+            size_t blockBytes = z < blocks ? BLOCK_BYTES : bytesCount % BLOCK_BYTES;
+            if(blockBytes == 0){
+                break;
+            }
+
+            // Copies with room for the 8 bytes read and written at a time.
+            uint8_t input[BLOCK_BYTES + 8] = {0};
+            uint8_t output[BLOCK_HAMMING_BYTES + 8] = {0};
+            memcpy(input, bytes + (z * BLOCK_BYTES), blockBytes);
+            if(blockBytes == BLOCK_BYTES){
+                encodeBlock(codeTables, input, hammingBytes + (z * BLOCK_HAMMING_BYTES));
+                continue;
+            }
+            uint64_t dataBits = (uint64_t)blockBytes * 8;
+            uint64_t outputBit = 0;
+            for(uint64_t bit = 0; bit < dataBits; bit += DATA_BITS){
+                uint64_t restBits = dataBits - bit;
+                unsigned count = restBits < DATA_BITS ? (unsigned)restBits : DATA_BITS;
+                uint64_t data = loadBits(input, bit, count) << (DATA_BITS - count);
+                storeBits(output, outputBit, data >> (DATA_BITS - count), count);
+                storeBits(output, outputBit + count, tailBits(codeTables, data), TAIL_BITS);
+                outputBit += count + TAIL_BITS;
+            }
+            memcpy(hammingBytes + (z * BLOCK_HAMMING_BYTES), output, (size_t)((outputBit + 7) / 8));
+        }
+    }
+
+    /**
+        @brief Correct and remove the code from bytes.
+
+        @param const uint8_t* hammingBytes: Bytes in the hamming format.
+        @param size_t bytesCount: Number of bytes in the hamming format.
+        @param uint8_t* bytes: Receives "decodedSize(bytesCount)" original
+            bytes.
+        @param DecodeStats* stats: Gets the groups decoded, corrected and
+            detected added (can be NULL).
+        @return size_t: Number of bytes written to "bytes".
+    */
+    static size_t decode(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes,
+                         DecodeStats* stats){
+        size_t size = decodedSize(bytesCount);
+        size_t blocks = size / BLOCK_BYTES;
+        const Tables& codeTables = TABLES;
+        DecodeStats counts;
+
+        // As "encode", from "hammingBytes".
+        size_t directBlocks = bytesCount < DECODE_READ_AFTER ? 0 :
+                              (bytesCount - DECODE_READ_AFTER) / BLOCK_HAMMING_BYTES;
+        directBlocks = directBlocks < blocks ? directBlocks : blocks;
+        for(size_t z = 0; z < directBlocks; z++){
+            decodeBlock(codeTables, hammingBytes + (z * BLOCK_HAMMING_BYTES),
+                        bytes + (z * BLOCK_BYTES), &counts);
+        }
+        for(size_t z = directBlocks; z <= blocks; z++){
+            size_t blockBytes = z < blocks ? BLOCK_BYTES : size % BLOCK_BYTES;
+            if(blockBytes == 0){
+                break;
+            }
+            size_t blockHammingBytes = z < blocks ? BLOCK_HAMMING_BYTES :
+                                       codeTables.restSizes[blockBytes];
+            uint8_t input[BLOCK_HAMMING_BYTES + 8] = {0};
+            uint8_t output[BLOCK_BYTES + 8] = {0};
+            memcpy(input, hammingBytes + (z * BLOCK_HAMMING_BYTES), blockHammingBytes);
+            if(blockBytes == BLOCK_BYTES){
+                decodeBlock(codeTables, input, bytes + (z * BLOCK_BYTES), &counts);
+                continue;
+            }
+            uint64_t dataBits = (uint64_t)blockBytes * 8;
+            uint64_t inputBit = 0;
+            for(uint64_t bit = 0; bit < dataBits; bit += DATA_BITS){
+                uint64_t restBits = dataBits - bit;
+                unsigned count = restBits < DATA_BITS ? (unsigned)restBits : DATA_BITS;
+                uint64_t data = loadBits(input, inputBit, count) << (DATA_BITS - count);
+                unsigned tail = (unsigned)loadBits(input, inputBit + count, TAIL_BITS);
+                data = correct(codeTables, data, tail, DATA_BITS - count, &counts);
+                storeBits(output, bit, data >> (DATA_BITS - count), count);
+                inputBit += count + TAIL_BITS;
+            }
+            memcpy(bytes + (z * BLOCK_BYTES), output, blockBytes);
+        }
+        if(stats != NULL){
+            *stats += counts;
+        }
+        return size;
+    }
+
+    /**
+        @brief Remove the code from bytes known to have no inverted bit,
+            copying the data bits of each group without computing its
+            syndrome.
+
+        @param const uint8_t* hammingBytes: Bytes in the hamming format.
+        @param size_t bytesCount: Number of bytes in the hamming format.
+        @param uint8_t* bytes: Receives "decodedSize(bytesCount)" original
+            bytes.
+        @param DecodeStats* stats: Gets the groups decoded added (can be
+            NULL).
+        @return size_t: Number of bytes written to "bytes".
+    */
+    static size_t extract(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes,
+                          DecodeStats* stats){
+        size_t size = decodedSize(bytesCount);
+        size_t blocks = size / BLOCK_BYTES;
+        const Tables& codeTables = TABLES;
+
+        // The data bits of whole blocks are one stream of bits, written 64
+        // at a time, read straight from "hammingBytes" while it has 8 more
+        // bytes after the block.
+        size_t streamBlocks = bytesCount < BLOCK_HAMMING_BYTES + 8 ? 0 :
+                              (bytesCount - 8) / BLOCK_HAMMING_BYTES;
+        streamBlocks = streamBlocks < blocks ? streamBlocks : blocks;
+        uint64_t groups = (uint64_t)streamBlocks * 8;
+        uint64_t pendingBits = 0;
+        unsigned pendingCount = 0;
+        uint8_t* output = bytes;
+        for(uint64_t z = 0; z < groups; z++){
+            uint64_t data = loadBits(hammingBytes, z * GROUP_BITS, DATA_BITS);
+            unsigned count = pendingCount + DATA_BITS;
+            if(count < 64){
+
+                // Never reached with 64 data bits, which would shift by 64.
+                pendingBits = (pendingBits << (count - pendingCount)) | data;
+                pendingCount = count;
+                continue;
+            }
+            pendingCount = count - 64;
+            unsigned shift = DATA_BITS - pendingCount;
+            storeBigEndian(output, shift == 64 ? data :
+                                   (pendingBits << shift) | (data >> pendingCount));
+            output += 8;
+            pendingBits = data;
+        }
+        for( ; pendingCount > 0; pendingCount -= 8){
+            *output++ = (uint8_t)(pendingBits >> (pendingCount - 8));
+        }
+        for(size_t z = streamBlocks; z <= blocks; z++){
+            size_t blockBytes = z < blocks ? BLOCK_BYTES : size % BLOCK_BYTES;
+            if(blockBytes == 0){
+                break;
+            }
+            size_t blockHammingBytes = z < blocks ? BLOCK_HAMMING_BYTES :
+                                       codeTables.restSizes[blockBytes];
+            uint8_t input[BLOCK_HAMMING_BYTES + 8] = {0};
+            uint8_t output[BLOCK_BYTES + 8] = {0};
+            memcpy(input, hammingBytes + (z * BLOCK_HAMMING_BYTES), blockHammingBytes);
+            uint64_t dataBits = (uint64_t)blockBytes * 8;
+            uint64_t inputBit = 0;
+            for(uint64_t bit = 0; bit < dataBits; bit += DATA_BITS){
+                uint64_t restBits = dataBits - bit;
+                unsigned count = restBits < DATA_BITS ? (unsigned)restBits : DATA_BITS;
+                storeBits(output, bit, loadBits(input, inputBit, count), count);
+                inputBit += count + TAIL_BITS;
+                groups++;
+            }
+            memcpy(bytes + (z * BLOCK_BYTES), output, blockBytes);
+        }
+        if(stats != NULL){
+            stats->groups += groups;
+        }
+        return size;
+    }
+
+    /**
+        @brief Apply the code to a whole block, giving its groups as words
+            instead of packing their bits, for "hamming::interleave" to
+            transpose them as they are.
+
+        @param const uint8_t* bytes: "BLOCK_BYTES" original bytes, followed
+            by 8 readable ones.
+        @param uint64_t* words: Receives the first 64 bits of each of the 8
+            groups, the first bit the most significant (the bits after a
+            shorter group are zeros), and with 72 bits the last byte of
+            the 8 groups as a ninth word, the group 0 the most significant.
+        @param size_t stride: Distance between the words.
+        @return void.
+    */
+    static void encodeWords(const uint8_t* bytes, uint64_t* words, size_t stride){
+        const Tables& codeTables = TABLES;
+        if(BYTE_GROUPS){
+            words[8 * stride] = 0;
+        }
+        encodeGroupWords(codeTables, bytes, words, stride,
+                         typename tables::MakeIndexSequence<8>::Type());
+    }
+
+private:
+
+    static const unsigned DATA_BYTES = (DATA_BITS + 7) / 8;
+
+    // Whether the groups are whole bytes (72,64), the data bits being one
+    // "uint64_t" and the other bits one byte.
+    static const bool BYTE_GROUPS = DATA_BITS == 64;
+
+    // Whether the parity bits of 64 data bits are the parity of each of
+    // "parityMasks", when the compiler has a popcount instruction
+    // ("-mpopcnt"). Computed with shifts, those 8 parities are slower than
+    // the 8 bytes looked up in "syndromes".
+#if defined(__POPCNT__)
+    static const bool MASK_SYNDROMES = BYTE_GROUPS;
+#else
+    static const bool MASK_SYNDROMES = false;
+#endif
+
+    // Whether a group is read as one number: "loadBits" takes at most 57
+    // bits from any bit of a byte.
+    static const bool ONE_LOAD_GROUPS = GROUP_BITS <= 57;
+
+    // Shift of a group shorter than 64 bits to the top of its word.
+    static const unsigned WORD_SHIFT = BYTE_GROUPS ? 0 : 64 - GROUP_BITS;
+
+    // Bytes after a block read with it, the last of the 8 bytes read for
+    // its last group.
+    static const size_t ENCODE_READ_AFTER = ((7 * DATA_BITS) / 8) + 8 - DATA_BITS;
+    static const size_t DECODE_READ_AFTER =
+        BYTE_GROUPS ? 0 :
+        ONE_LOAD_GROUPS ? ((7 * GROUP_BITS) / 8) + 8 - GROUP_BITS :
+                          (((7 * GROUP_BITS) + DATA_BITS) / 8) + 8 - GROUP_BITS;
+
+    typedef BlockCodeTables<DATA_BITS, PARITY_BITS, TAIL_BITS> Tables;
+
+    // Filled in when compiled.
+    static constexpr Tables TABLES = makeBlockCodeTables<DATA_BITS, PARITY_BITS, TAIL_BITS>(
+        typename tables::MakeIndexSequence<DATA_BYTES * 256>::Type(),
+        typename tables::MakeIndexSequence<PARITY_BITS>::Type(),
+        typename tables::MakeIndexSequence<2u << PARITY_BITS>::Type(),
+        typename tables::MakeIndexSequence<DATA_BITS>::Type());
+
+    /**
+        @brief Apply the code to a whole block, each of its groups written
+            out with the positions of its bits known when compiled.
+
+        @param Tables& codeTables: Tables of the code.
+        @param const uint8_t* bytes: "BLOCK_BYTES" original bytes, followed
+            by "ENCODE_READ_AFTER" readable ones.
+        @param uint8_t* hammingBytes: Receives "BLOCK_HAMMING_BYTES" bytes.
+        @return void.
+    */
+    static void encodeBlock(const Tables& codeTables, const uint8_t* bytes,
+                            uint8_t* hammingBytes){
+        encodeGroups(codeTables, bytes, hammingBytes,
+                     typename tables::MakeIndexSequence<8>::Type());
+    }
+
+    /**
+        @brief Apply the code to the groups of a block, one after the other.
+
+        @param IndexSequence<G...>: The groups.
+        @return void: The other parameters are those of "encodeBlock".
+    */
+    template<size_t... G>
+    static void encodeGroups(const Tables& codeTables, const uint8_t* bytes,
+                             uint8_t* hammingBytes, tables::IndexSequence<G...>){
+
+        // Local, so that the bits it holds are known when compiled. The
+        // elements of a braced list are evaluated in order.
+        BitWriter output(hammingBytes);
+        int groups[] = {(encodeGroup<G>(codeTables, bytes, hammingBytes, &output), 0)...};
+        (void)groups;
+        output.finish();
+    }
+
+    /**
+        @brief Apply the code to a group of a whole block.
+
+        @param Tables& codeTables: Tables of the code.
+        @param const uint8_t* bytes: The original bytes of the block.
+        @param uint8_t* hammingBytes: Receives the block in the hamming
+            format, written directly when the groups are whole bytes.
+        @param BitWriter* output: Gets the group added otherwise.
+        @return void.
+    */
+    template<size_t GROUP>
+    static void encodeGroup(const Tables& codeTables, const uint8_t* bytes,
+                            uint8_t* hammingBytes, BitWriter* output){
+        if(BYTE_GROUPS){
+            uint64_t data = loadBigEndian(bytes + (GROUP * 8));
+            storeBigEndian(hammingBytes + (GROUP * 9), data);
+            hammingBytes[(GROUP * 9) + 8] = (uint8_t)tailBits(codeTables, data);
+            return;
+        }
+        uint64_t data = loadBits(bytes, GROUP * DATA_BITS, DATA_BITS);
+        output->add((data << TAIL_BITS) | tailBits(codeTables, data), GROUP_BITS);
+    }
+
+    /**
+        @brief Apply the code to the groups of a block as "encodeWords".
+
+        @param Tables& codeTables: Tables of the code.
+        @param const uint8_t* bytes: The original bytes of the block.
+        @param uint64_t* words: Receives the words of the groups.
+        @param size_t stride: Distance between the words.
+        @param IndexSequence<G...>: The groups.
+        @return void.
+    */
+    template<size_t... G>
+    static void encodeGroupWords(const Tables& codeTables, const uint8_t* bytes,
+                                 uint64_t* words, size_t stride, tables::IndexSequence<G...>){
+        int groups[] = {(encodeGroupWord<G>(codeTables, bytes, words, stride), 0)...};
+        (void)groups;
+    }
+
+    /**
+        @brief Apply the code to a group of a whole block as "encodeWords".
+
+        @param Tables& codeTables: Tables of the code.
+        @param const uint8_t* bytes: The original bytes of the block.
+        @param uint64_t* words: Receives the word of the group (and its
+            last byte added to the ninth one with 72 bits).
+        @param size_t stride: Distance between the words.
+        @return void.
+    */
+    template<size_t GROUP>
+    static void encodeGroupWord(const Tables& codeTables, const uint8_t* bytes,
+                                uint64_t* words, size_t stride){
+        if(BYTE_GROUPS){
+            uint64_t data = loadBigEndian(bytes + (GROUP * 8));
+            words[GROUP * stride] = data;
+            words[8 * stride] = (words[8 * stride] << 8) | tailBits(codeTables, data);
+            return;
+        }
+        uint64_t data = loadBits(bytes, GROUP * DATA_BITS, DATA_BITS);
+        words[GROUP * stride] = ((data << TAIL_BITS) | tailBits(codeTables, data)) << WORD_SHIFT;
+    }
+
+    /**
+        @brief Correct and remove the code from a whole block, as
+            "encodeBlock".
+
+        @param Tables& codeTables: Tables of the code.
+        @param const uint8_t* hammingBytes: "BLOCK_HAMMING_BYTES" bytes in
+            the hamming format, followed by "DECODE_READ_AFTER" readable
+            ones.
+        @param uint8_t* bytes: Receives "BLOCK_BYTES" original bytes.
+        @param DecodeStats* counts: Gets the groups counted.
+        @return void.
+    */
+    static void decodeBlock(const Tables& codeTables, const uint8_t* hammingBytes,
+                            uint8_t* bytes, DecodeStats* counts){
+        decodeGroups(codeTables, hammingBytes, bytes, counts,
+                     typename tables::MakeIndexSequence<8>::Type());
+    }
+
+    /**
+        @brief Correct and remove the code from the groups of a block, one
+            after the other.
+
+        @param IndexSequence<G...>: The groups.
+        @return void: The other parameters are those of "decodeBlock".
+    */
+    template<size_t... G>
+    static void decodeGroups(const Tables& codeTables, const uint8_t* hammingBytes,
+                             uint8_t* bytes, DecodeStats* counts, tables::IndexSequence<G...>){
+        BitWriter output(bytes);
+        DecodeStats blockCounts;
+        int groups[] = {(decodeGroup<G>(codeTables, hammingBytes, bytes, &output, &blockCounts),
+                         0)...};
+        (void)groups;
+        output.finish();
+        *counts += blockCounts;
+    }
+
+    /**
+        @brief Correct and remove the code from a group of a whole block.
+
+        @param Tables& codeTables: Tables of the code.
+        @param const uint8_t* hammingBytes: The block in the hamming format.
+        @param uint8_t* bytes: Receives the original bytes of the block,
+            written directly when the groups are whole bytes.
+        @param BitWriter* output: Gets the data bits added otherwise.
+        @param DecodeStats* counts: Gets the group counted.
+        @return void.
+    */
+    template<size_t GROUP>
+    static void decodeGroup(const Tables& codeTables, const uint8_t* hammingBytes,
+                            uint8_t* bytes, BitWriter* output, DecodeStats* counts){
+        if(BYTE_GROUPS){
+            uint64_t data = loadBigEndian(hammingBytes + (GROUP * 9));
+            storeBigEndian(bytes + (GROUP * 8), correct(codeTables, data,
+                                                        hammingBytes[(GROUP * 9) + 8], 0, counts));
+            return;
+        }
+        uint64_t data;
+        unsigned tail;
+        if(ONE_LOAD_GROUPS){
+            uint64_t group = loadBits(hammingBytes, GROUP * GROUP_BITS, GROUP_BITS);
+            data = group >> TAIL_BITS;
+            tail = (unsigned)group & ((1u << TAIL_BITS) - 1);
+        }else{
+            data = loadBits(hammingBytes, GROUP * GROUP_BITS, DATA_BITS);
+            tail = (unsigned)loadBits(hammingBytes, (GROUP * GROUP_BITS) + DATA_BITS, TAIL_BITS);
+        }
+        output->add(correct(codeTables, data, tail, 0, counts), DATA_BITS);
+    }
+
+    /**
+        @brief Syndrome of data bits: the XOR of the positions of the odd
+            ones, which is also their parity bits.
+
+        @param Tables& codeTables: Tables of the code.
+        @param uint64_t data: Data bits, the first one the most significant.
+        @return unsigned: Parity bits ("P1" being bit 0), with the parity of
+            the data bits in bit 7.
+    */
+    static unsigned dataSyndrome(const Tables& codeTables, uint64_t data){
+        unsigned syndrome = 0;
+        if(MASK_SYNDROMES){
+            for(unsigned z = 0; z < PARITY_BITS; z++){
+                syndrome |= (unsigned)__builtin_parityll(data & codeTables.parityMasks[z]) << z;
+            }
+            return syndrome | ((unsigned)__builtin_parityll(data) << 7);
+        }
+        for(unsigned z = 0; z < DATA_BYTES; z++){
+            syndrome ^= codeTables.syndromes[z][(data >> (z * 8)) & 0xFF];
+        }
+        return syndrome;
+    }
+
+    /**
+        @brief Bits written after the data bits of a group.
+
+        @param Tables& codeTables: Tables of the code.
+        @param uint64_t data: Data bits, the first one the most significant.
+        @return unsigned: The parity bits, followed by the parity of the
+            whole group for the extended codes.
+    */
+    static unsigned tailBits(const Tables& codeTables, uint64_t data){
+        unsigned syndrome = dataSyndrome(codeTables, data);
+        unsigned bits = syndrome & 0x7F;
+        if(EXTENDED){
+            bits = (bits << 1) | ((syndrome >> 7) ^ (unsigned)__builtin_parity(bits));
+        }
+        return bits;
+    }
+
+    /**
+        @brief Correct the data bits of a group.
+
+        @param Tables& codeTables: Tables of the code.
+        @param uint64_t data: Data bits, the first one the most significant.
+        @param unsigned tail: Bits written after them.
+        @param unsigned absentBits: Last data bits that are not in the file
+            (zeros).
+        @param DecodeStats* counts: Gets the group counted.
+        @return uint64_t: Corrected data bits.
+    */
+    static uint64_t correct(const Tables& codeTables, uint64_t data, unsigned tail,
+                            unsigned absentBits, DecodeStats* counts){
+        unsigned dataBitsSyndrome = dataSyndrome(codeTables, data);
+        unsigned syndrome = (dataBitsSyndrome & 0x7F) ^ (tail >> (EXTENDED ? 1 : 0));
+
+        // Looked up without branches, as which groups have errors cannot be
+        // predicted. Without the extension, every group counts as odd.
+        unsigned odd = EXTENDED ? ((dataBitsSyndrome >> 7) ^ (unsigned)__builtin_parity(tail)) & 1 :
+                                  1;
+        unsigned index = (odd << PARITY_BITS) | syndrome;
+        uint64_t flip = codeTables.corrections[index];
+        unsigned outcome = codeTables.outcomes[index];
+
+        // An absent data bit (a zero) cannot be a single error.
+        unsigned absent = (flip & ((1ULL << absentBits) - 1)) != 0;
+        counts->groups++;
+        counts->corrected += (outcome & GROUP_CORRECTED) ^ absent;
+        counts->detected += (outcome / GROUP_DETECTED) | absent;
+        return data ^ (flip & ((uint64_t)absent - 1));
+    }
+};
+
+template<unsigned DATA_BITS, unsigned PARITY_BITS, bool EXTENDED>
+const unsigned BlockCode<DATA_BITS, PARITY_BITS, EXTENDED>::TAIL_BITS;
+template<unsigned DATA_BITS, unsigned PARITY_BITS, bool EXTENDED>
+const unsigned BlockCode<DATA_BITS, PARITY_BITS, EXTENDED>::GROUP_BITS;
+template<unsigned DATA_BITS, unsigned PARITY_BITS, bool EXTENDED>
+const size_t BlockCode<DATA_BITS, PARITY_BITS, EXTENDED>::BLOCK_BYTES;
+template<unsigned DATA_BITS, unsigned PARITY_BITS, bool EXTENDED>
+const unsigned BlockCode<DATA_BITS, PARITY_BITS, EXTENDED>::DATA_BYTES;
+template<unsigned DATA_BITS, unsigned PARITY_BITS, bool EXTENDED>
+const size_t BlockCode<DATA_BITS, PARITY_BITS, EXTENDED>::BLOCK_HAMMING_BYTES;
+template<unsigned DATA_BITS, unsigned PARITY_BITS, bool EXTENDED>
+const bool BlockCode<DATA_BITS, PARITY_BITS, EXTENDED>::BYTE_GROUPS;
+template<unsigned DATA_BITS, unsigned PARITY_BITS, bool EXTENDED>
+const bool BlockCode<DATA_BITS, PARITY_BITS, EXTENDED>::MASK_SYNDROMES;
+template<unsigned DATA_BITS, unsigned PARITY_BITS, bool EXTENDED>
+const bool BlockCode<DATA_BITS, PARITY_BITS, EXTENDED>::ONE_LOAD_GROUPS;
+template<unsigned DATA_BITS, unsigned PARITY_BITS, bool EXTENDED>
+const unsigned BlockCode<DATA_BITS, PARITY_BITS, EXTENDED>::WORD_SHIFT;
+template<unsigned DATA_BITS, unsigned PARITY_BITS, bool EXTENDED>
+const size_t BlockCode<DATA_BITS, PARITY_BITS, EXTENDED>::ENCODE_READ_AFTER;
+template<unsigned DATA_BITS, unsigned PARITY_BITS, bool EXTENDED>
+const size_t BlockCode<DATA_BITS, PARITY_BITS, EXTENDED>::DECODE_READ_AFTER;
+template<unsigned DATA_BITS, unsigned PARITY_BITS, bool EXTENDED>
+constexpr typename BlockCode<DATA_BITS, PARITY_BITS, EXTENDED>::Tables
+    BlockCode<DATA_BITS, PARITY_BITS, EXTENDED>::TABLES;
+
+// The larger codes of "hamming::Code".
+typedef BlockCode<11, 4, false> Code15_11;
+typedef BlockCode<26, 5, false> Code31_26;
+typedef BlockCode<57, 6, false> Code63_57;
+typedef BlockCode<64, 7, true> Code72_64;
+
+} // namespace codes
+} // namespace hamming
+
+#endif
@@ -0,0 +1,201 @@
+/**
+    @file    hamming_container.cpp
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Header of the files in the hamming format that describe
+        themselves.
+
+    @section DESCRIPTION
+
+    The numbers are written byte by byte, so the header is the same on any
+    machine. Every block but the last has the same size, so the position of
+    each one is also what the index must have, which is checked when read.
+    A header without checksums is still version 1, so files that do not ask
+    for them stay readable by the tools that only know that version.
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#include <string.h>
+
+#include "hamming.h"
+#include "hamming_container.h"
+
+namespace hamming {
+
+namespace {
+
+const uint8_t CONTAINER_MAGIC[8] = {0x89, 'H', 'A', 'M', '\r', '\n', 0x1A, '\n'};
+const unsigned CONTAINER_VERSION = 1;
+const unsigned CONTAINER_CHECKSUM_VERSION = 2;
+
+/**
+    @brief Write a number little-endian.
+
+    @param uint8_t* bytes: Receives "count" bytes.
+    @param uint64_t value: Number.
+    @param unsigned count: Number of bytes.
+    @return void.
+*/
+void putNumber(uint8_t* bytes, uint64_t value, unsigned count){
+    for(unsigned z = 0; z < count; z++){
+        bytes[z] = (uint8_t)(value >> (z * 8));
+    }
+}
+
+/**
+    @brief Read a number little-endian.
+
+    @param uint8_t* bytes: Bytes.
+    @param unsigned count: Number of bytes.
+    @return uint64_t: Number.
+*/
+uint64_t getNumber(const uint8_t* bytes, unsigned count){
+    uint64_t value = 0;
+    for(unsigned z = count; z > 0; z--){
+        value = (value << 8) | bytes[z - 1];
+    }
+    return value;
+}
+
+/**
+    @brief Positions of the blocks of a container.
+
+    @param ContainerHeader* header: Gets "blockOffsets" from its other
+        fields, and "blockChecksums" with zeros for each block.
+    @param bool checksums: Whether the header has checksums.
+    @return void.
+*/
+void setBlockOffsets(ContainerHeader* header, bool checksums){
+    uint64_t blocks = header->originalSize == 0 ? 0 :
+                      ((header->originalSize - 1) / header->blockBytes) + 1;
+    header->blockOffsets.resize((size_t)blocks);
+    header->blockChecksums.assign(checksums ? (size_t)blocks : 0, 0);
+    uint64_t headerBytes = CONTAINER_FIXED_BYTES +
+        (blocks * (checksums ? CONTAINER_CHECKSUM_ENTRY_BYTES : CONTAINER_ENTRY_BYTES));
+    uint64_t blockHammingBytes = encodedSize((size_t)header->blockBytes, header->code);
+    for(size_t z = 0; z < header->blockOffsets.size(); z++){
+        header->blockOffsets[z] = headerBytes + (z * blockHammingBytes);
+    }
+}
+
+} // namespace
+
+ContainerHeader containerHeader(Code code, uint64_t originalSize, uint64_t blockBytes,
+                                bool checksums){
+    size_t codeBytes = codeBlocks(code).bytes;
+    if(blockBytes == 0){
+        blockBytes = CONTAINER_BLOCK_BYTES;
+    }
+    blockBytes = blockBytes < codeBytes ? codeBytes : (blockBytes / codeBytes) * codeBytes;
+
+    ContainerHeader header;
+    header.code = code;
+    header.originalSize = originalSize;
+    header.blockBytes = blockBytes;
+    setBlockOffsets(&header, checksums);
+    return header;
+}
+
+size_t containerHeaderBytes(const ContainerHeader& header){
+    size_t entryBytes = header.blockChecksums.empty() ? CONTAINER_ENTRY_BYTES :
+                                                        CONTAINER_CHECKSUM_ENTRY_BYTES;
+    return CONTAINER_FIXED_BYTES + (header.blockOffsets.size() * entryBytes);
+}
+
+uint64_t containerBlockSize(const ContainerHeader& header, size_t block){
+    uint64_t from = block * header.blockBytes;
+    uint64_t size = header.originalSize - from < header.blockBytes ? header.originalSize - from :
+                                                                     header.blockBytes;
+    return encodedSize((size_t)size, header.code);
+}
+
+void writeContainerHeader(const ContainerHeader& header, uint8_t* bytes){
+    bool checksums = !header.blockChecksums.empty();
+    size_t entryBytes = checksums ? CONTAINER_CHECKSUM_ENTRY_BYTES : CONTAINER_ENTRY_BYTES;
+    memcpy(bytes, CONTAINER_MAGIC, sizeof(CONTAINER_MAGIC));
+    putNumber(bytes + 8, checksums ? CONTAINER_CHECKSUM_VERSION : CONTAINER_VERSION, 2);
+    putNumber(bytes + 10, (uint64_t)header.code, 2);
+    putNumber(bytes + 12, containerHeaderBytes(header), 4);
+    putNumber(bytes + 16, header.originalSize, 8);
+    putNumber(bytes + 24, header.blockBytes, 8);
+    putNumber(bytes + 32, header.blockOffsets.size(), 8);
+    for(size_t z = 0; z < header.blockOffsets.size(); z++){
+        uint8_t* entry = bytes + CONTAINER_FIXED_BYTES + (z * entryBytes);
+        putNumber(entry, header.blockOffsets[z], 8);
+        if(checksums){
+            putNumber(entry + 8, header.blockChecksums[z], 4);
+        }
+    }
+}
+
+bool hasContainerMagic(const uint8_t* bytes, size_t bytesCount){
+    return (bytesCount >= sizeof(CONTAINER_MAGIC)) &&
+           (memcmp(bytes, CONTAINER_MAGIC, sizeof(CONTAINER_MAGIC)) == 0);
+}
+
+size_t containerHeaderSize(const uint8_t* bytes, size_t bytesCount){
+    if((bytesCount < CONTAINER_FIXED_BYTES) || !hasContainerMagic(bytes, bytesCount)){
+        return 0;
+    }
+    uint64_t version = getNumber(bytes + 8, 2);
+    if((version != CONTAINER_VERSION) && (version != CONTAINER_CHECKSUM_VERSION)){
+        return 0;
+    }
+    uint64_t entryBytes = version == CONTAINER_CHECKSUM_VERSION ? CONTAINER_CHECKSUM_ENTRY_BYTES :
+                                                                  CONTAINER_ENTRY_BYTES;
+    uint64_t headerBytes = getNumber(bytes + 12, 4);
+    uint64_t blocks = getNumber(bytes + 32, 8);
+    if((blocks > ((0xFFFFFFFFULL - CONTAINER_FIXED_BYTES) / entryBytes)) ||
+       (headerBytes != CONTAINER_FIXED_BYTES + (blocks * entryBytes))){
+        return 0;
+    }
+    return (size_t)headerBytes;
+}
+
+bool readContainerHeader(const uint8_t* bytes, size_t bytesCount, ContainerHeader* header){
+    size_t headerBytes = containerHeaderSize(bytes, bytesCount);
+    if((headerBytes == 0) || (bytesCount < headerBytes)){
+        return false;
+    }
+
+    // Only the codes there are, and a header that gives back the same index.
+    Code code = (Code)getNumber(bytes + 10, 2);
+    if(!parseCode(codeName(code), &code) || (code != (Code)getNumber(bytes + 10, 2))){
+        return false;
+    }
+    ContainerHeader read;
+    read.code = code;
+    read.originalSize = getNumber(bytes + 16, 8);
+    read.blockBytes = getNumber(bytes + 24, 8);
+    uint64_t blocks = getNumber(bytes + 32, 8);
+    size_t codeBytes = codeBlocks(code).bytes;
+    if((read.blockBytes == 0) || ((read.blockBytes % codeBytes) != 0) ||
+       (read.blockBytes > ((size_t)-1 / 2)) ||
+       (blocks != (read.originalSize == 0 ? 0 : ((read.originalSize - 1) / read.blockBytes) + 1))){
+        return false;
+    }
+    bool checksums = getNumber(bytes + 8, 2) == CONTAINER_CHECKSUM_VERSION;
+    size_t entryBytes = checksums ? CONTAINER_CHECKSUM_ENTRY_BYTES : CONTAINER_ENTRY_BYTES;
+    setBlockOffsets(&read, checksums);
+    for(size_t z = 0; z < read.blockOffsets.size(); z++){
+        const uint8_t* entry = bytes + CONTAINER_FIXED_BYTES + (z * entryBytes);
+        if(getNumber(entry, 8) != read.blockOffsets[z]){
+            return false;
+        }
+        if(checksums){
+            read.blockChecksums[z] = (uint32_t)getNumber(entry + 8, 4);
+        }
+    }
+    *header = read;
+    return true;
+}
+
+} // namespace hamming
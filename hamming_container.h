@@ -0,0 +1,157 @@
+/**
+    @file    hamming_container.h
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Header of the files in the hamming format that describe
+        themselves.
+
+    @section DESCRIPTION
+
+    A container is a file in the hamming format preceded by a header that
+    tells its code, the exact size of the original file and where each of
+    its blocks starts, so it is decoded without "--code", to exactly the
+    original size (the last group of (7,4) can otherwise give one more byte,
+    and the size of the original file can be known before decoding it), and
+    any block can be found without reading the ones before it.
+
+    The header (numbers little-endian):
+
+        0  8  magic: 0x89 "HAM" "\r\n" 0x1A "\n"
+        8  2  version (1 - no checksums; 2 - checksums)
+       10  2  code ("hamming::Code")
+       12  4  size of the header, index included
+       16  8  size of the original file
+       24  8  original bytes of each block (whole blocks of the code, the
+              last one can be smaller)
+       32  8  number of blocks
+       40  8  position in the file of each block (the index), followed in
+              version 2 by 4 bytes: the CRC32C of the block in the hamming
+              format, so a block whose CRC matches is known to have no
+              inverted bit and does not need to be corrected
+
+    The header is not protected by the code: it is copied as it is by
+    "hamming_err" and checked when read.
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#ifndef HAMMING_CONTAINER_H
+#define HAMMING_CONTAINER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "hamming.h"
+
+namespace hamming {
+
+// Size of the header before the index.
+const size_t CONTAINER_FIXED_BYTES = 40;
+
+// Size of each entry of the index, without and with checksums.
+const size_t CONTAINER_ENTRY_BYTES = 8;
+const size_t CONTAINER_CHECKSUM_ENTRY_BYTES = 12;
+
+// Original bytes of each block of a container (1 MiB, rounded down to whole
+// blocks of the code).
+const uint64_t CONTAINER_BLOCK_BYTES = 1048576;
+
+/**
+    @brief Header of a container.
+*/
+struct ContainerHeader {
+    Code code;             /**< Code of the hamming format. */
+    uint64_t originalSize; /**< Size of the original file. */
+    uint64_t blockBytes;   /**< Original bytes of each block. */
+    std::vector<uint64_t> blockOffsets; /**< Position in the container of
+                                             each block. */
+    std::vector<uint32_t> blockChecksums; /**< CRC32C of each block in the
+                                               hamming format (empty -
+                                               none). */
+
+    ContainerHeader() : code(CODE_7_4), originalSize(0), blockBytes(0){}
+};
+
+/**
+    @brief Header of the container of a file.
+
+    @param Code code: Code of the hamming format.
+    @param uint64_t originalSize: Size of the original file.
+    @param uint64_t blockBytes: Original bytes of each block, rounded down to
+        whole blocks of the code (0 - "CONTAINER_BLOCK_BYTES").
+    @param bool checksums: Whether the header has room for the checksum of
+        each block (zeros, to be set once the blocks are encoded).
+    @return ContainerHeader: The header.
+*/
+ContainerHeader containerHeader(Code code, uint64_t originalSize, uint64_t blockBytes=0,
+                                bool checksums=false);
+
+/**
+    @brief Size of a header.
+
+    @param ContainerHeader& header: Header.
+    @return size_t: Its size in the file, index included.
+*/
+size_t containerHeaderBytes(const ContainerHeader& header);
+
+/**
+    @brief Size of a block of a container in the hamming format.
+
+    @param ContainerHeader& header: Header.
+    @param size_t block: Number of the block.
+    @return uint64_t: Its size (the last one can be smaller).
+*/
+uint64_t containerBlockSize(const ContainerHeader& header, size_t block);
+
+/**
+    @brief Write a header.
+
+    @param ContainerHeader& header: Header.
+    @param uint8_t* bytes: Receives "containerHeaderBytes(header)" bytes.
+    @return void.
+*/
+void writeContainerHeader(const ContainerHeader& header, uint8_t* bytes);
+
+/**
+    @brief Whether a file starts like a container.
+
+    @param uint8_t* bytes: First bytes of the file.
+    @param size_t bytesCount: Number of bytes.
+    @return bool: true if they start with the magic of a container.
+*/
+bool hasContainerMagic(const uint8_t* bytes, size_t bytesCount);
+
+/**
+    @brief Size of the header of a container from its first bytes, to know
+        how much of it there is still to read.
+
+    @param uint8_t* bytes: First bytes of the file.
+    @param size_t bytesCount: Number of bytes (at least
+        "CONTAINER_FIXED_BYTES" for a container).
+    @return size_t: Size of its header, index included (0 - not a container
+        or not a known version).
+*/
+size_t containerHeaderSize(const uint8_t* bytes, size_t bytesCount);
+
+/**
+    @brief Read and check the header of a container.
+
+    @param uint8_t* bytes: First bytes of the file.
+    @param size_t bytesCount: Number of bytes (at least the size of the
+        header).
+    @param ContainerHeader* header: Receives the header.
+    @return bool: false if the bytes are not a valid header.
+*/
+bool readContainerHeader(const uint8_t* bytes, size_t bytesCount, ContainerHeader* header);
+
+} // namespace hamming
+
+#endif
@@ -20,351 +20,289 @@
     Copyright 2016 Eduardo Lúcio Amorim Costa
 */
 
-#include <fstream>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <memory>
 #include <vector>
-#include <iterator>
-#include <algorithm>
+
+#include "hamming.h"
+#include "hamming_gpu.h"
+#include "hamming_io.h"
 
 /**
-    @brief Converts a file into bytes vector.
+    @brief Control and retrieve using the hamming method.
 
-    @param char* fileName: Name of the file to be converted.
-    @return std::vector<unsigned char>: File in bytes array.
+    @param char* flNameFrom: File to recover with hamming method.
+    @param char* flNameTo: Name of the file to be recovered with the hamming 
+        method.
+    @param hamming::FileOptions& options: How the files are read, converted
+        and written.
+    @return bool: false if a file could not be read or written.
 */
-std::vector<unsigned char> readFileBytes(const char* fileName){
-
-    // Open the file.
-    std::ifstream file(fileName, std::ios::binary);
-
-    // Stop eating new lines in binary mode.
-    file.unsetf(std::ios::skipws);
-
-    // Get its size.
-    std::streampos fileSize;
-
-    file.seekg(0, std::ios::end);
-    fileSize = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    // Reserve capacity.
-    std::vector<unsigned char> vec;
-    vec.reserve(fileSize);
-
-    // Read the data.
-    vec.insert(vec.begin(),
-               std::istream_iterator<unsigned char>(file),
-               std::istream_iterator<unsigned char>());
-
-    return vec;
+bool recoverHamming(const char* flNameFrom, const char* flNameTo, const hamming::FileOptions& options){
+    return hamming::decodeFile(flNameFrom, flNameTo, options);
 }
 
 /**
-    @brief Convert a vector of bytes to a file.
-
-    @param char* fileName: Name of the file to be written to the current 
-        directory.
-    @param std::vector<unsigned char> fileBytes: File in bytes.
-    @return void.
-*/  
-void writeFileBytes(const char* fileName, std::vector<unsigned char> fileBytes){
-    std::ofstream file(fileName, std::ios::out|std::ios::binary);
-    std::copy(fileBytes.cbegin(), fileBytes.cend(),
-        std::ostream_iterator<unsigned char>(file));
-}
+    @brief Counters of one chunk of the hamming file.
+*/
+struct ChunkStats {
+    uint64_t offset;            /**< Position in the hamming file. */
+    uint64_t bytesCount;        /**< Size in the hamming file. */
+    hamming::DecodeStats stats; /**< Groups decoded and corrected. */
+};
 
 /**
-    @brief Convert bytes to bits.
+    @brief Keep the counters of each chunk recovered.
 
-    @param std::vector<unsigned char> bytesArray: File Bytes.
-    @return std::vector<bool>: File in bits.
+    @param uint64_t offset: Position of the chunk in the hamming file.
+    @param uint64_t bytesCount: Size of the chunk in the hamming file.
+    @param hamming::DecodeStats& stats: Groups decoded and corrected.
+    @param void* context: "std::vector<ChunkStats>" that receives them.
+    @return void.
 */
-std::vector<bool> bytesToBits(std::vector<unsigned char> bytesArray){
-    std::vector<bool> boolBitsArray;
-    std::vector<bool> oneByteBits;
-    int bytesArrayCount = bytesArray.size() - 1;
-    for( ; bytesArrayCount > -1; bytesArrayCount--){
-        for(int o=7; o >= 0; o--){
-            oneByteBits.push_back(((bytesArray[bytesArrayCount] >> o) & 1));
-
-            // [Ref.: http://www.cplusplus.com/reference/vector/vector/resize/]
-            // Reduces the size of the vector to free up memory.
-            bytesArray.resize(bytesArrayCount + 1);
-
-            // [Ref.: http://stackoverflow.com/questions/16173887/how-to-reduce-the-size-of-vector-when-removing-elements-from-it]
-            // [Ref.: http://stackoverflow.com/questions/1111078/reduce-the-capacity-of-an-stl-vector]
-            // Ensures that the allocated vector space will also be reduced.
-            std::vector<unsigned char>(bytesArray).swap(bytesArray);
-        }
-
-        // Invert then you can then put the boolBitsArray array in the correct order.
-        std::reverse(oneByteBits.begin(), oneByteBits.end());
-
-        boolBitsArray.insert(std::end(boolBitsArray), std::begin(oneByteBits), std::end(oneByteBits));
-        oneByteBits.clear();
-    }
-
-    // Put in the correct order.
-    std::reverse(boolBitsArray.begin(), boolBitsArray.end());
-
-    return boolBitsArray;
+void keepStats(uint64_t offset, uint64_t bytesCount, const hamming::DecodeStats& stats,
+               void* context){
+    ChunkStats chunk;
+    chunk.offset = offset;
+    chunk.bytesCount = bytesCount;
+    chunk.stats = stats;
+    ((std::vector<ChunkStats>*)context)->push_back(chunk);
 }
 
 /**
-    @brief Convert bits into bytes.
+    @brief Write the counters of the groups recovered as JSON: the totals and
+        the ones of each chunk, so that the errors can be located.
 
-    @param std::vector<bool> bitsArray: File bits.
-    @param int byteAdjust=0 [Optional]: 1 - Complete with zeros the array of 
-        bits to be a multiple of 8 (byte); 2 - Does not complete with zeros. Default 0.
-    @return std::vector<unsigned char>: File in bytes.
+    @param char* flName: File to be written ("-" - standard output).
+    @param std::vector<ChunkStats>& chunks: Counters of each chunk.
+    @return bool: false if the file could not be written.
 */
-std::vector<unsigned char> bitsToBytes(std::vector<bool> bitsArray, int byteAdjust=0){
-
-    if(byteAdjust == 1){
-
-        /**
-            The calculation below is to adjust the size of the array of bits 
-            ("bitsArray") to be equal to a multiple of 8 (size of the byte) 
-            completing with zeros! The reason for this is because the smaller
-            possible data unit for c/c++ is 1 byte (8 bits).
-        */
-        int boolBitsArraySize=bitsArray.size();
-        if((boolBitsArraySize%8) > 0){
-            int adjustFactor=((((int)boolBitsArraySize/8)+1)*8)-boolBitsArraySize;
-            for(int z=0; z < adjustFactor; z++){
-                bitsArray.push_back(0);
-            }
-        }
+bool writeStats(const char* flName, const std::vector<ChunkStats>& chunks){
+    FILE* file = hamming::isStdio(flName) ? stdout : fopen(flName, "w");
+    if(file == NULL){
+        return false;
     }
-
-    int bit8Count=0;
-    std::vector<bool> bit8Array;
-    unsigned char charByte;
-    std::vector<unsigned char> bytesArray;
-
-    // The array is read back-to-back to free up memory using the "resize" 
-    // and "swap" operations.
-    int boolBitsArrayCount = bitsArray.size() - 1;
-    for( ; boolBitsArrayCount > -1; boolBitsArrayCount--){
-        if(bit8Count < 8){
-            bit8Array.push_back(bitsArray[boolBitsArrayCount]);
-            bit8Count++;
-        }
-        if(bit8Count == 8){
-
-            // [Ref.: http://www.cplusplus.com/reference/vector/vector/resize/]
-            // Reduces the size of the vector to free up memory.
-            bitsArray.resize(boolBitsArrayCount + 1);
-
-            // [Ref.: http://stackoverflow.com/questions/16173887/how-to-reduce-the-size-of-vector-when-removing-elements-from-it]
-            // [Ref.: http://stackoverflow.com/questions/1111078/reduce-the-capacity-of-an-stl-vector]
-            // Ensures that the allocated vector space will also be reduced.
-            std::vector<bool>(bitsArray).swap(bitsArray);
-
-            // It resets in the correct default order, because the treatment 
-            // scheme below is already reversed.
-            charByte = (bit8Array[0]     ) | 
-                       (bit8Array[1] << 1) | 
-                       (bit8Array[2] << 2) | 
-                       (bit8Array[3] << 3) | 
-                       (bit8Array[4] << 4) | 
-                       (bit8Array[5] << 5) | 
-                       (bit8Array[6] << 6) | 
-                       (bit8Array[7] << 7);
-
-            bytesArray.push_back(charByte);
-            bit8Array.clear();
-            bit8Count=0;
-        }
+    hamming::DecodeStats total;
+    for(size_t z = 0; z < chunks.size(); z++){
+        total += chunks[z].stats;
+    }
+    fprintf(file, "{\n");
+    fprintf(file, "  \"groups\": %" PRIu64 ",\n", total.groups);
+    fprintf(file, "  \"clean_groups\": %" PRIu64 ",\n",
+            total.groups - total.corrected - total.detected);
+    fprintf(file, "  \"corrected_groups\": %" PRIu64 ",\n", total.corrected);
+    fprintf(file, "  \"detected_groups\": %" PRIu64 ",\n", total.detected);
+    fprintf(file, "  \"error_density\": %.9g,\n",
+            total.groups > 0 ? (double)(total.corrected + total.detected) / total.groups : 0.0);
+    fprintf(file, "  \"chunks\": [");
+    for(size_t z = 0; z < chunks.size(); z++){
+        fprintf(file, "%s\n    {\"offset\": %" PRIu64 ", \"bytes\": %" PRIu64
+                      ", \"groups\": %" PRIu64 ", \"corrected_groups\": %" PRIu64
+                      ", \"detected_groups\": %" PRIu64 "}",
+                z > 0 ? "," : "", chunks[z].offset, chunks[z].bytesCount,
+                chunks[z].stats.groups, chunks[z].stats.corrected, chunks[z].stats.detected);
+    }
+    fprintf(file, "%s]\n}\n", chunks.empty() ? "" : "\n  ");
+    bool ok = !ferror(file);
+    if(file == stdout){
+        return (fflush(file) == 0) && ok;
     }
-    std::reverse(bytesArray.begin(), bytesArray.end());
-    return bytesArray;
+    int fileErrno = errno;
+    if((fclose(file) != 0) && ok){
+        return false;
+    }
+    errno = fileErrno;
+    return ok;
 }
 
-/**
-    @brief Correct by applying the hamming method.
-
-    @param std::vector<bool> hamming7Bit: 7 bits in the hamming form 
-        containing the 4 original bits.
-    @return std::vector<bool>: 4 original bits.
-*/
-std::vector<bool> hammingCorrection(std::vector<bool> hamming7Bit){
-
-    std::vector<bool> xorOddBitsPos;
-    std::vector<bool> original4Bit;
-    bool e;
-    int f;
-    for(int hamming7BitCount=0; hamming7BitCount < hamming7Bit.size(); hamming7BitCount++){
-
-        if(hamming7Bit[hamming7BitCount] == 1){
-        /**
-            Verifies what are the odd bits (1) and their positions 
-            in the hamming logic (7~1) and stored in an array 3 to 
-            3.
-        */
-
-            /**
-                Adjusting the position of the calculation logic (hamming) to 
-                the position in the array.
-            */
-            f=7-hamming7BitCount;
+int main(int argc, char *argv[]){
 
-            for(int w = 2; w >= 0; w--){
-                e = ((f >> w) & 1);
-                xorOddBitsPos.push_back(e);
+    const char* flNameFrom = NULL;
+    const char* flNameTo = NULL;
+    const char* flNameStats = NULL;
+    const char* batchSource = NULL;
+    std::vector<ChunkStats> chunks;
+    hamming::FileOptions options;
+    hamming::Profile profile;
+    bool gpu = false;
+    bool range = false;
+    bool scrub = false;
+    uint64_t offset = 0;
+    uint64_t length = (uint64_t)-1;
+
+    // Always kept, to report the groups that could not be corrected.
+    options.statsFn = keepStats;
+    options.statsContext = &chunks;
+    for(int argCount = 1; argCount < argc; argCount++){
+        if((strcmp(argv[argCount], "--kernel") == 0) && ((argCount + 1) < argc)){
+            hamming::Kernel kernel;
+            if(!hamming::parseKernel(argv[++argCount], &kernel)){
+                fprintf(stderr, "Unknown kernel \"%s\"!\n", argv[argCount]);
+                return 1;
             }
-        }
-    }
-
-    /**
-        They get the position of the bit to be inverted/corrected by taking 
-        the array as groups of 3 and accessing the "indexes" 0, 1 and 2 of 
-        each of these groups of three in that order and running an XOR between 
-        them.
-    */
-    bool corrPosBits[8]={0, 0, 0, 0, 0, 0, 0, 0};
-    if(xorOddBitsPos.size() > 0){
-        int octalBitPos;
-        int xorNumCount;
-        for(int octalBitGroupPos=0; octalBitGroupPos < 3; octalBitGroupPos++){
-            xorNumCount=0;
-            octalBitPos=octalBitGroupPos;
-            for(int xorBitsCount=0; xorBitsCount < (xorOddBitsPos.size()/3); xorBitsCount++){
-                if(xorOddBitsPos[octalBitPos] == 1){
-                    xorNumCount++;
-                }
-                octalBitPos=octalBitPos+3;
+            if(!hamming::setKernel(kernel)){
+                fprintf(stderr, "Kernel \"%s\" is not supported by this CPU!\n", argv[argCount]);
+                return 1;
             }
-            if(xorNumCount%2 == 0){
-                corrPosBits[(octalBitGroupPos+5)]=0; // even
-            }else{
-                corrPosBits[(octalBitGroupPos+5)]=1; // odd
+        }else if((strcmp(argv[argCount], "--code") == 0) && ((argCount + 1) < argc)){
+            if(!hamming::parseCode(argv[++argCount], &options.code)){
+                fprintf(stderr, "Unknown code \"%s\"!\n", argv[argCount]);
+                return 1;
             }
+        }else if(strcmp(argv[argCount], "--mmap") == 0){
+            options.ioMode = hamming::IO_MMAP;
+        }else if(strcmp(argv[argCount], "--io-uring") == 0){
+            options.ioMode = hamming::IO_URING;
+        }else if(strcmp(argv[argCount], "--direct") == 0){
+            options.ioMode = hamming::IO_URING;
+            options.direct = true;
+        }else if(strcmp(argv[argCount], "--fast-verify") == 0){
+            options.fastVerify = true;
+        }else if(strcmp(argv[argCount], "--scrub") == 0){
+            scrub = true;
+        }else if((strcmp(argv[argCount], "--interleave") == 0) && ((argCount + 1) < argc)){
+            options.interleave = (unsigned)atoi(argv[++argCount]);
+        }else if((strcmp(argv[argCount], "-j") == 0) && ((argCount + 1) < argc)){
+            options.threads = (unsigned)atoi(argv[++argCount]);
+        }else if(strcmp(argv[argCount], "--profile") == 0){
+            options.profile = &profile;
+        }else if(strcmp(argv[argCount], "--gpu") == 0){
+            gpu = true;
+        }else if((strcmp(argv[argCount], "--batch") == 0) && ((argCount + 1) < argc)){
+            batchSource = argv[++argCount];
+        }else if((strcmp(argv[argCount], "--stats") == 0) && ((argCount + 1) < argc)){
+            flNameStats = argv[++argCount];
+        }else if((strcmp(argv[argCount], "--offset") == 0) && ((argCount + 1) < argc)){
+            offset = strtoull(argv[++argCount], NULL, 0);
+            range = true;
+        }else if((strcmp(argv[argCount], "--length") == 0) && ((argCount + 1) < argc)){
+            length = strtoull(argv[++argCount], NULL, 0);
+            range = true;
+        }else if(flNameFrom == NULL){
+            flNameFrom = argv[argCount];
+        }else{
+            flNameTo = argv[argCount];
         }
     }
 
-    // Bit (position) to be corrected/inverted (converts the position value 
-    // into bits for int).
-    int flipBit = (corrPosBits[7]     ) | 
-                  (corrPosBits[6] << 1) | 
-                  (corrPosBits[5] << 2) | 
-                  (corrPosBits[4] << 3) | 
-                  (corrPosBits[3] << 4) | 
-                  (corrPosBits[2] << 5) | 
-                  (corrPosBits[1] << 6) | 
-                  (corrPosBits[0] << 7);
-
-    /**
-        If flipBit equals zero, then there are no fixes to be made.
-    */
-    if(flipBit > 0){
-
-        // Transform the correction index into the vector index.
-        flipBit=7-flipBit;
-
-        // Scheme to invert one of the bits for the correction.
-        hamming7Bit[flipBit]=!hamming7Bit[flipBit];
+    // With "--scrub" or "--batch" the only file named is the hamming file or
+    // the directory written.
+    bool named = (scrub || (batchSource != NULL)) ? (flNameFrom != NULL) && (flNameTo == NULL) :
+                 flNameTo != NULL;
+    if(!named){
+        fprintf(stderr, "Usage: %s [--kernel auto|bitwise|table|ssse3|avx2|neon] [--code 7,4|8,4|15,11|31,26|63,57|72,64|7,4-sliced] [--interleave depth] [--mmap | --io-uring [--direct]] [--fast-verify] [-j threads] [--gpu] [--profile] [--stats <json file>] [--offset bytes] [--length bytes] <hamming file> <file>\n", argv[0]);
+        fprintf(stderr, "       %s --scrub [--kernel ...] [--code ...] [--mmap] [--fast-verify] [-j threads] [--profile] [--stats <json file>] <hamming file>\n", argv[0]);
+        fprintf(stderr, "       %s --batch <directory | list of files> [--kernel ...] [--code ...] [--interleave depth] [--mmap | --io-uring [--direct]] [--fast-verify] [-j threads] [--gpu] [--profile] <output directory>\n", argv[0]);
+        return 1;
+    }
+    if((batchSource != NULL) && (range || scrub || (flNameStats != NULL))){
+        fprintf(stderr, "\"--batch\" cannot be used with \"--scrub\", \"--stats\", "
+                        "\"--offset\" or \"--length\"!\n");
+        return 1;
+    }
+    if(!scrub && (flNameStats != NULL) && hamming::isStdio(flNameStats) &&
+       hamming::isStdio(flNameTo)){
+        fprintf(stderr, "\"--stats -\" cannot be used when the recovered file is the standard "
+                        "output!\n");
+        return 1;
+    }
+    if((options.interleave != 0) && (range || scrub)){
+        fprintf(stderr, "An interleaved file can only be decoded whole!\n");
+        return 1;
+    }
+    if((options.interleave != 0) && !hamming::validInterleave(options.code, options.interleave)){
+        fprintf(stderr, "The depth of the interleaving must be a multiple of 8 from 8 to %u, "
+                        "and not with the code 7,4-sliced!\n", hamming::MAX_INTERLEAVE_DEPTH);
+        return 1;
     }
 
-    // original4Bit contains the original 4 bits. As the source reading is 
-    // done from forward to back we also invert here to adjust.
-    original4Bit.push_back(hamming7Bit[4]);
-    original4Bit.push_back(hamming7Bit[2]);
-    original4Bit.push_back(hamming7Bit[1]);
-    original4Bit.push_back(hamming7Bit[0]);
-
-    return original4Bit;
-}
-
-/**
-    @brief Correct by applying the hamming method.
-
-    @param std::vector<bool> boolBitsArray: Contains the bits of the file in 
-        the hamming format. The bits will be taken 7-by-7.
-    @return std::vector<bool>: Original Bits.
-*/
-std::vector<bool> removeHammingParity(std::vector<bool> boolBitsArray){
-
-    int bit7Count=0;
-    std::vector<bool> bit7Array;
-    std::vector<bool> bit4Array;
-    std::vector<bool> originalBits;
-
-    /**
-        "boolBitsArray" will always have a size greater than or equal to the 
-        largest multiple of 7 that "fits" inside it.
-        The array is read backwards to free up memory using the "resize" and 
-        "swap" operations.
-    */
-    int boolBitsArrayCount = ((((int)boolBitsArray.size()/7)*7) - 1);
-
-    for( ; boolBitsArrayCount > -1; boolBitsArrayCount--){
-        if(bit7Count < 7){
-            bit7Array.push_back(boolBitsArray[boolBitsArrayCount]);
-            bit7Count++;
+    // Without a device for it, the files are converted as without "--gpu".
+    std::unique_ptr<hamming::GpuCodec> gpuCodec;
+    if(gpu){
+        gpuCodec.reset(new hamming::GpuCodec());
+        if(!gpuCodec->ready()){
+            fprintf(stderr, "No GPU could be used, converting on the CPU!\n");
         }
-        if(bit7Count == 7){
-
-            // [Ref.: http://www.cplusplus.com/reference/vector/vector/resize/]
-            // Reduces the size of the vector to free up memory.
-            boolBitsArray.resize(boolBitsArrayCount + 1);
-
-            // [Ref.: http://stackoverflow.com/questions/16173887/how-to-reduce-the-size-of-vector-when-removing-elements-from-it]
-            // [Ref.: http://stackoverflow.com/questions/1111078/reduce-the-capacity-of-an-stl-vector]
-            // Ensures that the allocated vector space will also be reduced.
-            std::vector<bool>(boolBitsArray).swap(boolBitsArray);
+        options.gpu = gpuCodec.get();
+    }
 
-            // Replaces in the correct default order.
-            std::reverse(bit7Array.begin(), bit7Array.end());
+    if(batchSource != NULL){
 
-            bit4Array=hammingCorrection(bit7Array);
-            bit7Array.clear();
-            originalBits.insert(std::end(originalBits), std::begin(bit4Array), std::end(bit4Array));
-            bit4Array.clear();
-            bit7Count=0;
+        // The list of files can come from the standard input, given as "-".
+        std::vector<hamming::BatchFile> files;
+        if(!hamming::listBatch(batchSource, flNameFrom, &files)){
+            fprintf(stderr, "Could not list the files of \"%s\" for \"%s\": %s\n",
+                    batchSource, flNameFrom, strerror(errno));
+            return 1;
+        }
+        fprintf(stdout, "%s", "> ---------------------------------------------\n");
+        fprintf(stdout, "Correcting error of %u files!\n", (unsigned)files.size());
+        fflush(stdout);
+        size_t failed = hamming::convertBatch(&files, recoverHamming, options);
+        for(size_t z = 0; z < files.size(); z++){
+            if(!files[z].ok){
+                fprintf(stderr, "Could not recover \"%s\" to \"%s\": %s\n",
+                        files[z].from.c_str(), files[z].to.c_str(), strerror(files[z].error));
+            }else if(files[z].stats.detected > 0){
+                fprintf(stderr, "\"%s\": %" PRIu64 " groups had two bits inverted, which could "
+                                "not be corrected!\n", files[z].from.c_str(),
+                        files[z].stats.detected);
+            }
+        }
+        fprintf(stdout, "%u files recovered, %u failed.\n", (unsigned)(files.size() - failed),
+                (unsigned)failed);
+        if(options.profile != NULL){
+            hamming::printProfile(stdout, profile);
         }
+        fprintf(stdout, "%s", "\n< ---------------------------------------------\n");
+        fflush(stdout);
+        return failed > 0 ? 1 : 0;
     }
 
-    std::reverse(originalBits.begin(), originalBits.end());
-    return originalBits;
-}
-
-/**
-    @brief Control and retrieve using the hamming method.
-
-    @param char* flNameFrom: File to recover with hamming method.
-    @param char* flNameTo: Name of the file to be recovered with the hamming 
-        method.
-    @return void.
-*/
-void recoverHamming(const char* flNameFrom, const char* flNameTo){
-
-    /**
-        The functions have been placed one inside the others so that the 
-        memory is released immediately after the return of the operation. 
-        Before we were duplicating the values (in memory) several times 
-        because we were hosting them in variables unnecessarily!
-    */
-    writeFileBytes(flNameTo, 
-                        bitsToBytes(
-                            removeHammingParity(
-                                bytesToBits(
-                                    readFileBytes(flNameFrom)
-                                )
-                            )
-                        )
-                    );
-
-}
-
-int main(int argc, char *argv[]){
-
-    const char* flNameFrom = argv[1];
-    const char* flNameTo = argv[2];
-
-    printf("%s", "> ---------------------------------------------\n");
-    printf("Correcting error!\n");
-    printf("%s", "\n< ---------------------------------------------\n");
-    recoverHamming(flNameFrom, flNameTo);
+    // The messages go to the standard error when the standard output is the
+    // file being written.
+    FILE* messages = !scrub && hamming::isStdio(flNameTo) ? stderr : stdout;
+    fprintf(messages, "%s", "> ---------------------------------------------\n");
+    fprintf(messages, "Correcting error!\n");
+    fprintf(messages, "%s", "\n< ---------------------------------------------\n");
+    fflush(messages);
+    if(scrub){
+        uint64_t bytesRewritten;
+        if(!hamming::scrubFile(flNameFrom, options, &bytesRewritten)){
+            fprintf(stderr, "Could not scrub \"%s\": %s\n", flNameFrom, strerror(errno));
+            return 1;
+        }
+        fprintf(messages, "%" PRIu64 " bytes written again.\n", bytesRewritten);
+    }else{
+        bool recovered = range ?
+                         hamming::decodeFileRange(flNameFrom, flNameTo, offset, length, options) :
+                         recoverHamming(flNameFrom, flNameTo, options);
+        if(!recovered){
+            fprintf(stderr, "Could not recover \"%s\" to \"%s\": %s\n",
+                    flNameFrom, flNameTo, strerror(errno));
+            return 1;
+        }
+    }
+    if(options.profile != NULL){
+        hamming::printProfile(messages, profile);
+    }
+    uint64_t detected = 0;
+    for(size_t z = 0; z < chunks.size(); z++){
+        detected += chunks[z].stats.detected;
+    }
+    if(detected > 0){
+        fprintf(stderr, "%" PRIu64 " groups had two bits inverted, which could not be corrected!\n",
+                detected);
+    }
+    if((flNameStats != NULL) && !writeStats(flNameStats, chunks)){
+        fprintf(stderr, "Could not write the statistics to \"%s\": %s\n",
+                flNameStats, strerror(errno));
+        return 1;
+    }
 
     return 0;
 }
@@ -20,326 +20,156 @@
     Copyright 2016 Eduardo Lúcio Amorim Costa
 */
 
-#include <fstream>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <memory>
 #include <vector>
-#include <iterator>
-#include <algorithm>
 
-/**
-    @brief Converts a file into bytes vector.
-
-    @param char* fileName: Name of the file to be converted.
-    @return std::vector<unsigned char>: File in bytes array.
-*/
-std::vector<unsigned char> readFileBytes(const char* fileName){
-
-    // Open the file.
-    std::ifstream file(fileName, std::ios::binary);
-
-    // Stop eating new lines in binary mode.
-    file.unsetf(std::ios::skipws);
-
-    // Get its size.
-    std::streampos fileSize;
-
-    file.seekg(0, std::ios::end);
-    fileSize = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    // Reserve capacity.
-    std::vector<unsigned char> vec;
-    vec.reserve(fileSize);
-
-    // Read the data.
-    vec.insert(vec.begin(),
-               std::istream_iterator<unsigned char>(file),
-               std::istream_iterator<unsigned char>());
-
-    return vec;
-}
-
-/**
-    @brief Convert a vector of bytes to a file.
-
-    @param char* fileName: Name of the file to be written to the current 
-        directory.
-    @param std::vector<unsigned char> fileBytes: File in bytes.
-    @return void.
-*/  
-void writeFileBytes(const char* fileName, std::vector<unsigned char> fileBytes){
-    std::ofstream file(fileName, std::ios::out|std::ios::binary);
-    std::copy(fileBytes.cbegin(), fileBytes.cend(),
-        std::ostream_iterator<unsigned char>(file));
-}
+#include "hamming.h"
+#include "hamming_gpu.h"
+#include "hamming_io.h"
 
 /**
-    @brief Convert bytes to bits.
+    @brief Control and apply the hamming method.
 
-    @param std::vector<unsigned char> bytesArray: File Bytes.
-    @return std::vector<bool>: File in bits.
+    @param char* flNameFrom: File to apply the hamming method.
+    @param char* flNameTo: Name the file to save after applying the hamming 
+        method.
+    @param hamming::FileOptions& options: How the files are read, converted
+        and written.
+    @return bool: false if a file could not be read or written.
 */
-std::vector<bool> bytesToBits(std::vector<unsigned char> bytesArray){
-    std::vector<bool> boolBitsArray;
-    std::vector<bool> oneByteBits;
-    int bytesArrayCount = bytesArray.size() - 1;
-    for( ; bytesArrayCount > -1; bytesArrayCount--){
-        for(int o=7; o >= 0; o--){
-            oneByteBits.push_back(((bytesArray[bytesArrayCount] >> o) & 1));
-
-            // [Ref.: http://www.cplusplus.com/reference/vector/vector/resize/]
-            // Reduces the size of the vector to free up memory.
-            bytesArray.resize(bytesArrayCount + 1);
-
-            // [Ref.: http://stackoverflow.com/questions/16173887/how-to-reduce-the-size-of-vector-when-removing-elements-from-it]
-            // [Ref.: http://stackoverflow.com/questions/1111078/reduce-the-capacity-of-an-stl-vector]
-            // Ensures that the allocated vector space will also be reduced.
-            std::vector<unsigned char>(bytesArray).swap(bytesArray);
-        }
-
-        // Invert then you can then put the boolBitsArray array in the correct order.
-        std::reverse(oneByteBits.begin(), oneByteBits.end());
-
-        boolBitsArray.insert(std::end(boolBitsArray), std::begin(oneByteBits), std::end(oneByteBits));
-        oneByteBits.clear();
-    }
-
-    // Put in the correct order.
-    std::reverse(boolBitsArray.begin(), boolBitsArray.end());
-
-    return boolBitsArray;
+bool applyHamming(const char* flNameFrom, const char* flNameTo, const hamming::FileOptions& options){
+    return hamming::encodeFile(flNameFrom, flNameTo, options);
 }
 
-/**
-    @brief Convert bits into bytes.
-
-    @param std::vector<bool> bitsArray: File bits.
-    @param int byteAdjust=0 [Optional]: 1 - Complete with zeros the array of 
-        bits to be a multiple of 8 (byte); 2 - Does not complete with zeros. Default 0.
-    @return std::vector<unsigned char>: File in bytes.
-*/
-std::vector<unsigned char> bitsToBytes(std::vector<bool> bitsArray, int byteAdjust=0){
-
-    if(byteAdjust == 1){
+int main(int argc, char *argv[]){
 
-        /**
-            The calculation below is to adjust the size of the array of bits 
-            ("bitsArray") to be equal to a multiple of 8 (size of the byte) 
-            completing with zeros! The reason for this is because the smaller
-            possible data unit for c/c++ is 1 byte (8 bits).
-        */
-        int boolBitsArraySize=bitsArray.size();
-        if((boolBitsArraySize%8) > 0){
-            int adjustFactor=((((int)boolBitsArraySize/8)+1)*8)-boolBitsArraySize;
-            for(int z=0; z < adjustFactor; z++){
-                bitsArray.push_back(0);
+    const char* flNameFrom = NULL;
+    const char* flNameTo = NULL;
+    const char* batchSource = NULL;
+    hamming::FileOptions options;
+    hamming::Profile profile;
+    bool gpu = false;
+    for(int argCount = 1; argCount < argc; argCount++){
+        if((strcmp(argv[argCount], "--kernel") == 0) && ((argCount + 1) < argc)){
+            hamming::Kernel kernel;
+            if(!hamming::parseKernel(argv[++argCount], &kernel)){
+                fprintf(stderr, "Unknown kernel \"%s\"!\n", argv[argCount]);
+                return 1;
+            }
+            if(!hamming::setKernel(kernel)){
+                fprintf(stderr, "Kernel \"%s\" is not supported by this CPU!\n", argv[argCount]);
+                return 1;
             }
+        }else if((strcmp(argv[argCount], "--code") == 0) && ((argCount + 1) < argc)){
+            if(!hamming::parseCode(argv[++argCount], &options.code)){
+                fprintf(stderr, "Unknown code \"%s\"!\n", argv[argCount]);
+                return 1;
+            }
+        }else if(strcmp(argv[argCount], "--mmap") == 0){
+            options.ioMode = hamming::IO_MMAP;
+        }else if(strcmp(argv[argCount], "--io-uring") == 0){
+            options.ioMode = hamming::IO_URING;
+        }else if(strcmp(argv[argCount], "--direct") == 0){
+            options.ioMode = hamming::IO_URING;
+            options.direct = true;
+        }else if(strcmp(argv[argCount], "--container") == 0){
+            options.container = true;
+        }else if(strcmp(argv[argCount], "--checksums") == 0){
+            options.container = true;
+            options.checksums = true;
+        }else if((strcmp(argv[argCount], "--interleave") == 0) && ((argCount + 1) < argc)){
+            options.interleave = (unsigned)atoi(argv[++argCount]);
+        }else if((strcmp(argv[argCount], "-j") == 0) && ((argCount + 1) < argc)){
+            options.threads = (unsigned)atoi(argv[++argCount]);
+        }else if(strcmp(argv[argCount], "--profile") == 0){
+            options.profile = &profile;
+        }else if(strcmp(argv[argCount], "--gpu") == 0){
+            gpu = true;
+        }else if((strcmp(argv[argCount], "--batch") == 0) && ((argCount + 1) < argc)){
+            batchSource = argv[++argCount];
+        }else if(flNameFrom == NULL){
+            flNameFrom = argv[argCount];
+        }else{
+            flNameTo = argv[argCount];
         }
     }
 
-    int bit8Count=0;
-    std::vector<bool> bit8Array;
-    unsigned char charByte;
-    std::vector<unsigned char> bytesArray;
-
-    // The array is read back-to-back to free up memory using the "resize" 
-    // and "swap" operations.
-    int boolBitsArrayCount = bitsArray.size() - 1;
-    for( ; boolBitsArrayCount > -1; boolBitsArrayCount--){
-        if(bit8Count < 8){
-            bit8Array.push_back(bitsArray[boolBitsArrayCount]);
-            bit8Count++;
-        }
-        if(bit8Count == 8){
-
-            // [Ref.: http://www.cplusplus.com/reference/vector/vector/resize/]
-            // Reduces the size of the vector to free up memory.
-            bitsArray.resize(boolBitsArrayCount + 1);
-
-            // [Ref.: http://stackoverflow.com/questions/16173887/how-to-reduce-the-size-of-vector-when-removing-elements-from-it]
-            // [Ref.: http://stackoverflow.com/questions/1111078/reduce-the-capacity-of-an-stl-vector]
-            // Ensures that the allocated vector space will also be reduced.
-            std::vector<bool>(bitsArray).swap(bitsArray);
-
-            // It resets in the correct default order, because the treatment 
-            // scheme below is already reversed.
-            charByte = (bit8Array[0]     ) | 
-                       (bit8Array[1] << 1) | 
-                       (bit8Array[2] << 2) | 
-                       (bit8Array[3] << 3) | 
-                       (bit8Array[4] << 4) | 
-                       (bit8Array[5] << 5) | 
-                       (bit8Array[6] << 6) | 
-                       (bit8Array[7] << 7);
+    // With "--batch" the only file named is the directory written.
+    bool named = batchSource == NULL ? flNameTo != NULL :
+                 (flNameFrom != NULL) && (flNameTo == NULL);
+    if(!named){
+        fprintf(stderr, "Usage: %s [--kernel auto|bitwise|table|ssse3|avx2|neon] [--code 7,4|8,4|15,11|31,26|63,57|72,64|7,4-sliced] [--container] [--checksums] [--interleave depth] [--mmap | --io-uring [--direct]] [-j threads] [--gpu] [--profile] <file> <hamming file>\n", argv[0]);
+        fprintf(stderr, "       %s --batch <directory | list of files> [--kernel ...] [--code ...] [--container] [--checksums] [--interleave depth] [--mmap | --io-uring [--direct]] [-j threads] [--gpu] [--profile] <output directory>\n", argv[0]);
+        return 1;
+    }
+    if((options.interleave != 0) && options.container){
+        fprintf(stderr, "An interleaved file cannot be a container!\n");
+        return 1;
+    }
+    if((options.interleave != 0) && !hamming::validInterleave(options.code, options.interleave)){
+        fprintf(stderr, "The depth of the interleaving must be a multiple of 8 from 8 to %u, "
+                        "and not with the code 7,4-sliced!\n", hamming::MAX_INTERLEAVE_DEPTH);
+        return 1;
+    }
 
-            bytesArray.push_back(charByte);
-            bit8Array.clear();
-            bit8Count=0;
+    // Without a device for it, the files are converted as without "--gpu".
+    std::unique_ptr<hamming::GpuCodec> gpuCodec;
+    if(gpu){
+        gpuCodec.reset(new hamming::GpuCodec());
+        if(!gpuCodec->ready()){
+            fprintf(stderr, "No GPU could be used, converting on the CPU!\n");
         }
+        options.gpu = gpuCodec.get();
     }
-    std::reverse(bytesArray.begin(), bytesArray.end());
-    return bytesArray;
-}
-
-/**
-    @brief Apply hamming parity to file.
-
-    @param std::vector<bool> boolBitsArray: File Bits.
-    @return std::vector<bool>: File Bits with hamming par.
-*/
-std::vector<bool> addHammingParity(std::vector<bool> boolBitsArray){
 
-    int bit4Count=0;
-    std::vector<bool> xorParity;
-    int e;
-    int f;
-    std::vector<bool> bit4Array;
-    std::vector<bool> hammingBits;
+    if(batchSource != NULL){
 
-    /**
-        The array is read back-to-back to free up memory using the resize and 
-        swap operations.
-    */
-    int boolBitsArrayCount = boolBitsArray.size() - 1;
-    for( ; boolBitsArrayCount > -1; boolBitsArrayCount--){
-        if(bit4Count < 4){
-            bit4Array.push_back(boolBitsArray[boolBitsArrayCount]);
-            bit4Count++;
+        // The list of files can come from the standard input, given as "-".
+        std::vector<hamming::BatchFile> files;
+        if(!hamming::listBatch(batchSource, flNameFrom, &files)){
+            fprintf(stderr, "Could not list the files of \"%s\" for \"%s\": %s\n",
+                    batchSource, flNameFrom, strerror(errno));
+            return 1;
         }
-        if(bit4Count == 4){
-            xorParity.clear();
-
-            /**
-                [Ref.: http://www.cplusplus.com/reference/vector/vector/resize/]
-                Reduces the size of the vector to free up memory.
-            */
-            boolBitsArray.resize(boolBitsArrayCount + 1);
-
-            /**
-                [Ref.: http://stackoverflow.com/questions/16173887/how-to-reduce-the-size-of-vector-when-removing-elements-from-it]
-                [Ref.: http://stackoverflow.com/questions/1111078/reduce-the-capacity-of-an-stl-vector]
-                Ensures that the allocated vector space will also be reduced.
-            */
-            std::vector<bool>(boolBitsArray).swap(boolBitsArray);
-
-            // Replace in the correct default order.
-            std::reverse(bit4Array.begin(), bit4Array.end());
-
-            for(int z = 0; z < 4; z++){
-                if(bit4Array[z] == 1){
-                    /**
-                        Verifies what are the odd bits (1) and their positions 
-                        in the hamming logic (7~1) and stored in an array 3 to 
-                        3.
-                    */
-                    switch(z){
-                        case 0:
-                            f=7;
-                            break;
-                        case 1:
-                            f=6;
-                            break;
-                        case 2:
-                            f=5;
-                            break;
-                        case 3:
-                            f=3;
-                            break;
-                    }
-                    for(int w = 2; w >= 0; w--){
-                        e = ((f >> w) & 1);
-                        xorParity.push_back(e);
-                    }
-                }
+        fprintf(stdout, "%s", "> ---------------------------------------------\n");
+        fprintf(stdout, "Converting %u files to hamming format!\n", (unsigned)files.size());
+        fflush(stdout);
+        size_t failed = hamming::convertBatch(&files, applyHamming, options);
+        for(size_t z = 0; z < files.size(); z++){
+            if(!files[z].ok){
+                fprintf(stderr, "Could not convert \"%s\" to \"%s\": %s\n",
+                        files[z].from.c_str(), files[z].to.c_str(), strerror(files[z].error));
             }
-
-            /**
-                Computes the parity bits by taking the array as groups of 3 
-                and accessing the "indexes" 0, 1, and 2 of each of these groups 
-                of three in that order by running an XOR between them.
-            */
-            bool parityBits[3]={0, 0, 0};
-            if(xorParity.size() > 0){
-                int octalBitPos;
-                int xorNumCount;
-                for(int octalBitGroupPos=0; octalBitGroupPos < 3; octalBitGroupPos++){
-                    xorNumCount=0;
-                    octalBitPos=octalBitGroupPos;
-                    for(int xorBitsCount=0; xorBitsCount < (xorParity.size()/3); xorBitsCount++){
-                        if(xorParity[octalBitPos] == 1){
-                            xorNumCount++;
-                        }
-                        octalBitPos=octalBitPos+3;
-                    }
-                    if(xorNumCount%2 == 0){
-                        parityBits[octalBitGroupPos]=0; // even
-                    }else{
-                        parityBits[octalBitGroupPos]=1; // odd
-                    }
-                }
-            }
-
-            // Assemble a group of 7 bits (4 data and 3 parity).
-            bool hamming7Bits[7]={0, 0, 0, 0, 0, 0, 0};
-
-            /**
-                We insert in reverse order because the file array is read 
-                backwards!
-            */
-            hamming7Bits[6] = bit4Array[0];  // D7
-            hamming7Bits[5] = bit4Array[1];  // D6
-            hamming7Bits[4] = bit4Array[2];  // D5
-            hamming7Bits[3] = parityBits[0]; // P4
-            hamming7Bits[2] = bit4Array[3];  // D3
-            hamming7Bits[1] = parityBits[1]; // P2
-            hamming7Bits[0] = parityBits[2]; // P1
-
-            hammingBits.insert(hammingBits.end(), &hamming7Bits[0], &hamming7Bits[7]);
-            bit4Count=0;
-            bit4Array.clear();
         }
+        fprintf(stdout, "%u files converted, %u failed.\n", (unsigned)(files.size() - failed),
+                (unsigned)failed);
+        if(options.profile != NULL){
+            hamming::printProfile(stdout, profile);
+        }
+        fprintf(stdout, "%s", "\n< ---------------------------------------------\n");
+        fflush(stdout);
+        return failed > 0 ? 1 : 0;
     }
 
-    // Put in the right order.
-    std::reverse(hammingBits.begin(), hammingBits.end());
-    return hammingBits;
-}
-
-/**
-    @brief Control and apply the hamming method.
-
-    @param char* flNameFrom: File to apply the hamming method.
-    @param char* flNameTo: Name the file to save after applying the hamming 
-        method.
-    @return void.
-*/
-void applyHamming(const char* flNameFrom, const char* flNameTo){
-
-    /**
-        The functions have been placed one inside the others so that the 
-        memory is released immediately after the return of the operation. 
-        Before we were duplicating the values (in memory) several times 
-        because we were hosting them in variables unnecessarily!
-    */
-    writeFileBytes(flNameTo, 
-                        bitsToBytes(
-                            addHammingParity(
-                                bytesToBits(
-                                    readFileBytes(flNameFrom)
-                                )
-                            )
-                        , 1)
-                   );
-}
-
-int main(int argc, char *argv[]){
-
-    const char* flNameFrom = argv[1];
-    const char* flNameTo = argv[2];
-
-    printf("%s", "> ---------------------------------------------\n");
-    printf("Converting to hamming format!\n");
-    printf("%s", "\n< ---------------------------------------------\n");
-    applyHamming(flNameFrom, flNameTo);
+    // The messages go to the standard error when the standard output is the
+    // file being written.
+    FILE* messages = hamming::isStdio(flNameTo) ? stderr : stdout;
+    fprintf(messages, "%s", "> ---------------------------------------------\n");
+    fprintf(messages, "Converting to hamming format!\n");
+    fprintf(messages, "%s", "\n< ---------------------------------------------\n");
+    fflush(messages);
+    if(!applyHamming(flNameFrom, flNameTo, options)){
+        fprintf(stderr, "Could not convert \"%s\" to \"%s\": %s\n",
+                flNameFrom, flNameTo, strerror(errno));
+        return 1;
+    }
+    if(options.profile != NULL){
+        hamming::printProfile(messages, profile);
+    }
 
     return 0;
 }
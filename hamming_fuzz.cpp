@@ -0,0 +1,959 @@
+/**
+    @file    hamming_fuzz.cpp
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Checks every fast path of the hamming method against the original
+        functions.
+
+    @section DESCRIPTION
+
+    Each round takes a random buffer and runs it through everything that
+    encodes or decodes it: each kernel the CPU supports, the threads of the
+    pool, the GPU (with "--gpu"), the buffer split at random block
+    boundaries, "decodeRange", "scrubHamming" and the interleaving, and now
+    and then the files through each way of reading them. All of them must
+    give exactly the bytes and counters of the reference: the original
+    "std::vector<bool>" functions for (7,4) (only up to "--legacy-max", as
+    they are quadratic), and the bitwise kernel, checked against them, for
+    the larger buffers and the other codes. The bytes are checked clean,
+    with one inverted bit in some groups (all of them corrected), with two in
+    each group (all of them detected by the SECDED codes) and with errors at
+    a random rate. A failure prints the seed of its round, which
+    "--seed <seed> --rounds 1" runs again.
+
+    Built with "-DHAMMING_LIBFUZZER", the same checks are run by libFuzzer
+    over the buffers it makes (see "hamming_fuzzer" in the Makefile). With
+    "--bench" it measures instead how much faster than the original
+    functions each of them is, and fails if any is slower than
+    "--min-speedup" times.
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32) || defined(__CYGWIN__)
+#include <unistd.h>
+#define HAMMING_MKSTEMP 1
+#endif
+
+#include "hamming.h"
+#include "hamming_gpu.h"
+#include "hamming_io.h"
+#include "hamming_legacy.h"
+#include "hamming_pool.h"
+
+namespace {
+
+/**
+    @brief Options of the checks.
+*/
+struct FuzzOptions {
+    uint64_t seed;      /**< Seed of the first round. */
+    unsigned rounds;    /**< Rounds checked. */
+    double seconds;     /**< Rounds are checked until this time passes
+                             instead (0 - "rounds"). */
+    size_t maxBytes;    /**< Largest buffer. */
+    size_t legacyMax;   /**< Largest buffer for the legacy functions. */
+    unsigned threads;   /**< Threads of the pool (0 - one for each CPU). */
+    bool files;         /**< Also check the files now and then. */
+    bool gpu;           /**< Also check the GPU, when there is one. */
+    bool bench;         /**< Measure the speed instead. */
+    double minSpeedup;  /**< Slowest speed allowed with "bench", in times the
+                             speed of the legacy functions. */
+    double benchSeconds; /**< Shortest time of each measurement. */
+
+    FuzzOptions() : seed(0),
+                    rounds(200),
+                    seconds(0),
+                    maxBytes(256 * 1024),
+                    legacyMax(4 * 1024),
+                    threads(3),
+                    files(true),
+                    gpu(false),
+                    bench(false),
+                    minSpeedup(1),
+                    benchSeconds(0.2){}
+};
+
+/**
+    @brief Random numbers that only depend on the seed (SplitMix64), so a
+        round is the same on every platform.
+*/
+class Random {
+public:
+    explicit Random(uint64_t seed) : state(seed){}
+
+    /**
+        @brief Next number.
+
+        @return uint64_t: Any 64-bit number.
+    */
+    uint64_t next(){
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    /**
+        @brief Next number below a limit.
+
+        @param uint64_t limit: Limit (0 gives 0).
+        @return uint64_t: A number from 0 to "limit - 1".
+    */
+    uint64_t below(uint64_t limit){
+        return (limit == 0) ? 0 : (next() % limit);
+    }
+
+private:
+    uint64_t state;
+};
+
+/**
+    @brief Where the checks run and what they found.
+*/
+struct Harness {
+    std::vector<hamming::Kernel> kernels; /**< Kernels the CPU supports. */
+    hamming::ThreadPool* pool;            /**< Threads of the pool. */
+    hamming::GpuCodec* gpu;               /**< Device (NULL - none). */
+    size_t legacyMax;                     /**< Largest buffer for the legacy
+                                               functions. */
+    uint64_t seed;                        /**< Seed of the current round. */
+    uint64_t checks;                      /**< Checks made. */
+    uint64_t failures;                    /**< Checks that failed. */
+
+    Harness() : pool(NULL), gpu(NULL), legacyMax(0), seed(0), checks(0), failures(0){}
+};
+
+const hamming::Code CODES[] = {hamming::CODE_7_4, hamming::CODE_8_4, hamming::CODE_15_11,
+                               hamming::CODE_31_26, hamming::CODE_63_57, hamming::CODE_72_64,
+                               hamming::CODE_7_4_SLICED};
+const size_t CODE_COUNT = sizeof(CODES) / sizeof(CODES[0]);
+
+/**
+    @brief Count a check and print it when it failed.
+
+    @param Harness& harness: Checks made.
+    @param bool ok: Whether it passed.
+    @param const char* format: What was checked ("printf" format), followed by
+        its arguments.
+    @return bool: "ok".
+*/
+bool expect(Harness& harness, bool ok, const char* format, ...){
+    harness.checks++;
+    if(!ok){
+        harness.failures++;
+        fprintf(stderr, "FAILED (seed %llu): ", (unsigned long long)harness.seed);
+        va_list arguments;
+        va_start(arguments, format);
+        vfprintf(stderr, format, arguments);
+        va_end(arguments);
+        fprintf(stderr, "\n");
+    }
+    return ok;
+}
+
+/**
+    @brief Whether two decodings counted the same groups.
+
+    @param hamming::DecodeStats& a: Counters of one decoding.
+    @param hamming::DecodeStats& b: Counters of the other one.
+    @return bool: true if all the counters are equal.
+*/
+bool sameStats(const hamming::DecodeStats& a, const hamming::DecodeStats& b){
+    return (a.groups == b.groups) && (a.corrected == b.corrected) && (a.detected == b.detected);
+}
+
+/**
+    @brief Random cuts of a buffer at the boundaries of its blocks.
+
+    @param size_t blocks: Blocks of the buffer (the last one can be partial).
+    @param Random& random: Source of the cuts.
+    @return std::vector<size_t>: Block of each cut, from 0 to "blocks",
+        increasing (some pieces can be empty).
+*/
+std::vector<size_t> blockCuts(size_t blocks, Random& random){
+    std::vector<size_t> cuts(1, 0);
+    size_t pieces = 1 + (size_t)random.below(5);
+    for(size_t z = 1; z < pieces; z++){
+        size_t cut = cuts.back() + (size_t)random.below(blocks - cuts.back() + 1);
+        cuts.push_back(cut);
+    }
+    cuts.push_back(blocks);
+    return cuts;
+}
+
+/**
+    @brief Check the encoding of a buffer by every way of encoding it.
+
+    @param Harness& harness: Where the checks run.
+    @param std::vector<uint8_t>& bytes: Original bytes.
+    @param hamming::Code code: Code of the hamming format.
+    @param Random& random: Source of the cuts.
+    @return std::vector<uint8_t>: The bytes in the hamming format, as the
+        bitwise kernel gives them.
+*/
+std::vector<uint8_t> checkEncode(Harness& harness, const std::vector<uint8_t>& bytes,
+                                 hamming::Code code, Random& random){
+    const char* name = hamming::codeName(code);
+    const size_t n = bytes.size();
+    std::vector<uint8_t> reference(hamming::encodedSize(n, code));
+    hamming::setKernel(hamming::KERNEL_BITWISE);
+    hamming::encode(bytes, reference, code);
+
+    if((code == hamming::CODE_7_4) && (n <= harness.legacyMax)){
+        std::vector<uint8_t> legacyBytes = legacy::bitsToBytes(
+            legacy::addHammingParity(legacy::bytesToBits(bytes)), 1);
+        expect(harness, legacyBytes == reference, "encode %s of %zu bytes: bitwise != legacy",
+               name, n);
+    }
+
+    std::vector<uint8_t> output(reference.size());
+    for(size_t z = 0; z < harness.kernels.size(); z++){
+        hamming::setKernel(harness.kernels[z]);
+        std::fill(output.begin(), output.end(), 0x5A);
+        hamming::encode(bytes, output, code);
+        expect(harness, output == reference, "encode %s of %zu bytes: %s != bitwise", name, n,
+               hamming::kernelName(harness.kernels[z]));
+    }
+    hamming::setKernel(hamming::KERNEL_AUTO);
+
+    std::fill(output.begin(), output.end(), 0x5A);
+    hamming::encode(bytes, output, code, *harness.pool);
+    expect(harness, output == reference, "encode %s of %zu bytes: %u threads != bitwise", name,
+           n, harness.pool->size());
+
+    if((harness.gpu != NULL) && harness.gpu->takes(n, code)){
+        std::fill(output.begin(), output.end(), 0x5A);
+        harness.gpu->encode(bytes.data(), n, output.data(), code);
+        expect(harness, output == reference, "encode %s of %zu bytes: GPU != bitwise", name, n);
+    }
+
+    // Each piece encoded on its own lands where it is in the whole buffer.
+    hamming::CodeBlocks blocks = hamming::codeBlocks(code);
+    std::vector<size_t> cuts = blockCuts((n + blocks.bytes - 1) / blocks.bytes, random);
+    std::fill(output.begin(), output.end(), 0x5A);
+    for(size_t z = 0; (z + 1) < cuts.size(); z++){
+        size_t from = cuts[z] * blocks.bytes;
+        size_t to = std::min(n, cuts[z + 1] * blocks.bytes);
+        if(from >= to){
+            continue;
+        }
+        size_t written = hamming::encode(
+            hamming::Span<const uint8_t>(bytes.data() + from, to - from),
+            hamming::Span<uint8_t>(output.data() + cuts[z] * blocks.hammingBytes,
+                                   output.size() - cuts[z] * blocks.hammingBytes), code);
+        expect(harness, written == hamming::encodedSize(to - from, code),
+               "encode %s of %zu bytes: piece %zu~%zu wrote %zu bytes", name, n, from, to,
+               written);
+    }
+    expect(harness, output == reference, "encode %s of %zu bytes: %zu pieces != whole", name, n,
+           cuts.size() - 1);
+    return reference;
+}
+
+/**
+    @brief Check the decoding of bytes in the hamming format by every way of
+        decoding them.
+
+    @param Harness& harness: Where the checks run.
+    @param std::vector<uint8_t>& hammingBytes: Bytes in the hamming format.
+    @param hamming::Code code: Code of the hamming format.
+    @param const char* errors: What errors the bytes have (for the messages).
+    @param Random& random: Source of the cuts and ranges.
+    @param hamming::DecodeStats* stats: Receives the counters of the
+        bitwise kernel.
+    @return std::vector<uint8_t>: The bytes decoded by the bitwise kernel.
+*/
+std::vector<uint8_t> checkDecode(Harness& harness, const std::vector<uint8_t>& hammingBytes,
+                                 hamming::Code code, const char* errors, Random& random,
+                                 hamming::DecodeStats* stats){
+    const char* name = hamming::codeName(code);
+    const size_t n = hammingBytes.size();
+    std::vector<uint8_t> reference(hamming::decodedSize(n, code));
+    hamming::DecodeStats referenceStats;
+    hamming::setKernel(hamming::KERNEL_BITWISE);
+    hamming::decode(hammingBytes, reference, code, &referenceStats);
+    *stats = referenceStats;
+
+    if((code == hamming::CODE_7_4) && (reference.size() <= harness.legacyMax)){
+        std::vector<uint8_t> legacyBytes = legacy::bitsToBytes(
+            legacy::removeHammingParity(legacy::bytesToBits(hammingBytes)));
+        expect(harness, legacyBytes == reference, "decode %s %s of %zu bytes: bitwise != legacy",
+               name, errors, n);
+    }
+
+    std::vector<uint8_t> output(reference.size());
+    hamming::DecodeStats outputStats;
+    for(size_t z = 0; z < harness.kernels.size(); z++){
+        hamming::setKernel(harness.kernels[z]);
+        std::fill(output.begin(), output.end(), 0x5A);
+        outputStats = hamming::DecodeStats();
+        hamming::decode(hammingBytes, output, code, &outputStats);
+        expect(harness, (output == reference) && sameStats(outputStats, referenceStats),
+               "decode %s %s of %zu bytes: %s != bitwise", name, errors, n,
+               hamming::kernelName(harness.kernels[z]));
+    }
+    hamming::setKernel(hamming::KERNEL_AUTO);
+
+    std::fill(output.begin(), output.end(), 0x5A);
+    outputStats = hamming::DecodeStats();
+    hamming::decode(hammingBytes, output, code, *harness.pool, &outputStats);
+    expect(harness, (output == reference) && sameStats(outputStats, referenceStats),
+           "decode %s %s of %zu bytes: %u threads != bitwise", name, errors, n,
+           harness.pool->size());
+
+    if((harness.gpu != NULL) && harness.gpu->takes(n, code)){
+        std::fill(output.begin(), output.end(), 0x5A);
+        outputStats = hamming::DecodeStats();
+        harness.gpu->decode(hammingBytes.data(), n, output.data(), code, &outputStats);
+        expect(harness, (output == reference) && sameStats(outputStats, referenceStats),
+               "decode %s %s of %zu bytes: GPU != bitwise", name, errors, n);
+    }
+
+    // Each piece decoded on its own, the counters added.
+    hamming::CodeBlocks blocks = hamming::codeBlocks(code);
+    std::vector<size_t> cuts = blockCuts((n + blocks.hammingBytes - 1) / blocks.hammingBytes,
+                                         random);
+    std::fill(output.begin(), output.end(), 0x5A);
+    outputStats = hamming::DecodeStats();
+    for(size_t z = 0; (z + 1) < cuts.size(); z++){
+        size_t from = cuts[z] * blocks.hammingBytes;
+        size_t to = std::min(n, cuts[z + 1] * blocks.hammingBytes);
+        if(from >= to){
+            continue;
+        }
+        hamming::decode(hamming::Span<const uint8_t>(hammingBytes.data() + from, to - from),
+                        hamming::Span<uint8_t>(output.data() + cuts[z] * blocks.bytes,
+                                               output.size() - cuts[z] * blocks.bytes),
+                        code, &outputStats);
+    }
+    expect(harness, (output == reference) && sameStats(outputStats, referenceStats),
+           "decode %s %s of %zu bytes: %zu pieces != whole", name, errors, n, cuts.size() - 1);
+
+    // A range, which can go past the end.
+    size_t offset = (size_t)random.below(reference.size() + 2);
+    std::vector<uint8_t> range((size_t)random.below(reference.size() + 3));
+    size_t expected = (offset < reference.size()) ?
+        std::min(range.size(), reference.size() - offset) : 0;
+    size_t got = hamming::decodeRange(hammingBytes, offset, range, code);
+    expect(harness, (got == expected) && ((got == 0) ||
+           std::equal(range.begin(), range.begin() + got, reference.begin() + offset)),
+           "decodeRange %s %s of %zu bytes: %zu bytes from %zu", name, errors, n, range.size(),
+           offset);
+    return reference;
+}
+
+/**
+    @brief Bits of the hamming format that belong to a group: all of them but
+        the padding of the last byte, and after a shortened last group.
+
+    @param size_t bytesCount: Number of original bytes.
+    @param hamming::Code code: Code of the hamming format.
+    @return uint64_t: Number of bits from the start.
+*/
+uint64_t groupedBits(size_t bytesCount, hamming::Code code){
+    hamming::CodeBlocks blocks = hamming::codeBlocks(code);
+    uint64_t dataBits = (uint64_t)bytesCount * 8;
+    if((code == hamming::CODE_7_4) || (code == hamming::CODE_7_4_SLICED) ||
+       (code == hamming::CODE_8_4)){
+        return dataBits / 4 * blocks.groupBits;
+    }
+    uint64_t groupData = blocks.bytes * blocks.groupBits / blocks.hammingBytes;
+    uint64_t rest = dataBits % groupData;
+    return dataBits / groupData * blocks.groupBits +
+           ((rest > 0) ? rest + blocks.groupBits - groupData : 0);
+}
+
+/**
+    @brief Check a buffer with one code: encoded, then decoded clean and with
+        each kind of errors.
+
+    @param Harness& harness: Where the checks run.
+    @param std::vector<uint8_t>& bytes: Original bytes.
+    @param hamming::Code code: Code of the hamming format.
+    @param Random& random: Source of the errors, cuts and ranges.
+    @return void.
+*/
+void checkBuffer(Harness& harness, const std::vector<uint8_t>& bytes, hamming::Code code,
+                 Random& random){
+    const char* name = hamming::codeName(code);
+    const size_t n = bytes.size();
+    std::vector<uint8_t> encoded = checkEncode(harness, bytes, code, random);
+    hamming::DecodeStats stats;
+    std::vector<uint8_t> decoded = checkDecode(harness, encoded, code, "clean", random, &stats);
+    expect(harness, (decoded == bytes) && (stats.corrected == 0) && (stats.detected == 0),
+           "decode %s clean of %zu bytes: not the original", name, n);
+    uint64_t groups = stats.groups;
+
+    hamming::ErrorModel model;
+    model.groupBits = hamming::codeBlocks(code).groupBits;
+    model.sliced = (code == hamming::CODE_7_4_SLICED);
+
+    // One inverted bit in some groups: all of them corrected. The bits after
+    // a shortened last group, which "hammingError" can also invert, belong
+    // to no group and are left as they are.
+    std::vector<uint8_t> damaged = encoded;
+    std::vector<uint64_t> flips;
+    uint64_t seed = random.next();
+    hamming::hammingError(damaged.data(), damaged.size(), model, seed);
+    hamming::errorFlips(damaged.size(), model, seed, 0, &flips);
+    uint64_t bits = groupedBits(n, code);
+    uint64_t singles = 0;
+    for(size_t z = 0; z < flips.size(); z++){
+        singles += (flips[z] < bits);
+    }
+    decoded = checkDecode(harness, damaged, code, "single", random, &stats);
+    expect(harness, (decoded == bytes) && (stats.groups == groups) &&
+           (stats.corrected == singles) && (stats.detected == 0),
+           "decode %s single of %zu bytes: %llu of %llu groups corrected", name, n,
+           (unsigned long long)stats.corrected, (unsigned long long)singles);
+
+    std::vector<uint8_t> scrubbed = damaged;
+    hamming::DecodeStats scrubStats;
+    hamming::scrubHamming(scrubbed.data(), scrubbed.size(), code, &scrubStats);
+    for(uint64_t bit = bits; bit < ((uint64_t)scrubbed.size() * 8); bit++){
+        uint8_t mask = (uint8_t)(0x80 >> (bit % 8));
+        scrubbed[bit / 8] = (uint8_t)((scrubbed[bit / 8] & ~mask) | (encoded[bit / 8] & mask));
+    }
+    expect(harness, (scrubbed == encoded) && (scrubStats.corrected == singles),
+           "scrub %s single of %zu bytes: not as encoded", name, n);
+
+    // Two inverted bits in each group: all of them detected by SECDED (the
+    // two bits of a group are next to each other in "flips").
+    damaged = encoded;
+    flips.clear();
+    model.kind = hamming::ERRORS_EXACT;
+    model.flips = 2;
+    seed = random.next();
+    hamming::hammingError(damaged.data(), damaged.size(), model, seed);
+    hamming::errorFlips(damaged.size(), model, seed, 0, &flips);
+    checkDecode(harness, damaged, code, "double", random, &stats);
+    if((code == hamming::CODE_8_4) || (code == hamming::CODE_72_64)){
+        uint64_t doubles = 0;
+        singles = 0;
+        for(size_t z = 0; (z + 1) < flips.size(); z += 2){
+            unsigned inside = (flips[z] < bits) + (flips[z + 1] < bits);
+            doubles += (inside == 2);
+            singles += (inside == 1);
+        }
+        expect(harness, (stats.detected == doubles) && (stats.corrected == singles),
+               "decode %s double of %zu bytes: %llu of %llu groups detected", name, n,
+               (unsigned long long)stats.detected, (unsigned long long)doubles);
+    }
+
+    // Errors at a random rate: groups with any number of them.
+    damaged = encoded;
+    model.kind = hamming::ERRORS_RATE;
+    model.rate = 1.0 / (double)(1 + random.below(200));
+    hamming::hammingError(damaged.data(), damaged.size(), model, random.next());
+    checkDecode(harness, damaged, code, "rate", random, &stats);
+
+    // Interleaved, a burst of "depth" bits over whole frames is corrected.
+    unsigned depth = 8 * (1 + (unsigned)random.below(hamming::MAX_INTERLEAVE_DEPTH / 8));
+    if(hamming::validInterleave(code, depth)){
+        size_t frameBytes = depth * model.groupBits / 8;
+        size_t frames = encoded.size() / frameBytes;
+        damaged = encoded;
+        expect(harness, hamming::interleave(damaged.data(), damaged.size(), code, depth),
+               "interleave %s of %zu bytes: depth %u refused", name, n, depth);
+        std::vector<uint8_t> fused(encoded.size());
+        hamming::addInterleavedParity(bytes.data(), bytes.size(), fused.data(), code, depth);
+        expect(harness, fused == damaged,
+               "interleave %s of %zu bytes: encoded in one pass at depth %u differs", name, n,
+               depth);
+        if(frames > 0){
+            uint64_t frameBits = (uint64_t)frames * frameBytes * 8;
+            uint64_t length = 1 + random.below(depth);
+            uint64_t start = random.below(frameBits - length + 1);
+            for(uint64_t bit = start; bit < (start + length); bit++){
+                damaged[bit / 8] ^= (uint8_t)(0x80 >> (bit % 8));
+            }
+        }
+        hamming::deinterleave(damaged.data(), damaged.size(), code, depth);
+        std::vector<uint8_t> burstDecoded(bytes.size());
+        hamming::decode(damaged, burstDecoded, code);
+        expect(harness, burstDecoded == bytes,
+               "interleave %s of %zu bytes: burst over depth %u not corrected", name, n, depth);
+    }
+}
+
+/**
+    @brief Find the kernels the CPU supports.
+
+    @param Harness& harness: Receives them.
+    @return void.
+*/
+void findKernels(Harness& harness){
+    const hamming::Kernel kernels[] = {hamming::KERNEL_BITWISE, hamming::KERNEL_TABLE,
+                                       hamming::KERNEL_SSSE3, hamming::KERNEL_AVX2,
+                                       hamming::KERNEL_NEON};
+    for(size_t z = 0; z < (sizeof(kernels) / sizeof(kernels[0])); z++){
+        if(hamming::setKernel(kernels[z])){
+            harness.kernels.push_back(kernels[z]);
+        }
+    }
+    hamming::setKernel(hamming::KERNEL_AUTO);
+}
+
+#ifndef HAMMING_LIBFUZZER
+
+/**
+    @brief Size of a random buffer: often a few bytes or around the blocks of
+        the codes, the others up to the largest one.
+
+    @param Random& random: Source of the size.
+    @param size_t maxBytes: Largest buffer.
+    @return size_t: Size of the buffer.
+*/
+size_t randomSize(Random& random, size_t maxBytes){
+    switch(random.below(4)){
+        case 0:
+            return (size_t)random.below(std::min(maxBytes, (size_t)300) + 1);
+        case 1: {
+
+            // A few bytes from a multiple of a slab (128 bytes).
+            size_t size = 128 * (1 + (size_t)random.below(64)) + (size_t)random.below(16);
+            return std::min(size - 8, maxBytes);
+        }
+        default: {
+            unsigned bits = 1 + (unsigned)random.below(24);
+            size_t size = (size_t)(random.next() & ((1ULL << bits) - 1));
+            return size % (maxBytes + 1);
+        }
+    }
+}
+
+/**
+    @brief Bytes with random contents, now and then all zeros or all ones.
+
+    @param size_t bytesCount: Number of bytes.
+    @param Random& random: Source of the contents.
+    @return std::vector<uint8_t>: The bytes.
+*/
+std::vector<uint8_t> randomBytes(size_t bytesCount, Random& random){
+    std::vector<uint8_t> bytes(bytesCount);
+    switch(random.below(8)){
+        case 0:
+            break;
+        case 1:
+            std::fill(bytes.begin(), bytes.end(), 0xFF);
+            break;
+        default:
+            for(size_t z = 0; z < bytesCount; z++){
+                bytes[z] = (uint8_t)random.next();
+            }
+    }
+    return bytes;
+}
+
+#if HAMMING_MKSTEMP
+
+/**
+    @brief Write bytes to a new temporary file.
+
+    @param std::vector<uint8_t>& bytes: Contents of the file.
+    @return std::string: Name of the file ("" - it could not be written).
+*/
+std::string writeTemporary(const std::vector<uint8_t>& bytes){
+    const char* directory = getenv("TMPDIR");
+    std::string flName = std::string((directory != NULL) ? directory : "/tmp") +
+                         "/hamming_fuzz.XXXXXX";
+    std::vector<char> name(flName.begin(), flName.end());
+    name.push_back('\0');
+    int fd = mkstemp(name.data());
+    if(fd < 0){
+        return "";
+    }
+    size_t written = 0;
+    while(written < bytes.size()){
+        ssize_t count = write(fd, bytes.data() + written, bytes.size() - written);
+        if(count <= 0){
+            close(fd);
+            unlink(name.data());
+            return "";
+        }
+        written += (size_t)count;
+    }
+    close(fd);
+    return name.data();
+}
+
+/**
+    @brief Read a whole file.
+
+    @param std::string& flName: Name of the file.
+    @return std::vector<uint8_t>: Its contents.
+*/
+std::vector<uint8_t> readFile(const std::string& flName){
+    std::vector<uint8_t> bytes;
+    FILE* file = fopen(flName.c_str(), "rb");
+    if(file == NULL){
+        return bytes;
+    }
+    uint8_t buffer[65536];
+    size_t count;
+    while((count = fread(buffer, 1, sizeof(buffer), file)) > 0){
+        bytes.insert(bytes.end(), buffer, buffer + count);
+    }
+    fclose(file);
+    return bytes;
+}
+
+/**
+    @brief Check the files around the boundaries of their chunks, through a
+        random way of reading them, against the buffers in memory.
+
+    @param Harness& harness: Where the checks run.
+    @param Random& random: Source of the file and the options.
+    @return void.
+*/
+void checkFiles(Harness& harness, Random& random){
+    const hamming::IoMode modes[] = {hamming::IO_STREAM, hamming::IO_MMAP, hamming::IO_URING};
+    const char* modeNames[] = {"stream", "mmap", "uring"};
+    hamming::FileOptions options;
+    size_t mode = (size_t)random.below(3);
+    options.ioMode = modes[mode];
+    options.code = CODES[random.below(CODE_COUNT)];
+    options.threads = 1 + (unsigned)random.below(4);
+    options.container = (random.below(3) == 0);
+    options.checksums = options.container && (random.below(2) == 0);
+    options.fastVerify = options.checksums;
+
+    // Around a multiple of the chunks of all the threads.
+    size_t chunks = (size_t)random.below(3) * options.threads;
+    size_t size = chunks * hamming::CHUNK_BYTES + (size_t)random.below(4) * 4;
+    size = (size > 7) ? size - 7 + (size_t)random.below(15) : size;
+    std::vector<uint8_t> bytes = randomBytes(size, random);
+    const char* name = hamming::codeName(options.code);
+
+    std::vector<uint8_t> encoded(hamming::encodedSize(size, options.code));
+    hamming::encode(bytes, encoded, options.code);
+    hamming::ErrorModel model;
+    model.groupBits = hamming::codeBlocks(options.code).groupBits;
+    model.sliced = (options.code == hamming::CODE_7_4_SLICED);
+
+    std::string original = writeTemporary(bytes);
+    std::string hammingName = writeTemporary(std::vector<uint8_t>());
+    std::string recovered = writeTemporary(std::vector<uint8_t>());
+    if(expect(harness, !original.empty() && !hammingName.empty() && !recovered.empty(),
+              "files: temporary files not written")){
+        bool ok = hamming::encodeFile(original.c_str(), hammingName.c_str(), options);
+        if(expect(harness, ok, "encodeFile %s %s of %zu bytes (%u threads) failed", name,
+                  modeNames[mode], size, options.threads) && !options.container){
+            expect(harness, readFile(hammingName) == encoded,
+                   "encodeFile %s %s of %zu bytes (%u threads) != encode", name,
+                   modeNames[mode], size, options.threads);
+
+            // The file decoded with errors, which are corrected.
+            std::vector<uint8_t> damaged = encoded;
+            hamming::hammingError(damaged.data(), damaged.size(), model, random.next());
+            unlink(hammingName.c_str());
+            hammingName = writeTemporary(damaged);
+        }
+        ok = !hammingName.empty() &&
+             hamming::decodeFile(hammingName.c_str(), recovered.c_str(), options);
+        expect(harness, ok && (readFile(recovered) == bytes),
+               "decodeFile %s %s of %zu bytes (%u threads%s) not the original", name,
+               modeNames[mode], size, options.threads, options.container ? ", container" : "");
+    }
+    const std::string* names[] = {&original, &hammingName, &recovered};
+    for(size_t z = 0; z < 3; z++){
+        if(!names[z]->empty()){
+            unlink(names[z]->c_str());
+        }
+    }
+}
+
+#endif
+
+/**
+    @brief Check one round: a random buffer with every code, and the files
+        now and then.
+
+    @param Harness& harness: Where the checks run.
+    @param FuzzOptions& options: Options of the checks.
+    @return void.
+*/
+void checkRound(Harness& harness, const FuzzOptions& options){
+    Random random(harness.seed);
+    std::vector<uint8_t> bytes = randomBytes(randomSize(random, options.maxBytes), random);
+    for(size_t z = 0; z < CODE_COUNT; z++){
+        checkBuffer(harness, bytes, CODES[z], random);
+    }
+#if HAMMING_MKSTEMP
+    if(options.files && (random.below(8) == 0)){
+        checkFiles(harness, random);
+    }
+#endif
+}
+
+/**
+    @brief Run an operation until it takes at least "minSeconds".
+
+    @param double minSeconds: Shortest time to measure.
+    @param size_t bytesCount: Original bytes handled on each run.
+    @param std::function<void()>& run: The operation.
+    @return double: MB/s of the original bytes.
+*/
+double measure(double minSeconds, size_t bytesCount, const std::function<void()>& run){
+    typedef std::chrono::steady_clock Clock;
+    size_t runs = 0;
+    double seconds = 0;
+    Clock::time_point start = Clock::now();
+    do{
+        run();
+        runs++;
+        seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    }while(seconds < minSeconds);
+    return (double)bytesCount * runs / seconds / 1e6;
+}
+
+/**
+    @brief Measure every way of encoding and decoding against the legacy
+        functions.
+
+    @param Harness& harness: Where it runs.
+    @param FuzzOptions& options: Options of the measurements.
+    @return bool: false if any of them was slower than "minSpeedup" times
+        the legacy functions.
+*/
+bool benchAll(Harness& harness, const FuzzOptions& options){
+    Random random(options.seed);
+    std::vector<uint8_t> small = randomBytes(options.legacyMax, random);
+    std::vector<uint8_t> smallEncoded = legacy::bitsToBytes(
+        legacy::addHammingParity(legacy::bytesToBits(small)), 1);
+    double legacyEncode = measure(options.benchSeconds, small.size(), [&](){
+        legacy::bitsToBytes(legacy::addHammingParity(legacy::bytesToBits(small)), 1);
+    });
+    double legacyDecode = measure(options.benchSeconds, small.size(), [&](){
+        legacy::bitsToBytes(legacy::removeHammingParity(legacy::bytesToBits(smallEncoded)));
+    });
+    printf("%-24s %10s %10s %10s %10s\n", "engine", "apply MB/s", "x legacy", "recover MB/s",
+           "x legacy");
+    printf("%-24s %10.1f %10s %10.1f %10s\n", "legacy", legacyEncode, "1.0", legacyDecode,
+           "1.0");
+
+    bool ok = true;
+    std::vector<uint8_t> bytes = randomBytes(options.maxBytes, random);
+    for(size_t c = 0; c < CODE_COUNT; c++){
+        hamming::Code code = CODES[c];
+        std::vector<uint8_t> encoded(hamming::encodedSize(bytes.size(), code));
+        std::vector<uint8_t> decoded(bytes.size());
+        hamming::encode(bytes, encoded, code);
+        hamming::ErrorModel model;
+        model.groupBits = hamming::codeBlocks(code).groupBits;
+        model.sliced = (code == hamming::CODE_7_4_SLICED);
+        hamming::hammingError(encoded.data(), encoded.size(), model, random.next());
+
+        // The kernels only change these, the other codes are measured once.
+        bool kernels = (code == hamming::CODE_7_4) || (code == hamming::CODE_8_4) ||
+                       (code == hamming::CODE_7_4_SLICED);
+        size_t engines = (kernels ? harness.kernels.size() : 1) + 2;
+        for(size_t e = 0; e < engines; e++){
+            char name[64];
+            std::function<void()> encodeRun;
+            std::function<void()> decodeRun;
+            if(e < (engines - 2)){
+                hamming::Kernel kernel = kernels ? harness.kernels[e] : hamming::KERNEL_AUTO;
+                hamming::setKernel(kernel);
+                snprintf(name, sizeof(name), "%s-%s", kernels ? hamming::kernelName(kernel) :
+                         "code", hamming::codeName(code));
+                encodeRun = [&](){ hamming::encode(bytes, encoded, code); };
+                decodeRun = [&](){ hamming::decode(encoded, decoded, code); };
+            }else if(e == (engines - 2)){
+                hamming::setKernel(hamming::KERNEL_AUTO);
+                snprintf(name, sizeof(name), "threads%u-%s", harness.pool->size(),
+                         hamming::codeName(code));
+                encodeRun = [&](){ hamming::encode(bytes, encoded, code, *harness.pool); };
+                decodeRun = [&](){ hamming::decode(encoded, decoded, code, *harness.pool); };
+            }else if((harness.gpu != NULL) && harness.gpu->takes(bytes.size(), code)){
+                snprintf(name, sizeof(name), "gpu-%s", hamming::codeName(code));
+                encodeRun = [&](){
+                    harness.gpu->encode(bytes.data(), bytes.size(), encoded.data(), code);
+                };
+                decodeRun = [&](){
+                    harness.gpu->decode(encoded.data(), encoded.size(), decoded.data(), code);
+                };
+            }else{
+                continue;
+            }
+            double encodeSpeed = measure(options.benchSeconds, bytes.size(), encodeRun);
+            double decodeSpeed = measure(options.benchSeconds, bytes.size(), decodeRun);
+            bool fast = (encodeSpeed >= (legacyEncode * options.minSpeedup)) &&
+                        (decodeSpeed >= (legacyDecode * options.minSpeedup));
+            printf("%-24s %10.1f %10.1f %10.1f %10.1f%s\n", name, encodeSpeed,
+                   encodeSpeed / legacyEncode, decodeSpeed, decodeSpeed / legacyDecode,
+                   fast ? "" : "  SLOW");
+            fflush(stdout);
+            ok = ok && fast;
+        }
+        hamming::setKernel(hamming::KERNEL_AUTO);
+    }
+    return ok;
+}
+
+/**
+    @brief Read a size in bytes, with an optional "K" or "M" (KiB, MiB).
+
+    @param const char* text: Size.
+    @param size_t* bytes: Receives the size.
+    @return bool: false if it is not a size.
+*/
+bool parseSize(const char* text, size_t* bytes){
+    char* end;
+    unsigned long long value = strtoull(text, &end, 10);
+    if(end == text){
+        return false;
+    }
+    if((*end == 'K') || (*end == 'k')){
+        value <<= 10;
+        end++;
+    }else if((*end == 'M') || (*end == 'm')){
+        value <<= 20;
+        end++;
+    }
+    if(*end != '\0'){
+        return false;
+    }
+    *bytes = (size_t)value;
+    return true;
+}
+
+#endif
+
+} // namespace
+
+#ifdef HAMMING_LIBFUZZER
+
+/**
+    @brief Entry point of libFuzzer: the first byte chooses the code, the
+        next 8 are the seed of the errors, cuts and ranges, and the rest is
+        the buffer.
+
+    @param const uint8_t* data: Bytes made by libFuzzer.
+    @param size_t size: Number of bytes.
+    @return int: Always 0 (a failure aborts).
+*/
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size){
+    static Harness* harness = NULL;
+    if(harness == NULL){
+        harness = new Harness();
+        findKernels(*harness);
+        harness->pool = new hamming::ThreadPool(3);
+        harness->legacyMax = FuzzOptions().legacyMax;
+    }
+    if(size < 9){
+        return 0;
+    }
+    uint64_t seed = 0;
+    for(size_t z = 1; z < 9; z++){
+        seed = (seed << 8) | data[z];
+    }
+    harness->seed = seed;
+    Random random(seed);
+    std::vector<uint8_t> bytes(data + 9, data + size);
+    checkBuffer(*harness, bytes, CODES[data[0] % CODE_COUNT], random);
+    if(harness->failures > 0){
+        abort();
+    }
+    return 0;
+}
+
+#else
+
+int main(int argc, char *argv[]){
+
+    FuzzOptions options;
+    options.seed = hamming::randomSeed();
+    for(int argCount = 1; argCount < argc; argCount++){
+        bool ok = true;
+        bool hasValue = (argCount + 1) < argc;
+        if(hasValue && (strcmp(argv[argCount], "--seed") == 0)){
+            options.seed = strtoull(argv[++argCount], NULL, 0);
+        }else if(hasValue && (strcmp(argv[argCount], "--rounds") == 0)){
+            options.rounds = (unsigned)atoi(argv[++argCount]);
+        }else if(hasValue && (strcmp(argv[argCount], "--time") == 0)){
+            options.seconds = atof(argv[++argCount]);
+        }else if(hasValue && (strcmp(argv[argCount], "--max") == 0)){
+            ok = parseSize(argv[++argCount], &options.maxBytes);
+        }else if(hasValue && (strcmp(argv[argCount], "--legacy-max") == 0)){
+            ok = parseSize(argv[++argCount], &options.legacyMax);
+        }else if(hasValue && (strcmp(argv[argCount], "-j") == 0)){
+            options.threads = (unsigned)atoi(argv[++argCount]);
+        }else if(hasValue && (strcmp(argv[argCount], "--min-speedup") == 0)){
+            options.minSpeedup = atof(argv[++argCount]);
+        }else if(hasValue && (strcmp(argv[argCount], "--bench-time") == 0)){
+            options.benchSeconds = atof(argv[++argCount]);
+        }else if(strcmp(argv[argCount], "--no-files") == 0){
+            options.files = false;
+        }else if(strcmp(argv[argCount], "--gpu") == 0){
+            options.gpu = true;
+        }else if(strcmp(argv[argCount], "--bench") == 0){
+            options.bench = true;
+        }else{
+            ok = false;
+        }
+        if(!ok || (options.maxBytes == 0) || (options.legacyMax == 0)){
+            fprintf(stderr, "Usage: %s [--seed seed] [--rounds rounds | --time seconds] [--max bytes] [--legacy-max bytes] [-j threads] [--no-files] [--gpu]\n"
+                            "       %s --bench [--max bytes] [--legacy-max bytes] [-j threads] [--gpu] [--bench-time seconds] [--min-speedup times]\n"
+                            "       (sizes can end with K or M)\n", argv[0], argv[0]);
+            return 1;
+        }
+    }
+
+    Harness harness;
+    findKernels(harness);
+    hamming::ThreadPool pool(options.threads);
+    harness.pool = &pool;
+    harness.legacyMax = options.legacyMax;
+    hamming::GpuCodec* gpu = NULL;
+    if(options.gpu){
+        gpu = new hamming::GpuCodec(0);
+        if(gpu->ready()){
+            harness.gpu = gpu;
+        }else{
+            fprintf(stderr, "No GPU could be used, checking only the CPU!\n");
+        }
+    }
+
+    if(options.bench){
+        bool ok = benchAll(harness, options);
+        delete gpu;
+        return ok ? 0 : 1;
+    }
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    printf("seed %llu\n", (unsigned long long)options.seed);
+    unsigned rounds = 0;
+    while((options.seconds > 0) ?
+          (std::chrono::duration<double>(Clock::now() - start).count() < options.seconds) :
+          (rounds < options.rounds)){
+        harness.seed = options.seed + rounds;
+        checkRound(harness, options);
+        rounds++;
+    }
+    printf("%u rounds, %llu checks, %llu failed\n", rounds,
+           (unsigned long long)harness.checks, (unsigned long long)harness.failures);
+    delete gpu;
+    return (harness.failures == 0) ? 0 : 1;
+}
+
+#endif
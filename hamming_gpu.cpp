@@ -0,0 +1,696 @@
+/**
+    @file    hamming_gpu.cpp
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Encoding and decoding of large buffers on a GPU.
+
+    @section DESCRIPTION
+
+    The few OpenCL 1.1 functions used are taken from "libOpenCL" with
+    "dlsym", with their types declared here, so neither its headers nor the
+    library are needed to build (the same as the system calls of
+    "hamming_uring.cpp"). Each work-item converts a block: 4 original bytes
+    and their 7 bytes of (7,4) or 8 bytes of (8,4). The counters of the
+    groups corrected are added with "atomic_add" only by the blocks that
+    have any.
+
+    Each of the two slots has its own queue, its buffers on the device and
+    two buffers that the driver allocates in memory the device can read and
+    write directly ("CL_MEM_ALLOC_HOST_PTR", mapped once). A slice is copied
+    to one of them while the transfers and the kernel of the other slot run.
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <mutex>
+#include <string>
+
+#include "hamming_gpu.h"
+
+#if !defined(_WIN32) && defined(__has_include)
+#if __has_include(<dlfcn.h>)
+#include <dlfcn.h>
+#define HAMMING_OPENCL 1
+#endif
+#endif
+
+namespace hamming {
+
+namespace {
+
+// Original bytes of a block of a kernel.
+const size_t GPU_BLOCK_BYTES = 4;
+
+// Bytes read, and written, by each slot at a time. Its buffers hold a slice
+// of any of the kernels, whose blocks have at most 8 bytes.
+const size_t GPU_SLICE_BYTES = 4 * 1048576;
+const size_t GPU_SLICE_BLOCKS = GPU_SLICE_BYTES / 8;
+
+/**
+    @brief Kernels, in the order of "GpuContext::Slot::kernels".
+*/
+enum GpuKernel {
+    GPU_ENCODE_7_4,
+    GPU_DECODE_7_4,
+    GPU_ENCODE_8_4,
+    GPU_DECODE_8_4,
+    GPU_KERNELS
+};
+
+/**
+    @brief Name of each kernel and size of its blocks.
+*/
+struct GpuKernelInfo {
+    const char* name;
+    size_t inputBytes;  /**< Bytes read by a work-item. */
+    size_t outputBytes; /**< Bytes written by a work-item. */
+};
+
+const GpuKernelInfo gpuKernels[GPU_KERNELS] = {
+    {"encode74", 4, 7},
+    {"decode74", 7, 4},
+    {"encode84", 4, 8},
+    {"decode84", 8, 4}
+};
+
+// The tables are put before it, as "__constant" arrays made from the
+// functions of the CPU. decode74Table: nibble | corrected << 4.
+// decode84Table: nibble | corrected << 4 | detected << 5.
+const char* const GPU_KERNELS_SOURCE =
+    "__kernel void encode74(__global const uchar* input, __global uchar* output,\n"
+    "                       __global uint* counts, uint blocks){\n"
+    "    uint z = get_global_id(0);\n"
+    "    if(z >= blocks){\n"
+    "        return;\n"
+    "    }\n"
+    "    __global const uchar* in = input + (z * 4);\n"
+    "    __global uchar* out = output + (z * 7);\n"
+    "    ulong bits = 0;\n"
+    "    for(int k = 0; k < 4; k++){\n"
+    "        bits = (bits << 14) | encode74Table[in[k]];\n"
+    "    }\n"
+    "    for(int k = 0; k < 7; k++){\n"
+    "        out[k] = (uchar)(bits >> (48 - (8 * k)));\n"
+    "    }\n"
+    "}\n"
+    "\n"
+    "__kernel void decode74(__global const uchar* input, __global uchar* output,\n"
+    "                       __global uint* counts, uint blocks){\n"
+    "    uint z = get_global_id(0);\n"
+    "    if(z >= blocks){\n"
+    "        return;\n"
+    "    }\n"
+    "    __global const uchar* in = input + (z * 7);\n"
+    "    __global uchar* out = output + (z * 4);\n"
+    "    ulong bits = 0;\n"
+    "    for(int k = 0; k < 7; k++){\n"
+    "        bits = (bits << 8) | in[k];\n"
+    "    }\n"
+    "    uint corrected = 0;\n"
+    "    for(int k = 0; k < 4; k++){\n"
+    "        uchar high = decode74Table[(bits >> (49 - (14 * k))) & 0x7F];\n"
+    "        uchar low = decode74Table[(bits >> (42 - (14 * k))) & 0x7F];\n"
+    "        out[k] = (uchar)(((high & 0x0F) << 4) | (low & 0x0F));\n"
+    "        corrected += (uint)(high >> 4) + (uint)(low >> 4);\n"
+    "    }\n"
+    "    if(corrected > 0){\n"
+    "        atomic_add(&counts[0], corrected);\n"
+    "    }\n"
+    "}\n"
+    "\n"
+    "__kernel void encode84(__global const uchar* input, __global uchar* output,\n"
+    "                       __global uint* counts, uint blocks){\n"
+    "    uint z = get_global_id(0);\n"
+    "    if(z >= blocks){\n"
+    "        return;\n"
+    "    }\n"
+    "    __global const uchar* in = input + (z * 4);\n"
+    "    __global uchar* out = output + (z * 8);\n"
+    "    for(int k = 0; k < 4; k++){\n"
+    "        ushort groups = encode84Table[in[k]];\n"
+    "        out[2 * k] = (uchar)(groups >> 8);\n"
+    "        out[(2 * k) + 1] = (uchar)groups;\n"
+    "    }\n"
+    "}\n"
+    "\n"
+    "__kernel void decode84(__global const uchar* input, __global uchar* output,\n"
+    "                       __global uint* counts, uint blocks){\n"
+    "    uint z = get_global_id(0);\n"
+    "    if(z >= blocks){\n"
+    "        return;\n"
+    "    }\n"
+    "    __global const uchar* in = input + (z * 8);\n"
+    "    __global uchar* out = output + (z * 4);\n"
+    "    uint corrected = 0;\n"
+    "    uint detected = 0;\n"
+    "    for(int k = 0; k < 4; k++){\n"
+    "        uchar high = decode84Table[in[2 * k]];\n"
+    "        uchar low = decode84Table[in[(2 * k) + 1]];\n"
+    "        out[k] = (uchar)(((high & 0x0F) << 4) | (low & 0x0F));\n"
+    "        corrected += (uint)((high >> 4) & 1) + (uint)((low >> 4) & 1);\n"
+    "        detected += (uint)(high >> 5) + (uint)(low >> 5);\n"
+    "    }\n"
+    "    if(corrected > 0){\n"
+    "        atomic_add(&counts[0], corrected);\n"
+    "    }\n"
+    "    if(detected > 0){\n"
+    "        atomic_add(&counts[1], detected);\n"
+    "    }\n"
+    "}\n";
+
+/**
+    @brief Append a table to the source of the kernels.
+
+    @param std::string* source: Source.
+    @param char* declaration: Type and name of the table.
+    @param unsigned* values: Its values.
+    @param unsigned count: Number of values.
+    @return void.
+*/
+void appendTable(std::string* source, const char* declaration, const unsigned* values,
+                 unsigned count){
+    *source += "__constant ";
+    *source += declaration;
+    *source += " = {";
+    for(unsigned z = 0; z < count; z++){
+        char value[16];
+        snprintf(value, sizeof(value), "%s%u", (z % 16) == 0 ? "\n    " : " ", values[z]);
+        *source += value;
+        if(z + 1 < count){
+            *source += ",";
+        }
+    }
+    *source += "\n};\n\n";
+}
+
+/**
+    @brief Source of the kernels with the tables of the CPU.
+
+    @return std::string: OpenCL C source.
+*/
+std::string kernelsSource(){
+    unsigned encode74[256];
+    unsigned encode84[256];
+    for(unsigned z = 0; z < 256; z++){
+        uint8_t byte = (uint8_t)z;
+        uint8_t hammingBytes[2];
+        addHammingParity(&byte, 1, hammingBytes, CODE_7_4);
+        encode74[z] = (((unsigned)hammingBytes[0] << 8) | hammingBytes[1]) >> 2;
+        addHammingParity(&byte, 1, hammingBytes, CODE_8_4);
+        encode84[z] = ((unsigned)hammingBytes[0] << 8) | hammingBytes[1];
+    }
+    unsigned decode74[128];
+    for(unsigned z = 0; z < 128; z++){
+        GroupCorrection correction = hammingCorrection(z);
+        decode74[z] = correction.nibble | (correction.corrected ? 0x10 : 0);
+    }
+    unsigned decode84[256];
+    for(unsigned z = 0; z < 256; z++){
+        GroupCorrection correction = secdedCorrection(z);
+        decode84[z] = correction.nibble | (correction.corrected ? 0x10 : 0) |
+                      (correction.detected ? 0x20 : 0);
+    }
+    std::string source;
+    appendTable(&source, "ushort encode74Table[256]", encode74, 256);
+    appendTable(&source, "uchar decode74Table[128]", decode74, 128);
+    appendTable(&source, "ushort encode84Table[256]", encode84, 256);
+    appendTable(&source, "uchar decode84Table[256]", decode84, 256);
+    source += GPU_KERNELS_SOURCE;
+    return source;
+}
+
+} // namespace
+
+#if HAMMING_OPENCL
+
+namespace {
+
+// The types and constants of OpenCL 1.1 used.
+typedef int32_t cl_int;
+typedef uint32_t cl_uint;
+typedef uint64_t cl_bitfield;
+typedef void* cl_object;
+
+const cl_int CL_SUCCESS = 0;
+const cl_bitfield CL_DEVICE_TYPE_GPU = 1 << 2;
+const cl_bitfield CL_DEVICE_TYPE_ACCELERATOR = 1 << 3;
+const cl_uint CL_DEVICE_NAME = 0x102B;
+const cl_bitfield CL_MEM_READ_WRITE = 1 << 0;
+const cl_bitfield CL_MEM_WRITE_ONLY = 1 << 1;
+const cl_bitfield CL_MEM_READ_ONLY = 1 << 2;
+const cl_bitfield CL_MEM_ALLOC_HOST_PTR = 1 << 4;
+const cl_bitfield CL_MAP_READ = 1 << 0;
+const cl_bitfield CL_MAP_WRITE = 1 << 1;
+const cl_uint CL_TRUE = 1;
+const cl_uint CL_FALSE = 0;
+
+/**
+    @brief Functions of "libOpenCL".
+*/
+struct OpenCl {
+    cl_int (*getPlatformIDs)(cl_uint, cl_object*, cl_uint*);
+    cl_int (*getDeviceIDs)(cl_object, cl_bitfield, cl_uint, cl_object*, cl_uint*);
+    cl_int (*getDeviceInfo)(cl_object, cl_uint, size_t, void*, size_t*);
+    cl_object (*createContext)(const intptr_t*, cl_uint, const cl_object*,
+                               void (*)(const char*, const void*, size_t, void*), void*,
+                               cl_int*);
+    cl_object (*createCommandQueue)(cl_object, cl_object, cl_bitfield, cl_int*);
+    cl_object (*createProgramWithSource)(cl_object, cl_uint, const char**, const size_t*,
+                                         cl_int*);
+    cl_int (*buildProgram)(cl_object, cl_uint, const cl_object*, const char*,
+                           void (*)(cl_object, void*), void*);
+    cl_object (*createKernel)(cl_object, const char*, cl_int*);
+    cl_object (*createBuffer)(cl_object, cl_bitfield, size_t, void*, cl_int*);
+    cl_int (*setKernelArg)(cl_object, cl_uint, size_t, const void*);
+    cl_int (*enqueueWriteBuffer)(cl_object, cl_object, cl_uint, size_t, size_t, const void*,
+                                 cl_uint, const cl_object*, cl_object*);
+    cl_int (*enqueueReadBuffer)(cl_object, cl_object, cl_uint, size_t, size_t, void*, cl_uint,
+                                const cl_object*, cl_object*);
+    cl_int (*enqueueNDRangeKernel)(cl_object, cl_object, cl_uint, const size_t*, const size_t*,
+                                   const size_t*, cl_uint, const cl_object*, cl_object*);
+    void* (*enqueueMapBuffer)(cl_object, cl_object, cl_uint, cl_bitfield, size_t, size_t,
+                              cl_uint, const cl_object*, cl_object*, cl_int*);
+    cl_int (*enqueueUnmapMemObject)(cl_object, cl_object, void*, cl_uint, const cl_object*,
+                                    cl_object*);
+    cl_int (*flush)(cl_object);
+    cl_int (*finish)(cl_object);
+    cl_int (*releaseMemObject)(cl_object);
+    cl_int (*releaseKernel)(cl_object);
+    cl_int (*releaseProgram)(cl_object);
+    cl_int (*releaseCommandQueue)(cl_object);
+    cl_int (*releaseContext)(cl_object);
+};
+
+/**
+    @brief Take a function from the library.
+
+    @param void* library: Given by "dlopen".
+    @param char* name: Name of the function.
+    @param T* function: Receives it.
+    @return bool: false if the library does not have it.
+*/
+template<typename T> bool loadFunction(void* library, const char* name, T* function){
+    void* address = dlsym(library, name);
+    memcpy(function, &address, sizeof(address));
+    return address != NULL;
+}
+
+/**
+    @brief Take the functions used from the library.
+
+    @param void* library: Given by "dlopen".
+    @param OpenCl* cl: Receives them.
+    @return bool: false if any of them is missing.
+*/
+bool loadOpenCl(void* library, OpenCl* cl){
+    return loadFunction(library, "clGetPlatformIDs", &cl->getPlatformIDs) &&
+           loadFunction(library, "clGetDeviceIDs", &cl->getDeviceIDs) &&
+           loadFunction(library, "clGetDeviceInfo", &cl->getDeviceInfo) &&
+           loadFunction(library, "clCreateContext", &cl->createContext) &&
+           loadFunction(library, "clCreateCommandQueue", &cl->createCommandQueue) &&
+           loadFunction(library, "clCreateProgramWithSource", &cl->createProgramWithSource) &&
+           loadFunction(library, "clBuildProgram", &cl->buildProgram) &&
+           loadFunction(library, "clCreateKernel", &cl->createKernel) &&
+           loadFunction(library, "clCreateBuffer", &cl->createBuffer) &&
+           loadFunction(library, "clSetKernelArg", &cl->setKernelArg) &&
+           loadFunction(library, "clEnqueueWriteBuffer", &cl->enqueueWriteBuffer) &&
+           loadFunction(library, "clEnqueueReadBuffer", &cl->enqueueReadBuffer) &&
+           loadFunction(library, "clEnqueueNDRangeKernel", &cl->enqueueNDRangeKernel) &&
+           loadFunction(library, "clEnqueueMapBuffer", &cl->enqueueMapBuffer) &&
+           loadFunction(library, "clEnqueueUnmapMemObject", &cl->enqueueUnmapMemObject) &&
+           loadFunction(library, "clFlush", &cl->flush) &&
+           loadFunction(library, "clFinish", &cl->finish) &&
+           loadFunction(library, "clReleaseMemObject", &cl->releaseMemObject) &&
+           loadFunction(library, "clReleaseKernel", &cl->releaseKernel) &&
+           loadFunction(library, "clReleaseProgram", &cl->releaseProgram) &&
+           loadFunction(library, "clReleaseCommandQueue", &cl->releaseCommandQueue) &&
+           loadFunction(library, "clReleaseContext", &cl->releaseContext);
+}
+
+} // namespace
+
+/**
+    @brief An OpenCL device with the kernels built for it (internal).
+*/
+struct GpuContext {
+
+    /**
+        @brief One of the two slices being converted.
+    */
+    struct Slot {
+        cl_object queue;
+        cl_object kernels[GPU_KERNELS];
+        cl_object input;       /**< Slice read, on the device. */
+        cl_object output;      /**< Slice written, on the device. */
+        cl_object counts;      /**< Groups corrected and detected. */
+        cl_object stageInput;  /**< Pinned buffers, mapped to "hostInput"... */
+        cl_object stageOutput;
+        uint8_t* hostInput;
+        uint8_t* hostOutput;
+        cl_uint hostCounts[2];
+        uint8_t* pendingOutput; /**< Where the slice running goes (NULL -
+                                     none). */
+        size_t pendingBytes;
+    };
+
+    void* library;
+    OpenCl cl;
+    cl_object device;
+    cl_object context;
+    cl_object program;
+    Slot slots[2];
+    std::string name;
+    std::mutex mutex; /**< One conversion at a time. */
+
+    GpuContext();
+    ~GpuContext();
+    bool open();
+    bool openSlot(Slot* slot);
+    void closeSlot(Slot* slot);
+    bool finishSlot(Slot* slot, DecodeStats* stats);
+};
+
+GpuContext::GpuContext() :
+    library(NULL),
+    device(NULL),
+    context(NULL),
+    program(NULL){
+    memset(&cl, 0, sizeof(cl));
+    memset(slots, 0, sizeof(slots));
+}
+
+GpuContext::~GpuContext(){
+    if(library == NULL){
+        return;
+    }
+    for(unsigned z = 0; z < 2; z++){
+        closeSlot(&slots[z]);
+    }
+    if(program != NULL){
+        cl.releaseProgram(program);
+    }
+    if(context != NULL){
+        cl.releaseContext(context);
+    }
+    dlclose(library);
+}
+
+bool GpuContext::open(){
+    library = dlopen("libOpenCL.so.1", RTLD_NOW|RTLD_LOCAL);
+    if(library == NULL){
+        library = dlopen("libOpenCL.so", RTLD_NOW|RTLD_LOCAL);
+    }
+    if((library == NULL) || !loadOpenCl(library, &cl)){
+        return false;
+    }
+
+    // The first GPU of any platform, or else the first accelerator.
+    cl_object platforms[8];
+    cl_uint platformsCount = 0;
+    if((cl.getPlatformIDs(8, platforms, &platformsCount) != CL_SUCCESS) ||
+       (platformsCount == 0)){
+        return false;
+    }
+    platformsCount = platformsCount < 8 ? platformsCount : 8;
+    const cl_bitfield types[2] = {CL_DEVICE_TYPE_GPU, CL_DEVICE_TYPE_ACCELERATOR};
+    for(unsigned t = 0; (t < 2) && (device == NULL); t++){
+        for(cl_uint z = 0; (z < platformsCount) && (device == NULL); z++){
+            cl_uint devicesCount = 0;
+            if((cl.getDeviceIDs(platforms[z], types[t], 1, &device, &devicesCount) !=
+                CL_SUCCESS) || (devicesCount == 0)){
+                device = NULL;
+            }
+        }
+    }
+    if(device == NULL){
+        return false;
+    }
+    char deviceName[256];
+    if(cl.getDeviceInfo(device, CL_DEVICE_NAME, sizeof(deviceName), deviceName, NULL) ==
+       CL_SUCCESS){
+        deviceName[sizeof(deviceName) - 1] = '\0';
+        name = deviceName;
+    }
+
+    cl_int error;
+    context = cl.createContext(NULL, 1, &device, NULL, NULL, &error);
+    if(context == NULL){
+        return false;
+    }
+    std::string source = kernelsSource();
+    const char* sourceText = source.c_str();
+    size_t sourceSize = source.size();
+    program = cl.createProgramWithSource(context, 1, &sourceText, &sourceSize, &error);
+    if((program == NULL) || (cl.buildProgram(program, 1, &device, "", NULL, NULL) != CL_SUCCESS)){
+        return false;
+    }
+    for(unsigned z = 0; z < 2; z++){
+        if(!openSlot(&slots[z])){
+            return false;
+        }
+    }
+    return true;
+}
+
+bool GpuContext::openSlot(Slot* slot){
+    cl_int error;
+    slot->queue = cl.createCommandQueue(context, device, 0, &error);
+    if(slot->queue == NULL){
+        return false;
+    }
+    for(unsigned z = 0; z < GPU_KERNELS; z++){
+        slot->kernels[z] = cl.createKernel(program, gpuKernels[z].name, &error);
+        if(slot->kernels[z] == NULL){
+            return false;
+        }
+    }
+    slot->input = cl.createBuffer(context, CL_MEM_READ_ONLY, GPU_SLICE_BYTES, NULL, &error);
+    slot->output = cl.createBuffer(context, CL_MEM_WRITE_ONLY, GPU_SLICE_BYTES, NULL, &error);
+    slot->counts = cl.createBuffer(context, CL_MEM_READ_WRITE, sizeof(slot->hostCounts), NULL,
+                                   &error);
+    slot->stageInput = cl.createBuffer(context, CL_MEM_READ_WRITE|CL_MEM_ALLOC_HOST_PTR,
+                                       GPU_SLICE_BYTES, NULL, &error);
+    slot->stageOutput = cl.createBuffer(context, CL_MEM_READ_WRITE|CL_MEM_ALLOC_HOST_PTR,
+                                        GPU_SLICE_BYTES, NULL, &error);
+    if((slot->input == NULL) || (slot->output == NULL) || (slot->counts == NULL) ||
+       (slot->stageInput == NULL) || (slot->stageOutput == NULL)){
+        return false;
+    }
+    slot->hostInput = (uint8_t*)cl.enqueueMapBuffer(slot->queue, slot->stageInput, CL_TRUE,
+                                                    CL_MAP_WRITE, 0, GPU_SLICE_BYTES, 0, NULL,
+                                                    NULL, &error);
+    slot->hostOutput = (uint8_t*)cl.enqueueMapBuffer(slot->queue, slot->stageOutput, CL_TRUE,
+                                                     CL_MAP_READ, 0, GPU_SLICE_BYTES, 0, NULL,
+                                                     NULL, &error);
+    return (slot->hostInput != NULL) && (slot->hostOutput != NULL);
+}
+
+void GpuContext::closeSlot(Slot* slot){
+    if(slot->queue != NULL){
+        cl.finish(slot->queue);
+        if(slot->hostInput != NULL){
+            cl.enqueueUnmapMemObject(slot->queue, slot->stageInput, slot->hostInput, 0, NULL,
+                                     NULL);
+        }
+        if(slot->hostOutput != NULL){
+            cl.enqueueUnmapMemObject(slot->queue, slot->stageOutput, slot->hostOutput, 0, NULL,
+                                     NULL);
+        }
+        cl.finish(slot->queue);
+    }
+    cl_object buffers[5] = {slot->input, slot->output, slot->counts, slot->stageInput,
+                            slot->stageOutput};
+    for(unsigned z = 0; z < 5; z++){
+        if(buffers[z] != NULL){
+            cl.releaseMemObject(buffers[z]);
+        }
+    }
+    for(unsigned z = 0; z < GPU_KERNELS; z++){
+        if(slot->kernels[z] != NULL){
+            cl.releaseKernel(slot->kernels[z]);
+        }
+    }
+    if(slot->queue != NULL){
+        cl.releaseCommandQueue(slot->queue);
+    }
+    memset(slot, 0, sizeof(*slot));
+}
+
+/**
+    @brief Wait for the slice of a slot and copy it to where it goes.
+
+    @param Slot* slot: Slot.
+    @param DecodeStats* stats: Gets the groups corrected and detected added.
+    @return bool: false if the device failed.
+*/
+bool GpuContext::finishSlot(Slot* slot, DecodeStats* stats){
+    if(slot->pendingOutput == NULL){
+        return true;
+    }
+    uint8_t* output = slot->pendingOutput;
+    slot->pendingOutput = NULL;
+    if(cl.finish(slot->queue) != CL_SUCCESS){
+        return false;
+    }
+    memcpy(output, slot->hostOutput, slot->pendingBytes);
+    stats->corrected += slot->hostCounts[0];
+    stats->detected += slot->hostCounts[1];
+    return true;
+}
+
+#else
+
+struct GpuContext {
+    std::string name;
+    std::mutex mutex;
+
+    bool open(){
+        return false;
+    }
+};
+
+#endif
+
+GpuCodec::GpuCodec(size_t minBytes) :
+    context(new GpuContext()),
+    minBytes(minBytes){
+    if(!context->open()){
+        delete context;
+        context = NULL;
+    }
+}
+
+GpuCodec::~GpuCodec(){
+    delete context;
+}
+
+bool GpuCodec::ready() const{
+    return context != NULL;
+}
+
+std::string GpuCodec::deviceName() const{
+    return context != NULL ? context->name : std::string();
+}
+
+bool GpuCodec::takes(size_t bytesCount, Code code) const{
+    return (context != NULL) && ((code == CODE_7_4) || (code == CODE_8_4)) &&
+           (bytesCount >= minBytes);
+}
+
+void GpuCodec::encode(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes,
+                      Code code){
+    size_t blocks = takes(bytesCount, code) ? bytesCount / GPU_BLOCK_BYTES : 0;
+    if((blocks > 0) && run(code == CODE_7_4 ? GPU_ENCODE_7_4 : GPU_ENCODE_8_4, bytes, blocks,
+                           hammingBytes, NULL)){
+
+        // The bytes that do not make a whole block, with the zeros of the CPU.
+        size_t from = blocks * GPU_BLOCK_BYTES;
+        addHammingParity(bytes + from, bytesCount - from, hammingBytes + encodedSize(from, code),
+                         code);
+        return;
+    }
+    addHammingParity(bytes, bytesCount, hammingBytes, code);
+}
+
+size_t GpuCodec::decode(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes,
+                        Code code, DecodeStats* stats){
+    size_t blockBytes = code == CODE_7_4 ? 7 : 8;
+    size_t blocks = takes(bytesCount, code) ? bytesCount / blockBytes : 0;
+    DecodeStats blockStats;
+    if((blocks > 0) && run(code == CODE_7_4 ? GPU_DECODE_7_4 : GPU_DECODE_8_4, hammingBytes,
+                           blocks, bytes, &blockStats)){
+        size_t from = blocks * blockBytes;
+        size_t size = (blocks * GPU_BLOCK_BYTES) +
+                      removeHammingParity(hammingBytes + from, bytesCount - from,
+                                          bytes + (blocks * GPU_BLOCK_BYTES), code, stats);
+        if(stats != NULL){
+            stats->groups += (uint64_t)blocks * GPU_BLOCK_BYTES * 2;
+            stats->corrected += blockStats.corrected;
+            stats->detected += blockStats.detected;
+        }
+        return size;
+    }
+    return removeHammingParity(hammingBytes, bytesCount, bytes, code, stats);
+}
+
+#if HAMMING_OPENCL
+
+bool GpuCodec::run(unsigned kernel, const uint8_t* input, size_t blocks, uint8_t* output,
+                   DecodeStats* stats){
+    std::lock_guard<std::mutex> lock(context->mutex);
+    const OpenCl& cl = context->cl;
+    const GpuKernelInfo& info = gpuKernels[kernel];
+    static const cl_uint zeros[2] = {0, 0};
+    DecodeStats sliceStats;
+    bool ok = true;
+    unsigned number = 0;
+    for(size_t first = 0; ok && (first < blocks); first += GPU_SLICE_BLOCKS, number++){
+        GpuContext::Slot& slot = context->slots[number % 2];
+
+        // The slot is free once the slice it had two slices ago is copied.
+        ok = context->finishSlot(&slot, &sliceStats);
+        if(!ok){
+            break;
+        }
+        cl_uint sliceBlocks = (cl_uint)(blocks - first < GPU_SLICE_BLOCKS ? blocks - first :
+                                                                            GPU_SLICE_BLOCKS);
+        size_t inputBytes = sliceBlocks * info.inputBytes;
+        size_t outputBytes = sliceBlocks * info.outputBytes;
+        memcpy(slot.hostInput, input + (first * info.inputBytes), inputBytes);
+        cl_object kernelObject = slot.kernels[kernel];
+        size_t globalSize = sliceBlocks;
+        ok = (cl.enqueueWriteBuffer(slot.queue, slot.input, CL_FALSE, 0, inputBytes,
+                                    slot.hostInput, 0, NULL, NULL) == CL_SUCCESS) &&
+             (cl.enqueueWriteBuffer(slot.queue, slot.counts, CL_FALSE, 0, sizeof(zeros), zeros,
+                                    0, NULL, NULL) == CL_SUCCESS) &&
+             (cl.setKernelArg(kernelObject, 0, sizeof(cl_object), &slot.input) == CL_SUCCESS) &&
+             (cl.setKernelArg(kernelObject, 1, sizeof(cl_object), &slot.output) == CL_SUCCESS) &&
+             (cl.setKernelArg(kernelObject, 2, sizeof(cl_object), &slot.counts) == CL_SUCCESS) &&
+             (cl.setKernelArg(kernelObject, 3, sizeof(cl_uint), &sliceBlocks) == CL_SUCCESS) &&
+             (cl.enqueueNDRangeKernel(slot.queue, kernelObject, 1, NULL, &globalSize, NULL, 0,
+                                      NULL, NULL) == CL_SUCCESS) &&
+             (cl.enqueueReadBuffer(slot.queue, slot.output, CL_FALSE, 0, outputBytes,
+                                   slot.hostOutput, 0, NULL, NULL) == CL_SUCCESS) &&
+             (cl.enqueueReadBuffer(slot.queue, slot.counts, CL_FALSE, 0,
+                                   sizeof(slot.hostCounts), slot.hostCounts, 0, NULL, NULL) ==
+              CL_SUCCESS) &&
+             (cl.flush(slot.queue) == CL_SUCCESS);
+        slot.pendingOutput = output + (first * info.outputBytes);
+        slot.pendingBytes = outputBytes;
+    }
+
+    // The older slice first. After a failure, the slices are dropped: the
+    // whole buffer is converted again on the CPU.
+    for(unsigned z = 0; z < 2; z++){
+        GpuContext::Slot& slot = context->slots[(number + z) % 2];
+        if(ok){
+            ok = context->finishSlot(&slot, &sliceStats);
+        }else if(slot.pendingOutput != NULL){
+            cl.finish(slot.queue);
+            slot.pendingOutput = NULL;
+        }
+    }
+    if(ok && (stats != NULL)){
+        *stats += sliceStats;
+    }
+    return ok;
+}
+
+#else
+
+bool GpuCodec::run(unsigned, const uint8_t*, size_t, uint8_t*, DecodeStats*){
+    return false;
+}
+
+#endif
+
+} // namespace hamming
@@ -0,0 +1,129 @@
+/**
+    @file    hamming_gpu.h
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Encoding and decoding of large buffers on a GPU.
+
+    @section DESCRIPTION
+
+    "GpuCodec" runs the codes (7,4) and (8,4) on an OpenCL device, looking
+    up each group in the same tables as the CPU (the tables are made from
+    "addHammingParity", "hammingCorrection" and "secdedCorrection", so the
+    bits are exactly the same). The buffer is sent in slices through two
+    queues: while the device converts one slice, the other is copied to the
+    memory it reads and from the memory it wrote, in pinned memory given by
+    the driver.
+
+    OpenCL is loaded when the program runs, so nothing is needed to build
+    it. Without a device, for the other codes, and for buffers too small to
+    pay for the copies, the same functions convert on the CPU.
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#ifndef HAMMING_GPU_H
+#define HAMMING_GPU_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+#include "hamming.h"
+
+namespace hamming {
+
+// Smallest buffer converted on the device by default: below it, copying
+// the bytes there and back takes longer than converting them on the CPU.
+const size_t GPU_MIN_BYTES = 4 * 1048576;
+
+struct GpuContext;
+
+class GpuCodec {
+public:
+
+    /**
+        @brief Find a GPU (or another accelerator) and build the kernels for
+            it.
+
+        @param size_t minBytes: Smallest buffer converted on the device.
+    */
+    explicit GpuCodec(size_t minBytes=GPU_MIN_BYTES);
+
+    /**
+        @brief Free the device.
+    */
+    ~GpuCodec();
+
+    /**
+        @brief Whether there is a device to convert on.
+
+        @return bool: false if there is no OpenCL, no device, or the kernels
+            could not be built.
+    */
+    bool ready() const;
+
+    /**
+        @brief Name of the device.
+
+        @return std::string: Its name ("" - none).
+    */
+    std::string deviceName() const;
+
+    /**
+        @brief Whether a buffer goes to the device.
+
+        @param size_t bytesCount: Size of the buffer read.
+        @param Code code: Code of the hamming format.
+        @return bool: true if there is a device, the code is (7,4) or (8,4)
+            and the buffer has at least "minBytes".
+    */
+    bool takes(size_t bytesCount, Code code) const;
+
+    /**
+        @brief Same as "hamming::addHammingParity" with a code, on the device
+            when it "takes" the buffer.
+
+        @param uint8_t* bytes: Original bytes.
+        @param size_t bytesCount: Number of original bytes.
+        @param uint8_t* hammingBytes: Receives "encodedSize" bytes.
+        @param Code code: Code of the hamming format.
+        @return void.
+    */
+    void encode(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes, Code code);
+
+    /**
+        @brief Same as "hamming::removeHammingParity" with a code, on the
+            device when it "takes" the buffer.
+
+        @param uint8_t* hammingBytes: Bytes in the hamming format.
+        @param size_t bytesCount: Number of bytes in the hamming format.
+        @param uint8_t* bytes: Receives "decodedSize" bytes.
+        @param Code code: Code of the hamming format.
+        @param DecodeStats* stats: Gets the groups decoded, corrected and
+            detected added (can be NULL).
+        @return size_t: Number of bytes written to "bytes".
+    */
+    size_t decode(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes, Code code,
+                  DecodeStats* stats=NULL);
+
+private:
+    GpuCodec(const GpuCodec&);
+    GpuCodec& operator=(const GpuCodec&);
+
+    bool run(unsigned kernel, const uint8_t* input, size_t blocks, uint8_t* output,
+             DecodeStats* stats);
+
+    GpuContext* context; /**< The device (NULL - none). */
+    size_t minBytes;
+};
+
+} // namespace hamming
+
+#endif
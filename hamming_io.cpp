@@ -0,0 +1,2106 @@
+/**
+    @file    hamming_io.cpp
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Streaming of files through the hamming method.
+
+    @section DESCRIPTION
+
+    Plain "read"/"write" over file descriptors, each call moving a whole
+    chunk, which also works for pipes ("-" being the standard input or
+    output). With "IO_MMAP" regular files are mapped instead, the output
+    having its exact size set with "ftruncate", so the conversion reads and
+    writes the pages of the files directly. With "IO_URING" three chunks go
+    through an "IoRing", one being read and one written while the other is
+    converted.
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "hamming.h"
+#include "hamming_arena.h"
+#include "hamming_container.h"
+#include "hamming_gpu.h"
+#include "hamming_io.h"
+#include "hamming_pool.h"
+#include "hamming_profile.h"
+#include "hamming_uring.h"
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+#if defined(_WIN32) || defined(__CYGWIN__)
+#include <io.h>
+#endif
+
+#if !defined(_WIN32) || defined(__CYGWIN__)
+#define HAMMING_MMAP 1
+#include <sys/mman.h>
+#endif
+
+namespace hamming {
+
+namespace {
+
+/**
+    @brief Read until the buffer is full or the file ends.
+
+    @param int fd: File to be read.
+    @param uint8_t* buffer: Receives the bytes.
+    @param size_t size: Size of the buffer.
+    @param size_t* readCount: Receives the number of bytes read (less than
+        "size" only at the end of the file).
+    @return bool: false if the file could not be read.
+*/
+bool readFull(int fd, uint8_t* buffer, size_t size, size_t* readCount){
+    *readCount = 0;
+    while(*readCount < size){
+        ssize_t count = read(fd, buffer + *readCount, size - *readCount);
+        if(count < 0){
+            if(errno == EINTR){
+                continue;
+            }
+            return false;
+        }
+        if(count == 0){
+            break;
+        }
+        *readCount += (size_t)count;
+    }
+    return true;
+}
+
+/**
+    @brief Write the whole buffer.
+
+    @param int fd: File to be written.
+    @param uint8_t* buffer: Bytes to be written.
+    @param size_t size: Number of bytes.
+    @return bool: false if the file could not be written.
+*/
+bool writeFull(int fd, const uint8_t* buffer, size_t size){
+    while(size > 0){
+        ssize_t count = write(fd, buffer, size);
+        if(count < 0){
+            if(errno == EINTR){
+                continue;
+            }
+            return false;
+        }
+        buffer += count;
+        size -= (size_t)count;
+    }
+    return true;
+}
+
+/**
+    @brief "readFull" timed as the stage "PROFILE_READ".
+
+    @param Profile* profile: Gets the counters added (NULL - none).
+    @param int fd: File to be read.
+    @param uint8_t* buffer: Receives the bytes.
+    @param size_t size: Size of the buffer.
+    @param size_t* readCount: Receives the number of bytes read.
+    @return bool: false if the file could not be read.
+*/
+bool readTimed(Profile* profile, int fd, uint8_t* buffer, size_t size, size_t* readCount){
+    StageTimer timer(profile, PROFILE_READ);
+    bool ok = readFull(fd, buffer, size, readCount);
+    timer.stop(ok ? *readCount : 0);
+    return ok;
+}
+
+/**
+    @brief "writeFull" timed as the stage "PROFILE_WRITE" (unless there is
+        nothing to write).
+
+    @param Profile* profile: Gets the counters added (NULL - none).
+    @param int fd: File to be written.
+    @param uint8_t* buffer: Bytes to be written.
+    @param size_t size: Number of bytes.
+    @return bool: false if the file could not be written.
+*/
+bool writeTimed(Profile* profile, int fd, const uint8_t* buffer, size_t size){
+    if(size == 0){
+        return true;
+    }
+    StageTimer timer(profile, PROFILE_WRITE);
+    bool ok = writeFull(fd, buffer, size);
+    timer.stop(ok ? size : 0);
+    return ok;
+}
+
+// Bytes in the hamming format encoded and interleaved ("addInterleavedParity"),
+// or de-interleaved and decoded, at a time, so that the frames are still in
+// the cache.
+const size_t INTERLEAVE_PIECE_BYTES = 32768;
+
+/**
+    @brief Blocks of the code in each piece of "INTERLEAVE_PIECE_BYTES": at
+        least one frame, and always whole frames.
+
+    @param Code code: Code of the hamming format.
+    @param unsigned depth: Depth of the interleaving.
+    @return size_t: Number of blocks.
+*/
+size_t interleavePieceBlocks(Code code, unsigned depth){
+    CodeBlocks blocks = codeBlocks(code);
+    size_t frameBlocks = ((depth / 8) * blocks.groupBits) / blocks.hammingBytes;
+    size_t frames = INTERLEAVE_PIECE_BYTES / (frameBlocks * blocks.hammingBytes);
+    return (frames > 0 ? frames : 1) * frameBlocks;
+}
+
+size_t encodeChunk(uint8_t* chunk, size_t chunkSize, uint8_t* output, uint64_t,
+                   const FileOptions& options, DecodeStats*){
+    if(options.interleave == 0){
+        if(options.gpu != NULL){
+            options.gpu->encode(chunk, chunkSize, output, options.code);
+        }else{
+            addHammingParity(chunk, chunkSize, output, options.code);
+        }
+        return encodedSize(chunkSize, options.code);
+    }
+    CodeBlocks blocks = codeBlocks(options.code);
+    size_t pieceBytes = interleavePieceBlocks(options.code, options.interleave) * blocks.bytes;
+    size_t outputSize = 0;
+    for(size_t from = 0; from < chunkSize; from += pieceBytes){
+        size_t size = chunkSize - from < pieceBytes ? chunkSize - from : pieceBytes;
+        size_t hammingSize = encodedSize(size, options.code);
+        addInterleavedParity(chunk + from, size, output + outputSize, options.code,
+                             options.interleave);
+        outputSize += hammingSize;
+    }
+    return outputSize;
+}
+
+size_t decodeChunk(uint8_t* chunk, size_t chunkSize, uint8_t* output, uint64_t,
+                   const FileOptions& options, DecodeStats* stats){
+    if(options.interleave == 0){
+        return options.gpu != NULL ?
+               options.gpu->decode(chunk, chunkSize, output, options.code, stats) :
+               removeHammingParity(chunk, chunkSize, output, options.code, stats);
+    }
+
+    // The chunk is a buffer or a private mapping, so it can be changed.
+    CodeBlocks blocks = codeBlocks(options.code);
+    size_t pieceBytes = interleavePieceBlocks(options.code, options.interleave) *
+                        blocks.hammingBytes;
+    size_t outputSize = 0;
+    for(size_t from = 0; from < chunkSize; from += pieceBytes){
+        size_t size = chunkSize - from < pieceBytes ? chunkSize - from : pieceBytes;
+        deinterleave(chunk + from, size, options.code, options.interleave);
+        outputSize += removeHammingParity(chunk + from, size, output + outputSize, options.code,
+                                          stats);
+    }
+    return outputSize;
+}
+
+size_t errorChunk(uint8_t* chunk, size_t chunkSize, uint8_t*, uint64_t offset,
+                  const FileOptions& options, DecodeStats*){
+    hammingError(chunk, chunkSize, options.errorModel, options.seed, offset);
+    return chunkSize;
+}
+
+size_t sameSize(size_t bytesCount, Code){
+    return bytesCount;
+}
+
+/**
+    @brief How errors are generated in a file, in chunks of about
+        "CHUNK_HAMMING_BYTES". They work over blocks of 7 bytes, of 8
+        groups for groups of more than 8 bits, or of a slab of the bit-sliced
+        layout.
+
+    @param ErrorModel& model: Model of the errors.
+    @return Conversion: The conversion.
+*/
+Conversion errorConversion(const ErrorModel& model){
+    size_t blockBytes = model.groupBits > 8 ? model.groupBits :
+                        model.sliced ? codeBlocks(CODE_7_4_SLICED).hammingBytes : 7;
+    size_t chunkBytes = (CHUNK_HAMMING_BYTES / blockBytes) * blockBytes;
+    Conversion conversion = {chunkBytes, 0, errorChunk, sameSize, blockBytes, blockBytes,
+                             false};
+    return conversion;
+}
+
+/**
+    @brief How a file is encoded with a code, in chunks of "CHUNK_BYTES"
+        original bytes.
+
+    @param Code code: Code of the hamming format.
+    @return Conversion: The conversion.
+*/
+Conversion encodeConversion(Code code){
+    CodeBlocks blocks = codeBlocks(code);
+    size_t chunkBlocks = CHUNK_BYTES / blocks.bytes;
+    Conversion conversion = {chunkBlocks * blocks.bytes, chunkBlocks * blocks.hammingBytes,
+                             encodeChunk, encodedSize, blocks.bytes, blocks.hammingBytes, true};
+    return conversion;
+}
+
+/**
+    @brief How a file is decoded with a code, in chunks that give
+        "CHUNK_BYTES" original bytes.
+
+    @param Code code: Code of the hamming format.
+    @return Conversion: The conversion.
+*/
+Conversion decodeConversion(Code code){
+    CodeBlocks blocks = codeBlocks(code);
+    size_t chunkBlocks = CHUNK_BYTES / blocks.bytes;
+    Conversion conversion = {chunkBlocks * blocks.hammingBytes, chunkBlocks * blocks.bytes,
+                             decodeChunk, decodedSize, blocks.hammingBytes, blocks.bytes, true};
+    return conversion;
+}
+
+/**
+    @brief A conversion whose blocks are the pieces of an interleaving, so
+        that every chunk, and every part of it, starts at a frame.
+
+    @param Conversion conversion: The conversion of the code.
+    @param Code code: Code of the hamming format.
+    @param unsigned depth: Depth of the interleaving (0 - none).
+    @return Conversion: The conversion.
+*/
+Conversion interleaveConversion(Conversion conversion, Code code, unsigned depth){
+    if(depth == 0){
+        return conversion;
+    }
+    size_t pieceBlocks = interleavePieceBlocks(code, depth);
+    size_t chunkPieces = conversion.chunkBytes / (conversion.blockBytes * pieceBlocks);
+    conversion.chunkBytes = chunkPieces * pieceBlocks * conversion.blockBytes;
+    conversion.outputBytes = chunkPieces * pieceBlocks * conversion.outputBlockBytes;
+    conversion.blockBytes *= pieceBlocks;
+    conversion.outputBlockBytes *= pieceBlocks;
+    conversion.gpu = false;
+    return conversion;
+}
+
+/**
+    @brief Options of a decoding that checks the CRC32C of each block of a
+        container, given to "verifyChunk" as its "FileOptions".
+*/
+struct VerifyOptions : FileOptions {
+    const ContainerHeader* header; /**< Header with the checksums. */
+    size_t blockHammingBytes;      /**< Size of a block of the container in
+                                        the hamming format. */
+
+    VerifyOptions() : header(NULL), blockHammingBytes(0){}
+};
+
+/**
+    @brief Decode whole blocks of a container, taking the data bits of the
+        ones whose CRC32C matches and correcting the others.
+
+    @param uint8_t* chunk: Whole blocks of the container.
+    @param size_t chunkSize: Number of bytes read.
+    @param uint8_t* output: Receives the original bytes.
+    @param uint64_t offset: Position of the chunk after the header (a
+        multiple of the size of a block).
+    @param FileOptions& options: A "VerifyOptions".
+    @param DecodeStats* stats: Gets the counters of the groups decoded added.
+    @return size_t: Number of bytes written to "output".
+*/
+size_t verifyChunk(uint8_t* chunk, size_t chunkSize, uint8_t* output, uint64_t offset,
+                   const FileOptions& options, DecodeStats* stats){
+    const VerifyOptions& verify = static_cast<const VerifyOptions&>(options);
+    const ContainerHeader& header = *verify.header;
+    size_t outputSize = 0;
+    for(size_t from = 0; from < chunkSize; from += verify.blockHammingBytes){
+        size_t block = (size_t)((offset + from) / verify.blockHammingBytes);
+        size_t size = chunkSize - from < verify.blockHammingBytes ? chunkSize - from :
+                                                                    verify.blockHammingBytes;
+
+        // A block cut at the end of the file is never taken as clean.
+        bool clean = (block < header.blockChecksums.size()) &&
+                     (size == containerBlockSize(header, block)) &&
+                     (crc32c(chunk + from, size) == header.blockChecksums[block]);
+        outputSize += clean ?
+            extractData(chunk + from, size, output + outputSize, options.code, stats) :
+            removeHammingParity(chunk + from, size, output + outputSize, options.code, stats);
+    }
+    return outputSize;
+}
+
+// Largest block of a container whose checksum is checked, as each thread
+// holds a whole one.
+const uint64_t MAX_VERIFY_BLOCK_BYTES = 64 * 1048576;
+
+/**
+    @brief How a container is decoded checking the CRC32C of its blocks, in
+        chunks of one block.
+
+    @param ContainerHeader& header: Header of the container (kept by
+        "verifyOptions").
+    @param FileOptions& options: How the file is decoded.
+    @param VerifyOptions* verifyOptions: Receives "options" and the header.
+    @param Conversion* conversion: Receives the conversion.
+    @return bool: false if the container has no checksums or blocks larger
+        than "MAX_VERIFY_BLOCK_BYTES", which are decoded as usual.
+*/
+bool verifyConversion(const ContainerHeader& header, const FileOptions& options,
+                      VerifyOptions* verifyOptions, Conversion* conversion){
+    uint64_t blockHammingBytes = encodedSize((size_t)header.blockBytes, header.code);
+    if(header.blockChecksums.empty() || (blockHammingBytes > MAX_VERIFY_BLOCK_BYTES)){
+        return false;
+    }
+    static_cast<FileOptions&>(*verifyOptions) = options;
+    verifyOptions->header = &header;
+    verifyOptions->blockHammingBytes = (size_t)blockHammingBytes;
+    Conversion verify = {(size_t)blockHammingBytes, (size_t)header.blockBytes, verifyChunk,
+                         decodedSize, (size_t)blockHammingBytes, (size_t)header.blockBytes,
+                         false};
+    *conversion = verify;
+    return true;
+}
+
+// Smallest part of a chunk given to a thread.
+const size_t MIN_PART_BYTES = 64 * 1024;
+
+// Chunks converted on a device, of a few of its smallest buffers, so that
+// copying one part of a chunk to it overlaps converting another.
+const size_t GPU_CHUNK_BYTES = 4 * GPU_MIN_BYTES;
+
+/**
+    @brief The threads of a conversion: "options.pool", or ones started for
+        it, which stop when it ends.
+*/
+struct OptionsPool {
+    std::unique_ptr<ThreadPool> own; /**< Started for the conversion. */
+    ThreadPool& pool;                /**< Threads that convert the blocks. */
+
+    explicit OptionsPool(const FileOptions& options) :
+        own(options.pool == NULL ? new ThreadPool(options.threads) : NULL),
+        pool(options.pool == NULL ? *own : *options.pool){}
+};
+
+/**
+    @brief Convert a chunk, splitting it in ranges of whole blocks among the
+        threads of the pool. Each range writes its own part of the output, in
+        the same order as the input, and counts its own groups, which are
+        added when it ends. A chunk that "options.gpu" takes goes to it
+        whole. "options.statsFn" gets the counters of the chunk.
+
+    @param ThreadPool& pool: Threads that convert the ranges.
+    @param Conversion& conversion: How the chunk is converted.
+    @param FileOptions& options: How the file is converted.
+    @param uint8_t* chunk: Bytes read.
+    @param size_t chunkSize: Number of bytes read.
+    @param uint64_t offset: Position of the chunk in the file read.
+    @param uint8_t* output: Receives the converted bytes (the chunk itself
+        when "conversion.outputBytes" is 0).
+    @return size_t: Number of bytes written to "output".
+*/
+size_t convertChunk(ThreadPool& pool, const Conversion& conversion, const FileOptions& options,
+                    uint8_t* chunk, size_t chunkSize, uint64_t offset, uint8_t* output){
+    StageTimer timer(options.profile, PROFILE_CONVERT);
+    DecodeStats stats;
+    size_t outputSize;
+    if((pool.size() == 1) ||
+       (conversion.gpu && (options.gpu != NULL) && options.gpu->takes(chunkSize, options.code))){
+        outputSize = conversion.chunkFn(chunk, chunkSize, output, offset, options, &stats);
+    }else{
+
+        // The last range also gets the bytes that do not make a whole block.
+        std::mutex statsMutex;
+        pool.runBlocks(chunkSize / conversion.blockBytes, MIN_PART_BYTES / conversion.blockBytes,
+                       [&](size_t firstBlock, size_t blocksCount, bool last){
+            size_t from = firstBlock * conversion.blockBytes;
+            DecodeStats partStats;
+            conversion.chunkFn(chunk + from,
+                               last ? chunkSize - from : blocksCount * conversion.blockBytes,
+                               output + (firstBlock * conversion.outputBlockBytes),
+                               offset + from, options, &partStats);
+            std::lock_guard<std::mutex> lock(statsMutex);
+            stats += partStats;
+        });
+        outputSize = conversion.outputSize(chunkSize, options.code);
+    }
+    timer.stop(chunkSize);
+    if(options.statsFn != NULL){
+        options.statsFn(offset, chunkSize, stats, options.statsContext);
+    }
+    return outputSize;
+}
+
+/**
+    @brief What a file has besides the bytes converted.
+*/
+struct Framing {
+    std::vector<uint8_t> prefix;  /**< Written before the converted bytes
+                                       (the header of a container). */
+    std::vector<uint8_t> pending; /**< Bytes to be converted already read
+                                       from the file (streamed only). */
+    uint64_t dataOffset;          /**< Bytes before the ones converted (the
+                                       header of a container read). */
+    uint64_t outputLimit;         /**< Largest number of converted bytes
+                                       written (the original size of a
+                                       container). */
+
+    Framing() : dataOffset(0), outputLimit((uint64_t)-1){}
+};
+
+/**
+    @brief Read chunks from a file, convert each one and write it to another
+        file.
+
+    @param int fdFrom: File to be read, after "framing.dataOffset".
+    @param int fdTo: File to be written.
+    @param Conversion& conversion: How the chunks are converted.
+    @param FileOptions& options: How the file is converted.
+    @param Framing& framing: What the files have besides the bytes
+        converted.
+    @param ThreadPool& pool: Threads that convert each chunk, which holds one
+        "conversion.chunkBytes" for each of them.
+    @param uint64_t* bytesRead: Receives the number of bytes converted.
+    @param uint64_t* bytesWritten: Receives the number of converted bytes
+        written.
+    @return bool: false if a file could not be read or written.
+*/
+bool streamFd(int fdFrom, int fdTo, const Conversion& conversion, const FileOptions& options,
+              const Framing& framing, ThreadPool& pool, uint64_t* bytesRead,
+              uint64_t* bytesWritten){
+    size_t chunkBytes = conversion.chunkBytes * pool.size();
+    ArenaScope scope(threadArena());
+    uint8_t* chunk = scope.allocate(chunkBytes);
+    uint8_t* outputPtr = conversion.outputBytes > 0 ?
+                         scope.allocate(conversion.outputBytes * pool.size()) : chunk;
+    *bytesRead = 0;
+    *bytesWritten = 0;
+    if(!writeTimed(options.profile, fdTo, framing.prefix.data(), framing.prefix.size())){
+        return false;
+    }
+
+    // The pending bytes are smaller than a chunk and start the first one.
+    size_t pendingSize = framing.pending.size();
+    memcpy(chunk, framing.pending.data(), pendingSize);
+    for(;;){
+        size_t chunkSize;
+        if(!readTimed(options.profile, fdFrom, chunk + pendingSize, chunkBytes - pendingSize,
+                      &chunkSize)){
+            return false;
+        }
+        chunkSize += pendingSize;
+        pendingSize = 0;
+        if(chunkSize == 0){
+            return true;
+        }
+        size_t outputSize = convertChunk(pool, conversion, options, chunk, chunkSize,
+                                         *bytesRead, outputPtr);
+        *bytesRead += chunkSize;
+        uint64_t leftSize = framing.outputLimit - *bytesWritten;
+        size_t writeSize = outputSize < leftSize ? outputSize : (size_t)leftSize;
+        if(!writeTimed(options.profile, fdTo, outputPtr, writeSize)){
+            return false;
+        }
+        *bytesWritten += writeSize;
+        if(chunkSize < chunkBytes){
+            return true;
+        }
+    }
+}
+
+/**
+    @brief Convert a file mapped in memory straight into another file mapped
+        in memory, with its final size set beforehand.
+
+    @param int fdFrom: File to be read.
+    @param int fdTo: File to be written (open for reading and writing).
+    @param Conversion& conversion: How the file is converted.
+    @param FileOptions& options: How the file is converted.
+    @param Framing& framing: What the files have besides the bytes
+        converted ("pending" is read again from the file).
+    @param ThreadPool& pool: Threads that convert the file.
+    @param uint64_t* bytesRead: Receives the number of bytes converted.
+    @param uint64_t* bytesWritten: Receives the number of converted bytes
+        written.
+    @param bool* ok: Receives false if a file could not be read or written.
+    @return bool: false if the files cannot be mapped (pipes, terminals, ...)
+        and nothing was done, so that they can still be streamed. Once the
+        output was written to, a mapping that fails gives "ok" false.
+*/
+bool mapFd(int fdFrom, int fdTo, const Conversion& conversion, const FileOptions& options,
+           const Framing& framing, ThreadPool& pool, uint64_t* bytesRead,
+           uint64_t* bytesWritten, bool* ok){
+#if HAMMING_MMAP
+    struct stat statFrom;
+    struct stat statTo;
+    if((fstat(fdFrom, &statFrom) != 0) || !S_ISREG(statFrom.st_mode) ||
+       (fstat(fdTo, &statTo) != 0) || !S_ISREG(statTo.st_mode) ||
+       ((uint64_t)statFrom.st_size < framing.dataOffset)){
+        return false;
+    }
+    size_t fileSize = (size_t)statFrom.st_size;
+    size_t inputSize = fileSize - (size_t)framing.dataOffset;
+    size_t outputSize = conversion.outputSize(inputSize, options.code);
+    size_t keptSize = outputSize < framing.outputLimit ? outputSize : (size_t)framing.outputLimit;
+    size_t prefixSize = framing.prefix.size();
+    *bytesRead = inputSize;
+    *bytesWritten = keptSize;
+
+    // Private copy-on-write pages, as "chunkFn" is allowed to change its
+    // input (the errors are generated in place). The mappings start at the
+    // beginning of the files, the only place sure to be aligned to a page.
+    // The input is mapped before anything is written, so the files can still
+    // be streamed when it cannot be.
+    void* inputMap = NULL;
+    if(inputSize > 0){
+        inputMap = mmap(NULL, fileSize, PROT_READ|PROT_WRITE, MAP_PRIVATE, fdFrom, 0);
+        if(inputMap == MAP_FAILED){
+            return false;
+        }
+        madvise(inputMap, fileSize, MADV_SEQUENTIAL);
+    }
+    if((ftruncate(fdTo, (off_t)(prefixSize + outputSize)) != 0) ||
+       !writeTimed(options.profile, fdTo, framing.prefix.data(), prefixSize)){
+        if(inputMap != NULL){
+            munmap(inputMap, fileSize);
+        }
+        *ok = false;
+        return true;
+    }
+    if(inputSize == 0){
+        *ok = true;
+        return true;
+    }
+    uint8_t* input = (uint8_t*)inputMap + framing.dataOffset;
+    void* outputMap = inputMap;
+    uint8_t* output = input;
+    if(conversion.outputBytes > 0){
+        if(outputSize > 0){
+            outputMap = mmap(NULL, prefixSize + outputSize, PROT_READ|PROT_WRITE, MAP_SHARED,
+                             fdTo, 0);
+        }
+
+        // The prefix is already written, so it is not streamed again.
+        if(outputMap == MAP_FAILED){
+            munmap(inputMap, fileSize);
+            *ok = false;
+            return true;
+        }
+        output = (uint8_t*)outputMap + prefixSize;
+    }
+
+    // In slices of the size of the streamed chunks, so "options.statsFn" is
+    // called for the same parts.
+    size_t sliceBytes = conversion.chunkBytes * pool.size();
+    size_t convertedSize = 0;
+    for(size_t from = 0; from < inputSize; from += sliceBytes){
+        size_t sliceSize = inputSize - from < sliceBytes ? inputSize - from : sliceBytes;
+        uint8_t* sliceOutput = conversion.outputBytes > 0 ?
+            output + ((from / conversion.blockBytes) * conversion.outputBlockBytes) :
+            input + from;
+        convertedSize += convertChunk(pool, conversion, options, input + from, sliceSize,
+                                      from, sliceOutput);
+    }
+    *ok = true;
+    if(conversion.outputBytes > 0){
+        if(outputSize > 0){
+            munmap(outputMap, prefixSize + outputSize);
+        }
+        if(keptSize < outputSize){
+            *ok = ftruncate(fdTo, (off_t)(prefixSize + keptSize)) == 0;
+        }
+    }else{
+
+        // Converted in place: the private pages still have to be written.
+        *ok = writeTimed(options.profile, fdTo, input,
+                         convertedSize < keptSize ? convertedSize : keptSize);
+    }
+    int mapErrno = errno;
+    munmap(inputMap, fileSize);
+    errno = mapErrno;
+    return true;
+#else
+    (void)fdFrom;
+    (void)fdTo;
+    (void)conversion;
+    (void)options;
+    (void)framing;
+    (void)pool;
+    (void)bytesRead;
+    (void)bytesWritten;
+    (void)ok;
+    return false;
+#endif
+}
+
+// Chunks of "ringFd" at the same time: one read, one converted and one
+// written.
+const unsigned RING_CHUNKS = 3;
+
+// Alignment of the positions, sizes and buffers of the reads and writes
+// with "O_DIRECT".
+const size_t DIRECT_ALIGNMENT = 4096;
+
+/**
+    @brief Turn "O_DIRECT" on or off for a file.
+
+    @param int fd: File.
+    @param bool direct: Whether its reads and writes skip the page cache.
+    @return bool: false if the file (or the system) does not allow it.
+*/
+bool setDirect(int fd, bool direct){
+#ifdef O_DIRECT
+    int flags = fcntl(fd, F_GETFL);
+    return (flags != -1) &&
+           (fcntl(fd, F_SETFL, direct ? flags | O_DIRECT : flags & ~O_DIRECT) == 0);
+#else
+    (void)fd;
+    return !direct;
+#endif
+}
+
+/**
+    @brief A chunk of "ringFd" and its buffers.
+*/
+struct RingChunk {
+    uint8_t* input;       /**< Bytes read. */
+    uint8_t* output;      /**< Converted bytes (the input when converted in
+                               place). */
+    uint64_t number;      /**< Position of the chunk in the file read, in
+                               chunks. */
+    size_t size;          /**< Bytes read so far. */
+    size_t writeSize;     /**< Converted bytes to be written. */
+    size_t written;       /**< Bytes written so far. */
+    uint64_t writeOffset; /**< Position of the write in the file written. */
+    bool reading;
+    bool writing;
+};
+
+/**
+    @brief Read, convert and write the chunks of a file at the same time,
+        through an io_uring: while a chunk is converted the next one is
+        being read and the one before it written, each at its own position
+        of the files, so the disk and the CPU do not wait for each other.
+        Each chunk is converted in order, so "options.statsFn" is called as
+        when streamed.
+
+    @param int fdFrom: File to be read.
+    @param int fdTo: File to be written.
+    @param Conversion& conversion: How the chunks are converted.
+    @param FileOptions& options: How the file is converted.
+    @param Framing& framing: What the files have besides the bytes
+        converted ("pending" is read again from the file).
+    @param ThreadPool& pool: Threads that convert each chunk.
+    @param uint64_t* bytesRead: Receives the number of bytes converted.
+    @param uint64_t* bytesWritten: Receives the number of converted bytes
+        written.
+    @param bool* ok: Receives false if a file could not be read or written.
+    @return bool: false if the files are not regular files or there is no
+        io_uring, and nothing was done, so that they can still be streamed.
+*/
+bool ringFd(int fdFrom, int fdTo, const Conversion& conversion, const FileOptions& options,
+            const Framing& framing, ThreadPool& pool, uint64_t* bytesRead,
+            uint64_t* bytesWritten, bool* ok){
+    struct stat statFrom;
+    struct stat statTo;
+    if((fstat(fdFrom, &statFrom) != 0) || !S_ISREG(statFrom.st_mode) ||
+       (fstat(fdTo, &statTo) != 0) || !S_ISREG(statTo.st_mode)){
+        return false;
+    }
+    IoRing ring(RING_CHUNKS);
+    if(!ring.ready()){
+        return false;
+    }
+    *bytesRead = 0;
+    *bytesWritten = 0;
+    size_t prefixSize = framing.prefix.size();
+    if(!writeTimed(options.profile, fdTo, framing.prefix.data(), prefixSize)){
+        *ok = false;
+        return true;
+    }
+
+    // The chunks are the streamed ones, so "options.statsFn" gets the same
+    // parts. "O_DIRECT" is used for the files whose chunks are all aligned,
+    // but the last write, which is made without it.
+    size_t chunkBytes = conversion.chunkBytes * pool.size();
+    size_t outputBytes = conversion.outputBytes * pool.size();
+    bool directFrom = options.direct && ((framing.dataOffset % DIRECT_ALIGNMENT) == 0) &&
+                      ((chunkBytes % DIRECT_ALIGNMENT) == 0) && setDirect(fdFrom, true);
+    bool directTo = options.direct && ((prefixSize % DIRECT_ALIGNMENT) == 0) &&
+                    (((outputBytes > 0 ? outputBytes : chunkBytes) % DIRECT_ALIGNMENT) == 0) &&
+                    setDirect(fdTo, true);
+    size_t inputSlot = ((chunkBytes + DIRECT_ALIGNMENT - 1) / DIRECT_ALIGNMENT) *
+                       DIRECT_ALIGNMENT;
+    size_t outputSlot = ((outputBytes + DIRECT_ALIGNMENT - 1) / DIRECT_ALIGNMENT) *
+                        DIRECT_ALIGNMENT;
+    ArenaScope scope(threadArena());
+    uint8_t* buffers = scope.allocate(RING_CHUNKS * (inputSlot + outputSlot), DIRECT_ALIGNMENT);
+    RingChunk chunks[RING_CHUNKS];
+    for(unsigned z = 0; z < RING_CHUNKS; z++){
+        chunks[z].input = buffers + (z * (inputSlot + outputSlot));
+        chunks[z].output = outputBytes > 0 ? chunks[z].input + inputSlot : chunks[z].input;
+        chunks[z].reading = false;
+        chunks[z].writing = false;
+    }
+
+    // A chunk is read into the buffers of the one "RING_CHUNKS" before it
+    // once that one is written, unless it comes after the end of the file:
+    // "lastChunk" is the first chunk found short (the writes complete in any
+    // order, so a later chunk can be found empty before an earlier one is
+    // read).
+    uint64_t lastChunk = (uint64_t)-1;
+    auto startRead = [&](RingChunk& chunk, uint64_t number) -> bool {
+        if(number > lastChunk){
+            return true;
+        }
+        chunk.number = number;
+        chunk.size = 0;
+        chunk.reading = true;
+        return ring.read(fdFrom, chunk.input, chunkBytes,
+                         framing.dataOffset + (number * chunkBytes), &chunk - chunks);
+    };
+    auto complete = [&]() -> bool {
+        uint64_t tag;
+        int result;
+        if(!ring.wait(&tag, &result)){
+            return false;
+        }
+        RingChunk& chunk = chunks[tag];
+        if(result < 0){
+            chunk.reading = false;
+            chunk.writing = false;
+            errno = -result;
+            return false;
+        }
+        if(chunk.reading){
+
+            // Read again for the rest, unless it is the end of the file (a
+            // read with "O_DIRECT" that stops before an aligned position).
+            chunk.size += (size_t)result;
+            if((result > 0) && (chunk.size < chunkBytes) &&
+               (!directFrom || ((chunk.size % DIRECT_ALIGNMENT) == 0))){
+                return ring.read(fdFrom, chunk.input + chunk.size, chunkBytes - chunk.size,
+                                 framing.dataOffset + (chunk.number * chunkBytes) + chunk.size,
+                                 tag);
+            }
+            chunk.reading = false;
+            if((chunk.size < chunkBytes) && (chunk.number < lastChunk)){
+                lastChunk = chunk.number;
+            }
+            return true;
+        }
+        chunk.written += (size_t)result;
+        if(chunk.written < chunk.writeSize){
+            if(result == 0){
+                errno = EIO;
+                return false;
+            }
+            return ring.write(fdTo, chunk.output + chunk.written, chunk.writeSize - chunk.written,
+                              chunk.writeOffset + chunk.written, tag);
+        }
+        chunk.writing = false;
+        return startRead(chunk, chunk.number + RING_CHUNKS);
+    };
+
+    bool fine = true;
+    for(unsigned z = 0; fine && (z < RING_CHUNKS); z++){
+        fine = startRead(chunks[z], z);
+    }
+    uint64_t outputOffset = prefixSize;
+    uint64_t writesCount = 0;
+    for(uint64_t number = 0; fine; number++){
+        RingChunk& chunk = chunks[number % RING_CHUNKS];
+        fine = ring.submit();
+        StageTimer readTimer(options.profile, PROFILE_READ);
+        while(fine && (chunk.writing || chunk.reading)){
+            fine = complete();
+        }
+        readTimer.stop(chunk.size);
+
+        // Not read again: the file ended before it.
+        if(!fine || (chunk.number != number) || (chunk.size == 0)){
+            break;
+        }
+        size_t outputSize = convertChunk(pool, conversion, options, chunk.input, chunk.size,
+                                         *bytesRead, chunk.output);
+        *bytesRead += chunk.size;
+        uint64_t leftSize = framing.outputLimit - *bytesWritten;
+        chunk.writeSize = outputSize < leftSize ? outputSize : (size_t)leftSize;
+        chunk.written = 0;
+        chunk.writeOffset = outputOffset;
+        bool last = chunk.size < chunkBytes;
+        if(chunk.writeSize == 0){
+            fine = startRead(chunk, number + RING_CHUNKS);
+        }else{
+            if(directTo && ((chunk.writeSize % DIRECT_ALIGNMENT) != 0)){
+
+                // Once the writes before it are done.
+                StageTimer writeTimer(options.profile, PROFILE_WRITE);
+                for(unsigned z = 0; z < RING_CHUNKS; z++){
+                    while(fine && chunks[z].writing){
+                        fine = complete();
+                    }
+                }
+                writeTimer.stop(0, 0);
+                if(fine){
+                    fine = setDirect(fdTo, false);
+                    directTo = !fine;
+                }
+            }
+            chunk.writing = fine && ring.write(fdTo, chunk.output, chunk.writeSize,
+                                               outputOffset, number % RING_CHUNKS);
+            fine = chunk.writing;
+            writesCount++;
+            outputOffset += chunk.writeSize;
+            *bytesWritten += chunk.writeSize;
+        }
+        if(last){
+            break;
+        }
+    }
+    if(fine && (ring.busy() > 0)){
+        fine = ring.submit();
+    }
+
+    // Every read and write must complete before the buffers are freed, the
+    // ones after an error too.
+    int ringErrno = fine ? 0 : errno;
+    lastChunk = 0;
+    StageTimer writeTimer(options.profile, PROFILE_WRITE);
+    while(ring.busy() > 0){
+        unsigned busy = ring.busy();
+        if(!complete()){
+            ringErrno = fine ? errno : ringErrno;
+            fine = false;
+            if(ring.busy() == busy){
+
+                // The ring itself failed.
+                break;
+            }
+        }
+    }
+    writeTimer.stop(*bytesWritten, writesCount);
+    if(directFrom){
+        setDirect(fdFrom, false);
+    }
+    if(directTo){
+        setDirect(fdTo, false);
+    }
+    *ok = fine;
+    if(!fine){
+        errno = ringErrno;
+    }
+    return true;
+}
+
+/**
+    @brief Files being converted.
+*/
+struct OpenFiles {
+    int fdFrom;
+    int fdTo;
+    bool stdioFrom;
+    bool stdioTo;
+};
+
+/**
+    @brief Open the files of a conversion.
+
+    @param char* flNameFrom: File to be read ("-" - standard input).
+    @param char* flNameTo: File to be written ("-" - standard output).
+    @param OpenFiles* files: Receives the files.
+    @return bool: false if a file could not be opened.
+*/
+bool openFiles(const char* flNameFrom, const char* flNameTo, OpenFiles* files){
+    files->stdioFrom = isStdio(flNameFrom);
+    files->stdioTo = isStdio(flNameTo);
+    files->fdFrom = files->stdioFrom ? STDIN_FILENO : open(flNameFrom, O_RDONLY|O_BINARY);
+    if(files->fdFrom < 0){
+        return false;
+    }
+
+    // Read and write, because "mmap" needs both to share the writes.
+    files->fdTo = files->stdioTo ? STDOUT_FILENO :
+                  open(flNameTo, O_RDWR|O_CREAT|O_TRUNC|O_BINARY, 0666);
+    if(files->fdTo < 0){
+        int openErrno = errno;
+        if(!files->stdioFrom){
+            close(files->fdFrom);
+        }
+        errno = openErrno;
+        return false;
+    }
+#if defined(_WIN32) || defined(__CYGWIN__)
+    if(files->stdioFrom){
+        setmode(files->fdFrom, O_BINARY);
+    }
+    if(files->stdioTo){
+        setmode(files->fdTo, O_BINARY);
+    }
+#endif
+    return true;
+}
+
+/**
+    @brief Close the files of a conversion, keeping "errno".
+
+    @param OpenFiles& files: Files.
+    @param bool ok: Whether the conversion worked.
+    @return bool: "ok", or false if the file written could not be closed.
+*/
+bool closeFiles(const OpenFiles& files, bool ok){
+    int convertErrno = errno;
+    if(!files.stdioFrom){
+        close(files.fdFrom);
+    }
+    if(!files.stdioTo && (close(files.fdTo) != 0) && ok){
+        return false;
+    }
+    errno = convertErrno;
+    return ok;
+}
+
+/**
+    @brief Convert the bytes of a file into another file, mapped or
+        streamed. The chunks are of about "GPU_CHUNK_BYTES" when they can go
+        to "options.gpu".
+
+    @param OpenFiles& files: Files.
+    @param Conversion& conversion: How the file is converted.
+    @param FileOptions& options: How the files are read, converted and
+        written.
+    @param Framing& framing: What the files have besides the bytes
+        converted.
+    @param uint64_t* bytesRead: Receives the number of bytes converted.
+    @param uint64_t* bytesWritten: Receives the number of converted bytes
+        written.
+    @return bool: false if a file could not be read or written.
+*/
+bool convertFiles(const OpenFiles& files, const Conversion& conversion,
+                  const FileOptions& options, const Framing& framing, uint64_t* bytesRead,
+                  uint64_t* bytesWritten){
+
+    // The standard input and output are always streamed, as the shell may
+    // have opened them in a way that does not allow mapping.
+    OptionsPool threads(options);
+    ThreadPool& pool = threads.pool;
+    Conversion chunks = conversion;
+    size_t scale = GPU_CHUNK_BYTES / (conversion.chunkBytes * pool.size());
+    if(conversion.gpu && (options.gpu != NULL) && options.gpu->ready() && (scale > 1)){
+        chunks.chunkBytes *= scale;
+        chunks.outputBytes *= scale;
+    }
+    bool ok;
+    if((options.ioMode == IO_MMAP) && !files.stdioFrom && !files.stdioTo &&
+       mapFd(files.fdFrom, files.fdTo, chunks, options, framing, pool, bytesRead,
+             bytesWritten, &ok)){
+        return ok;
+    }
+    if((options.ioMode == IO_URING) && !files.stdioFrom && !files.stdioTo &&
+       ringFd(files.fdFrom, files.fdTo, chunks, options, framing, pool, bytesRead,
+              bytesWritten, &ok)){
+        return ok;
+    }
+    return streamFd(files.fdFrom, files.fdTo, chunks, options, framing, pool, bytesRead,
+                    bytesWritten);
+}
+
+/**
+    @brief Skip bytes of a file, with "lseek" when it can, reading them
+        otherwise (pipes).
+
+    @param int fd: File being read.
+    @param std::vector<uint8_t>* pending: Bytes already read from it, which
+        come before the others (the ones left after skipping are kept).
+    @param uint64_t skipBytes: Number of bytes to skip.
+    @return bool: false if the file could not be read.
+*/
+bool skipInput(int fd, std::vector<uint8_t>* pending, uint64_t skipBytes){
+    if(skipBytes <= pending->size()){
+        pending->erase(pending->begin(), pending->begin() + (size_t)skipBytes);
+        return true;
+    }
+    skipBytes -= pending->size();
+    pending->clear();
+    if(lseek(fd, (off_t)skipBytes, SEEK_CUR) != (off_t)-1){
+        return true;
+    }
+    ArenaScope scope(threadArena());
+    uint8_t* buffer = scope.allocate(CHUNK_HAMMING_BYTES);
+    while(skipBytes > 0){
+        size_t readBytes = skipBytes < CHUNK_HAMMING_BYTES ? (size_t)skipBytes :
+                                                            CHUNK_HAMMING_BYTES;
+        size_t readCount;
+        if(!readFull(fd, buffer, readBytes, &readCount)){
+            return false;
+        }
+        if(readCount < readBytes){
+            return true;
+        }
+        skipBytes -= readCount;
+    }
+    return true;
+}
+
+/**
+    @brief Compute the CRC32C of each block of a container just written and
+        write its header again with them.
+
+    @param int fd: Container written (read again).
+    @param ContainerHeader* header: Header written, gets the checksums.
+    @return bool: false if the file could not be read or written.
+*/
+bool writeChecksums(int fd, ContainerHeader* header){
+    if(header->blockOffsets.empty()){
+        return true;
+    }
+
+    // The blocks follow each other, so they are read in a row.
+    if(lseek(fd, (off_t)header->blockOffsets[0], SEEK_SET) == (off_t)-1){
+        return false;
+    }
+    ArenaScope scope(threadArena());
+    uint8_t* buffer = scope.allocate(CHUNK_HAMMING_BYTES);
+    for(size_t z = 0; z < header->blockOffsets.size(); z++){
+        uint64_t leftBytes = containerBlockSize(*header, z);
+        uint32_t crc = 0;
+        while(leftBytes > 0){
+            size_t readBytes = leftBytes < CHUNK_HAMMING_BYTES ? (size_t)leftBytes :
+                                                                 CHUNK_HAMMING_BYTES;
+            size_t readCount;
+            if(!readFull(fd, buffer, readBytes, &readCount)){
+                return false;
+            }
+            if(readCount < readBytes){
+                errno = EIO;
+                return false;
+            }
+            crc = crc32c(buffer, readCount, crc);
+            leftBytes -= readCount;
+        }
+        header->blockChecksums[z] = crc;
+    }
+    std::vector<uint8_t> bytes(containerHeaderBytes(*header));
+    writeContainerHeader(*header, bytes.data());
+    return (lseek(fd, 0, SEEK_SET) == 0) && writeFull(fd, bytes.data(), bytes.size());
+}
+
+/**
+    @brief Read the header of a container at the start of a file, if it is
+        one.
+
+    @param int fd: File at its start.
+    @param Framing* framing: Gets the size of the header in "dataOffset" and
+        the header itself in "prefix", or the bytes read that are not a
+        header in "pending".
+    @param ContainerHeader* header: Receives the header (if it is a
+        container).
+    @param bool* container: Receives whether the file is a container.
+    @return bool: false if the file could not be read or its header is
+        damaged ("errno" "EBADMSG").
+*/
+bool readHeader(int fd, Framing* framing, ContainerHeader* header, bool* container){
+    std::vector<uint8_t> bytes(CONTAINER_FIXED_BYTES);
+    size_t readCount;
+    if(!readFull(fd, bytes.data(), bytes.size(), &readCount)){
+        return false;
+    }
+    bytes.resize(readCount);
+    *container = hasContainerMagic(bytes.data(), bytes.size());
+    if(!*container){
+        framing->pending.swap(bytes);
+        return true;
+    }
+    size_t headerSize = containerHeaderSize(bytes.data(), bytes.size());
+    if(headerSize > 0){
+        bytes.resize(headerSize);
+        if(!readFull(fd, bytes.data() + CONTAINER_FIXED_BYTES, headerSize - CONTAINER_FIXED_BYTES,
+                     &readCount)){
+            return false;
+        }
+    }
+    if((headerSize == 0) || (readCount < headerSize - CONTAINER_FIXED_BYTES) ||
+       !readContainerHeader(bytes.data(), bytes.size(), header)){
+        errno = EBADMSG;
+        return false;
+    }
+    framing->dataOffset = headerSize;
+    framing->prefix.swap(bytes);
+    return true;
+}
+
+/**
+    @brief A range of bytes written again by "scrubPart".
+*/
+struct ScrubRange {
+    size_t from; /**< Position in the part scrubbed. */
+    size_t size; /**< Number of bytes. */
+};
+
+// Bytes of a file in the hamming format scrubbed and written again at once.
+const size_t SCRUB_SEGMENT_BYTES = 4096;
+
+/**
+    @brief Scrub a part of a file in the hamming format in memory, in
+        segments of about "SCRUB_SEGMENT_BYTES" split among the threads of
+        the pool. With checksums, the blocks of the container whose CRC32C
+        matches are not even decoded.
+
+    @param ThreadPool& pool: Threads that scrub the segments.
+    @param uint8_t* bytes: Bytes of the part, corrected in place.
+    @param size_t bytesCount: Number of bytes (whole blocks of the code, or
+        of the container with "header", but at the end of the file).
+    @param uint64_t offset: Position of the part after the header.
+    @param Code code: Code of the hamming format.
+    @param ContainerHeader* header: Header with the checksums of the blocks
+        (NULL - not checked).
+    @param std::vector<ScrubRange>* ranges: Receives the ranges written
+        again, in order.
+    @param DecodeStats* stats: Gets the counters of the groups decoded added.
+    @return uint64_t: Number of bytes written again.
+*/
+uint64_t scrubPart(ThreadPool& pool, uint8_t* bytes, size_t bytesCount, uint64_t offset,
+                   Code code, const ContainerHeader* header, std::vector<ScrubRange>* ranges,
+                   DecodeStats* stats){
+
+    // The segments start again at each block of the container, whose CRC is
+    // checked first.
+    size_t unitBytes = bytesCount;
+    if(header != NULL){
+        unitBytes = encodedSize((size_t)header->blockBytes, code);
+    }
+    size_t units = bytesCount == 0 ? 0 : ((bytesCount - 1) / unitBytes) + 1;
+    ArenaScope scope(threadArena());
+    uint8_t* dirty = scope.allocate(units);
+    memset(dirty, 1, units);
+    if(header != NULL){
+        pool.run(units, [&](size_t unit){
+            size_t from = unit * unitBytes;
+            size_t size = bytesCount - from < unitBytes ? bytesCount - from : unitBytes;
+            size_t block = (size_t)((offset + from) / unitBytes);
+            dirty[unit] = (block >= header->blockChecksums.size()) ||
+                          (size != containerBlockSize(*header, block)) ||
+                          (crc32c(bytes + from, size) != header->blockChecksums[block]);
+        });
+    }
+    CodeBlocks blocks = codeBlocks(code);
+    size_t segmentBytes = (SCRUB_SEGMENT_BYTES / blocks.hammingBytes) * blocks.hammingBytes;
+    std::vector<ScrubRange> segments;
+    for(size_t unit = 0; unit < units; unit++){
+        size_t unitEnd = bytesCount - (unit * unitBytes) < unitBytes ? bytesCount :
+                                                                       (unit + 1) * unitBytes;
+        for(size_t from = unit * unitBytes; dirty[unit] && (from < unitEnd);
+            from += segmentBytes){
+            ScrubRange segment = {from, unitEnd - from < segmentBytes ? unitEnd - from :
+                                                                        segmentBytes};
+            segments.push_back(segment);
+        }
+    }
+    std::vector<uint64_t> rewritten(segments.size(), 0);
+    std::vector<DecodeStats> segmentStats(segments.size());
+    pool.run(segments.size(), [&](size_t segment){
+        rewritten[segment] = scrubHamming(bytes + segments[segment].from, segments[segment].size,
+                                          code, &segmentStats[segment]);
+    });
+
+    // Whole segments are written again, the ones next to each other at once.
+    uint64_t rewrittenBytes = 0;
+    ranges->clear();
+    for(size_t z = 0; z < segments.size(); z++){
+        *stats += segmentStats[z];
+        if(rewritten[z] == 0){
+            continue;
+        }
+        rewrittenBytes += rewritten[z];
+        if(!ranges->empty() && (ranges->back().from + ranges->back().size == segments[z].from)){
+            ranges->back().size += segments[z].size;
+        }else{
+            ranges->push_back(segments[z]);
+        }
+    }
+    return rewrittenBytes;
+}
+
+/**
+    @brief Scrub a file mapped in memory: only the pages of the segments
+        written again are changed, and so written back by the system.
+
+    @param int fd: File (open for reading and writing).
+    @param uint64_t dataOffset: Size of the header.
+    @param uint64_t dataEnd: End of the bytes in the hamming format.
+    @param size_t chunkBytes: Bytes given to "options.statsFn" at a time.
+    @param FileOptions& options: How the file is scrubbed.
+    @param ContainerHeader* header: Header with the checksums of the blocks
+        (NULL - not checked).
+    @param ThreadPool& pool: Threads that scrub the file.
+    @param uint64_t* bytesRewritten: Receives the number of bytes written
+        again.
+    @param bool* ok: Receives false if the file could not be written.
+    @return bool: false if the file cannot be mapped and nothing was done.
+*/
+bool scrubMapped(int fd, uint64_t dataOffset, uint64_t dataEnd, size_t chunkBytes,
+                 const FileOptions& options, const ContainerHeader* header, ThreadPool& pool,
+                 uint64_t* bytesRewritten, bool* ok){
+#if HAMMING_MMAP
+    *bytesRewritten = 0;
+    *ok = true;
+    if(dataEnd <= dataOffset){
+        return true;
+    }
+    void* map = mmap(NULL, (size_t)dataEnd, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+    if(map == MAP_FAILED){
+        return false;
+    }
+    madvise(map, (size_t)dataEnd, MADV_SEQUENTIAL);
+    uint8_t* bytes = (uint8_t*)map + dataOffset;
+    size_t bytesCount = (size_t)(dataEnd - dataOffset);
+    std::vector<ScrubRange> ranges;
+    for(size_t from = 0; from < bytesCount; from += chunkBytes){
+        size_t size = bytesCount - from < chunkBytes ? bytesCount - from : chunkBytes;
+        DecodeStats stats;
+        StageTimer timer(options.profile, PROFILE_CONVERT);
+        *bytesRewritten += scrubPart(pool, bytes + from, size, from, options.code, header,
+                                     &ranges, &stats);
+        timer.stop(size);
+        if(options.statsFn != NULL){
+            options.statsFn(from, size, stats, options.statsContext);
+        }
+    }
+    *ok = munmap(map, (size_t)dataEnd) == 0;
+    return true;
+#else
+    (void)fd;
+    (void)dataOffset;
+    (void)dataEnd;
+    (void)chunkBytes;
+    (void)options;
+    (void)header;
+    (void)pool;
+    (void)bytesRewritten;
+    (void)ok;
+    return false;
+#endif
+}
+
+/**
+    @brief Scrub a file read chunk by chunk, writing again only the segments
+        that were corrected.
+
+    @param int fd: File (open for reading and writing).
+    @param uint64_t dataOffset: Size of the header.
+    @param uint64_t dataEnd: End of the bytes in the hamming format.
+    @param size_t chunkBytes: Size of the chunks read.
+    @param FileOptions& options: How the file is scrubbed.
+    @param ContainerHeader* header: Header with the checksums of the blocks
+        (NULL - not checked).
+    @param ThreadPool& pool: Threads that scrub each chunk.
+    @param uint64_t* bytesRewritten: Receives the number of bytes written
+        again.
+    @return bool: false if the file could not be read or written.
+*/
+bool scrubStreamed(int fd, uint64_t dataOffset, uint64_t dataEnd, size_t chunkBytes,
+                   const FileOptions& options, const ContainerHeader* header, ThreadPool& pool,
+                   uint64_t* bytesRewritten){
+    *bytesRewritten = 0;
+    ArenaScope scope(threadArena());
+    uint8_t* chunk = scope.allocate(chunkBytes);
+    std::vector<ScrubRange> ranges;
+    for(uint64_t position = dataOffset; position < dataEnd; position += chunkBytes){
+        size_t readBytes = dataEnd - position < chunkBytes ? (size_t)(dataEnd - position) :
+                                                             chunkBytes;
+        size_t chunkSize;
+        if((lseek(fd, (off_t)position, SEEK_SET) == (off_t)-1) ||
+           !readTimed(options.profile, fd, chunk, readBytes, &chunkSize)){
+            return false;
+        }
+        DecodeStats stats;
+        StageTimer timer(options.profile, PROFILE_CONVERT);
+        *bytesRewritten += scrubPart(pool, chunk, chunkSize, position - dataOffset,
+                                     options.code, header, &ranges, &stats);
+        timer.stop(chunkSize);
+        for(size_t z = 0; z < ranges.size(); z++){
+            if((lseek(fd, (off_t)(position + ranges[z].from), SEEK_SET) == (off_t)-1) ||
+               !writeTimed(options.profile, fd, chunk + ranges[z].from, ranges[z].size)){
+                return false;
+            }
+        }
+        if(options.statsFn != NULL){
+            options.statsFn(position - dataOffset, chunkSize, stats, options.statsContext);
+        }
+        if(chunkSize < readBytes){
+            break;
+        }
+    }
+    return true;
+}
+
+// Original bytes taken at a time through the whole round trip of
+// "verifyFile", so that all its steps work in the cache.
+const size_t VERIFY_PIECE_BYTES = 32768;
+
+/**
+    @brief Options of a round trip of "verifyFile", given to "verifyChunk" as
+        its "FileOptions".
+*/
+struct RoundTripOptions : FileOptions {
+    size_t unitBytes;       /**< Original bytes of the smallest unit: whole
+                                 blocks of the code and of the errors, and
+                                 whole pieces of the interleaving. */
+    size_t unitHammingBytes; /**< Its size in the hamming format. */
+    std::mutex* mutex;      /**< Guards "stats". */
+    VerifyStats* stats;     /**< Gets the counters of each part added. */
+};
+
+/**
+    @brief Encode, generate errors, decode and compare bytes, a piece at a
+        time.
+
+    @param uint8_t* chunk: Original bytes.
+    @param size_t chunkSize: Number of bytes.
+    @param uint8_t*: Not used.
+    @param uint64_t offset: Position of the bytes in the original file (a
+        multiple of the unit).
+    @param FileOptions& options: "RoundTripOptions".
+    @param DecodeStats* stats: Gets the counters of the groups decoded added.
+    @return size_t: 0.
+*/
+size_t roundTripChunk(uint8_t* chunk, size_t chunkSize, uint8_t*, uint64_t offset,
+                      const FileOptions& options, DecodeStats* stats){
+    const RoundTripOptions& roundTrip = static_cast<const RoundTripOptions&>(options);
+    Code code = options.code;
+    size_t pieceBytes = VERIFY_PIECE_BYTES < roundTrip.unitBytes ? roundTrip.unitBytes :
+                        (VERIFY_PIECE_BYTES / roundTrip.unitBytes) * roundTrip.unitBytes;
+
+    // The decoding can give one byte more than the original (see
+    // "decodedSize").
+    size_t pieceHammingBytes = encodedSize(pieceBytes, code);
+    ArenaScope scope(threadArena());
+    uint8_t* hammingBytes = scope.allocate(pieceHammingBytes);
+    uint8_t* errorBytes = scope.allocate(pieceHammingBytes);
+    uint8_t* decoded = scope.allocate(pieceBytes + 1);
+    VerifyStats partStats;
+    for(size_t from = 0; from < chunkSize; from += pieceBytes){
+        size_t size = chunkSize - from < pieceBytes ? chunkSize - from : pieceBytes;
+        size_t hammingSize = encodedSize(size, code);
+        uint64_t hammingOffset = ((offset + from) / roundTrip.unitBytes) *
+                                 roundTrip.unitHammingBytes;
+        if(options.interleave != 0){
+            addInterleavedParity(chunk + from, size, hammingBytes, code, options.interleave);
+        }else{
+            addHammingParity(chunk + from, size, hammingBytes, code);
+        }
+        memcpy(errorBytes, hammingBytes, hammingSize);
+        hammingError(errorBytes, hammingSize, options.errorModel, options.seed,
+                     hammingOffset);
+        size_t z = 0;
+        for( ; z + 8 <= hammingSize; z += 8){
+            uint64_t errorWord;
+            uint64_t hammingWord;
+            memcpy(&errorWord, errorBytes + z, 8);
+            memcpy(&hammingWord, hammingBytes + z, 8);
+            partStats.flips += (uint64_t)__builtin_popcountll(errorWord ^ hammingWord);
+        }
+        for( ; z < hammingSize; z++){
+            partStats.flips += (uint64_t)__builtin_popcount(errorBytes[z] ^ hammingBytes[z]);
+        }
+        if(options.interleave != 0){
+            deinterleave(errorBytes, hammingSize, code, options.interleave);
+        }
+        removeHammingParity(errorBytes, hammingSize, decoded, code,
+                            &partStats.decode);
+        if(memcmp(decoded, chunk + from, size) != 0){
+            for(size_t z = 0; z < size; z++){
+                if(decoded[z] != chunk[from + z]){
+                    if(partStats.wrongBytes == 0){
+                        partStats.firstWrong = offset + from + z;
+                    }
+                    partStats.wrongBytes++;
+                }
+            }
+        }
+        partStats.bytes += size;
+    }
+    *stats += partStats.decode;
+    std::lock_guard<std::mutex> lock(*roundTrip.mutex);
+    roundTrip.stats->bytes += partStats.bytes;
+    roundTrip.stats->decode += partStats.decode;
+    roundTrip.stats->flips += partStats.flips;
+    if((partStats.wrongBytes > 0) && (partStats.firstWrong < roundTrip.stats->firstWrong)){
+        roundTrip.stats->firstWrong = partStats.firstWrong;
+    }
+    roundTrip.stats->wrongBytes += partStats.wrongBytes;
+    return 0;
+}
+
+// Files of a batch converted one at a time, by all the threads.
+const uint64_t BATCH_LARGE_BYTES = 16 * (uint64_t)CHUNK_BYTES;
+
+/**
+    @brief Add the counters of a chunk of a file of a batch to the ones of
+        the file.
+
+    @param uint64_t: Not used.
+    @param uint64_t: Not used.
+    @param DecodeStats& stats: Groups decoded and corrected in the chunk.
+    @param void* context: "BatchFile" of the file.
+    @return void.
+*/
+void addBatchStats(uint64_t, uint64_t, const DecodeStats& stats, void* context){
+    ((BatchFile*)context)->stats += stats;
+}
+
+/**
+    @brief Convert a file of a batch, keeping whether it worked.
+
+    @param BatchFile* file: File, which gets the result.
+    @param FileFn fileFn: Converts the file.
+    @param FileOptions& options: How the files are read, converted and
+        written.
+    @return void.
+*/
+void convertBatchFile(BatchFile* file, FileFn fileFn, const FileOptions& options){
+    FileOptions fileOptions = options;
+    fileOptions.statsFn = addBatchStats;
+    fileOptions.statsContext = file;
+    fileOptions.profile = options.profile != NULL ? &file->profile : NULL;
+    file->ok = fileFn(file->from.c_str(), file->to.c_str(), fileOptions);
+    file->error = file->ok ? 0 : errno;
+}
+
+/**
+    @brief What a thread of a batch keeps from one file to the next.
+*/
+struct BatchWorker {
+    ThreadPool pool; /**< The thread alone. */
+
+    BatchWorker() : pool(1){}
+};
+
+/**
+    @brief Add a file to a batch, written to a directory with its name.
+
+    @param std::string& from: File to be read.
+    @param char* outputDir: Directory of the file written.
+    @param std::vector<BatchFile>* files: Gets the file added.
+    @return bool: false if it is "-" or would be written over itself
+        ("errno" "EINVAL").
+*/
+bool addBatchFile(const std::string& from, const char* outputDir, std::vector<BatchFile>* files){
+    if(isStdio(from.c_str())){
+        errno = EINVAL;
+        return false;
+    }
+    size_t slash = from.find_last_of('/');
+    BatchFile file;
+    file.from = from;
+    file.to = std::string(outputDir) + "/" +
+              (slash == std::string::npos ? from : from.substr(slash + 1));
+
+    // A file that cannot be read now fails when it is converted.
+    struct stat statFrom;
+    struct stat statTo;
+    if(stat(from.c_str(), &statFrom) == 0){
+        file.size = (uint64_t)statFrom.st_size;
+        if((stat(file.to.c_str(), &statTo) == 0) && (statTo.st_ino != 0) &&
+           (statTo.st_dev == statFrom.st_dev) && (statTo.st_ino == statFrom.st_ino)){
+            errno = EINVAL;
+            return false;
+        }
+    }
+    files->push_back(file);
+    return true;
+}
+
+/**
+    @brief Read the names of the files of a batch, one per line.
+
+    @param FILE* list: File with the names.
+    @param std::vector<std::string>* names: Gets the names that are not empty
+        (without the "\r" of a line ended with "\r\n").
+    @return bool: false if the file could not be read.
+*/
+bool readBatchList(FILE* list, std::vector<std::string>* names){
+    std::string line;
+    for(;;){
+        int c = getc(list);
+        if((c != EOF) && (c != '\n')){
+            line += (char)c;
+            continue;
+        }
+        if(!line.empty() && (line[line.size() - 1] == '\r')){
+            line.erase(line.size() - 1);
+        }
+        if(!line.empty()){
+            names->push_back(line);
+        }
+        line.clear();
+        if(c == EOF){
+            if(ferror(list)){
+                errno = EIO;
+                return false;
+            }
+            return true;
+        }
+    }
+}
+
+} // namespace
+
+bool isStdio(const char* fileName){
+    return strcmp(fileName, "-") == 0;
+}
+
+bool convertFile(const char* flNameFrom, const char* flNameTo,
+                 const Conversion& conversion, const FileOptions& options,
+                 uint64_t* bytesRead){
+    OpenFiles files;
+    if(!openFiles(flNameFrom, flNameTo, &files)){
+        return false;
+    }
+    uint64_t readCount = 0;
+    uint64_t writeCount;
+    bool ok = convertFiles(files, conversion, options, Framing(), &readCount, &writeCount);
+    if(bytesRead != NULL){
+        *bytesRead = readCount;
+    }
+    return closeFiles(files, ok);
+}
+
+bool encodeFile(const char* flNameFrom, const char* flNameTo, const FileOptions& options){
+    if((options.interleave != 0) &&
+       (options.container || !validInterleave(options.code, options.interleave))){
+        errno = EINVAL;
+        return false;
+    }
+    if(!options.container){
+        return convertFile(flNameFrom, flNameTo,
+                           interleaveConversion(encodeConversion(options.code), options.code,
+                                                options.interleave),
+                           options);
+    }
+    OpenFiles files;
+    if(!openFiles(flNameFrom, flNameTo, &files)){
+        return false;
+    }
+
+    // The header comes first, so the size must be known before reading. The
+    // checksums are computed from the blocks written, and then written over
+    // the zeros the header has for them.
+    struct stat statFrom;
+    struct stat statTo;
+    if((fstat(files.fdFrom, &statFrom) != 0) || !S_ISREG(statFrom.st_mode) ||
+       (options.checksums && ((fstat(files.fdTo, &statTo) != 0) || !S_ISREG(statTo.st_mode)))){
+        errno = ESPIPE;
+        return closeFiles(files, false);
+    }
+    ContainerHeader header = containerHeader(options.code, (uint64_t)statFrom.st_size, 0,
+                                             options.checksums);
+    Framing framing;
+    framing.prefix.resize(containerHeaderBytes(header));
+    writeContainerHeader(header, framing.prefix.data());
+    uint64_t readCount;
+    uint64_t writeCount;
+    bool ok = convertFiles(files, encodeConversion(options.code), options, framing, &readCount,
+                           &writeCount);
+    if(ok && (readCount != header.originalSize)){
+
+        // The file changed while it was read.
+        errno = EIO;
+        ok = false;
+    }
+    if(ok && options.checksums){
+        StageTimer timer(options.profile, PROFILE_CHECKSUMS);
+        ok = writeChecksums(files.fdTo, &header);
+        timer.stop(writeCount);
+    }
+    return closeFiles(files, ok);
+}
+
+bool decodeFile(const char* flNameFrom, const char* flNameTo, const FileOptions& options){
+    if((options.interleave != 0) && !validInterleave(options.code, options.interleave)){
+        errno = EINVAL;
+        return false;
+    }
+    OpenFiles files;
+    if(!openFiles(flNameFrom, flNameTo, &files)){
+        return false;
+    }
+    Framing framing;
+    ContainerHeader header;
+    bool container;
+    if(!readHeader(files.fdFrom, &framing, &header, &container)){
+        return closeFiles(files, false);
+    }
+    FileOptions fileOptions = options;
+    if(container && (options.interleave != 0)){
+        errno = EINVAL;
+        return closeFiles(files, false);
+    }
+    if(container){
+        fileOptions.code = header.code;
+        framing.outputLimit = header.originalSize;
+        framing.prefix.clear();
+    }
+    Conversion conversion = interleaveConversion(decodeConversion(fileOptions.code),
+                                                 fileOptions.code, fileOptions.interleave);
+    VerifyOptions verifyOptions;
+    const FileOptions* convertOptions = &fileOptions;
+    if(container && options.fastVerify &&
+       verifyConversion(header, fileOptions, &verifyOptions, &conversion)){
+        convertOptions = &verifyOptions;
+    }
+    uint64_t readCount;
+    uint64_t writeCount;
+    bool ok = convertFiles(files, conversion, *convertOptions, framing, &readCount,
+                           &writeCount);
+    if(ok && container && (writeCount != header.originalSize)){
+
+        // Less than the header says: the container was cut.
+        errno = EBADMSG;
+        ok = false;
+    }
+    return closeFiles(files, ok);
+}
+
+bool decodeFileRange(const char* flNameFrom, const char* flNameTo, uint64_t offset,
+                     uint64_t length, const FileOptions& options){
+    if(options.interleave != 0){
+        errno = EINVAL;
+        return false;
+    }
+    OpenFiles files;
+    if(!openFiles(flNameFrom, flNameTo, &files)){
+        return false;
+    }
+    Framing framing;
+    ContainerHeader header;
+    bool container;
+    if(!readHeader(files.fdFrom, &framing, &header, &container)){
+        return closeFiles(files, false);
+    }
+    FileOptions fileOptions = options;
+    uint64_t end = length < ((uint64_t)-1 - offset) ? offset + length : (uint64_t)-1;
+    if(container){
+        fileOptions.code = header.code;
+        end = end < header.originalSize ? end : header.originalSize;
+    }
+    if(offset >= end){
+        return closeFiles(files, true);
+    }
+
+    // Checking the checksums, the blocks read are the ones of the container.
+    Conversion conversion = decodeConversion(fileOptions.code);
+    VerifyOptions verifyOptions;
+    const FileOptions* convertOptions = &fileOptions;
+    CodeBlocks blocks = codeBlocks(fileOptions.code);
+    if(container && options.fastVerify &&
+       verifyConversion(header, fileOptions, &verifyOptions, &conversion)){
+        convertOptions = &verifyOptions;
+        blocks.bytes = conversion.outputBlockBytes;
+        blocks.hammingBytes = conversion.blockBytes;
+    }
+
+    // Skips to the block of "offset", through the index of a container.
+    uint64_t firstBlock = offset / blocks.bytes;
+    uint64_t skipBytes = firstBlock * blocks.hammingBytes;
+    if(container){
+        uint64_t indexBlock = offset / header.blockBytes;
+        skipBytes = (header.blockOffsets[(size_t)indexBlock] - framing.dataOffset) +
+                    (((offset % header.blockBytes) / blocks.bytes) * blocks.hammingBytes);
+    }
+    bool ok = skipInput(files.fdFrom, &framing.pending, skipBytes);
+
+    // Chunks of whole blocks, of which only the bytes of the range are
+    // written.
+    OptionsPool threads(fileOptions);
+    ThreadPool& pool = threads.pool;
+    size_t chunkBytes = conversion.chunkBytes * pool.size();
+    ArenaScope scope(threadArena());
+    uint8_t* chunk = scope.allocate(chunkBytes);
+    uint8_t* output = scope.allocate(conversion.outputBytes * pool.size());
+    uint64_t endBlock = ((end - 1) / blocks.bytes) + 1;
+    uint64_t leftBytes = (endBlock - firstBlock) * blocks.hammingBytes;
+    uint64_t chunkOffset = skipBytes;
+    uint64_t chunkOriginal = firstBlock * blocks.bytes;
+    size_t pendingSize = framing.pending.size();
+    memcpy(chunk, framing.pending.data(), pendingSize);
+    while(ok && (leftBytes > 0)){
+        size_t readBytes = leftBytes < chunkBytes ? (size_t)leftBytes : chunkBytes;
+        size_t chunkSize = pendingSize;
+        if(pendingSize < readBytes){
+            ok = readTimed(fileOptions.profile, files.fdFrom, chunk + pendingSize,
+                           readBytes - pendingSize, &chunkSize);
+            chunkSize += pendingSize;
+        }
+        pendingSize = 0;
+        if(!ok || (chunkSize == 0)){
+            break;
+        }
+        size_t outputSize = convertChunk(pool, conversion, *convertOptions, chunk,
+                                         chunkSize, chunkOffset, output);
+        uint64_t from = chunkOriginal < offset ? offset - chunkOriginal : 0;
+        uint64_t to = chunkOriginal + outputSize < end ? outputSize : end - chunkOriginal;
+        if(from < to){
+            ok = writeTimed(fileOptions.profile, files.fdTo, output + from,
+                            (size_t)(to - from));
+        }
+        leftBytes -= chunkSize < leftBytes ? chunkSize : leftBytes;
+        chunkOffset += chunkSize;
+        chunkOriginal += outputSize;
+        if(chunkSize < readBytes){
+            break;
+        }
+    }
+    return closeFiles(files, ok);
+}
+
+bool scrubFile(const char* flName, const FileOptions& options, uint64_t* bytesRewritten){
+    if(options.interleave != 0){
+        errno = EINVAL;
+        return false;
+    }
+    if(isStdio(flName)){
+        errno = ESPIPE;
+        return false;
+    }
+    int fd = open(flName, O_RDWR|O_BINARY);
+    if(fd < 0){
+        return false;
+    }
+    Framing framing;
+    ContainerHeader header;
+    bool container;
+    struct stat statFile;
+    bool ok = readHeader(fd, &framing, &header, &container) && (fstat(fd, &statFile) == 0);
+    if(ok && !S_ISREG(statFile.st_mode)){
+        errno = ESPIPE;
+        ok = false;
+    }
+    uint64_t rewrittenCount = 0;
+    if(ok){
+
+        // Only the blocks a container says it has, in chunks of whole blocks
+        // of the container when their checksums are checked.
+        FileOptions fileOptions = options;
+        uint64_t dataEnd = (uint64_t)statFile.st_size;
+        const ContainerHeader* checked = NULL;
+        OptionsPool threads(options);
+        ThreadPool& pool = threads.pool;
+        size_t chunkBytes = decodeConversion(options.code).chunkBytes * pool.size();
+        if(container){
+            fileOptions.code = header.code;
+            chunkBytes = decodeConversion(header.code).chunkBytes * pool.size();
+            uint64_t containerEnd = framing.dataOffset;
+            if(!header.blockOffsets.empty()){
+                containerEnd = header.blockOffsets.back() +
+                               containerBlockSize(header, header.blockOffsets.size() - 1);
+            }
+            dataEnd = dataEnd < containerEnd ? dataEnd : containerEnd;
+            uint64_t blockHammingBytes = encodedSize((size_t)header.blockBytes, header.code);
+            if(options.fastVerify && !header.blockChecksums.empty() &&
+               (blockHammingBytes <= MAX_VERIFY_BLOCK_BYTES)){
+                checked = &header;
+                chunkBytes = (size_t)blockHammingBytes * pool.size();
+            }
+        }
+        bool mapped = false;
+        if(options.ioMode == IO_MMAP){
+            mapped = scrubMapped(fd, framing.dataOffset, dataEnd, chunkBytes, fileOptions,
+                                 checked, pool, &rewrittenCount, &ok);
+        }
+        if(!mapped){
+            ok = scrubStreamed(fd, framing.dataOffset, dataEnd, chunkBytes, fileOptions, checked,
+                               pool, &rewrittenCount);
+        }
+    }
+    if(bytesRewritten != NULL){
+        *bytesRewritten = rewrittenCount;
+    }
+    int scrubErrno = errno;
+    if((close(fd) != 0) && ok){
+        return false;
+    }
+    errno = scrubErrno;
+    return ok;
+}
+
+bool writeFlipLog(const char* flName, uint64_t bytesCount, const ErrorModel& model, uint64_t seed,
+                  uint64_t firstByte){
+    FILE* log = fopen(flName, "w");
+    if(log == NULL){
+        return false;
+    }
+
+    // One chunk of positions at a time, each formatted by hand as there can
+    // be billions of them.
+    uint64_t chunkBytes = errorConversion(model).chunkBytes;
+    std::vector<uint64_t> flips;
+    std::vector<char> text;
+    bool ok = true;
+    for(uint64_t offset = 0; ok && (offset < bytesCount); offset += chunkBytes){
+        uint64_t chunkSize = bytesCount - offset < chunkBytes ? bytesCount - offset : chunkBytes;
+        flips.clear();
+        errorFlips((size_t)chunkSize, model, seed, offset, &flips);
+        text.resize(flips.size() * 21);
+        char* end = text.data();
+        for(size_t z = 0; z < flips.size(); z++){
+            char digits[20];
+            size_t count = 0;
+            uint64_t value = flips[z] + (firstByte * 8);
+            do{
+                digits[count++] = (char)('0' + (value % 10));
+                value /= 10;
+            }while(value > 0);
+            while(count > 0){
+                *end++ = digits[--count];
+            }
+            *end++ = '\n';
+        }
+        size_t size = (size_t)(end - text.data());
+        ok = fwrite(text.data(), 1, size, log) == size;
+    }
+    int logErrno = errno;
+    if((fclose(log) != 0) && ok){
+        return false;
+    }
+    errno = logErrno;
+    return ok;
+}
+
+bool errorFile(const char* flNameFrom, const char* flNameTo, const FileOptions& options){
+    OpenFiles files;
+    if(!openFiles(flNameFrom, flNameTo, &files)){
+        return false;
+    }
+
+    // A container keeps its header as it is, only its groups get errors.
+    Framing framing;
+    ContainerHeader header;
+    bool container;
+    if(!readHeader(files.fdFrom, &framing, &header, &container)){
+        return closeFiles(files, false);
+    }
+    FileOptions fileOptions = options;
+    if(container){
+        fileOptions.code = header.code;
+        fileOptions.errorModel.groupBits = codeBlocks(header.code).groupBits;
+        fileOptions.errorModel.sliced = header.code == CODE_7_4_SLICED;
+    }
+    uint64_t readCount;
+    uint64_t writeCount;
+    bool ok = convertFiles(files, errorConversion(fileOptions.errorModel), fileOptions, framing,
+                           &readCount, &writeCount);
+    ok = closeFiles(files, ok);
+    return ok && ((options.flipLog == NULL) ||
+                  writeFlipLog(options.flipLog, readCount, fileOptions.errorModel, options.seed,
+                               framing.dataOffset));
+}
+
+bool verifyFile(const char* flName, const FileOptions& options, VerifyStats* stats){
+    if((options.interleave != 0) && !validInterleave(options.code, options.interleave)){
+        errno = EINVAL;
+        return false;
+    }
+    bool stdio = isStdio(flName);
+    int fd = stdio ? STDIN_FILENO : open(flName, O_RDONLY|O_BINARY);
+    if(fd < 0){
+        return false;
+    }
+#if defined(_WIN32) || defined(__CYGWIN__)
+    if(stdio){
+        setmode(fd, O_BINARY);
+    }
+#endif
+
+    // The unit: whole blocks of the code, whose size in the hamming format
+    // is a whole number of blocks of the errors (so that each piece gets the
+    // errors it would get in the whole file), and whole pieces of the
+    // interleaving.
+    CodeBlocks blocks = codeBlocks(options.code);
+    size_t stepBlocks = options.interleave != 0 ?
+                        interleavePieceBlocks(options.code, options.interleave) : 1;
+    size_t errorBlockBytes = errorConversion(options.errorModel).blockBytes;
+    size_t unitBlocks = stepBlocks;
+    while(((unitBlocks * blocks.hammingBytes) % errorBlockBytes) != 0){
+        unitBlocks += stepBlocks;
+    }
+    std::mutex mutex;
+    VerifyStats verifyStats;
+    RoundTripOptions roundTrip;
+    static_cast<FileOptions&>(roundTrip) = options;
+    roundTrip.unitBytes = unitBlocks * blocks.bytes;
+    roundTrip.unitHammingBytes = unitBlocks * blocks.hammingBytes;
+    roundTrip.mutex = &mutex;
+    roundTrip.stats = &verifyStats;
+    Conversion conversion = {(CHUNK_BYTES / roundTrip.unitBytes) * roundTrip.unitBytes, 0,
+                             roundTripChunk, sameSize, roundTrip.unitBytes, 0, false};
+    if(conversion.chunkBytes == 0){
+        conversion.chunkBytes = roundTrip.unitBytes;
+    }
+
+    OptionsPool threads(options);
+    ThreadPool& pool = threads.pool;
+    size_t chunkBytes = conversion.chunkBytes * pool.size();
+    ArenaScope scope(threadArena());
+    uint8_t* chunk = scope.allocate(chunkBytes);
+    bool ok = true;
+    for(uint64_t offset = 0; ; ){
+        size_t chunkSize;
+        if(!readTimed(options.profile, fd, chunk, chunkBytes, &chunkSize)){
+            ok = false;
+            break;
+        }
+        if(chunkSize == 0){
+            break;
+        }
+        convertChunk(pool, conversion, roundTrip, chunk, chunkSize, offset, NULL);
+        offset += chunkSize;
+        if(chunkSize < chunkBytes){
+            break;
+        }
+    }
+    int readErrno = errno;
+    if(!stdio){
+        close(fd);
+    }
+    errno = readErrno;
+    if(stats != NULL){
+        *stats = verifyStats;
+    }
+    return ok;
+}
+
+bool listBatch(const char* source, const char* outputDir, std::vector<BatchFile>* files){
+
+    // Without the directory every file would fail, so the batch fails at
+    // once ("stat" gives "ENOENT").
+    struct stat statOutput;
+    if(stat(outputDir, &statOutput) != 0){
+        return false;
+    }
+    if(!S_ISDIR(statOutput.st_mode)){
+        errno = ENOTDIR;
+        return false;
+    }
+    std::vector<std::string> names;
+    struct stat statSource;
+    if(!isStdio(source) && (stat(source, &statSource) == 0) && S_ISDIR(statSource.st_mode)){
+        DIR* dir = opendir(source);
+        if(dir == NULL){
+            return false;
+        }
+        for(dirent* entry = readdir(dir); entry != NULL; entry = readdir(dir)){
+            std::string name = std::string(source) + "/" + entry->d_name;
+            struct stat statEntry;
+            if((stat(name.c_str(), &statEntry) == 0) && S_ISREG(statEntry.st_mode)){
+                names.push_back(name);
+            }
+        }
+        closedir(dir);
+        std::sort(names.begin(), names.end());
+    }else{
+        FILE* list = isStdio(source) ? stdin : fopen(source, "r");
+        if(list == NULL){
+            return false;
+        }
+        bool ok = readBatchList(list, &names);
+        if(list != stdin){
+            int listErrno = errno;
+            fclose(list);
+            errno = listErrno;
+        }
+        if(!ok){
+            return false;
+        }
+    }
+    size_t first = files->size();
+    for(size_t z = 0; z < names.size(); z++){
+        if(!addBatchFile(names[z], outputDir, files)){
+            files->resize(first);
+            return false;
+        }
+    }
+
+    // Two files of the same name would be written over each other.
+    std::vector<std::string> written;
+    for(size_t z = 0; z < files->size(); z++){
+        written.push_back((*files)[z].to);
+    }
+    std::sort(written.begin(), written.end());
+    if(std::adjacent_find(written.begin(), written.end()) != written.end()){
+        files->resize(first);
+        errno = EEXIST;
+        return false;
+    }
+    return true;
+}
+
+size_t convertBatch(std::vector<BatchFile>* files, FileFn fileFn, const FileOptions& options){
+
+    // The largest first, so that no large file is left for the end.
+    std::vector<BatchFile*> order;
+    for(size_t z = 0; z < files->size(); z++){
+        order.push_back(&(*files)[z]);
+    }
+    std::stable_sort(order.begin(), order.end(), [](const BatchFile* first,
+                                                    const BatchFile* second){
+        return first->size > second->size;
+    });
+    ThreadPool pool(options.threads);
+    FileOptions largeOptions = options;
+    largeOptions.pool = &pool;
+    size_t large = 0;
+    for( ; (large < order.size()) && (order[large]->size >= BATCH_LARGE_BYTES); large++){
+        convertBatchFile(order[large], fileFn, largeOptions);
+    }
+
+    // A worker is taken by a thread for each file and given back when it
+    // ends, so there are never more of them than threads.
+    std::vector<std::unique_ptr<BatchWorker> > workers;
+    std::vector<BatchWorker*> idle;
+    std::mutex idleMutex;
+    pool.run(order.size() - large, [&](size_t index){
+        BatchWorker* worker;
+        {
+            std::lock_guard<std::mutex> lock(idleMutex);
+            if(idle.empty()){
+                workers.push_back(std::unique_ptr<BatchWorker>(new BatchWorker()));
+                idle.push_back(workers.back().get());
+            }
+            worker = idle.back();
+            idle.pop_back();
+        }
+        FileOptions fileOptions = options;
+        fileOptions.pool = &worker->pool;
+
+        // The device converts one chunk at a time: the small files stay on
+        // their threads.
+        fileOptions.gpu = NULL;
+        convertBatchFile(order[large + index], fileFn, fileOptions);
+        std::lock_guard<std::mutex> lock(idleMutex);
+        idle.push_back(worker);
+    });
+    size_t failed = 0;
+    for(size_t z = 0; z < files->size(); z++){
+        failed += (*files)[z].ok ? 0 : 1;
+        if(options.profile != NULL){
+            *options.profile += (*files)[z].profile;
+        }
+    }
+    return failed;
+}
+
+} // namespace hamming
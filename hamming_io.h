@@ -0,0 +1,403 @@
+/**
+    @file    hamming_io.h
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Streaming of files through the hamming method.
+
+    @section DESCRIPTION
+
+    The files are read in chunks of a fixed size, which are converted and
+    written before the next one is read. The chunks of the original files are
+    a multiple of 4 bytes and the ones of the files in the hamming format a
+    multiple of 7 bytes, so that each chunk has whole blocks and can be
+    converted by itself. The memory used is the same no matter how large the
+    file is. Regular files can also be mapped in memory instead.
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#ifndef HAMMING_IO_H
+#define HAMMING_IO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "hamming.h"
+#include "hamming_profile.h"
+
+namespace hamming {
+
+class GpuCodec;
+class ThreadPool;
+
+// Chunk of an original file (1 MiB, 262144 blocks) and the same chunk in the
+// hamming format.
+const size_t CHUNK_BYTES = 4 * 262144;
+const size_t CHUNK_HAMMING_BYTES = 7 * 262144;
+
+/**
+    @brief How the files are read and written.
+*/
+enum IoMode {
+    IO_STREAM, /**< Chunk by chunk with "read"/"write" (default). */
+    IO_MMAP,   /**< Mapping the files in memory. Files that cannot be mapped
+                    (pipes, terminals, ...) are streamed. */
+    IO_URING   /**< Reading the next chunk and writing the one before while
+                    each chunk is converted, through an io_uring (Linux).
+                    Files other than regular files, or without io_uring, are
+                    streamed. */
+};
+
+/**
+    @brief Receives the counters of each part of a file converted, in the
+        order of the file. Only "decodeFile" counts the groups, the others
+        give zeros.
+
+    @param uint64_t offset: Position of the part in the file read (after the
+        header of a container).
+    @param uint64_t bytesCount: Size of the part in the file read.
+    @param DecodeStats& stats: Groups decoded and corrected in the part.
+    @param void* context: "FileOptions::statsContext".
+    @return void.
+*/
+typedef void (*StatsFn)(uint64_t offset, uint64_t bytesCount, const DecodeStats& stats,
+                        void* context);
+
+/**
+    @brief How the files are converted.
+*/
+struct FileOptions {
+    IoMode ioMode;    /**< How the files are read and written. */
+    Code code;        /**< Code of the hamming format. */
+    unsigned threads; /**< Threads converting the blocks (0 - one for each
+                           CPU). */
+    uint64_t seed;    /**< Seed of the errors of "errorFile" (the same seed
+                           gives the same errors). */
+    ErrorModel errorModel; /**< Model of the errors of "errorFile". */
+    const char* flipLog;   /**< File that receives the position of each bit
+                                inverted by "errorFile" (NULL - none). */
+    StatsFn statsFn;       /**< Called for each chunk converted (NULL -
+                                none). */
+    void* statsContext;    /**< Given to "statsFn". */
+    bool container;        /**< "encodeFile" writes a container (see
+                                "hamming_container.h"). The other functions
+                                always read one, with the code it has. */
+    bool checksums;        /**< With "container", "encodeFile" also stores
+                                the CRC32C of each block (the file written
+                                must be a regular file). */
+    bool fastVerify;       /**< "decodeFile" and "decodeFileRange" check the
+                                CRC32C of each block of a container that has
+                                them: the data bits of a block that matches
+                                are taken without correcting it, the others
+                                are corrected. */
+    unsigned interleave;   /**< Depth of the interleaving (see
+                                "hamming::interleave") of the file written
+                                by "encodeFile" and read by "decodeFile"
+                                (0 - none). Not with containers. */
+    bool direct;           /**< With "IO_URING", the files are read and
+                                written with "O_DIRECT", skipping the page
+                                cache, when their chunks can be aligned to 4
+                                KiB (the last write is made without it). */
+    ThreadPool* pool;      /**< Threads converting the blocks, shared by many
+                                conversions instead of starting "threads"
+                                for each one (NULL - started by each). The
+                                buffers of the chunks come from the
+                                "threadArena" of the thread that calls. */
+    Profile* profile;      /**< Gets the time, bytes and chunks of each stage
+                                added (NULL - none). */
+    GpuCodec* gpu;         /**< Device that encodes and decodes the chunks of
+                                the codes it has, when they are not
+                                interleaved (NULL - none). The chunks are
+                                made larger for it, and each goes whole to
+                                the device instead of being split among the
+                                threads. */
+
+    FileOptions() : ioMode(IO_STREAM), code(CODE_7_4), threads(1), seed(0), flipLog(NULL),
+                    statsFn(NULL), statsContext(NULL), container(false), checksums(false),
+                    fastVerify(false), interleave(0), direct(false), pool(NULL),
+                    profile(NULL), gpu(NULL){}
+};
+
+/**
+    @brief Converts a chunk.
+
+    @param uint8_t* chunk: Bytes read (can be changed).
+    @param size_t chunkSize: Number of bytes read.
+    @param uint8_t* output: Receives the converted bytes.
+    @param uint64_t offset: Position of the chunk in the file read (a
+        multiple of the size of a block).
+    @param FileOptions& options: How the file is converted.
+    @param DecodeStats* stats: Gets the counters of the groups decoded added.
+    @return size_t: Number of bytes written to "output".
+*/
+typedef size_t (*ChunkFn)(uint8_t* chunk, size_t chunkSize, uint8_t* output,
+                          uint64_t offset, const FileOptions& options, DecodeStats* stats);
+
+/**
+    @brief How a file is converted.
+*/
+struct Conversion {
+    size_t chunkBytes;              /**< Size of the chunks read. Only the
+                                         last one can be smaller. */
+    size_t outputBytes;             /**< Largest size of a converted chunk
+                                         (0 - the chunk is converted in place
+                                         and "chunkFn" gets it as "output"). */
+    ChunkFn chunkFn;                /**< Converts each chunk, or part of a
+                                         chunk. */
+    size_t (*outputSize)(size_t, Code); /**< Size of the converted file from
+                                             the size of the file read. */
+    size_t blockBytes;              /**< Size of a block read. Any range of
+                                         whole blocks is converted by itself. */
+    size_t outputBlockBytes;        /**< Size of a converted block. */
+    bool gpu;                       /**< "chunkFn" converts on "options.gpu"
+                                         the chunks it takes. */
+};
+
+/**
+    @brief Read a file, convert it and write it to another file.
+
+    @param char* flNameFrom: File to be read ("-" - standard input).
+    @param char* flNameTo: File to be written ("-" - standard output).
+    @param Conversion& conversion: How the file is converted.
+    @param FileOptions& options: How the files are read, converted and
+        written.
+    @param uint64_t* bytesRead: Receives the size of the file read (can be
+        NULL).
+    @return bool: false if a file could not be read or written ("errno" says
+        why).
+*/
+bool convertFile(const char* flNameFrom, const char* flNameTo,
+                 const Conversion& conversion, const FileOptions& options,
+                 uint64_t* bytesRead=NULL);
+
+/**
+    @brief Whether a file name means the standard input or output.
+
+    @param char* fileName: File name.
+    @return bool: true for "-".
+*/
+bool isStdio(const char* fileName);
+
+/**
+    @brief Write the position of each bit the errors of a file invert, one
+        decimal number per line in increasing order (bit 0 is the most
+        significant bit of the first byte). The errors depend only on the
+        model, the seed and the position of the bits, so this is computed
+        without reading the file.
+
+    @param char* flName: File to be written.
+    @param uint64_t bytesCount: Size of the file in the hamming format.
+    @param ErrorModel& model: Model of the errors.
+    @param uint64_t seed: Seed of the errors.
+    @param uint64_t firstByte: Position of the bytes in the hamming format in
+        the file (the size of the header of a container), added to each
+        position written.
+    @return bool: false if the file could not be written.
+*/
+bool writeFlipLog(const char* flName, uint64_t bytesCount, const ErrorModel& model, uint64_t seed,
+                  uint64_t firstByte=0);
+
+/**
+    @brief Apply the hamming method to a file.
+
+    @param char* flNameFrom: File to apply the hamming method (a regular
+        file with "options.container", whose size goes in the header).
+    @param char* flNameTo: File in the hamming format to be written.
+    @param FileOptions& options: How the files are read, converted and
+        written.
+    @return bool: false if a file could not be read or written ("errno"
+        "ESPIPE" if a container was asked for a pipe, or checksums for a
+        pipe written, "EINVAL" if the interleaving is not valid for the code
+        or was asked with a container).
+*/
+bool encodeFile(const char* flNameFrom, const char* flNameTo,
+                const FileOptions& options=FileOptions());
+
+/**
+    @brief Recover a file from the hamming format. A container is decoded
+        with its own code to exactly the size of the original file (with
+        "options.fastVerify" and checksums, in chunks of one block for each
+        thread).
+
+    @param char* flNameFrom: File in the hamming format.
+    @param char* flNameTo: Recovered file to be written.
+    @param FileOptions& options: How the files are read, converted and
+        written.
+    @return bool: false if a file could not be read or written ("errno"
+        "EBADMSG" if a container has a damaged header or was cut, "EINVAL"
+        if the interleaving is not valid for the code or the file is a
+        container).
+*/
+bool decodeFile(const char* flNameFrom, const char* flNameTo,
+                const FileOptions& options=FileOptions());
+
+/**
+    @brief Recover only a range of a file from the hamming format. The
+        position of its first block comes from the index of a container or is
+        computed from the code, so only the blocks the range touches are read
+        (a pipe is read up to them) and decoded.
+
+    @param char* flNameFrom: File in the hamming format.
+    @param char* flNameTo: Receives the original bytes of the range.
+    @param uint64_t offset: Position of the first original byte wanted.
+    @param uint64_t length: Number of original bytes wanted (fewer at the
+        end of the file).
+    @param FileOptions& options: How the files are read, converted and
+        written (always streamed).
+    @return bool: false if a file could not be read or written ("errno"
+        "EBADMSG" if a container has a damaged header, "EINVAL" with an
+        interleaving).
+*/
+bool decodeFileRange(const char* flNameFrom, const char* flNameTo, uint64_t offset,
+                     uint64_t length, const FileOptions& options=FileOptions());
+
+/**
+    @brief Correct a file in the hamming format in place, without decoding
+        it to another file: only the segments of about 4 KiB that had a group
+        corrected are encoded again and written back over themselves (with
+        "IO_MMAP", only their pages are changed). The groups whose errors
+        can only be detected are left as they are. A container is scrubbed
+        with its own code, its header untouched, and with
+        "options.fastVerify" the blocks whose CRC32C matches are skipped
+        without decoding them.
+
+    @param char* flName: File in the hamming format (a regular file, read
+        and written).
+    @param FileOptions& options: How the file is read, corrected and written
+        ("options.statsFn" gets the counters of each chunk).
+    @param uint64_t* bytesRewritten: Receives the number of bytes written
+        again (can be NULL).
+    @return bool: false if the file could not be read or written ("errno"
+        "ESPIPE" if it is not a regular file, "EBADMSG" if a container has a
+        damaged header, "EINVAL" with an interleaving).
+*/
+bool scrubFile(const char* flName, const FileOptions& options=FileOptions(),
+               uint64_t* bytesRewritten=NULL);
+
+/**
+    @brief Generate errors in a file in the hamming format, following
+        "options.errorModel", and write them to "options.flipLog" if given.
+        The groups of a container get the same errors as without its
+        header, which is copied as it is.
+
+    @param char* flNameFrom: File in the hamming format.
+    @param char* flNameTo: File with errors to be written.
+    @param FileOptions& options: How the files are read, converted and
+        written.
+    @return bool: false if a file could not be read or written ("errno"
+        "EBADMSG" if a container has a damaged header).
+*/
+bool errorFile(const char* flNameFrom, const char* flNameTo,
+               const FileOptions& options=FileOptions());
+
+/**
+    @brief Counters of "verifyFile".
+*/
+struct VerifyStats {
+    uint64_t bytes;      /**< Original bytes checked. */
+    uint64_t flips;      /**< Bits inverted in the hamming format. */
+    DecodeStats decode;  /**< Groups decoded, corrected and detected. */
+    uint64_t wrongBytes; /**< Decoded bytes that differ from the original. */
+    uint64_t firstWrong; /**< Position of the first of them ((uint64_t)-1 -
+                              none). */
+
+    VerifyStats() : bytes(0), flips(0), wrongBytes(0), firstWrong((uint64_t)-1){}
+};
+
+/**
+    @brief Check a code against a model of errors without writing any file:
+        each piece of about 32 KiB of the file is encoded, interleaved (with
+        "options.interleave"), gets the errors of "options.errorModel", is
+        decoded and compared with the original bytes, all in memory. The
+        errors are exactly the ones "errorFile" gives to the file encoded by
+        "encodeFile", with the same seed.
+
+    @param char* flName: Original file ("-" - standard input).
+    @param FileOptions& options: Code, interleaving, model of the errors,
+        seed and threads ("options.statsFn" gets the counters of each chunk,
+        always streamed).
+    @param VerifyStats* stats: Receives the counters (can be NULL).
+    @return bool: false if the file could not be read ("errno" "EINVAL" if
+        the interleaving is not valid for the code).
+*/
+bool verifyFile(const char* flName, const FileOptions& options=FileOptions(),
+                VerifyStats* stats=NULL);
+
+/**
+    @brief One file of a batch.
+*/
+struct BatchFile {
+    std::string from;  /**< File to be read. */
+    std::string to;    /**< File to be written. */
+    uint64_t size;     /**< Size of the file read, when it was listed. */
+    bool ok;           /**< Whether it was converted. */
+    int error;         /**< "errno" when it was not. */
+    DecodeStats stats; /**< Groups decoded and corrected (only "decodeFile"
+                            counts them). */
+    Profile profile;   /**< Stages of its conversion (with
+                            "FileOptions::profile"). */
+
+    BatchFile() : size(0), ok(false), error(0){}
+};
+
+/**
+    @brief Converts a file of a batch ("encodeFile", "decodeFile", ...).
+
+    @param char* flNameFrom: File to be read.
+    @param char* flNameTo: File to be written.
+    @param FileOptions& options: How the files are read, converted and
+        written.
+    @return bool: false if a file could not be read or written ("errno" says
+        why).
+*/
+typedef bool (*FileFn)(const char* flNameFrom, const char* flNameTo, const FileOptions& options);
+
+/**
+    @brief List the files of a batch: each file read is written to a
+        directory with the same name (without its directories).
+
+    @param char* source: A directory, whose regular files are converted (not
+        the ones of its subdirectories, and in the order of their names), or a
+        file with the name of one file per line ("-" - standard input, the
+        empty lines being skipped).
+    @param char* outputDir: Directory that receives the files written.
+    @param std::vector<BatchFile>* files: Gets the files added.
+    @return bool: false if the source could not be read or the directory
+        does not exist ("errno" "ENOENT", "ENOTDIR" if it is not a
+        directory, "EEXIST" if two files have the same name, "EINVAL" if one
+        would be written over itself or is "-").
+*/
+bool listBatch(const char* source, const char* outputDir, std::vector<BatchFile>* files);
+
+/**
+    @brief Convert many files in a single process. The files of at least 16
+        MiB are converted first, one at a time, their chunks split among all
+        the threads. Then each thread takes the next small file not started,
+        the largest first, and converts it by itself, with a pool of a single
+        thread kept from one file to the next (and its "threadArena"). A file
+        that fails does not stop the others.
+
+    @param std::vector<BatchFile>* files: Files, each getting whether it was
+        converted and its counters.
+    @param FileFn fileFn: Converts each file.
+    @param FileOptions& options: How the files are read, converted and
+        written ("threads" being the threads of the whole batch;
+        "statsFn" and "pool" are not used; "gpu" only converts the large
+        files; "profile" gets the stages of all the files added, their times
+        summed over the threads).
+    @return size_t: Number of files that could not be converted.
+*/
+size_t convertBatch(std::vector<BatchFile>* files, FileFn fileFn, const FileOptions& options);
+
+} // namespace hamming
+
+#endif
@@ -0,0 +1,188 @@
+/**
+    @file    hamming_kernels.h
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Functions of each kernel that process whole blocks (internal).
+
+    @section DESCRIPTION
+
+    A block is 4 original bytes or the 7 bytes (8 groups of 7 bits) they
+    become in the hamming format. With the code (8,4) it is 1 original byte
+    and its 2 groups of 8 bits, so those kernels get the number of original
+    bytes. Every kernel gives exactly the same bytes; "hamming.cpp" chooses
+    which one runs.
+
+    The bit-sliced layout of (7,4) works on slabs of 128 original bytes, the
+    256 groups of their nibbles stored as 7 planes of 256 bits (32 bytes)
+    each, one for each position of the group: D7 D6 D5 P4 D3 P2 P1. The bit
+    "c" of a plane (byte "c / 8", bit "c % 8" counted from the least
+    significant one) is from the high nibble of the byte "c" when "c" is
+    below 128 and from the low nibble of the byte "c - 128" otherwise.
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#ifndef HAMMING_KERNELS_H
+#define HAMMING_KERNELS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace hamming {
+namespace kernels {
+
+// Number of original bytes and of hamming bytes in a block.
+const size_t BLOCK_BYTES = 4;
+const size_t BLOCK_HAMMING_BYTES = 7;
+
+typedef void (*EncodeBlocksFn)(const uint8_t* bytes, size_t blocks, uint8_t* hammingBytes);
+// The decoding kernels return the number of groups that had a bit corrected.
+typedef uint64_t (*DecodeBlocksFn)(const uint8_t* hammingBytes, size_t blocks, uint8_t* bytes);
+typedef void (*EncodeSecdedFn)(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes);
+// Also add to "detected" the number of groups with two inverted bits.
+typedef uint64_t (*DecodeSecdedFn)(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes,
+                                   uint64_t* detected);
+
+void encodeBlocksBitwise(const uint8_t* bytes, size_t blocks, uint8_t* hammingBytes);
+uint64_t decodeBlocksBitwise(const uint8_t* hammingBytes, size_t blocks, uint8_t* bytes);
+void encodeSecdedBitwise(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes);
+uint64_t decodeSecdedBitwise(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes,
+                             uint64_t* detected);
+void encodeBlocksTable(const uint8_t* bytes, size_t blocks, uint8_t* hammingBytes);
+uint64_t decodeBlocksTable(const uint8_t* hammingBytes, size_t blocks, uint8_t* bytes);
+void encodeSecdedTable(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes);
+uint64_t decodeSecdedTable(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes,
+                           uint64_t* detected);
+
+// Original bytes and hamming bytes (7 planes of 32 bytes) of a slab of the
+// bit-sliced layout.
+const size_t SLICED_BYTES = 128;
+const size_t SLICED_HAMMING_BYTES = 224;
+
+typedef void (*EncodeSlicedFn)(const uint8_t* bytes, size_t slabs, uint8_t* hammingBytes);
+// Return the number of groups that had a bit corrected.
+typedef uint64_t (*DecodeSlicedFn)(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes);
+// Take the data planes of slabs with no inverted bit, without correcting them.
+typedef void (*ExtractSlicedFn)(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes);
+
+void encodeSlicedBitwise(const uint8_t* bytes, size_t slabs, uint8_t* hammingBytes);
+uint64_t decodeSlicedBitwise(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes);
+void extractSlicedBitwise(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes);
+
+// Interleave frames of groups of 7 bits ("hamming::interleave"), a block of 8
+// groups at a time: the bit "b" of the 8 groups of the block "z" becomes the
+// byte "b * blocks + z". The frame is followed by 16 bytes that can be read.
+typedef void (*InterleaveBlocksFn)(const uint8_t* frame, size_t blocks, uint8_t* output);
+typedef void (*DeinterleaveBlocksFn)(const uint8_t* input, size_t blocks, uint8_t* frame);
+// Apply the code to whole frames of "blocks" blocks and interleave them as
+// they are encoded ("hamming::addInterleavedParity").
+typedef void (*EncodeInterleavedFn)(const uint8_t* bytes, size_t frames, size_t blocks,
+                                    uint8_t* output);
+// Interleave a frame of the larger codes (groups of 15, 31, 63 or 72 bits)
+// from the words of its groups ("codes::BlockCode::encodeWords"), a tile
+// being 8 groups. The words of each 4 tiles are 9 rows of 4 words, the row
+// "r" having the word "r" of each tile (the ninth one only with 72 bits).
+typedef void (*InterleaveWordsFn)(const uint64_t* words, size_t tiles, unsigned groupBits,
+                                  uint8_t* output);
+const size_t QUAD_WORDS = 36;
+
+void interleaveWordsBitwise(const uint64_t* words, size_t tiles, unsigned groupBits,
+                            uint8_t* output);
+
+void interleaveBlocksBitwise(const uint8_t* frame, size_t blocks, uint8_t* output);
+void deinterleaveBlocksBitwise(const uint8_t* input, size_t blocks, uint8_t* frame);
+// The same for the groups of 8 bits of (8,4), a block being 8 bytes.
+void interleaveSecdedBitwise(const uint8_t* frame, size_t blocks, uint8_t* output);
+void deinterleaveSecdedBitwise(const uint8_t* input, size_t blocks, uint8_t* frame);
+
+// Take the data bits of groups with no inverted bit, without correcting them.
+typedef void (*ExtractBlocksFn)(const uint8_t* hammingBytes, size_t blocks, uint8_t* bytes);
+typedef void (*ExtractSecdedFn)(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes);
+// CRC32C without the inversions at the start and at the end.
+typedef uint32_t (*Crc32cFn)(uint32_t crc, const uint8_t* bytes, size_t bytesCount);
+
+void extractBlocksBitwise(const uint8_t* hammingBytes, size_t blocks, uint8_t* bytes);
+void extractSecdedBitwise(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes);
+uint32_t crc32cTable(uint32_t crc, const uint8_t* bytes, size_t bytesCount);
+
+/**
+    The SIMD kernels (hamming_simd.cpp) exist on every build, but they must
+    only be called when the matching "...Supported" returns true. The blocks
+    at the end that do not fill a whole register are left to the table
+    kernel.
+*/
+bool ssse3Supported();
+void encodeBlocksSsse3(const uint8_t* bytes, size_t blocks, uint8_t* hammingBytes);
+uint64_t decodeBlocksSsse3(const uint8_t* hammingBytes, size_t blocks, uint8_t* bytes);
+void encodeSecdedSsse3(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes);
+uint64_t decodeSecdedSsse3(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes,
+                           uint64_t* detected);
+// The 2 halves of a slab in the 2 lanes of each register.
+void encodeSlicedSsse3(const uint8_t* bytes, size_t slabs, uint8_t* hammingBytes);
+uint64_t decodeSlicedSsse3(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes);
+void extractSlicedSsse3(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes);
+
+bool avx2Supported();
+void encodeBlocksAvx2(const uint8_t* bytes, size_t blocks, uint8_t* hammingBytes);
+uint64_t decodeBlocksAvx2(const uint8_t* hammingBytes, size_t blocks, uint8_t* bytes);
+void encodeSecdedAvx2(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes);
+uint64_t decodeSecdedAvx2(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes,
+                          uint64_t* detected);
+// Each plane of a slab is one register.
+void encodeSlicedAvx2(const uint8_t* bytes, size_t slabs, uint8_t* hammingBytes);
+uint64_t decodeSlicedAvx2(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes);
+void extractSlicedAvx2(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes);
+
+// "pext" takes the data bits of a whole block at once.
+bool bmi2Supported();
+void extractBlocksBmi2(const uint8_t* hammingBytes, size_t blocks, uint8_t* bytes);
+void extractSecdedBmi2(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes);
+// "pext"/"pdep" take the same bit of the 8 groups of a block at once.
+void interleaveBlocksBmi2(const uint8_t* frame, size_t blocks, uint8_t* output);
+void deinterleaveBlocksBmi2(const uint8_t* input, size_t blocks, uint8_t* frame);
+// With AVX2, 4 blocks at once (the blocks that do not make 4 with BMI2).
+void interleaveBlocksAvx2(const uint8_t* frame, size_t blocks, uint8_t* output);
+void deinterleaveBlocksAvx2(const uint8_t* input, size_t blocks, uint8_t* frame);
+// And 4 blocks of (8,4) at once.
+void interleaveSecdedAvx2(const uint8_t* frame, size_t blocks, uint8_t* output);
+void deinterleaveSecdedAvx2(const uint8_t* input, size_t blocks, uint8_t* frame);
+// Encoding and interleaving 8 blocks of (7,4) or (8,4) at once, the rows of
+// their data bits taken from registers and XORed into those of the parity
+// bits.
+void encodeBlocksInterleavedAvx2(const uint8_t* bytes, size_t frames, size_t blocks,
+                                 uint8_t* output);
+void encodeSecdedInterleavedAvx2(const uint8_t* bytes, size_t frames, size_t blocks,
+                                 uint8_t* output);
+// And the words of 4 tiles of the larger codes at once, their bytes
+// transposed so that each bit of 32 groups is one mask.
+void interleaveWordsAvx2(const uint64_t* words, size_t tiles, unsigned groupBits,
+                         uint8_t* output);
+
+// The CRC instructions of SSE4.2 and of ARMv8.
+bool sse42Supported();
+uint32_t crc32cSse42(uint32_t crc, const uint8_t* bytes, size_t bytesCount);
+bool armCrcSupported();
+uint32_t crc32cArm(uint32_t crc, const uint8_t* bytes, size_t bytesCount);
+
+bool neonSupported();
+void encodeBlocksNeon(const uint8_t* bytes, size_t blocks, uint8_t* hammingBytes);
+uint64_t decodeBlocksNeon(const uint8_t* hammingBytes, size_t blocks, uint8_t* bytes);
+void encodeSecdedNeon(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes);
+uint64_t decodeSecdedNeon(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes,
+                          uint64_t* detected);
+// The 2 halves of a slab in the 2 lanes of each register, as the SSSE3 ones.
+void encodeSlicedNeon(const uint8_t* bytes, size_t slabs, uint8_t* hammingBytes);
+uint64_t decodeSlicedNeon(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes);
+void extractSlicedNeon(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes);
+
+} // namespace kernels
+} // namespace hamming
+
+#endif
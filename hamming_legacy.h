@@ -0,0 +1,39 @@
+/**
+    @file    hamming_legacy.h
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Original "std::vector<bool>" implementation of the hamming method.
+
+    @section DESCRIPTION
+
+    Reference implementation kept as it was first written. See
+    "hamming_legacy.cpp".
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#ifndef HAMMING_LEGACY_H
+#define HAMMING_LEGACY_H
+
+#include <vector>
+
+namespace legacy {
+
+std::vector<bool> bytesToBits(std::vector<unsigned char> bytesArray);
+std::vector<unsigned char> bitsToBytes(std::vector<bool> bitsArray, int byteAdjust=0);
+std::vector<bool> addHammingParity(std::vector<bool> boolBitsArray);
+std::vector<bool> hammingCorrection(std::vector<bool> hamming7Bit);
+std::vector<bool> removeHammingParity(std::vector<bool> boolBitsArray);
+int randomIntNum(int min, int max);
+std::vector<bool> hammingError(std::vector<bool> boolBitsArray);
+
+} // namespace legacy
+
+#endif
@@ -0,0 +1,205 @@
+/**
+    @file    hamming_pool.cpp
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Pool of threads to convert the blocks of a file in parallel.
+
+    @section DESCRIPTION
+
+    "run" publishes the task and wakes the threads. Every thread, the caller
+    included, takes the next index from an atomic counter until there are no
+    more, so the tasks are balanced even when some are slower.
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#include "hamming_pool.h"
+
+namespace hamming {
+
+ThreadPool::ThreadPool(unsigned threads) :
+    currentTask(NULL),
+    tasksCount(0),
+    nextTask(0),
+    busyWorkers(0),
+    generation(0),
+    stopping(false){
+    if(threads == 0){
+        threads = std::thread::hardware_concurrency();
+    }
+    for(unsigned z = 1; z < threads; z++){
+        workers.push_back(std::thread(&ThreadPool::work, this));
+    }
+}
+
+ThreadPool::~ThreadPool(){
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    started.notify_all();
+    for(size_t z = 0; z < workers.size(); z++){
+        workers[z].join();
+    }
+}
+
+unsigned ThreadPool::size() const{
+    return (unsigned)workers.size() + 1;
+}
+
+void ThreadPool::run(size_t count, const std::function<void(size_t)>& task){
+    if(workers.empty() || (count < 2)){
+        for(size_t z = 0; z < count; z++){
+            task(z);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        currentTask = &task;
+        tasksCount = count;
+        nextTask = 0;
+        busyWorkers = workers.size();
+        generation++;
+    }
+    started.notify_all();
+    runTasks();
+
+    // The task must outlive every thread still running it.
+    std::unique_lock<std::mutex> lock(mutex);
+    while(busyWorkers > 0){
+        finished.wait(lock);
+    }
+    currentTask = NULL;
+}
+
+void ThreadPool::runBlocks(size_t blocks, size_t minPartBlocks,
+                           const std::function<void(size_t, size_t, bool)>& task){
+    size_t partBlocks = ((blocks + size()) - 1) / size();
+    if(partBlocks < minPartBlocks){
+        partBlocks = minPartBlocks;
+    }
+    if(partBlocks == 0){
+        partBlocks = 1;
+    }
+    size_t parts = ((blocks + partBlocks) - 1) / partBlocks;
+    if(parts <= 1){
+        task(0, blocks, true);
+        return;
+    }
+    run(parts, [&](size_t part){
+        size_t firstBlock = part * partBlocks;
+        size_t blocksCount = (part + 1) < parts ? partBlocks : blocks - firstBlock;
+        task(firstBlock, blocksCount, (part + 1) == parts);
+    });
+}
+
+void ThreadPool::runTasks(){
+    for(;;){
+        size_t index = nextTask++;
+        if(index >= tasksCount){
+            return;
+        }
+        (*currentTask)(index);
+    }
+}
+
+void ThreadPool::work(){
+    unsigned long lastGeneration = 0;
+    for(;;){
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while(!stopping && (generation == lastGeneration)){
+                started.wait(lock);
+            }
+            if(stopping){
+                return;
+            }
+            lastGeneration = generation;
+        }
+        runTasks();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busyWorkers--;
+        }
+        finished.notify_one();
+    }
+}
+
+namespace {
+
+// Smallest range of original bytes given to a thread (64 KiB).
+const size_t MIN_PART_BYTES = 65536;
+
+} // namespace
+
+size_t encode(Span<const uint8_t> bytes, Span<uint8_t> hammingBytes, ThreadPool& pool){
+    return encode(bytes, hammingBytes, CODE_7_4, pool);
+}
+
+size_t decode(Span<const uint8_t> hammingBytes, Span<uint8_t> bytes, ThreadPool& pool,
+              DecodeStats* stats){
+    return decode(hammingBytes, bytes, CODE_7_4, pool, stats);
+}
+
+size_t encode(Span<const uint8_t> bytes, Span<uint8_t> hammingBytes, Code code,
+              ThreadPool& pool){
+    size_t size = encodedSize(bytes.size(), code);
+    if(hammingBytes.size() < size){
+        return 0;
+    }
+
+    // The last range also gets the bytes that do not make a whole block.
+    CodeBlocks blocks = codeBlocks(code);
+    pool.runBlocks(bytes.size() / blocks.bytes, MIN_PART_BYTES / blocks.bytes,
+                   [&](size_t firstBlock, size_t blocksCount, bool last){
+        size_t from = firstBlock * blocks.bytes;
+        addHammingParity(bytes.data() + from,
+                         last ? bytes.size() - from : blocksCount * blocks.bytes,
+                         hammingBytes.data() + (firstBlock * blocks.hammingBytes), code);
+    });
+    return size;
+}
+
+size_t decode(Span<const uint8_t> hammingBytes, Span<uint8_t> bytes, Code code,
+              ThreadPool& pool, DecodeStats* stats){
+    size_t size = decodedSize(hammingBytes.size(), code);
+    if(bytes.size() < size){
+        return 0;
+    }
+    CodeBlocks blocks = codeBlocks(code);
+    std::mutex statsMutex;
+    pool.runBlocks(hammingBytes.size() / blocks.hammingBytes, MIN_PART_BYTES / blocks.bytes,
+                   [&](size_t firstBlock, size_t blocksCount, bool last){
+        size_t from = firstBlock * blocks.hammingBytes;
+        DecodeStats partStats;
+        removeHammingParity(hammingBytes.data() + from,
+                            last ? hammingBytes.size() - from : blocksCount * blocks.hammingBytes,
+                            bytes.data() + (firstBlock * blocks.bytes), code, &partStats);
+        if(stats != NULL){
+            std::lock_guard<std::mutex> lock(statsMutex);
+            *stats += partStats;
+        }
+    });
+    return size;
+}
+
+void hammingError(Span<uint8_t> hammingBytes, uint64_t seed, ThreadPool& pool){
+    pool.runBlocks(hammingBytes.size() / 7, MIN_PART_BYTES / 4,
+                   [&](size_t firstBlock, size_t blocksCount, bool last){
+        size_t from = firstBlock * 7;
+        hammingError(hammingBytes.data() + from,
+                     last ? hammingBytes.size() - from : blocksCount * 7,
+                     seed, from);
+    });
+}
+
+} // namespace hamming
@@ -0,0 +1,172 @@
+/**
+    @file    hamming_pool.h
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Pool of threads to convert the blocks of a file in parallel.
+
+    @section DESCRIPTION
+
+    Each group of 7 bits depends only on its own 4 bits, so any range of whole
+    blocks can be converted by itself and write its own part of the output.
+    The pool keeps its threads between the calls, so the cost of creating
+    them is paid only once.
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#ifndef HAMMING_POOL_H
+#define HAMMING_POOL_H
+
+#include <stddef.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "hamming.h"
+
+namespace hamming {
+
+class ThreadPool {
+public:
+
+    /**
+        @brief Start the threads.
+
+        @param unsigned threads: Number of threads that run the tasks,
+            counting the one that calls "run" (0 - one for each CPU).
+    */
+    explicit ThreadPool(unsigned threads);
+
+    /**
+        @brief Stop the threads.
+    */
+    ~ThreadPool();
+
+    /**
+        @brief Number of threads that run the tasks.
+
+        @return unsigned: Number of threads, counting the one that calls "run".
+    */
+    unsigned size() const;
+
+    /**
+        @brief Run tasks in parallel and wait for all of them.
+
+        @param size_t count: Number of tasks.
+        @param std::function<void(size_t)>& task: Called once with each index
+            from 0 to "count - 1".
+        @return void.
+    */
+    void run(size_t count, const std::function<void(size_t)>& task);
+
+    /**
+        @brief Split blocks in ranges, one or more for each thread, and
+            convert them in parallel.
+
+        @param size_t blocks: Number of blocks.
+        @param size_t minPartBlocks: Smallest range worth a thread.
+        @param std::function<void(size_t, size_t, bool)>& task: Called with
+            the first block of each range, its number of blocks and whether
+            it is the last range.
+        @return void.
+    */
+    void runBlocks(size_t blocks, size_t minPartBlocks,
+                   const std::function<void(size_t, size_t, bool)>& task);
+
+private:
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+
+    void work();
+    void runTasks();
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable started;
+    std::condition_variable finished;
+    const std::function<void(size_t)>* currentTask;
+    size_t tasksCount;
+    std::atomic<size_t> nextTask;
+    size_t busyWorkers;
+    unsigned long generation;
+    bool stopping;
+};
+
+/**
+    @brief Apply hamming parity to bytes, splitting them among the threads.
+
+    @param Span<const uint8_t> bytes: Original bytes.
+    @param Span<uint8_t> hammingBytes: Receives the bytes in the hamming
+        format.
+    @param ThreadPool& pool: Threads that do the work.
+    @return size_t: Same as "encode" without the pool.
+*/
+size_t encode(Span<const uint8_t> bytes, Span<uint8_t> hammingBytes, ThreadPool& pool);
+
+/**
+    @brief Correct and remove hamming parity from bytes, splitting them among
+        the threads.
+
+    @param Span<const uint8_t> hammingBytes: Bytes in the hamming format.
+    @param Span<uint8_t> bytes: Receives the original bytes.
+    @param ThreadPool& pool: Threads that do the work.
+    @param DecodeStats* stats: Gets the groups decoded and corrected added
+        (can be NULL). Each thread counts its own and they are added at the
+        end.
+    @return size_t: Same as "decode" without the pool.
+*/
+size_t decode(Span<const uint8_t> hammingBytes, Span<uint8_t> bytes, ThreadPool& pool,
+              DecodeStats* stats=NULL);
+
+/**
+    @brief Same as "encode" with the pool, with a code.
+
+    @param Span<const uint8_t> bytes: Original bytes.
+    @param Span<uint8_t> hammingBytes: Receives the bytes in the hamming
+        format.
+    @param Code code: Code of the hamming format.
+    @param ThreadPool& pool: Threads that do the work.
+    @return size_t: Same as "encode" without the pool.
+*/
+size_t encode(Span<const uint8_t> bytes, Span<uint8_t> hammingBytes, Code code,
+              ThreadPool& pool);
+
+/**
+    @brief Same as "decode" with the pool, with a code.
+
+    @param Span<const uint8_t> hammingBytes: Bytes in the hamming format.
+    @param Span<uint8_t> bytes: Receives the original bytes.
+    @param Code code: Code of the hamming format.
+    @param ThreadPool& pool: Threads that do the work.
+    @param DecodeStats* stats: Gets the groups decoded, corrected and detected
+        added (can be NULL).
+    @return size_t: Same as "decode" without the pool.
+*/
+size_t decode(Span<const uint8_t> hammingBytes, Span<uint8_t> bytes, Code code,
+              ThreadPool& pool, DecodeStats* stats=NULL);
+
+/**
+    @brief Generate error in bytes, splitting them among the threads. The
+        errors are the same as "hammingError" gives without the pool.
+
+    @param Span<uint8_t> hammingBytes: Bytes in the hamming format, changed in
+        place (the whole file, from its start).
+    @param uint64_t seed: Seed of the errors.
+    @param ThreadPool& pool: Threads that do the work.
+    @return void.
+*/
+void hammingError(Span<uint8_t> hammingBytes, uint64_t seed, ThreadPool& pool);
+
+} // namespace hamming
+
+#endif
@@ -0,0 +1,64 @@
+/**
+    @file    hamming_profile.cpp
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Time spent in each stage of a conversion.
+
+    @section DESCRIPTION
+
+    The table of the stages, from the counters added by "StageTimer".
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#include <inttypes.h>
+
+#include "hamming_profile.h"
+
+namespace hamming {
+
+const char* profileStageName(ProfileStage stage){
+    switch(stage){
+    case PROFILE_READ:
+        return "read";
+    case PROFILE_CONVERT:
+        return "convert";
+    case PROFILE_WRITE:
+        return "write";
+    case PROFILE_CHECKSUMS:
+        return "checksums";
+    default:
+        return "?";
+    }
+}
+
+bool printProfile(FILE* file, const Profile& profile){
+    uint64_t totalNanoseconds = 0;
+    for(unsigned z = 0; z < PROFILE_STAGES; z++){
+        totalNanoseconds += profile.stages[z].nanoseconds;
+    }
+    fprintf(file, "%-10s %12s %16s %10s %10s %7s\n", "Stage", "Time (ms)", "Bytes", "Chunks",
+            "MB/s", "Share");
+    for(unsigned z = 0; z < PROFILE_STAGES; z++){
+        const StageProfile& stage = profile.stages[z];
+        if(stage.chunks == 0){
+            continue;
+        }
+        double seconds = stage.nanoseconds / 1e9;
+        fprintf(file, "%-10s %12.3f %16" PRIu64 " %10" PRIu64 " %10.1f %6.1f%%\n",
+                profileStageName((ProfileStage)z), seconds * 1e3, stage.bytes, stage.chunks,
+                seconds > 0 ? stage.bytes / seconds / 1e6 : 0.0,
+                totalNanoseconds > 0 ? 100.0 * stage.nanoseconds / totalNanoseconds : 0.0);
+    }
+    fprintf(file, "%-10s %12.3f\n", "total", totalNanoseconds / 1e6);
+    return !ferror(file);
+}
+
+} // namespace hamming
@@ -0,0 +1,187 @@
+/**
+    @file    hamming_profile.h
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Time spent in each stage of a conversion.
+
+    @section DESCRIPTION
+
+    The conversions of "hamming_io.h" given a "Profile" add to it the time,
+    the bytes and the chunks of each of their stages, so a slow run tells
+    whether it waited for the files or for the conversion. Without a
+    "Profile" the clock is not read at all, and built with
+    "-DHAMMING_NO_PROFILE" nothing of it is left in the library.
+
+    Where "<sys/sdt.h>" exists, each stage also has the static probes
+    "hamming:stage_start" (the stage) and "hamming:stage_end" (the stage and
+    its bytes), which "perf", "bpftrace" or "SystemTap" can attach to while
+    the program runs, without a "Profile".
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#ifndef HAMMING_PROFILE_H
+#define HAMMING_PROFILE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <chrono>
+
+#ifndef HAMMING_NO_PROFILE
+#define HAMMING_PROFILE 1
+#endif
+
+#if HAMMING_PROFILE && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define HAMMING_USDT 1
+#endif
+#endif
+
+namespace hamming {
+
+/**
+    @brief Stages of a conversion.
+*/
+enum ProfileStage {
+    PROFILE_READ,      /**< Reading the chunks (with "IO_URING", waiting for
+                            them, as they are read while others convert). */
+    PROFILE_CONVERT,   /**< Converting the chunks: the bits are unpacked,
+                            encoded or decoded and packed together by the
+                            kernels (with "IO_MMAP", the pages are also read
+                            and written here). */
+    PROFILE_WRITE,     /**< Writing the converted chunks (with "IO_URING",
+                            waiting for them). */
+    PROFILE_CHECKSUMS, /**< Reading a container written again to store the
+                            CRC32C of its blocks. */
+    PROFILE_STAGES     /**< Number of stages. */
+};
+
+/**
+    @brief Counters of a stage.
+*/
+struct StageProfile {
+    uint64_t nanoseconds; /**< Time spent in it. */
+    uint64_t bytes;       /**< Bytes read, converted or written. */
+    uint64_t chunks;      /**< Times it ran. */
+
+    StageProfile() : nanoseconds(0), bytes(0), chunks(0){}
+
+    StageProfile& operator+=(const StageProfile& other){
+        nanoseconds += other.nanoseconds;
+        bytes += other.bytes;
+        chunks += other.chunks;
+        return *this;
+    }
+};
+
+/**
+    @brief Counters of all the stages of one or more conversions.
+*/
+struct Profile {
+    StageProfile stages[PROFILE_STAGES]; /**< Indexed by "ProfileStage". */
+
+    Profile& operator+=(const Profile& other){
+        for(unsigned z = 0; z < PROFILE_STAGES; z++){
+            stages[z] += other.stages[z];
+        }
+        return *this;
+    }
+};
+
+/**
+    @brief Name of a stage.
+
+    @param ProfileStage stage: Stage.
+    @return const char*: "read", "convert", "write" or "checksums".
+*/
+const char* profileStageName(ProfileStage stage);
+
+/**
+    @brief Print a table of the stages that ran: time, bytes, chunks, speed
+        and share of the whole time of each one.
+
+    @param FILE* file: File to print to.
+    @param Profile& profile: Counters.
+    @return bool: false if the file could not be written.
+*/
+bool printProfile(FILE* file, const Profile& profile);
+
+#if HAMMING_PROFILE
+
+/**
+    @brief Times a stage, from its creation to "stop" (internal).
+*/
+class StageTimer {
+public:
+
+    /**
+        @brief Start timing.
+
+        @param Profile* profile: Gets the counters added (NULL - only the
+            probes).
+        @param ProfileStage stage: Stage timed.
+    */
+    StageTimer(Profile* profile, ProfileStage stage) :
+        profile(profile),
+        stage(stage),
+        running(true){
+#if HAMMING_USDT
+        STAP_PROBE1(hamming, stage_start, (int)stage);
+#endif
+        if(profile != NULL){
+            start = std::chrono::steady_clock::now();
+        }
+    }
+
+    /**
+        @brief Stop timing and add the counters (only the first time).
+
+        @param uint64_t bytes: Bytes of the stage.
+        @param uint64_t chunks: Times it ran.
+        @return void.
+    */
+    void stop(uint64_t bytes, uint64_t chunks=1){
+        if(!running){
+            return;
+        }
+        running = false;
+#if HAMMING_USDT
+        STAP_PROBE2(hamming, stage_end, (int)stage, bytes);
+#endif
+        if(profile != NULL){
+            StageProfile& counters = profile->stages[stage];
+            counters.nanoseconds += (uint64_t)std::chrono::duration_cast<
+                std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+            counters.bytes += bytes;
+            counters.chunks += chunks;
+        }
+    }
+
+private:
+    Profile* profile;
+    ProfileStage stage;
+    bool running;
+    std::chrono::steady_clock::time_point start;
+};
+
+#else
+
+class StageTimer {
+public:
+    StageTimer(Profile*, ProfileStage){}
+    void stop(uint64_t, uint64_t=1){}
+};
+
+#endif
+
+} // namespace hamming
+
+#endif
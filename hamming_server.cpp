@@ -0,0 +1,719 @@
+/**
+    @file    hamming_server.cpp
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Applies the hamming method to the streams of network connections.
+
+    @section DESCRIPTION
+
+    A long-running server that accepts connections on TCP or Unix sockets.
+    Each connection starts with one line, "encode <code>" or "decode
+    <code>", answered with "ok" (or "error <reason>" before closing), and
+    then everything the client sends is converted and sent back as it
+    arrives, until the client shuts its side down.
+
+    Each thread of a "ThreadPool" runs an epoll loop of its own over
+    non-blocking sockets, taking turns to accept from the listening
+    sockets, and converts the chunks of its connections itself. A
+    connection has a buffer for what it reads and one for what it writes:
+    a chunk is converted only after the one before has been sent, and
+    nothing more is read once the first buffer is full, so a client that
+    does not read its output stops being read and TCP slows it down,
+    without any connection holding more than its two buffers.
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "hamming.h"
+#include "hamming_pool.h"
+
+#if defined(__linux__)
+#define HAMMING_SERVER 1
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Only one of the loops waiting is woken for each connection (Linux 4.5).
+#ifndef EPOLLEXCLUSIVE
+#define EPOLLEXCLUSIVE 0
+#endif
+#endif
+
+#if HAMMING_SERVER
+
+namespace {
+
+// Bytes read from a connection at most, of which the whole blocks are
+// converted at a time. The converted bytes take at most twice as much.
+const size_t SERVER_CHUNK_BYTES = 256 * 1024;
+const size_t SERVER_OUTPUT_BYTES = 2 * SERVER_CHUNK_BYTES;
+
+// Longest first line of a connection.
+const size_t MAX_REQUEST_BYTES = 64;
+
+// Chunks converted for a connection before the loop goes to the others.
+const unsigned MAX_CHUNKS_IN_A_ROW = 4;
+
+// Events waited for at a time by each loop.
+const int MAX_EVENTS = 64;
+
+/**
+    @brief What an event of the loops is about.
+*/
+enum PollKind {
+    POLL_STOP,      /**< The server is stopping. */
+    POLL_LISTENER,  /**< A listening socket has a connection. */
+    POLL_CONNECTION /**< A connection can be read or written. */
+};
+
+/**
+    @brief A file descriptor watched by the loops.
+*/
+struct Pollable {
+    int fd;
+    PollKind kind;
+};
+
+/**
+    @brief A client and the state of its stream.
+*/
+struct Connection : Pollable {
+    bool started;         /**< Its first line was read. */
+    bool encoding;        /**< Encodes (or decodes) the stream. */
+    hamming::Code code;   /**< Code of the hamming format. */
+    bool refused;         /**< Its first line was wrong: the error is sent
+                               and nothing more is read. */
+    size_t blockBytes;    /**< Bytes read of a block of the code. */
+    bool inputEnded;      /**< The client shut its side down. */
+    uint32_t events;      /**< Events it is being watched for. */
+    std::unique_ptr<uint8_t[]> input;  /**< "SERVER_CHUNK_BYTES". */
+    std::unique_ptr<uint8_t[]> output; /**< "SERVER_OUTPUT_BYTES". */
+    size_t inputSize;     /**< Bytes read and not converted yet. */
+    size_t outputStart;   /**< Bytes of "output" already sent. */
+    size_t outputSize;    /**< Bytes of "output" to be sent. */
+    uint64_t bytesRead;
+    uint64_t bytesWritten;
+    hamming::DecodeStats stats;
+    std::string peer;     /**< Address of the client, for the messages. */
+};
+
+/**
+    @brief How the server runs.
+*/
+struct ServerOptions {
+    std::vector<Pollable> listeners; /**< Listening sockets. */
+    Pollable stop;                   /**< Read end of "stopPipe". */
+    unsigned maxConnections;         /**< Connections open at once. */
+    bool verbose;                    /**< A message for each connection. */
+};
+
+// Pipe written by the signals that stop the server. Its read end is never
+// read, so it wakes every loop.
+int stopPipe[2] = {-1, -1};
+
+// Connections open in all the loops.
+std::atomic<unsigned> openConnections(0);
+
+void stopServer(int){
+    ssize_t written = write(stopPipe[1], "x", 1);
+    (void)written;
+}
+
+/**
+    @brief Make a socket non-blocking.
+
+    @param int fd: Socket.
+    @return bool: false if it could not be changed.
+*/
+bool setNonBlocking(int fd){
+    int flags = fcntl(fd, F_GETFL);
+    return (flags >= 0) && (fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0);
+}
+
+/**
+    @brief Listen on a TCP port.
+
+    @param char* address: "[host:]port" (no host - every address). An IPv6
+        host is given between brackets ("[::1]:9000").
+    @param Pollable* listener: Receives the socket.
+    @return bool: false if it could not listen ("errno" says why, EINVAL
+        for an address not understood).
+*/
+bool listenTcp(const char* address, Pollable* listener){
+    std::string host;
+    std::string port = address;
+    size_t colon = port.rfind(':');
+    if(colon != std::string::npos){
+        host = port.substr(0, colon);
+        port = port.substr(colon + 1);
+        if((host.size() >= 2) && (host[0] == '[') && (host[host.size() - 1] == ']')){
+            host = host.substr(1, host.size() - 2);
+        }
+    }
+    addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    addrinfo* addresses;
+    if(getaddrinfo(host.empty() ? NULL : host.c_str(), port.c_str(), &hints, &addresses) != 0){
+        errno = EINVAL;
+        return false;
+    }
+    int fd = -1;
+    int bindErrno = EADDRNOTAVAIL;
+    for(addrinfo* item = addresses; (item != NULL) && (fd < 0); item = item->ai_next){
+        fd = socket(item->ai_family, item->ai_socktype | SOCK_CLOEXEC, item->ai_protocol);
+        if(fd < 0){
+            bindErrno = errno;
+            continue;
+        }
+        int yes = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+        if((bind(fd, item->ai_addr, item->ai_addrlen) != 0) || (listen(fd, SOMAXCONN) != 0)){
+            bindErrno = errno;
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(addresses);
+    if((fd < 0) || !setNonBlocking(fd)){
+        if(fd >= 0){
+            bindErrno = errno;
+            close(fd);
+        }
+        errno = bindErrno;
+        return false;
+    }
+    listener->fd = fd;
+    listener->kind = POLL_LISTENER;
+    return true;
+}
+
+/**
+    @brief Listen on a Unix socket. A socket left at the path by a server
+        before is replaced (any other file is not).
+
+    @param char* path: Path of the socket.
+    @param Pollable* listener: Receives the socket.
+    @return bool: false if it could not listen ("errno" says why).
+*/
+bool listenUnix(const char* path, Pollable* listener){
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if(strlen(path) >= sizeof(address.sun_path)){
+        errno = ENAMETOOLONG;
+        return false;
+    }
+    strcpy(address.sun_path, path);
+    struct stat pathStat;
+    if((lstat(path, &pathStat) == 0) && S_ISSOCK(pathStat.st_mode)){
+        unlink(path);
+    }
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if(fd < 0){
+        return false;
+    }
+    if((bind(fd, (const sockaddr*)&address, sizeof(address)) != 0) ||
+       (listen(fd, SOMAXCONN) != 0) || !setNonBlocking(fd)){
+        int listenErrno = errno;
+        close(fd);
+        errno = listenErrno;
+        return false;
+    }
+    listener->fd = fd;
+    listener->kind = POLL_LISTENER;
+    return true;
+}
+
+/**
+    @brief Address of the client of a socket.
+
+    @param sockaddr_storage& address: Given by "accept".
+    @return std::string: "host:port", or "unix" for a Unix socket.
+*/
+std::string peerName(const sockaddr_storage& address){
+    char host[NI_MAXHOST];
+    char port[NI_MAXSERV];
+    if((address.ss_family == AF_UNIX) ||
+       (getnameinfo((const sockaddr*)&address, sizeof(address), host, sizeof(host), port,
+                    sizeof(port), NI_NUMERICHOST | NI_NUMERICSERV) != 0)){
+        return "unix";
+    }
+    return address.ss_family == AF_INET6 ? "[" + std::string(host) + "]:" + port :
+                                           std::string(host) + ":" + port;
+}
+
+/**
+    @brief Put a line in the output of a connection (it is empty when
+        called).
+
+    @param Connection* connection: Connection.
+    @param char* line: Line, with its "\n".
+    @return void.
+*/
+void answer(Connection* connection, const char* line){
+    size_t size = strlen(line);
+    memcpy(connection->output.get(), line, size);
+    connection->outputStart = 0;
+    connection->outputSize = size;
+}
+
+/**
+    @brief Read the first line of a connection, if it has all arrived.
+
+    @param Connection* connection: Connection.
+    @return void.
+*/
+void readRequest(Connection* connection){
+    size_t lineSize = connection->inputSize < MAX_REQUEST_BYTES ? connection->inputSize :
+                                                                  MAX_REQUEST_BYTES;
+    const uint8_t* input = connection->input.get();
+    const uint8_t* newLine = (const uint8_t*)memchr(input, '\n', lineSize);
+    if(newLine == NULL){
+        if(connection->inputSize >= MAX_REQUEST_BYTES){
+            answer(connection, "error the first line must be \"encode <code>\" or "
+                               "\"decode <code>\"\n");
+            connection->refused = true;
+        }else if(connection->inputEnded){
+            connection->inputSize = 0;
+        }
+        return;
+    }
+    std::string line((const char*)input, (size_t)(newLine - input));
+    if(!line.empty() && (line[line.size() - 1] == '\r')){
+        line.erase(line.size() - 1);
+    }
+    size_t space = line.find(' ');
+    std::string verb = line.substr(0, space);
+    std::string codeName = space == std::string::npos ? std::string("7,4") :
+                                                        line.substr(space + 1);
+    if((verb != "encode") && (verb != "decode")){
+        answer(connection, "error the first line must be \"encode <code>\" or "
+                           "\"decode <code>\"\n");
+        connection->refused = true;
+        return;
+    }
+    if(!hamming::parseCode(codeName.c_str(), &connection->code)){
+        answer(connection, "error unknown code\n");
+        connection->refused = true;
+        return;
+    }
+    connection->started = true;
+    connection->encoding = verb == "encode";
+    hamming::CodeBlocks blocks = hamming::codeBlocks(connection->code);
+    connection->blockBytes = connection->encoding ? blocks.bytes : blocks.hammingBytes;
+    size_t lineBytes = (size_t)(newLine - input) + 1;
+    connection->inputSize -= lineBytes;
+    memmove(connection->input.get(), input + lineBytes, connection->inputSize);
+    answer(connection, "ok\n");
+}
+
+/**
+    @brief Convert the whole blocks read (all the bytes read, once the
+        client has shut its side down) into the output, which is empty.
+
+    @param Connection* connection: Connection.
+    @return bool: false if there was nothing to convert.
+*/
+bool convertInput(Connection* connection){
+    size_t size = connection->inputEnded ? connection->inputSize :
+                  (connection->inputSize / connection->blockBytes) * connection->blockBytes;
+    if(size == 0){
+        return false;
+    }
+    uint8_t* input = connection->input.get();
+    uint8_t* output = connection->output.get();
+    if(connection->encoding){
+        hamming::addHammingParity(input, size, output, connection->code);
+        connection->outputSize = hamming::encodedSize(size, connection->code);
+    }else{
+        connection->outputSize = hamming::removeHammingParity(input, size, output,
+                                                              connection->code,
+                                                              &connection->stats);
+    }
+    connection->outputStart = 0;
+    connection->inputSize -= size;
+    memmove(input, input + size, connection->inputSize);
+    return true;
+}
+
+/**
+    @brief Move a connection on as far as it goes without waiting: send its
+        output, convert what it read, and read more while there is room.
+
+    @param Connection* connection: Connection.
+    @return bool: false if it is over (finished, failed or refused).
+*/
+bool pump(Connection* connection){
+    unsigned chunks = 0;
+    for(;;){
+        bool moved = false;
+        if(connection->outputStart < connection->outputSize){
+            ssize_t count = send(connection->fd, connection->output.get() +
+                                 connection->outputStart,
+                                 connection->outputSize - connection->outputStart,
+                                 MSG_NOSIGNAL);
+            if(count > 0){
+                connection->outputStart += (size_t)count;
+                connection->bytesWritten += (uint64_t)count;
+                moved = true;
+            }else if((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR)){
+                return false;
+            }
+        }
+        bool outputSent = connection->outputStart == connection->outputSize;
+        if(connection->refused){
+            if(outputSent){
+                return false;
+            }
+            if(!moved){
+                return true;
+            }
+            continue;
+        }
+        if(!connection->started && (connection->inputSize > 0)){
+            readRequest(connection);
+            if(connection->refused){
+                continue;
+            }
+            outputSent = connection->outputStart == connection->outputSize;
+        }
+        if(connection->started && outputSent && (chunks < MAX_CHUNKS_IN_A_ROW) &&
+           convertInput(connection)){
+            chunks++;
+            moved = true;
+        }
+        if(!connection->inputEnded && (connection->inputSize < SERVER_CHUNK_BYTES) &&
+           (chunks < MAX_CHUNKS_IN_A_ROW)){
+            ssize_t count = recv(connection->fd, connection->input.get() + connection->inputSize,
+                                 SERVER_CHUNK_BYTES - connection->inputSize, 0);
+            if(count > 0){
+                connection->inputSize += (size_t)count;
+                connection->bytesRead += (uint64_t)count;
+                moved = true;
+            }else if(count == 0){
+                connection->inputEnded = true;
+                moved = true;
+            }else if((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR)){
+                return false;
+            }
+        }
+        if(connection->inputEnded && (connection->inputSize == 0) &&
+           (connection->outputStart == connection->outputSize)){
+            return false;
+        }
+        if(!moved){
+            return true;
+        }
+    }
+}
+
+/**
+    @brief Events a connection waits for: reading while there is room and
+        it has not ended, writing while it has output, or blocks left to
+        convert when it gave its turn to the other connections (the socket
+        being writable, the loop comes back to it at once).
+
+    @param Connection& connection: Connection.
+    @return uint32_t: Events for "epoll_ctl".
+*/
+uint32_t connectionEvents(const Connection& connection){
+    uint32_t events = 0;
+    if(!connection.refused && !connection.inputEnded &&
+       (connection.inputSize < SERVER_CHUNK_BYTES)){
+        events |= EPOLLIN;
+    }
+    bool converting = connection.started &&
+                      (connection.inputEnded ? connection.inputSize > 0 :
+                                               connection.inputSize >= connection.blockBytes);
+    if((connection.outputStart < connection.outputSize) || converting){
+        events |= EPOLLOUT;
+    }
+    return events;
+}
+
+/**
+    @brief Close a connection.
+
+    @param Connection* connection: Connection.
+    @param ServerOptions& options: How the server runs.
+    @return void.
+*/
+void closeConnection(Connection* connection, const ServerOptions& options){
+    if(options.verbose){
+        fprintf(stderr, "%s: %s %s, %" PRIu64 " bytes read, %" PRIu64 " written",
+                connection->peer.c_str(),
+                !connection->started ? "refused" : connection->encoding ? "encode" : "decode",
+                connection->started ? hamming::codeName(connection->code) : "-",
+                connection->bytesRead, connection->bytesWritten);
+        if(connection->started && !connection->encoding){
+            fprintf(stderr, ", %" PRIu64 " groups corrected, %" PRIu64 " detected",
+                    connection->stats.corrected, connection->stats.detected);
+        }
+        fprintf(stderr, "\n");
+    }
+    close(connection->fd);
+    openConnections--;
+}
+
+/**
+    @brief Accept a connection, refusing it when there are already
+        "maxConnections".
+
+    @param int epollFd: Loop that gets it.
+    @param int listenerFd: Listening socket.
+    @param ServerOptions& options: How the server runs.
+    @param std::unordered_map<int, std::unique_ptr<Connection> >*
+        connections: Connections of the loop.
+    @return void.
+*/
+void acceptConnection(int epollFd, int listenerFd, const ServerOptions& options,
+                      std::unordered_map<int, std::unique_ptr<Connection> >* connections){
+    sockaddr_storage address;
+    socklen_t addressSize = sizeof(address);
+    int fd = accept4(listenerFd, (sockaddr*)&address, &addressSize,
+                     SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if(fd < 0){
+
+        // Another loop took it first.
+        return;
+    }
+    if(++openConnections > options.maxConnections){
+        static const char busy[] = "error busy\n";
+        ssize_t written = send(fd, busy, sizeof(busy) - 1, MSG_NOSIGNAL);
+        (void)written;
+        close(fd);
+        openConnections--;
+        return;
+    }
+    if(address.ss_family != AF_UNIX){
+        int yes = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+    }
+    std::unique_ptr<Connection> connection(new Connection());
+    connection->fd = fd;
+    connection->kind = POLL_CONNECTION;
+    connection->started = false;
+    connection->refused = false;
+    connection->encoding = true;
+    connection->code = hamming::CODE_7_4;
+    connection->blockBytes = 1;
+    connection->inputEnded = false;
+    connection->input.reset(new uint8_t[SERVER_CHUNK_BYTES]);
+    connection->output.reset(new uint8_t[SERVER_OUTPUT_BYTES]);
+    connection->inputSize = 0;
+    connection->outputStart = 0;
+    connection->outputSize = 0;
+    connection->bytesRead = 0;
+    connection->bytesWritten = 0;
+    connection->peer = peerName(address);
+    connection->events = EPOLLIN;
+    epoll_event event;
+    event.events = connection->events;
+    event.data.ptr = connection.get();
+    if(epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0){
+        closeConnection(connection.get(), options);
+        return;
+    }
+    (*connections)[fd] = std::move(connection);
+}
+
+/**
+    @brief Run a loop of the server until it stops.
+
+    @param ServerOptions& options: How the server runs.
+    @return bool: false if the loop could not be started.
+*/
+bool serveLoop(const ServerOptions& options){
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if(epollFd < 0){
+        return false;
+    }
+    std::vector<const Pollable*> watched;
+    watched.push_back(&options.stop);
+    for(size_t z = 0; z < options.listeners.size(); z++){
+        watched.push_back(&options.listeners[z]);
+    }
+    for(size_t z = 0; z < watched.size(); z++){
+        epoll_event event;
+        event.events = watched[z]->kind == POLL_LISTENER ? EPOLLIN | EPOLLEXCLUSIVE : EPOLLIN;
+        event.data.ptr = (void*)watched[z];
+        if(epoll_ctl(epollFd, EPOLL_CTL_ADD, watched[z]->fd, &event) != 0){
+            close(epollFd);
+            return false;
+        }
+    }
+
+    std::unordered_map<int, std::unique_ptr<Connection> > connections;
+    epoll_event events[MAX_EVENTS];
+    bool stopping = false;
+    while(!stopping){
+        int count = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        if(count < 0){
+            if(errno == EINTR){
+                continue;
+            }
+            break;
+        }
+        for(int z = 0; z < count; z++){
+            Pollable* pollable = (Pollable*)events[z].data.ptr;
+            if(pollable->kind == POLL_STOP){
+                stopping = true;
+            }else if(pollable->kind == POLL_LISTENER){
+                acceptConnection(epollFd, pollable->fd, options, &connections);
+            }else{
+                Connection* connection = static_cast<Connection*>(pollable);
+                uint32_t wanted = pump(connection) ? connectionEvents(*connection) : 0;
+
+                // Hung up with nothing to send: nothing more will happen.
+                if((wanted != 0) && ((events[z].events & (EPOLLERR | EPOLLHUP)) != 0) &&
+                   ((wanted & EPOLLOUT) == 0)){
+                    wanted = 0;
+                }
+                if(wanted == 0){
+                    epoll_ctl(epollFd, EPOLL_CTL_DEL, connection->fd, NULL);
+                    closeConnection(connection, options);
+                    connections.erase(connection->fd);
+                    continue;
+                }
+                if(wanted != connection->events){
+                    epoll_event event;
+                    event.events = wanted;
+                    event.data.ptr = connection;
+                    connection->events = wanted;
+                    epoll_ctl(epollFd, EPOLL_CTL_MOD, connection->fd, &event);
+                }
+            }
+        }
+    }
+    for(auto& item : connections){
+        closeConnection(item.second.get(), options);
+    }
+    close(epollFd);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]){
+
+    ServerOptions options;
+    options.maxConnections = 1024;
+    options.verbose = false;
+    std::vector<std::string> unixPaths;
+    unsigned threads = 0;
+    for(int argCount = 1; argCount < argc; argCount++){
+        if((strcmp(argv[argCount], "--kernel") == 0) && ((argCount + 1) < argc)){
+            hamming::Kernel kernel;
+            if(!hamming::parseKernel(argv[++argCount], &kernel)){
+                fprintf(stderr, "Unknown kernel \"%s\"!\n", argv[argCount]);
+                return 1;
+            }
+            if(!hamming::setKernel(kernel)){
+                fprintf(stderr, "Kernel \"%s\" is not supported by this CPU!\n", argv[argCount]);
+                return 1;
+            }
+        }else if((strcmp(argv[argCount], "--tcp") == 0) && ((argCount + 1) < argc)){
+            Pollable listener;
+            if(!listenTcp(argv[++argCount], &listener)){
+                fprintf(stderr, "Could not listen on \"%s\": %s\n", argv[argCount],
+                        strerror(errno));
+                return 1;
+            }
+            options.listeners.push_back(listener);
+        }else if((strcmp(argv[argCount], "--unix") == 0) && ((argCount + 1) < argc)){
+            Pollable listener;
+            if(!listenUnix(argv[++argCount], &listener)){
+                fprintf(stderr, "Could not listen on \"%s\": %s\n", argv[argCount],
+                        strerror(errno));
+                return 1;
+            }
+            options.listeners.push_back(listener);
+            unixPaths.push_back(argv[argCount]);
+        }else if((strcmp(argv[argCount], "-j") == 0) && ((argCount + 1) < argc)){
+            threads = (unsigned)atoi(argv[++argCount]);
+        }else if((strcmp(argv[argCount], "--max-connections") == 0) && ((argCount + 1) < argc)){
+            options.maxConnections = (unsigned)atoi(argv[++argCount]);
+        }else if(strcmp(argv[argCount], "-v") == 0){
+            options.verbose = true;
+        }else{
+            options.listeners.clear();
+            break;
+        }
+    }
+    if(options.listeners.empty() || (options.maxConnections == 0)){
+        fprintf(stderr, "Usage: %s [--kernel auto|bitwise|table|ssse3|avx2|neon] [-j threads] [--max-connections count] [-v] (--tcp [host:]port | --unix path)...\n", argv[0]);
+        return 1;
+    }
+    if(pipe2(stopPipe, O_CLOEXEC) != 0){
+        fprintf(stderr, "Could not start: %s\n", strerror(errno));
+        return 1;
+    }
+    options.stop.fd = stopPipe[0];
+    options.stop.kind = POLL_STOP;
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGINT, stopServer);
+    signal(SIGTERM, stopServer);
+
+    // Each thread of the pool runs one loop, until the server stops.
+    hamming::ThreadPool pool(threads);
+    fprintf(stdout, "%s", "> ---------------------------------------------\n");
+    fprintf(stdout, "Serving with %u threads!\n", pool.size());
+    fprintf(stdout, "%s", "\n< ---------------------------------------------\n");
+    fflush(stdout);
+    std::atomic<unsigned> failed(0);
+    pool.run(pool.size(), [&](size_t){
+        if(!serveLoop(options)){
+            failed++;
+            stopServer(0);
+        }
+    });
+    for(size_t z = 0; z < options.listeners.size(); z++){
+        close(options.listeners[z].fd);
+    }
+    for(size_t z = 0; z < unixPaths.size(); z++){
+        unlink(unixPaths[z].c_str());
+    }
+    if(failed > 0){
+        fprintf(stderr, "Could not start the loops: %s\n", strerror(errno));
+        return 1;
+    }
+
+    return 0;
+}
+
+#else
+
+int main(int, char *argv[]){
+    fprintf(stderr, "%s needs Linux (epoll)!\n", argv[0]);
+    return 1;
+}
+
+#endif
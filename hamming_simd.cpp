@@ -0,0 +1,2304 @@
+/**
+    @file    hamming_simd.cpp
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief SIMD kernels (SSSE3, AVX2 and NEON) of the hamming method.
+
+    @section DESCRIPTION
+
+    To encode, the two nibbles of each byte go through a 16 entries table
+    ("pshufb"/"tbl") that gives their groups of 7 bits. Then the groups are
+    joined 2 by 2 (14 bits), 4 by 4 (28 bits) and 8 by 8 (56 bits) inside each
+    64 bits lane, and a last shuffle writes the 7 bytes of each lane most
+    significant first.
+
+    To decode, the same steps are done backwards, splitting the 56 bits of
+    each block into 8 bytes with one group each. The syndrome ("S", XOR of
+    the positions of the odd bits) and the 4 original bits ("D") of a group
+    are the XOR of the parts given by its positions 7~5 and 4~1, so two
+    tables give "S | D << 3" and a third one gives the data bit to be
+    inverted for each syndrome. A group was corrected when its syndrome is not
+    zero, which is counted in one byte for each group and summed ("psadbw")
+    before the bytes can overflow.
+
+    The code (8,4) needs no shifting at all: each nibble is looked up as its
+    byte, and each byte is split in its 2 nibbles, whose parts of
+    "D | S << 4 | P << 7" (P being the parity of the bits) are XORed. "S | P"
+    then gives the data bit to be inverted and whether a bit was corrected
+    (P odd) or two were detected (P even, S not zero), and "pmaddubsw" joins
+    the nibbles 2 by 2.
+
+    The blocks known to be clean only need their data bits, which "pext"
+    (BMI2) takes from a whole block of 7 bytes (or 8 groups of (8,4)) at
+    once. The CRC32C instruction of SSE4.2 waits for the one before it, so
+    3 parts of 4 KiB are computed at the same time and joined by shifting
+    their CRCs over the zeros of the parts after them, a linear function
+    looked up byte by byte.
+
+    The bit-sliced layout of (7,4) keeps each plane of a slab in one AVX2
+    register: encoding takes the same bit of 32 bytes with "movemask" and
+    XORs the data planes into the parity ones, and decoding XORs them into
+    the 3 bits of the syndromes, whose ANDs are the data bits to be
+    inverted. The data planes become bytes again by broadcasting each mask
+    of 32 bits and comparing each byte with its bit.
+
+    The x86 kernels are compiled with the "target" attribute, so the same
+    binary runs on any x86-64 machine and "hamming.cpp" only calls them after
+    checking the CPU. NEON is part of every AArch64 CPU.
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#include <string.h>
+#include <vector>
+
+#include "hamming_kernels.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define HAMMING_X86 1
+#include <immintrin.h>
+#endif
+
+// "pext" and the CRC instruction on 64 bits.
+#if defined(__x86_64__) && defined(__GNUC__)
+#define HAMMING_X86_64 1
+#endif
+
+#if defined(__aarch64__)
+#define HAMMING_NEON 1
+#include <arm_neon.h>
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+#endif
+
+namespace hamming {
+namespace kernels {
+
+#if HAMMING_X86
+
+namespace {
+
+/**
+    @brief Join the groups of 7 bits of 8 original bytes into 2 blocks.
+
+    @param __m128i groups: Groups of the low and high nibbles of 8 original
+        bytes, as given by "nibbleGroupsSsse3".
+    @return __m128i: The 2 blocks in the hamming format at bytes 0~13.
+*/
+__attribute__((target("ssse3")))
+inline __m128i joinGroupsSsse3(__m128i groups){
+
+    // 2 by 2: high * 64 + low = high << 7 | low.
+    __m128i bits14 = _mm_maddubs_epi16(groups, _mm_set1_epi16(0x4001));
+
+    // 4 by 4: first << 14 | second.
+    __m128i bits28 = _mm_madd_epi16(bits14, _mm_set1_epi32(0x00014000));
+
+    // 8 by 8: first << 28 | second.
+    __m128i bits56 = _mm_or_si128(
+        _mm_slli_epi64(_mm_and_si128(bits28, _mm_set1_epi64x(0xFFFFFFFF)), 28),
+        _mm_srli_epi64(bits28, 32));
+
+    return _mm_shuffle_epi8(bits56, _mm_setr_epi8(
+        6, 5, 4, 3, 2, 1, 0, 14, 13, 12, 11, 10, 9, 8, -1, -1));
+}
+
+/**
+    @brief Low/high nibble groups of 16 original bytes.
+
+    @param __m128i bytes: 16 original bytes.
+    @param __m128i* lowGroups: Receives bytes 0~7 ready for "joinGroupsSsse3".
+    @param __m128i* highGroups: Receives bytes 8~15 ready for "joinGroupsSsse3".
+    @return void.
+*/
+__attribute__((target("ssse3")))
+inline void nibbleGroupsSsse3(__m128i bytes, __m128i* lowGroups, __m128i* highGroups){
+    const __m128i lowTable = _mm_setr_epi8(
+        0x00, 0x07, 0x19, 0x1E, 0x2A, 0x2D, 0x33, 0x34,
+        0x4B, 0x4C, 0x52, 0x55, 0x61, 0x66, 0x78, 0x7F);
+
+    // The same groups shifted by 1, so that "_mm_maddubs_epi16" can multiply
+    // them by 64 (its multipliers are signed bytes).
+    const __m128i highTable = _mm_setr_epi8(
+        0x00, 0x0E, 0x32, 0x3C, 0x54, 0x5A, 0x66, 0x68,
+        (char)0x96, (char)0x98, (char)0xA4, (char)0xAA,
+        (char)0xC2, (char)0xCC, (char)0xF0, (char)0xFE);
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+
+    __m128i low = _mm_shuffle_epi8(lowTable, _mm_and_si128(bytes, nibbleMask));
+    __m128i high = _mm_shuffle_epi8(highTable,
+        _mm_and_si128(_mm_srli_epi16(bytes, 4), nibbleMask));
+    *lowGroups = _mm_unpacklo_epi8(low, high);
+    *highGroups = _mm_unpackhi_epi8(low, high);
+}
+
+/**
+    @brief Correct and remove hamming parity from 2 blocks.
+
+    @param __m128i hammingBytes: 2 blocks (14 bytes) in the hamming format at
+        bytes 0~13.
+    @param __m128i* corrected: Each byte gets one more for its group if it
+        had a bit corrected.
+    @return __m128i: The 16 corrected nibbles as 8 bytes (16 bits lanes with
+        "high * 16 + low").
+*/
+__attribute__((target("ssse3")))
+inline __m128i splitGroupsSsse3(__m128i hammingBytes, __m128i* corrected){
+
+    // Each block in a 64 bits lane, with its first byte as the most
+    // significant.
+    __m128i bits56 = _mm_shuffle_epi8(hammingBytes, _mm_setr_epi8(
+        6, 5, 4, 3, 2, 1, 0, -1, 13, 12, 11, 10, 9, 8, 7, -1));
+
+    // 2 halves of 28 bits in the 32 bits lanes (the first half in the low
+    // lane), then 4 quarters of 14 bits and at last 8 bytes with a group each.
+    __m128i bits28 = _mm_or_si128(
+        _mm_srli_epi64(bits56, 28),
+        _mm_and_si128(_mm_slli_epi64(bits56, 32), _mm_set1_epi64x(0x0FFFFFFF00000000LL)));
+    __m128i bits14 = _mm_or_si128(
+        _mm_srli_epi32(bits28, 14),
+        _mm_and_si128(_mm_slli_epi32(bits28, 16), _mm_set1_epi32(0x3FFF0000)));
+    __m128i groups = _mm_or_si128(
+        _mm_srli_epi16(bits14, 7),
+        _mm_and_si128(_mm_slli_epi16(bits14, 8), _mm_set1_epi16(0x7F00)));
+
+    // "S | D << 3" of positions 7~5 and of positions 4~1.
+    const __m128i highTable = _mm_setr_epi8(
+        0x00, 0x15, 0x26, 0x33, 0x47, 0x52, 0x61, 0x74,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
+    const __m128i lowTable = _mm_setr_epi8(
+        0x00, 0x01, 0x02, 0x03, 0x0B, 0x0A, 0x09, 0x08,
+        0x04, 0x05, 0x06, 0x07, 0x0F, 0x0E, 0x0D, 0x0C);
+
+    // Data bit inverted by each syndrome (7 - D7, 6 - D6, 5 - D5, 3 - D3).
+    const __m128i flipTable = _mm_setr_epi8(
+        0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x04, 0x08,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+
+    __m128i syndromeData = _mm_xor_si128(
+        _mm_shuffle_epi8(highTable, _mm_and_si128(_mm_srli_epi16(groups, 4), nibbleMask)),
+        _mm_shuffle_epi8(lowTable, _mm_and_si128(groups, nibbleMask)));
+    __m128i syndrome = _mm_and_si128(syndromeData, _mm_set1_epi8(0x07));
+    __m128i nibbles = _mm_xor_si128(
+        _mm_and_si128(_mm_srli_epi16(syndromeData, 3), nibbleMask),
+        _mm_shuffle_epi8(flipTable, syndrome));
+    *corrected = _mm_add_epi8(*corrected, _mm_min_epu8(syndrome, _mm_set1_epi8(1)));
+
+    return _mm_maddubs_epi16(nibbles, _mm_set1_epi16(0x0110));
+}
+
+/**
+    @brief Same as "joinGroupsSsse3" in each 128 bits lane.
+*/
+__attribute__((target("avx2")))
+inline __m256i joinGroupsAvx2(__m256i groups){
+    __m256i bits14 = _mm256_maddubs_epi16(groups, _mm256_set1_epi16(0x4001));
+    __m256i bits28 = _mm256_madd_epi16(bits14, _mm256_set1_epi32(0x00014000));
+    __m256i bits56 = _mm256_or_si256(
+        _mm256_slli_epi64(_mm256_and_si256(bits28, _mm256_set1_epi64x(0xFFFFFFFF)), 28),
+        _mm256_srli_epi64(bits28, 32));
+    return _mm256_shuffle_epi8(bits56, _mm256_setr_epi8(
+        6, 5, 4, 3, 2, 1, 0, 14, 13, 12, 11, 10, 9, 8, -1, -1,
+        6, 5, 4, 3, 2, 1, 0, 14, 13, 12, 11, 10, 9, 8, -1, -1));
+}
+
+/**
+    @brief Sum of the byte counters of "splitGroupsSsse3".
+
+    @param __m128i counts: 16 counters.
+    @return uint64_t: Their sum.
+*/
+__attribute__((target("ssse3")))
+inline uint64_t sumCountsSsse3(__m128i counts){
+    __m128i sums = _mm_sad_epu8(counts, _mm_setzero_si128());
+    return (uint64_t)_mm_cvtsi128_si32(sums) + (uint64_t)_mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+}
+
+/**
+    @brief Same as "splitGroupsSsse3" in each 128 bits lane.
+*/
+__attribute__((target("avx2")))
+inline __m256i splitGroupsAvx2(__m256i hammingBytes, __m256i* corrected){
+    __m256i bits56 = _mm256_shuffle_epi8(hammingBytes, _mm256_setr_epi8(
+        6, 5, 4, 3, 2, 1, 0, -1, 13, 12, 11, 10, 9, 8, 7, -1,
+        6, 5, 4, 3, 2, 1, 0, -1, 13, 12, 11, 10, 9, 8, 7, -1));
+    __m256i bits28 = _mm256_or_si256(
+        _mm256_srli_epi64(bits56, 28),
+        _mm256_and_si256(_mm256_slli_epi64(bits56, 32), _mm256_set1_epi64x(0x0FFFFFFF00000000LL)));
+    __m256i bits14 = _mm256_or_si256(
+        _mm256_srli_epi32(bits28, 14),
+        _mm256_and_si256(_mm256_slli_epi32(bits28, 16), _mm256_set1_epi32(0x3FFF0000)));
+    __m256i groups = _mm256_or_si256(
+        _mm256_srli_epi16(bits14, 7),
+        _mm256_and_si256(_mm256_slli_epi16(bits14, 8), _mm256_set1_epi16(0x7F00)));
+
+    const __m256i highTable = _mm256_setr_epi8(
+        0x00, 0x15, 0x26, 0x33, 0x47, 0x52, 0x61, 0x74,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x15, 0x26, 0x33, 0x47, 0x52, 0x61, 0x74,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
+    const __m256i lowTable = _mm256_setr_epi8(
+        0x00, 0x01, 0x02, 0x03, 0x0B, 0x0A, 0x09, 0x08,
+        0x04, 0x05, 0x06, 0x07, 0x0F, 0x0E, 0x0D, 0x0C,
+        0x00, 0x01, 0x02, 0x03, 0x0B, 0x0A, 0x09, 0x08,
+        0x04, 0x05, 0x06, 0x07, 0x0F, 0x0E, 0x0D, 0x0C);
+    const __m256i flipTable = _mm256_setr_epi8(
+        0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x04, 0x08,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x04, 0x08,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
+    const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+
+    __m256i syndromeData = _mm256_xor_si256(
+        _mm256_shuffle_epi8(highTable, _mm256_and_si256(_mm256_srli_epi16(groups, 4), nibbleMask)),
+        _mm256_shuffle_epi8(lowTable, _mm256_and_si256(groups, nibbleMask)));
+    __m256i syndrome = _mm256_and_si256(syndromeData, _mm256_set1_epi8(0x07));
+    __m256i nibbles = _mm256_xor_si256(
+        _mm256_and_si256(_mm256_srli_epi16(syndromeData, 3), nibbleMask),
+        _mm256_shuffle_epi8(flipTable, syndrome));
+    *corrected = _mm256_add_epi8(*corrected, _mm256_min_epu8(syndrome, _mm256_set1_epi8(1)));
+    return _mm256_maddubs_epi16(nibbles, _mm256_set1_epi16(0x0110));
+}
+
+/**
+    @brief Sum of the byte counters of "splitGroupsAvx2".
+
+    @param __m256i counts: 32 counters.
+    @return uint64_t: Their sum.
+*/
+__attribute__((target("avx2")))
+inline uint64_t sumCountsAvx2(__m256i counts){
+    __m256i sums = _mm256_sad_epu8(counts, _mm256_setzero_si256());
+    __m128i halves = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+    return (uint64_t)_mm_cvtsi128_si32(halves) + (uint64_t)_mm_cvtsi128_si32(_mm_srli_si128(halves, 8));
+}
+
+/**
+    @brief Correct and remove the code (8,4) from 16 groups.
+
+    @param __m128i groups: 16 groups of 8 bits.
+    @param __m128i* corrected: Each byte gets one more for its group if it
+        had a bit corrected.
+    @param __m128i* detected: Each byte gets one more for its group if it had
+        two inverted bits.
+    @return __m128i: The 16 nibbles as 8 bytes (16 bits lanes with
+        "high * 16 + low").
+*/
+__attribute__((target("ssse3")))
+inline __m128i splitSecdedSsse3(__m128i groups, __m128i* corrected, __m128i* detected){
+
+    // "D | S << 4 | P << 7" of bits 7~4 (D7 D6 D5 P4) and of bits 3~0
+    // (D3 P2 P1 P8).
+    const __m128i highTable = _mm_setr_epi8(
+        0x00, (char)0xC0, (char)0xD2, 0x12, (char)0xE4, 0x24, 0x36, (char)0xF6,
+        (char)0xF8, 0x38, 0x2A, (char)0xEA, 0x1C, (char)0xDC, (char)0xCE, 0x0E);
+    const __m128i lowTable = _mm_setr_epi8(
+        0x00, (char)0x80, (char)0x90, 0x10, (char)0xA0, 0x20, 0x30, (char)0xB0,
+        (char)0xB1, 0x31, 0x21, (char)0xA1, 0x11, (char)0x91, (char)0x81, 0x01);
+
+    // For each "S | P << 3": the data bit inverted, whether one bit was
+    // corrected and whether two were detected.
+    const __m128i flipTable = _mm_setr_epi8(
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x04, 0x08);
+    const __m128i correctedTable = _mm_setr_epi8(
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1);
+    const __m128i detectedTable = _mm_setr_epi8(
+        0, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+
+    __m128i parts = _mm_xor_si128(
+        _mm_shuffle_epi8(highTable, _mm_and_si128(_mm_srli_epi16(groups, 4), nibbleMask)),
+        _mm_shuffle_epi8(lowTable, _mm_and_si128(groups, nibbleMask)));
+    __m128i syndrome = _mm_and_si128(_mm_srli_epi16(parts, 4), nibbleMask);
+    __m128i nibbles = _mm_xor_si128(_mm_and_si128(parts, nibbleMask),
+                                    _mm_shuffle_epi8(flipTable, syndrome));
+    *corrected = _mm_add_epi8(*corrected, _mm_shuffle_epi8(correctedTable, syndrome));
+    *detected = _mm_add_epi8(*detected, _mm_shuffle_epi8(detectedTable, syndrome));
+    return _mm_maddubs_epi16(nibbles, _mm_set1_epi16(0x0110));
+}
+
+/**
+    @brief Same as "splitSecdedSsse3" in each 128 bits lane.
+*/
+__attribute__((target("avx2")))
+inline __m256i splitSecdedAvx2(__m256i groups, __m256i* corrected, __m256i* detected){
+    const __m256i highTable = _mm256_setr_epi8(
+        0x00, (char)0xC0, (char)0xD2, 0x12, (char)0xE4, 0x24, 0x36, (char)0xF6,
+        (char)0xF8, 0x38, 0x2A, (char)0xEA, 0x1C, (char)0xDC, (char)0xCE, 0x0E,
+        0x00, (char)0xC0, (char)0xD2, 0x12, (char)0xE4, 0x24, 0x36, (char)0xF6,
+        (char)0xF8, 0x38, 0x2A, (char)0xEA, 0x1C, (char)0xDC, (char)0xCE, 0x0E);
+    const __m256i lowTable = _mm256_setr_epi8(
+        0x00, (char)0x80, (char)0x90, 0x10, (char)0xA0, 0x20, 0x30, (char)0xB0,
+        (char)0xB1, 0x31, 0x21, (char)0xA1, 0x11, (char)0x91, (char)0x81, 0x01,
+        0x00, (char)0x80, (char)0x90, 0x10, (char)0xA0, 0x20, 0x30, (char)0xB0,
+        (char)0xB1, 0x31, 0x21, (char)0xA1, 0x11, (char)0x91, (char)0x81, 0x01);
+    const __m256i flipTable = _mm256_setr_epi8(
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x04, 0x08,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x04, 0x08);
+    const __m256i correctedTable = _mm256_setr_epi8(
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1);
+    const __m256i detectedTable = _mm256_setr_epi8(
+        0, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+
+    __m256i parts = _mm256_xor_si256(
+        _mm256_shuffle_epi8(highTable, _mm256_and_si256(_mm256_srli_epi16(groups, 4), nibbleMask)),
+        _mm256_shuffle_epi8(lowTable, _mm256_and_si256(groups, nibbleMask)));
+    __m256i syndrome = _mm256_and_si256(_mm256_srli_epi16(parts, 4), nibbleMask);
+    __m256i nibbles = _mm256_xor_si256(_mm256_and_si256(parts, nibbleMask),
+                                       _mm256_shuffle_epi8(flipTable, syndrome));
+    *corrected = _mm256_add_epi8(*corrected, _mm256_shuffle_epi8(correctedTable, syndrome));
+    *detected = _mm256_add_epi8(*detected, _mm256_shuffle_epi8(detectedTable, syndrome));
+    return _mm256_maddubs_epi16(nibbles, _mm256_set1_epi16(0x0110));
+}
+
+// Passes of a decoding loop before its byte counters are summed: each pass
+// adds at most 2 to each of them.
+const unsigned COUNT_PASSES = 127;
+
+} // namespace
+
+bool ssse3Supported(){
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3");
+}
+
+__attribute__((target("ssse3")))
+void encodeBlocksSsse3(const uint8_t* bytes, size_t blocks, uint8_t* hammingBytes){
+
+    // 4 blocks at a time. The stores write 2 bytes beyond them, so there must
+    // be at least one more block after.
+    for( ; blocks > 4; blocks -= 4){
+        __m128i lowGroups;
+        __m128i highGroups;
+        nibbleGroupsSsse3(_mm_loadu_si128((const __m128i*)bytes), &lowGroups, &highGroups);
+        _mm_storeu_si128((__m128i*)hammingBytes, joinGroupsSsse3(lowGroups));
+        _mm_storeu_si128((__m128i*)(hammingBytes + 14), joinGroupsSsse3(highGroups));
+        bytes += 4 * BLOCK_BYTES;
+        hammingBytes += 4 * BLOCK_HAMMING_BYTES;
+    }
+    encodeBlocksTable(bytes, blocks, hammingBytes);
+}
+
+__attribute__((target("ssse3")))
+uint64_t decodeBlocksSsse3(const uint8_t* hammingBytes, size_t blocks, uint8_t* bytes){
+
+    // 4 blocks at a time. The loads read 2 bytes beyond them.
+    uint64_t corrected = 0;
+    while(blocks > 4){
+        __m128i counts = _mm_setzero_si128();
+        for(unsigned z = 0; (z < COUNT_PASSES) && (blocks > 4); z++, blocks -= 4){
+            __m128i first = splitGroupsSsse3(_mm_loadu_si128((const __m128i*)hammingBytes), &counts);
+            __m128i second = splitGroupsSsse3(_mm_loadu_si128((const __m128i*)(hammingBytes + 14)),
+                                              &counts);
+            _mm_storeu_si128((__m128i*)bytes, _mm_packus_epi16(first, second));
+            hammingBytes += 4 * BLOCK_HAMMING_BYTES;
+            bytes += 4 * BLOCK_BYTES;
+        }
+        corrected += sumCountsSsse3(counts);
+    }
+    return corrected + decodeBlocksTable(hammingBytes, blocks, bytes);
+}
+
+__attribute__((target("ssse3")))
+void encodeSecdedSsse3(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes){
+    const __m128i groupTable = _mm_setr_epi8(
+        0x00, 0x0F, 0x33, 0x3C, 0x55, 0x5A, 0x66, 0x69,
+        (char)0x96, (char)0x99, (char)0xA5, (char)0xAA,
+        (char)0xC3, (char)0xCC, (char)0xF0, (char)0xFF);
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+
+    // 16 bytes at a time, the group of the high nibble first.
+    for( ; bytesCount >= 16; bytesCount -= 16){
+        __m128i input = _mm_loadu_si128((const __m128i*)bytes);
+        __m128i high = _mm_shuffle_epi8(groupTable,
+            _mm_and_si128(_mm_srli_epi16(input, 4), nibbleMask));
+        __m128i low = _mm_shuffle_epi8(groupTable, _mm_and_si128(input, nibbleMask));
+        _mm_storeu_si128((__m128i*)hammingBytes, _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128((__m128i*)(hammingBytes + 16), _mm_unpackhi_epi8(high, low));
+        bytes += 16;
+        hammingBytes += 32;
+    }
+    encodeSecdedTable(bytes, bytesCount, hammingBytes);
+}
+
+__attribute__((target("ssse3")))
+uint64_t decodeSecdedSsse3(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes,
+                           uint64_t* detected){
+
+    // 16 bytes (32 groups) at a time.
+    uint64_t corrected = 0;
+    while(bytesCount >= 16){
+        __m128i correctedCounts = _mm_setzero_si128();
+        __m128i detectedCounts = _mm_setzero_si128();
+        for(unsigned z = 0; (z < COUNT_PASSES) && (bytesCount >= 16); z++, bytesCount -= 16){
+            __m128i first = splitSecdedSsse3(_mm_loadu_si128((const __m128i*)hammingBytes),
+                                             &correctedCounts, &detectedCounts);
+            __m128i second = splitSecdedSsse3(_mm_loadu_si128((const __m128i*)(hammingBytes + 16)),
+                                              &correctedCounts, &detectedCounts);
+            _mm_storeu_si128((__m128i*)bytes, _mm_packus_epi16(first, second));
+            hammingBytes += 32;
+            bytes += 16;
+        }
+        corrected += sumCountsSsse3(correctedCounts);
+        *detected += sumCountsSsse3(detectedCounts);
+    }
+    return corrected + decodeSecdedTable(hammingBytes, bytesCount, bytes, detected);
+}
+
+namespace {
+
+/**
+    @brief Swap the bits "mask" of a register with the bits "shift" higher of
+        another one, in both 64 bits lanes.
+
+    @param __m128i* words: Registers.
+    @param unsigned masked: Index of the register of the bits "mask".
+    @param unsigned shifted: Index of the other register.
+    @param int shift: Distance between the bits swapped.
+    @param uint64_t mask: Bits of each lane of "masked" that are swapped.
+    @return void.
+*/
+__attribute__((target("ssse3")))
+inline void swapBitBlocksSsse3(__m128i* words, unsigned masked, unsigned shifted, int shift,
+                               uint64_t mask){
+    __m128i moved = _mm_srli_epi64(words[shifted], shift);
+    __m128i swap = _mm_and_si128(_mm_xor_si128(words[masked], moved),
+                                 _mm_set1_epi64x((long long)mask));
+    words[masked] = _mm_xor_si128(words[masked], swap);
+    words[shifted] = _mm_xor_si128(words[shifted], _mm_slli_epi64(swap, shift));
+}
+
+/**
+    @brief Exchange the index of 8 registers with 3 bits of the positions of
+        the bits of their lanes, as "exchangeWordBits" (hamming.cpp) does to
+        8 words, in both lanes at once.
+
+    @param __m128i* words: 8 registers, exchanged in place.
+    @param int unit: 1 for the bits of each byte, 8 for the bytes.
+    @return void.
+*/
+__attribute__((target("ssse3")))
+inline void exchangeWordBitsSsse3(__m128i* words, int unit){
+    uint64_t fours = unit == 1 ? 0x0F0F0F0F0F0F0F0FULL : 0x00000000FFFFFFFFULL;
+    uint64_t twos = unit == 1 ? 0x3333333333333333ULL : 0x0000FFFF0000FFFFULL;
+    uint64_t ones = unit == 1 ? 0x5555555555555555ULL : 0x00FF00FF00FF00FFULL;
+    swapBitBlocksSsse3(words, 4, 0, unit * 4, fours);
+    swapBitBlocksSsse3(words, 5, 1, unit * 4, fours);
+    swapBitBlocksSsse3(words, 6, 2, unit * 4, fours);
+    swapBitBlocksSsse3(words, 7, 3, unit * 4, fours);
+    swapBitBlocksSsse3(words, 2, 0, unit * 2, twos);
+    swapBitBlocksSsse3(words, 3, 1, unit * 2, twos);
+    swapBitBlocksSsse3(words, 6, 4, unit * 2, twos);
+    swapBitBlocksSsse3(words, 7, 5, unit * 2, twos);
+    swapBitBlocksSsse3(words, 1, 0, unit, ones);
+    swapBitBlocksSsse3(words, 3, 2, unit, ones);
+    swapBitBlocksSsse3(words, 5, 4, unit, ones);
+    swapBitBlocksSsse3(words, 7, 6, unit, ones);
+}
+
+/**
+    @brief Transpose the 2 halves of 64 bytes of a slab into the 8 planes of
+        their bits, the first half in the low lanes.
+
+    @param const uint8_t* bytes: 128 bytes.
+    @param __m128i* planes: Receives the bit "k" of the byte "i" of each half
+        as the bit "i" of the lane of the register "k".
+    @return void.
+*/
+__attribute__((target("ssse3")))
+inline void sliceBytesSsse3(const uint8_t* bytes, __m128i* planes){
+    for(unsigned z = 0; z < 8; z += 2){
+        __m128i first = _mm_loadu_si128((const __m128i*)(bytes + (z * 8)));
+        __m128i second = _mm_loadu_si128((const __m128i*)(bytes + 64 + (z * 8)));
+        planes[z] = _mm_unpacklo_epi64(first, second);
+        planes[z + 1] = _mm_unpackhi_epi64(first, second);
+    }
+    exchangeWordBitsSsse3(planes, 8);
+    exchangeWordBitsSsse3(planes, 1);
+}
+
+/**
+    @brief Inverse of "sliceBytesSsse3".
+
+    @param __m128i* planes: 8 planes, changed.
+    @param uint8_t* bytes: Receives 128 bytes.
+    @return void.
+*/
+__attribute__((target("ssse3")))
+inline void unsliceBytesSsse3(__m128i* planes, uint8_t* bytes){
+    exchangeWordBitsSsse3(planes, 1);
+    exchangeWordBitsSsse3(planes, 8);
+    for(unsigned z = 0; z < 8; z += 2){
+        _mm_storeu_si128((__m128i*)(bytes + (z * 8)), _mm_unpacklo_epi64(planes[z], planes[z + 1]));
+        _mm_storeu_si128((__m128i*)(bytes + 64 + (z * 8)),
+                         _mm_unpackhi_epi64(planes[z], planes[z + 1]));
+    }
+}
+
+/**
+    @brief Write 2 words of each plane of a slab (the planes being D7 D6 D5
+        P4 D3 P2 P1, of 32 bytes each).
+
+    @param uint8_t* hammingBytes: The first of the 2 words of the plane D7.
+    @param const __m128i* data: Bits 0~3 of the nibbles (D3 D5 D6 D7).
+    @return void.
+*/
+__attribute__((target("ssse3")))
+inline void storeSlicedSsse3(uint8_t* hammingBytes, const __m128i* data){
+    __m128i d76 = _mm_xor_si128(data[3], data[2]);
+    _mm_storeu_si128((__m128i*)hammingBytes, data[3]);
+    _mm_storeu_si128((__m128i*)(hammingBytes + 32), data[2]);
+    _mm_storeu_si128((__m128i*)(hammingBytes + 64), data[1]);
+    _mm_storeu_si128((__m128i*)(hammingBytes + 96), _mm_xor_si128(d76, data[1]));
+    _mm_storeu_si128((__m128i*)(hammingBytes + 128), data[0]);
+    _mm_storeu_si128((__m128i*)(hammingBytes + 160), _mm_xor_si128(d76, data[0]));
+    _mm_storeu_si128((__m128i*)(hammingBytes + 192),
+                     _mm_xor_si128(_mm_xor_si128(data[3], data[1]), data[0]));
+}
+
+/**
+    @brief Add the bits set in each 64 bits lane.
+
+    @param __m128i bits: Bits to be counted.
+    @param __m128i sums: Sums of each lane.
+    @return __m128i: The sums with the bits added.
+*/
+__attribute__((target("ssse3")))
+inline __m128i addBitsSsse3(__m128i bits, __m128i sums){
+    const __m128i nibbleBits = _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m128i lowNibbles = _mm_set1_epi8(0x0F);
+    __m128i counts = _mm_add_epi8(
+        _mm_shuffle_epi8(nibbleBits, _mm_and_si128(bits, lowNibbles)),
+        _mm_shuffle_epi8(nibbleBits, _mm_and_si128(_mm_srli_epi16(bits, 4), lowNibbles)));
+    return _mm_add_epi64(sums, _mm_sad_epu8(counts, _mm_setzero_si128()));
+}
+
+/**
+    @brief Inverse of "storeSlicedSsse3", correcting the groups.
+
+    @param const uint8_t* hammingBytes: The first of the 2 words of the plane
+        D7.
+    @param bool correct: false to take the data planes as they are.
+    @param __m128i* data: Receives the bits 0~3 of the nibbles.
+    @param __m128i sums: Groups corrected in each lane.
+    @return __m128i: The sums with the groups corrected added.
+*/
+__attribute__((target("ssse3")))
+inline __m128i loadSlicedSsse3(const uint8_t* hammingBytes, bool correct, __m128i* data,
+                               __m128i sums){
+    __m128i d7 = _mm_loadu_si128((const __m128i*)hammingBytes);
+    __m128i d6 = _mm_loadu_si128((const __m128i*)(hammingBytes + 32));
+    __m128i d5 = _mm_loadu_si128((const __m128i*)(hammingBytes + 64));
+    __m128i d3 = _mm_loadu_si128((const __m128i*)(hammingBytes + 128));
+    if(correct){
+        __m128i s4 = _mm_xor_si128(_mm_xor_si128(d7, d6),
+            _mm_xor_si128(d5, _mm_loadu_si128((const __m128i*)(hammingBytes + 96))));
+        __m128i s2 = _mm_xor_si128(_mm_xor_si128(d7, d6),
+            _mm_xor_si128(d3, _mm_loadu_si128((const __m128i*)(hammingBytes + 160))));
+        __m128i s1 = _mm_xor_si128(_mm_xor_si128(d7, d5),
+            _mm_xor_si128(d3, _mm_loadu_si128((const __m128i*)(hammingBytes + 192))));
+        __m128i s42 = _mm_and_si128(s4, s2);
+        d7 = _mm_xor_si128(d7, _mm_and_si128(s42, s1));
+        d6 = _mm_xor_si128(d6, _mm_andnot_si128(s1, s42));
+        d5 = _mm_xor_si128(d5, _mm_andnot_si128(s2, _mm_and_si128(s4, s1)));
+        d3 = _mm_xor_si128(d3, _mm_andnot_si128(s4, _mm_and_si128(s2, s1)));
+        sums = addBitsSsse3(_mm_or_si128(s4, _mm_or_si128(s2, s1)), sums);
+    }
+    data[0] = d3;
+    data[1] = d5;
+    data[2] = d6;
+    data[3] = d7;
+    return sums;
+}
+
+/**
+    @brief Decode slabs of the bit-sliced layout, both halves of each slab at
+        once.
+
+    @param const uint8_t* hammingBytes: "slabs * 224" bytes in the hamming
+        format.
+    @param size_t slabs: Number of slabs.
+    @param uint8_t* bytes: Receives "slabs * 128" original bytes.
+    @param bool correct: false to take the data planes as they are.
+    @return uint64_t: Number of groups that had a bit corrected.
+*/
+__attribute__((target("ssse3")))
+inline uint64_t unsliceSsse3(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes,
+                             bool correct){
+
+    // The words 0~1 of each plane have the high nibbles of the 2 halves, the
+    // words 2~3 their low nibbles.
+    __m128i sums = _mm_setzero_si128();
+    for( ; slabs > 0; slabs--){
+        __m128i planes[8];
+        sums = loadSlicedSsse3(hammingBytes + 16, correct, planes, sums);
+        sums = loadSlicedSsse3(hammingBytes, correct, planes + 4, sums);
+        unsliceBytesSsse3(planes, bytes);
+        hammingBytes += SLICED_HAMMING_BYTES;
+        bytes += SLICED_BYTES;
+    }
+    uint64_t lanes[2];
+    _mm_storeu_si128((__m128i*)lanes, sums);
+    return lanes[0] + lanes[1];
+}
+
+} // namespace
+
+__attribute__((target("ssse3")))
+void encodeSlicedSsse3(const uint8_t* bytes, size_t slabs, uint8_t* hammingBytes){
+    for( ; slabs > 0; slabs--){
+        __m128i planes[8];
+        sliceBytesSsse3(bytes, planes);
+        storeSlicedSsse3(hammingBytes, planes + 4);
+        storeSlicedSsse3(hammingBytes + 16, planes);
+        bytes += SLICED_BYTES;
+        hammingBytes += SLICED_HAMMING_BYTES;
+    }
+}
+
+__attribute__((target("ssse3")))
+uint64_t decodeSlicedSsse3(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes){
+    return unsliceSsse3(hammingBytes, slabs, bytes, true);
+}
+
+__attribute__((target("ssse3")))
+void extractSlicedSsse3(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes){
+    unsliceSsse3(hammingBytes, slabs, bytes, false);
+}
+
+bool avx2Supported(){
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+__attribute__((target("avx2")))
+void encodeBlocksAvx2(const uint8_t* bytes, size_t blocks, uint8_t* hammingBytes){
+
+    // 8 blocks at a time. "_mm256_unpack..." works inside each 128 bits lane,
+    // so the low groups hold bytes 0~7 and 16~23 and the high ones 8~15 and
+    // 24~31. The stores are done in order because each one writes 2 bytes
+    // over the next.
+    for( ; blocks > 8; blocks -= 8){
+        const __m256i lowTable = _mm256_setr_epi8(
+            0x00, 0x07, 0x19, 0x1E, 0x2A, 0x2D, 0x33, 0x34,
+            0x4B, 0x4C, 0x52, 0x55, 0x61, 0x66, 0x78, 0x7F,
+            0x00, 0x07, 0x19, 0x1E, 0x2A, 0x2D, 0x33, 0x34,
+            0x4B, 0x4C, 0x52, 0x55, 0x61, 0x66, 0x78, 0x7F);
+        const __m256i highTable = _mm256_setr_epi8(
+            0x00, 0x0E, 0x32, 0x3C, 0x54, 0x5A, 0x66, 0x68,
+            (char)0x96, (char)0x98, (char)0xA4, (char)0xAA,
+            (char)0xC2, (char)0xCC, (char)0xF0, (char)0xFE,
+            0x00, 0x0E, 0x32, 0x3C, 0x54, 0x5A, 0x66, 0x68,
+            (char)0x96, (char)0x98, (char)0xA4, (char)0xAA,
+            (char)0xC2, (char)0xCC, (char)0xF0, (char)0xFE);
+        const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+
+        __m256i input = _mm256_loadu_si256((const __m256i*)bytes);
+        __m256i low = _mm256_shuffle_epi8(lowTable, _mm256_and_si256(input, nibbleMask));
+        __m256i high = _mm256_shuffle_epi8(highTable,
+            _mm256_and_si256(_mm256_srli_epi16(input, 4), nibbleMask));
+        __m256i lowBits = joinGroupsAvx2(_mm256_unpacklo_epi8(low, high));
+        __m256i highBits = joinGroupsAvx2(_mm256_unpackhi_epi8(low, high));
+
+        _mm_storeu_si128((__m128i*)hammingBytes, _mm256_castsi256_si128(lowBits));
+        _mm_storeu_si128((__m128i*)(hammingBytes + 14), _mm256_castsi256_si128(highBits));
+        _mm_storeu_si128((__m128i*)(hammingBytes + 28), _mm256_extracti128_si256(lowBits, 1));
+        _mm_storeu_si128((__m128i*)(hammingBytes + 42), _mm256_extracti128_si256(highBits, 1));
+        bytes += 8 * BLOCK_BYTES;
+        hammingBytes += 8 * BLOCK_HAMMING_BYTES;
+    }
+    encodeBlocksSsse3(bytes, blocks, hammingBytes);
+}
+
+__attribute__((target("avx2")))
+uint64_t decodeBlocksAvx2(const uint8_t* hammingBytes, size_t blocks, uint8_t* bytes){
+
+    // 8 blocks at a time, 2 in each 128 bits lane. "_mm256_packus_epi16" also
+    // works inside the lanes, so the 64 bits parts are put back in order.
+    uint64_t corrected = 0;
+    while(blocks > 8){
+        __m256i counts = _mm256_setzero_si256();
+        for(unsigned z = 0; (z < COUNT_PASSES) && (blocks > 8); z++, blocks -= 8){
+            __m256i first = splitGroupsAvx2(_mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)hammingBytes)),
+                _mm_loadu_si128((const __m128i*)(hammingBytes + 14)), 1), &counts);
+            __m256i second = splitGroupsAvx2(_mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(hammingBytes + 28))),
+                _mm_loadu_si128((const __m128i*)(hammingBytes + 42)), 1), &counts);
+            _mm256_storeu_si256((__m256i*)bytes, _mm256_permute4x64_epi64(
+                _mm256_packus_epi16(first, second), 0xD8));
+            hammingBytes += 8 * BLOCK_HAMMING_BYTES;
+            bytes += 8 * BLOCK_BYTES;
+        }
+        corrected += sumCountsAvx2(counts);
+    }
+    return corrected + decodeBlocksSsse3(hammingBytes, blocks, bytes);
+}
+
+__attribute__((target("avx2")))
+void encodeSecdedAvx2(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes){
+    const __m256i groupTable = _mm256_setr_epi8(
+        0x00, 0x0F, 0x33, 0x3C, 0x55, 0x5A, 0x66, 0x69,
+        (char)0x96, (char)0x99, (char)0xA5, (char)0xAA,
+        (char)0xC3, (char)0xCC, (char)0xF0, (char)0xFF,
+        0x00, 0x0F, 0x33, 0x3C, 0x55, 0x5A, 0x66, 0x69,
+        (char)0x96, (char)0x99, (char)0xA5, (char)0xAA,
+        (char)0xC3, (char)0xCC, (char)0xF0, (char)0xFF);
+    const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+
+    // 32 bytes at a time. The unpacks work inside each 128 bits lane, so the
+    // low ones hold bytes 0~7 and 16~23 and the high ones 8~15 and 24~31.
+    for( ; bytesCount >= 32; bytesCount -= 32){
+        __m256i input = _mm256_loadu_si256((const __m256i*)bytes);
+        __m256i high = _mm256_shuffle_epi8(groupTable,
+            _mm256_and_si256(_mm256_srli_epi16(input, 4), nibbleMask));
+        __m256i low = _mm256_shuffle_epi8(groupTable, _mm256_and_si256(input, nibbleMask));
+        __m256i first = _mm256_unpacklo_epi8(high, low);
+        __m256i second = _mm256_unpackhi_epi8(high, low);
+        _mm256_storeu_si256((__m256i*)hammingBytes, _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256((__m256i*)(hammingBytes + 32),
+                            _mm256_permute2x128_si256(first, second, 0x31));
+        bytes += 32;
+        hammingBytes += 64;
+    }
+    encodeSecdedSsse3(bytes, bytesCount, hammingBytes);
+}
+
+__attribute__((target("avx2")))
+uint64_t decodeSecdedAvx2(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes,
+                          uint64_t* detected){
+
+    // 32 bytes (64 groups) at a time, put back in order as in
+    // "decodeBlocksAvx2".
+    uint64_t corrected = 0;
+    while(bytesCount >= 32){
+        __m256i correctedCounts = _mm256_setzero_si256();
+        __m256i detectedCounts = _mm256_setzero_si256();
+        for(unsigned z = 0; (z < COUNT_PASSES) && (bytesCount >= 32); z++, bytesCount -= 32){
+            __m256i first = splitSecdedAvx2(_mm256_loadu_si256((const __m256i*)hammingBytes),
+                                            &correctedCounts, &detectedCounts);
+            __m256i second = splitSecdedAvx2(_mm256_loadu_si256((const __m256i*)(hammingBytes + 32)),
+                                             &correctedCounts, &detectedCounts);
+            _mm256_storeu_si256((__m256i*)bytes, _mm256_permute4x64_epi64(
+                _mm256_packus_epi16(first, second), 0xD8));
+            hammingBytes += 64;
+            bytes += 32;
+        }
+        corrected += sumCountsAvx2(correctedCounts);
+        *detected += sumCountsAvx2(detectedCounts);
+    }
+    return corrected + decodeSecdedSsse3(hammingBytes, bytesCount, bytes, detected);
+}
+
+namespace {
+
+/**
+    @brief Transpose the 8x8 bits of each 64 bits lane: the bit "j" of the
+        byte "k" becomes the bit "k" of the byte "j".
+
+    @param __m256i bits: 4 matrices of 8x8 bits.
+    @return __m256i: The matrices transposed.
+*/
+__attribute__((target("avx2")))
+inline __m256i transposeBitsAvx2(__m256i bits){
+    __m256i swap = _mm256_and_si256(_mm256_xor_si256(bits, _mm256_srli_epi64(bits, 7)),
+                                    _mm256_set1_epi64x(0x00AA00AA00AA00AALL));
+    bits = _mm256_xor_si256(bits, _mm256_xor_si256(swap, _mm256_slli_epi64(swap, 7)));
+    swap = _mm256_and_si256(_mm256_xor_si256(bits, _mm256_srli_epi64(bits, 14)),
+                            _mm256_set1_epi64x(0x0000CCCC0000CCCCLL));
+    bits = _mm256_xor_si256(bits, _mm256_xor_si256(swap, _mm256_slli_epi64(swap, 14)));
+    swap = _mm256_and_si256(_mm256_xor_si256(bits, _mm256_srli_epi64(bits, 28)),
+                            _mm256_set1_epi64x(0x00000000F0F0F0F0LL));
+    return _mm256_xor_si256(bits, _mm256_xor_si256(swap, _mm256_slli_epi64(swap, 28)));
+}
+
+/**
+    @brief Transpose 4 rows of 4 words of 32 bits inside each half of the
+        registers (it is its own inverse).
+
+    @param __m256i* rows: The 4 registers, changed in place.
+    @return void.
+*/
+__attribute__((target("avx2")))
+inline void transposeWordsAvx2(__m256i* rows){
+    __m256i low01 = _mm256_unpacklo_epi32(rows[0], rows[1]);
+    __m256i high01 = _mm256_unpackhi_epi32(rows[0], rows[1]);
+    __m256i low23 = _mm256_unpacklo_epi32(rows[2], rows[3]);
+    __m256i high23 = _mm256_unpackhi_epi32(rows[2], rows[3]);
+    rows[0] = _mm256_unpacklo_epi64(low01, low23);
+    rows[1] = _mm256_unpackhi_epi64(low01, low23);
+    rows[2] = _mm256_unpacklo_epi64(high01, high23);
+    rows[3] = _mm256_unpackhi_epi64(high01, high23);
+}
+
+/**
+    @brief Shuffle that transposes 4x4 bytes inside each half of a register
+        (its own inverse).
+
+    @return __m256i: Indexes for "_mm256_shuffle_epi8".
+*/
+__attribute__((target("avx2")))
+inline __m256i transposeBytesAvx2(){
+    return _mm256_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15,
+                            0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+}
+
+/**
+    @brief 32 original bytes from the bits of the 4 data planes given for
+        them by "transposeWordsAvx2": each half has the 4 words of the high
+        nibbles, then of the low ones.
+
+    @param __m256i masks: Words of 32 bits of the data planes D3 D5 D6 D7.
+    @return __m256i: The bytes.
+*/
+__attribute__((target("avx2")))
+inline __m256i maskBytesAvx2(__m256i masks){
+
+    // Each 64 bits lane gets the same byte of the 8 words (the bit 0 of
+    // each original byte first), which is the transpose of its bytes.
+    __m256i lanes = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(masks, transposeBytesAvx2()),
+                                                _mm256_setr_epi32(4, 0, 5, 1, 6, 2, 7, 3));
+    return transposeBitsAvx2(lanes);
+}
+
+/**
+    @brief Inverse of "maskBytesAvx2".
+
+    @param __m256i bytes: 32 original bytes.
+    @return __m256i: Words of 32 bits of the data planes D3 D5 D6 D7, the
+        high nibbles in the first half, the low ones in the second.
+*/
+__attribute__((target("avx2")))
+inline __m256i bytesMasksAvx2(__m256i bytes){
+    __m256i words = _mm256_permutevar8x32_epi32(transposeBitsAvx2(bytes),
+                                                _mm256_setr_epi32(1, 3, 5, 7, 0, 2, 4, 6));
+    return _mm256_shuffle_epi8(words, transposeBytesAvx2());
+}
+
+/**
+    @brief Add the bits set in each 64 bits lane.
+
+    @param __m256i bits: Bits to be counted.
+    @param __m256i sums: Sums of each lane.
+    @return __m256i: The sums with the bits added.
+*/
+__attribute__((target("avx2")))
+inline __m256i addBitsAvx2(__m256i bits, __m256i sums){
+    const __m256i nibbleBits = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i lowNibbles = _mm256_set1_epi8(0x0F);
+    __m256i counts = _mm256_add_epi8(
+        _mm256_shuffle_epi8(nibbleBits, _mm256_and_si256(bits, lowNibbles)),
+        _mm256_shuffle_epi8(nibbleBits, _mm256_and_si256(_mm256_srli_epi16(bits, 4), lowNibbles)));
+    return _mm256_add_epi64(sums, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+}
+
+/**
+    @brief Decode slabs of the bit-sliced layout, each plane in one register.
+
+    @param const uint8_t* hammingBytes: "slabs * 224" bytes in the hamming
+        format.
+    @param size_t slabs: Number of slabs.
+    @param uint8_t* bytes: Receives "slabs * 128" original bytes.
+    @param bool correct: false to take the data planes as they are.
+    @return uint64_t: Number of groups that had a bit corrected.
+*/
+__attribute__((target("avx2")))
+inline uint64_t unsliceAvx2(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes,
+                            bool correct){
+    __m256i sums = _mm256_setzero_si256();
+    for( ; slabs > 0; slabs--){
+        const __m256i* planes = (const __m256i*)hammingBytes;
+        __m256i d7 = _mm256_loadu_si256(planes);
+        __m256i d6 = _mm256_loadu_si256(planes + 1);
+        __m256i d5 = _mm256_loadu_si256(planes + 2);
+        __m256i d3 = _mm256_loadu_si256(planes + 4);
+        if(correct){
+            __m256i s4 = _mm256_xor_si256(_mm256_xor_si256(d7, d6),
+                                          _mm256_xor_si256(d5, _mm256_loadu_si256(planes + 3)));
+            __m256i s2 = _mm256_xor_si256(_mm256_xor_si256(d7, d6),
+                                          _mm256_xor_si256(d3, _mm256_loadu_si256(planes + 5)));
+            __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(d7, d5),
+                                          _mm256_xor_si256(d3, _mm256_loadu_si256(planes + 6)));
+            __m256i s42 = _mm256_and_si256(s4, s2);
+            d7 = _mm256_xor_si256(d7, _mm256_and_si256(s42, s1));
+            d6 = _mm256_xor_si256(d6, _mm256_andnot_si256(s1, s42));
+            d5 = _mm256_xor_si256(d5, _mm256_andnot_si256(s2, _mm256_and_si256(s4, s1)));
+            d3 = _mm256_xor_si256(d3, _mm256_andnot_si256(s4, _mm256_and_si256(s2, s1)));
+            sums = addBitsAvx2(_mm256_or_si256(s4, _mm256_or_si256(s2, s1)), sums);
+        }
+
+        // Row "z" gets the words of the 4 data planes for the bytes
+        // 32z~32z+31.
+        __m256i rows[4] = {d3, d5, d6, d7};
+        transposeWordsAvx2(rows);
+        for(unsigned z = 0; z < 4; z++){
+            _mm256_storeu_si256((__m256i*)(bytes + (z * 32)), maskBytesAvx2(rows[z]));
+        }
+        hammingBytes += SLICED_HAMMING_BYTES;
+        bytes += SLICED_BYTES;
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, sums);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+} // namespace
+
+__attribute__((target("avx2")))
+void encodeSlicedAvx2(const uint8_t* bytes, size_t slabs, uint8_t* hammingBytes){
+    for( ; slabs > 0; slabs--){
+        __m256i rows[4];
+        for(unsigned z = 0; z < 4; z++){
+            rows[z] = bytesMasksAvx2(_mm256_loadu_si256((const __m256i*)(bytes + (z * 32))));
+        }
+
+        // Back from the rows of each 32 bytes to the planes D3 D5 D6 D7.
+        transposeWordsAvx2(rows);
+        __m256i* planes = (__m256i*)hammingBytes;
+        __m256i d76 = _mm256_xor_si256(rows[3], rows[2]);
+        _mm256_storeu_si256(planes, rows[3]);
+        _mm256_storeu_si256(planes + 1, rows[2]);
+        _mm256_storeu_si256(planes + 2, rows[1]);
+        _mm256_storeu_si256(planes + 3, _mm256_xor_si256(d76, rows[1]));
+        _mm256_storeu_si256(planes + 4, rows[0]);
+        _mm256_storeu_si256(planes + 5, _mm256_xor_si256(d76, rows[0]));
+        _mm256_storeu_si256(planes + 6, _mm256_xor_si256(_mm256_xor_si256(rows[3], rows[1]),
+                                                         rows[0]));
+        bytes += SLICED_BYTES;
+        hammingBytes += SLICED_HAMMING_BYTES;
+    }
+}
+
+__attribute__((target("avx2")))
+uint64_t decodeSlicedAvx2(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes){
+    return unsliceAvx2(hammingBytes, slabs, bytes, true);
+}
+
+__attribute__((target("avx2")))
+void extractSlicedAvx2(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes){
+    unsliceAvx2(hammingBytes, slabs, bytes, false);
+}
+
+#else
+
+bool ssse3Supported(){
+    return false;
+}
+
+void encodeBlocksSsse3(const uint8_t* bytes, size_t blocks, uint8_t* hammingBytes){
+    encodeBlocksTable(bytes, blocks, hammingBytes);
+}
+
+uint64_t decodeBlocksSsse3(const uint8_t* hammingBytes, size_t blocks, uint8_t* bytes){
+    return decodeBlocksTable(hammingBytes, blocks, bytes);
+}
+
+void encodeSecdedSsse3(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes){
+    encodeSecdedTable(bytes, bytesCount, hammingBytes);
+}
+
+uint64_t decodeSecdedSsse3(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes,
+                           uint64_t* detected){
+    return decodeSecdedTable(hammingBytes, bytesCount, bytes, detected);
+}
+
+void encodeSlicedSsse3(const uint8_t* bytes, size_t slabs, uint8_t* hammingBytes){
+    encodeSlicedBitwise(bytes, slabs, hammingBytes);
+}
+
+uint64_t decodeSlicedSsse3(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes){
+    return decodeSlicedBitwise(hammingBytes, slabs, bytes);
+}
+
+void extractSlicedSsse3(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes){
+    extractSlicedBitwise(hammingBytes, slabs, bytes);
+}
+
+bool avx2Supported(){
+    return false;
+}
+
+void encodeBlocksAvx2(const uint8_t* bytes, size_t blocks, uint8_t* hammingBytes){
+    encodeBlocksTable(bytes, blocks, hammingBytes);
+}
+
+uint64_t decodeBlocksAvx2(const uint8_t* hammingBytes, size_t blocks, uint8_t* bytes){
+    return decodeBlocksTable(hammingBytes, blocks, bytes);
+}
+
+void encodeSecdedAvx2(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes){
+    encodeSecdedTable(bytes, bytesCount, hammingBytes);
+}
+
+uint64_t decodeSecdedAvx2(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes,
+                          uint64_t* detected){
+    return decodeSecdedTable(hammingBytes, bytesCount, bytes, detected);
+}
+
+void encodeSlicedAvx2(const uint8_t* bytes, size_t slabs, uint8_t* hammingBytes){
+    encodeSlicedBitwise(bytes, slabs, hammingBytes);
+}
+
+uint64_t decodeSlicedAvx2(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes){
+    return decodeSlicedBitwise(hammingBytes, slabs, bytes);
+}
+
+void extractSlicedAvx2(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes){
+    extractSlicedBitwise(hammingBytes, slabs, bytes);
+}
+
+#endif
+
+#if HAMMING_X86_64
+
+namespace {
+
+// Data bits of the 8 groups of 7 bits of a block (D7 D6 D5 and D3 of each
+// group), the block being the most significant 56 bits.
+const uint64_t BLOCK_DATA_MASK = 0xE9D3A74E9D3A7400ULL;
+// Data bits of 8 groups of the code (8,4).
+const uint64_t SECDED_DATA_MASK = 0xE8E8E8E8E8E8E8E8ULL;
+// First bit of each of the 8 groups of 7 bits of a block (the block being the
+// least significant 56 bits), shifted right by the position of the bit.
+const uint64_t BLOCK_GROUP_MASK = 0x0081020408102040ULL;
+
+/**
+    @brief Read 8 bytes, the first one the most significant.
+
+    @param const uint8_t* bytes: Bytes.
+    @return uint64_t: The bytes.
+*/
+inline uint64_t loadBigEndian(const uint8_t* bytes){
+    uint64_t value;
+    memcpy(&value, bytes, 8);
+    return __builtin_bswap64(value);
+}
+
+/**
+    @brief Write 4 bytes, the first one the most significant.
+
+    @param uint8_t* bytes: Receives the bytes.
+    @param uint32_t value: The bytes.
+    @return void.
+*/
+inline void storeBigEndian(uint8_t* bytes, uint32_t value){
+    value = __builtin_bswap32(value);
+    memcpy(bytes, &value, 4);
+}
+
+/**
+    @brief Write 8 bytes, the first one the most significant.
+
+    @param uint8_t* bytes: Receives the bytes.
+    @param uint64_t value: The bytes.
+    @return void.
+*/
+inline void storeBigEndian(uint8_t* bytes, uint64_t value){
+    value = __builtin_bswap64(value);
+    memcpy(bytes, &value, 8);
+}
+
+} // namespace
+
+bool bmi2Supported(){
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("bmi2");
+}
+
+__attribute__((target("bmi2")))
+void extractBlocksBmi2(const uint8_t* hammingBytes, size_t blocks, uint8_t* bytes){
+
+    // 8 bytes are read for each block of 7, except for the last one.
+    for( ; blocks > 1; blocks--){
+        storeBigEndian(bytes, (uint32_t)_pext_u64(loadBigEndian(hammingBytes), BLOCK_DATA_MASK));
+        hammingBytes += 7;
+        bytes += 4;
+    }
+    if(blocks > 0){
+        uint8_t lastBytes[8] = {0};
+        memcpy(lastBytes, hammingBytes, 7);
+        storeBigEndian(bytes, (uint32_t)_pext_u64(loadBigEndian(lastBytes), BLOCK_DATA_MASK));
+    }
+}
+
+__attribute__((target("bmi2")))
+void extractSecdedBmi2(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes){
+    for( ; bytesCount >= 4; bytesCount -= 4){
+        storeBigEndian(bytes, (uint32_t)_pext_u64(loadBigEndian(hammingBytes), SECDED_DATA_MASK));
+        hammingBytes += 8;
+        bytes += 4;
+    }
+    extractSecdedBitwise(hammingBytes, bytesCount, bytes);
+}
+
+namespace {
+
+/**
+    @brief Interleave one block of a frame of groups of 7 bits.
+
+    @param uint64_t bits: The block, in the least significant 56 bits.
+    @param size_t blocks: Number of blocks of the frame.
+    @param size_t block: Number of the block.
+    @param uint8_t* output: Receives the bit "b" of the block in the byte
+        "b * blocks + block".
+    @return void.
+*/
+__attribute__((target("bmi2")))
+inline void interleaveBlockBmi2(uint64_t bits, size_t blocks, size_t block, uint8_t* output){
+    for(unsigned bit = 0; bit < 7; bit++){
+        output[(bit * blocks) + block] = (uint8_t)_pext_u64(bits, BLOCK_GROUP_MASK >> bit);
+    }
+}
+
+/**
+    @brief Inverse of "interleaveBlockBmi2".
+
+    @param const uint8_t* input: Interleaved frame.
+    @param size_t blocks: Number of blocks of the frame.
+    @param size_t block: Number of the block.
+    @return uint64_t: The block, in the least significant 56 bits.
+*/
+__attribute__((target("bmi2")))
+inline uint64_t deinterleaveBlockBmi2(const uint8_t* input, size_t blocks, size_t block){
+    uint64_t bits = 0;
+    for(unsigned bit = 0; bit < 7; bit++){
+        bits |= _pdep_u64(input[(bit * blocks) + block], BLOCK_GROUP_MASK >> bit);
+    }
+    return bits;
+}
+
+/**
+    @brief Write the last block of a frame, not touching what comes after it.
+
+    @param uint8_t* bytes: Receives 7 bytes.
+    @param uint64_t bits: The block, in the least significant 56 bits.
+    @return void.
+*/
+inline void storeLastBlock(uint8_t* bytes, uint64_t bits){
+    for(unsigned y = 0; y < 7; y++){
+        bytes[y] = (uint8_t)(bits >> (48 - (y * 8)));
+    }
+}
+
+/**
+    @brief Write the bit 7 of the 32 bytes of a register as 4 bytes.
+
+    @param __m256i bytes: Bytes.
+    @param uint8_t* row: Receives the bits, the byte 0 in the bit 0.
+    @return __m256i: The bytes doubled, so that their next bit is the bit 7.
+*/
+__attribute__((target("avx2")))
+inline __m256i storeRowAvx2(__m256i bytes, uint8_t* row){
+    uint32_t mask = (uint32_t)_mm256_movemask_epi8(bytes);
+    memcpy(row, &mask, 4);
+    return _mm256_add_epi8(bytes, bytes);
+}
+
+/**
+    @brief Write the bits of the 32 bytes of a register as rows of 4 bytes,
+        from the bit 7. The rows are written out, so that they are not a loop
+        of variable shifts.
+
+    @param __m256i bytes: Bytes.
+    @param unsigned rows: Number of rows (7 or 8).
+    @param uint8_t* output: Receives the first row.
+    @param size_t stride: Distance between the rows.
+    @return void.
+*/
+__attribute__((target("avx2")))
+inline void storeRowsAvx2(__m256i bytes, unsigned rows, uint8_t* output, size_t stride){
+    bytes = storeRowAvx2(bytes, output);
+    bytes = storeRowAvx2(bytes, output + stride);
+    bytes = storeRowAvx2(bytes, output + (stride * 2));
+    bytes = storeRowAvx2(bytes, output + (stride * 3));
+    bytes = storeRowAvx2(bytes, output + (stride * 4));
+    bytes = storeRowAvx2(bytes, output + (stride * 5));
+    bytes = storeRowAvx2(bytes, output + (stride * 6));
+    if(rows == 8){
+        storeRowAvx2(bytes, output + (stride * 7));
+    }
+}
+
+/**
+    @brief Inverse of "storeRowAvx2": the bytes are doubled and get the bits
+        of 4 bytes in their bit 0. The byte "8k + w" gets the bit "w" of the
+        byte "k".
+
+    @param __m256i bytes: Bytes.
+    @param const uint8_t* row: 4 bytes.
+    @return __m256i: The new bytes.
+*/
+__attribute__((target("avx2")))
+inline __m256i loadRowAvx2(__m256i bytes, const uint8_t* row){
+    const __m256i rowBytes = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+                                              2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+    const __m256i rowBits = _mm256_set1_epi64x(0x8040201008040201LL);
+    uint32_t mask;
+    memcpy(&mask, row, 4);
+    __m256i bits = _mm256_and_si256(_mm256_shuffle_epi8(_mm256_set1_epi32((int)mask), rowBytes),
+                                    rowBits);
+
+    // "cmpeq" gives -1 for the bits that are set.
+    return _mm256_sub_epi8(_mm256_add_epi8(bytes, bytes), _mm256_cmpeq_epi8(bits, rowBits));
+}
+
+/**
+    @brief Inverse of "storeRowsAvx2": the rows end up in the bits of the
+        bytes from the bit "rows - 1", the byte "8k + w" getting the bit "w"
+        of the byte "k" of each row.
+
+    @param const uint8_t* input: First row.
+    @param unsigned rows: Number of rows (7 or 8).
+    @param size_t stride: Distance between the rows.
+    @return __m256i: The bytes.
+*/
+__attribute__((target("avx2")))
+inline __m256i loadRowsAvx2(const uint8_t* input, unsigned rows, size_t stride){
+    __m256i bytes = loadRowAvx2(_mm256_setzero_si256(), input);
+    bytes = loadRowAvx2(bytes, input + stride);
+    bytes = loadRowAvx2(bytes, input + (stride * 2));
+    bytes = loadRowAvx2(bytes, input + (stride * 3));
+    bytes = loadRowAvx2(bytes, input + (stride * 4));
+    bytes = loadRowAvx2(bytes, input + (stride * 5));
+    bytes = loadRowAvx2(bytes, input + (stride * 6));
+    if(rows == 8){
+        bytes = loadRowAvx2(bytes, input + (stride * 7));
+    }
+    return bytes;
+}
+
+/**
+    @brief Read the nibbles of 4 blocks of (7,4) or (8,4) into the bits 7~4
+        of the bytes of a register: the byte "8k + w" gets the nibble of the
+        group "7 - w" of the block "k", so that the bits of a byte of a mask
+        are the groups 0~7 from the most significant.
+
+    @param const uint8_t* quad: 16 original bytes.
+    @return __m256i: The nibbles (the bits below them are not used).
+*/
+__attribute__((target("avx2")))
+inline __m256i loadNibblesAvx2(const uint8_t* quad){
+
+    // The 16 bytes are in both lanes, each one taken twice: the group "2y"
+    // is the high nibble of the byte "y" of its block, the other one the low
+    // nibble, shifted up.
+    const __m256i nibbleBytes = _mm256_setr_epi8(3, 3, 2, 2, 1, 1, 0, 0, 7, 7, 6, 6, 5, 5, 4, 4,
+                                                 11, 11, 10, 10, 9, 9, 8, 8, 15, 15, 14, 14, 13,
+                                                 13, 12, 12);
+    const __m256i lowNibbles = _mm256_set1_epi16(0x00F0);
+    const __m256i highNibbles = _mm256_set1_epi16((short)0xF000);
+    __m256i spread = _mm256_shuffle_epi8(
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)quad)), nibbleBytes);
+    return _mm256_or_si256(_mm256_and_si256(_mm256_slli_epi16(spread, 4), lowNibbles),
+                           _mm256_and_si256(spread, highNibbles));
+}
+
+/**
+    @brief Take the bit 7 of the nibbles of 8 blocks as a row of 8 bytes.
+
+    @param __m256i* low: Nibbles of the first 4 blocks, doubled so that their
+        next bit is the bit 7.
+    @param __m256i* high: Nibbles of the other 4, doubled.
+    @return uint64_t: The row, the block 0 in the byte 0.
+*/
+__attribute__((target("avx2")))
+inline uint64_t takeRowAvx2(__m256i* low, __m256i* high){
+    uint64_t row = (uint32_t)_mm256_movemask_epi8(*low) |
+                   ((uint64_t)(uint32_t)_mm256_movemask_epi8(*high) << 32);
+    *low = _mm256_add_epi8(*low, *low);
+    *high = _mm256_add_epi8(*high, *high);
+    return row;
+}
+
+/**
+    @brief Apply (7,4) or (8,4) to 8 blocks and write their rows. Only the 4
+        rows of the data bits are taken from registers ("takeRowAvx2"); the
+        rows of the parity bits are their XORs, as in the bit-sliced layout.
+
+    @param const uint8_t* octet: 32 original bytes.
+    @param unsigned rows: Bits of each group (7 or 8).
+    @param uint8_t* output: Receives the first row (8 bytes).
+    @param size_t stride: Distance between the rows.
+    @return void.
+*/
+__attribute__((target("avx2")))
+inline void encodeRowsAvx2(const uint8_t* octet, unsigned rows, uint8_t* output, size_t stride){
+    __m256i low = loadNibblesAvx2(octet);
+    __m256i high = loadNibblesAvx2(octet + 16);
+
+    // D7 D6 D5 P4 D3 P2 P1, and P8 with (8,4).
+    uint64_t d7 = takeRowAvx2(&low, &high);
+    uint64_t d6 = takeRowAvx2(&low, &high);
+    uint64_t d5 = takeRowAvx2(&low, &high);
+    uint64_t d3 = takeRowAvx2(&low, &high);
+    uint64_t p4 = d7 ^ d6 ^ d5;
+    uint64_t p2 = d7 ^ d6 ^ d3;
+    uint64_t p1 = d7 ^ d5 ^ d3;
+    memcpy(output, &d7, 8);
+    memcpy(output + stride, &d6, 8);
+    memcpy(output + (stride * 2), &d5, 8);
+    memcpy(output + (stride * 3), &p4, 8);
+    memcpy(output + (stride * 4), &d3, 8);
+    memcpy(output + (stride * 5), &p2, 8);
+    memcpy(output + (stride * 6), &p1, 8);
+    if(rows == 8){
+        uint64_t p8 = d6 ^ d5 ^ d3;
+        memcpy(output + (stride * 7), &p8, 8);
+    }
+}
+
+/**
+    @brief Apply (7,4) or (8,4) to whole frames and interleave them, 8 blocks
+        at a time ("encodeRowsAvx2"). The blocks of a frame that do not make
+        8 go through copies.
+
+    @param const uint8_t* bytes: "frames * blocks * 4" original bytes.
+    @param size_t frames: Number of frames.
+    @param size_t blocks: Blocks of each frame.
+    @param uint8_t* output: Receives the frames interleaved.
+    @param unsigned rows: Bits of each group (7 or 8).
+    @return void.
+*/
+__attribute__((target("avx2")))
+inline void encodeInterleavedAvx2(const uint8_t* bytes, size_t frames, size_t blocks,
+                                  uint8_t* output, unsigned rows){
+    for( ; frames > 0; frames--){
+        size_t z = 0;
+        for( ; z + 8 <= blocks; z += 8){
+            encodeRowsAvx2(bytes + (z * 4), rows, output + z, blocks);
+        }
+        if(z < blocks){
+            uint8_t lastOctet[32] = {0};
+            uint8_t lastRows[64];
+            memcpy(lastOctet, bytes + (z * 4), (blocks - z) * 4);
+            encodeRowsAvx2(lastOctet, rows, lastRows, 8);
+            for(unsigned bit = 0; bit < rows; bit++){
+                memcpy(output + (bit * blocks) + z, lastRows + (bit * 8), blocks - z);
+            }
+        }
+        bytes += blocks * 4;
+        output += blocks * rows;
+    }
+}
+
+/**
+    @brief Transpose the bytes of the words of 4 tiles of the larger codes,
+        in 3 rounds of "unpack" instructions and a last one of their halves.
+        The plane "m" gets in its byte "8k + j" the byte "m" (the least
+        significant being 0) of the word of the group "7 - j" of the tile
+        "k", as "storeRowsAvx2" takes them.
+
+    @param const uint64_t* quad: 8 rows of 4 words ("InterleaveWordsFn").
+    @param __m256i* planes: Receives 8 planes.
+    @return void.
+*/
+__attribute__((target("avx2")))
+inline void transposeQuadAvx2(const uint64_t* quad, __m256i* planes){
+    const __m256i* rows = (const __m256i*)quad;
+    __m256i groups0 = _mm256_loadu_si256(rows + 7);
+    __m256i groups1 = _mm256_loadu_si256(rows + 6);
+    __m256i groups2 = _mm256_loadu_si256(rows + 5);
+    __m256i groups3 = _mm256_loadu_si256(rows + 4);
+    __m256i groups4 = _mm256_loadu_si256(rows + 3);
+    __m256i groups5 = _mm256_loadu_si256(rows + 2);
+    __m256i groups6 = _mm256_loadu_si256(rows + 1);
+    __m256i groups7 = _mm256_loadu_si256(rows);
+
+    // The low halves of the lanes are the tiles 0 and 2, the high ones the
+    // tiles 1 and 3.
+    __m256i even01 = _mm256_unpacklo_epi8(groups0, groups1);
+    __m256i even23 = _mm256_unpacklo_epi8(groups2, groups3);
+    __m256i even45 = _mm256_unpacklo_epi8(groups4, groups5);
+    __m256i even67 = _mm256_unpacklo_epi8(groups6, groups7);
+    __m256i odd01 = _mm256_unpackhi_epi8(groups0, groups1);
+    __m256i odd23 = _mm256_unpackhi_epi8(groups2, groups3);
+    __m256i odd45 = _mm256_unpackhi_epi8(groups4, groups5);
+    __m256i odd67 = _mm256_unpackhi_epi8(groups6, groups7);
+
+    // The bytes 0~3 and 4~7 of the groups 0~3 and 4~7.
+    __m256i evenLow03 = _mm256_unpacklo_epi16(even01, even23);
+    __m256i evenHigh03 = _mm256_unpackhi_epi16(even01, even23);
+    __m256i evenLow47 = _mm256_unpacklo_epi16(even45, even67);
+    __m256i evenHigh47 = _mm256_unpackhi_epi16(even45, even67);
+    __m256i oddLow03 = _mm256_unpacklo_epi16(odd01, odd23);
+    __m256i oddHigh03 = _mm256_unpackhi_epi16(odd01, odd23);
+    __m256i oddLow47 = _mm256_unpacklo_epi16(odd45, odd67);
+    __m256i oddHigh47 = _mm256_unpackhi_epi16(odd45, odd67);
+
+    // The bytes "2n" and "2n + 1" of the 8 groups.
+    __m256i even0 = _mm256_unpacklo_epi32(evenLow03, evenLow47);
+    __m256i even1 = _mm256_unpackhi_epi32(evenLow03, evenLow47);
+    __m256i even2 = _mm256_unpacklo_epi32(evenHigh03, evenHigh47);
+    __m256i even3 = _mm256_unpackhi_epi32(evenHigh03, evenHigh47);
+    __m256i odd0 = _mm256_unpacklo_epi32(oddLow03, oddLow47);
+    __m256i odd1 = _mm256_unpackhi_epi32(oddLow03, oddLow47);
+    __m256i odd2 = _mm256_unpacklo_epi32(oddHigh03, oddHigh47);
+    __m256i odd3 = _mm256_unpackhi_epi32(oddHigh03, oddHigh47);
+    planes[0] = _mm256_unpacklo_epi64(even0, odd0);
+    planes[1] = _mm256_unpackhi_epi64(even0, odd0);
+    planes[2] = _mm256_unpacklo_epi64(even1, odd1);
+    planes[3] = _mm256_unpackhi_epi64(even1, odd1);
+    planes[4] = _mm256_unpacklo_epi64(even2, odd2);
+    planes[5] = _mm256_unpackhi_epi64(even2, odd2);
+    planes[6] = _mm256_unpacklo_epi64(even3, odd3);
+    planes[7] = _mm256_unpackhi_epi64(even3, odd3);
+}
+
+/**
+    @brief Write 4 tiles of groups of "GROUP_BITS" bits interleaved, from
+        the words of their groups: each plane of their bytes
+        ("transposeQuadAvx2") is 7 or 8 rows. With 72 bits, the ninth row of
+        words already has the last byte of "8k + j" from the group "7 - j".
+
+    @param const uint64_t* quad: 9 rows of 4 words ("InterleaveWordsFn").
+    @param uint8_t* output: Receives the first row (4 bytes).
+    @param size_t stride: Distance between the rows.
+    @return void.
+*/
+template<unsigned GROUP_BITS>
+__attribute__((target("avx2")))
+inline void storeQuadAvx2(const uint64_t* quad, uint8_t* output, size_t stride){
+    const unsigned wordBits = GROUP_BITS < 64 ? GROUP_BITS : 64;
+    __m256i planes[8];
+    transposeQuadAvx2(quad, planes);
+    for(unsigned b = 0; b * 8 < wordBits; b++){
+        storeRowsAvx2(planes[7 - b], wordBits - (b * 8) < 8 ? 7 : 8, output + (b * 8 * stride),
+                      stride);
+    }
+    if(GROUP_BITS > 64){
+        storeRowsAvx2(_mm256_loadu_si256((const __m256i*)(quad + 32)), 8, output + (64 * stride),
+                      stride);
+    }
+}
+
+/**
+    @brief Interleave a frame of groups of "GROUP_BITS" bits from the words
+        of its groups, 4 tiles at a time ("storeQuadAvx2"). The last tiles
+        that do not make 4 go through copies.
+
+    @param const uint64_t* words: The words of the groups
+        ("InterleaveWordsFn").
+    @param size_t tiles: Number of tiles of the frame.
+    @param uint8_t* output: Receives the bit "b" of the tile "t" in the byte
+        "b * tiles + t".
+    @return void.
+*/
+template<unsigned GROUP_BITS>
+__attribute__((target("avx2")))
+void interleaveWordsOfAvx2(const uint64_t* words, size_t tiles, uint8_t* output){
+    size_t t = 0;
+    for( ; t + 4 <= tiles; t += 4){
+        storeQuadAvx2<GROUP_BITS>(words + ((t / 4) * QUAD_WORDS), output + t, tiles);
+    }
+    if(t < tiles){
+        uint64_t lastQuad[QUAD_WORDS] = {0};
+        uint8_t lastRows[72 * 4];
+        for(unsigned r = 0; r < (GROUP_BITS > 64 ? 9u : 8u); r++){
+            memcpy(lastQuad + (r * 4), words + ((t / 4) * QUAD_WORDS) + (r * 4), (tiles - t) * 8);
+        }
+        storeQuadAvx2<GROUP_BITS>(lastQuad, lastRows, 4);
+        for(unsigned bit = 0; bit < GROUP_BITS; bit++){
+            memcpy(output + (bit * tiles) + t, lastRows + (bit * 4), tiles - t);
+        }
+    }
+}
+
+} // namespace
+
+__attribute__((target("bmi2")))
+void interleaveBlocksBmi2(const uint8_t* frame, size_t blocks, uint8_t* output){
+
+    // 8 bytes are read for each block of 7, except for the last one, read
+    // from a copy so that nothing after the frame is read.
+    for(size_t z = 0; z < blocks; z++){
+        uint64_t bits;
+        if(z + 1 < blocks){
+            bits = loadBigEndian(frame + (z * 7)) >> 8;
+        }else{
+            uint8_t lastBlock[8] = {0};
+            memcpy(lastBlock + 1, frame + (z * 7), 7);
+            bits = loadBigEndian(lastBlock);
+        }
+        interleaveBlockBmi2(bits, blocks, z, output);
+    }
+}
+
+__attribute__((target("bmi2")))
+void deinterleaveBlocksBmi2(const uint8_t* input, size_t blocks, uint8_t* frame){
+
+    // 8 bytes are written for each block of 7, the last one written over by
+    // the next block, except for the last one.
+    for(size_t z = 0; z < blocks; z++){
+        uint64_t bits = deinterleaveBlockBmi2(input, blocks, z);
+        if(z + 1 < blocks){
+            storeBigEndian(frame + (z * 7), bits << 8);
+        }else{
+            storeLastBlock(frame + (z * 7), bits);
+        }
+    }
+}
+
+__attribute__((target("avx2,bmi2")))
+void interleaveBlocksAvx2(const uint8_t* frame, size_t blocks, uint8_t* output){
+
+    // Each word of 16 bits gets the 2 bytes that have one group (the group
+    // 7 in the word 0 of each half, so that the bits of a byte of the mask
+    // are the groups 0~7 from the most significant), shifted right by a
+    // multiply so that the group is in its 7 least significant bits.
+    const __m256i pairs = _mm256_setr_epi8(7, 6, 6, 5, 5, 4, 4, 3, 3, 2, 2, 1, 1, 0, 1, 0,
+                                           7, 6, 6, 5, 5, 4, 4, 3, 3, 2, 2, 1, 1, 0, 1, 0);
+    const __m256i shifts = _mm256_setr_epi16(256, 512, 1024, 2048, 4096, 8192, 16384, 128,
+                                             256, 512, 1024, 2048, 4096, 8192, 16384, 128);
+    const __m256i groupMask = _mm256_set1_epi16(0x7F);
+
+    // 4 blocks at a time, in the halves of 2 registers in the order 0 2 1
+    // 3, which the packing of their words gives back in order 0 1 2 3. The
+    // last 4 read 9 bytes after the frame.
+    size_t z = 0;
+    for( ; z + 4 <= blocks; z += 4){
+        const uint8_t* quad = frame + (z * 7);
+        __m256i even = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)quad)),
+            _mm_loadu_si128((const __m128i*)(quad + 14)), 1);
+        __m256i odd = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(quad + 7))),
+            _mm_loadu_si128((const __m128i*)(quad + 21)), 1);
+        even = _mm256_and_si256(_mm256_mulhi_epu16(_mm256_shuffle_epi8(even, pairs), shifts),
+                                groupMask);
+        odd = _mm256_and_si256(_mm256_mulhi_epu16(_mm256_shuffle_epi8(odd, pairs), shifts),
+                               groupMask);
+        __m256i groups = _mm256_packus_epi16(even, odd);
+        storeRowsAvx2(_mm256_add_epi8(groups, groups), 7, output + z, blocks);
+    }
+    for( ; z < blocks; z++){
+        uint8_t block[8] = {0};
+        memcpy(block + 1, frame + (z * 7), 7);
+        interleaveBlockBmi2(loadBigEndian(block), blocks, z, output);
+    }
+}
+
+__attribute__((target("avx2,bmi2")))
+void deinterleaveBlocksAvx2(const uint8_t* input, size_t blocks, uint8_t* frame){
+
+    // The byte "8k + w" gets the group "7 - w" of the block "k", and the 8
+    // groups of each 64 bits lane are then joined into its 56 least
+    // significant bits.
+    const __m256i bigEndian = _mm256_setr_epi8(6, 5, 4, 3, 2, 1, 0, 14, 13, 12, 11, 10, 9, 8,
+                                               -1, -1, 6, 5, 4, 3, 2, 1, 0, 14, 13, 12, 11, 10,
+                                               9, 8, -1, -1);
+    size_t z = 0;
+    for( ; z + 4 <= blocks; z += 4){
+        __m256i groups = loadRowsAvx2(input + z, 7, blocks);
+        __m256i words = _mm256_or_si256(
+            _mm256_and_si256(groups, _mm256_set1_epi16(0x007F)),
+            _mm256_and_si256(_mm256_srli_epi16(groups, 1), _mm256_set1_epi16(0x3F80)));
+        __m256i doubles = _mm256_or_si256(
+            _mm256_and_si256(words, _mm256_set1_epi32(0x3FFF)),
+            _mm256_and_si256(_mm256_srli_epi32(words, 2), _mm256_set1_epi32(0x0FFFC000)));
+        __m256i blocksBits = _mm256_or_si256(
+            _mm256_and_si256(doubles, _mm256_set1_epi64x(0x0FFFFFFF)),
+            _mm256_and_si256(_mm256_srli_epi64(doubles, 4),
+                             _mm256_set1_epi64x(0x00FFFFFFF0000000LL)));
+
+        // Each half has 2 blocks in its first 14 bytes. The last 4 are
+        // written through a copy, so that nothing after the frame is
+        // written.
+        __m256i ordered = _mm256_shuffle_epi8(blocksBits, bigEndian);
+        uint8_t* quad = frame + (z * 7);
+        uint8_t lastQuad[32];
+        uint8_t* to = z + 5 > blocks ? lastQuad : quad;
+        _mm_storeu_si128((__m128i*)to, _mm256_castsi256_si128(ordered));
+        _mm_storeu_si128((__m128i*)(to + 14), _mm256_extracti128_si256(ordered, 1));
+        if(to == lastQuad){
+            memcpy(quad, lastQuad, 28);
+        }
+    }
+    for( ; z < blocks; z++){
+        storeLastBlock(frame + (z * 7), deinterleaveBlockBmi2(input, blocks, z));
+    }
+}
+
+__attribute__((target("avx2")))
+void interleaveSecdedAvx2(const uint8_t* frame, size_t blocks, uint8_t* output){
+
+    // The bytes of each block are reversed, so that the bits of a byte of
+    // the masks are the groups 0~7 from the most significant. The last
+    // blocks that do not make 4 go through copies.
+    const __m256i reversed = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10,
+                                              9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11,
+                                              10, 9, 8);
+    size_t z = 0;
+    for( ; z + 4 <= blocks; z += 4){
+        __m256i groups = _mm256_loadu_si256((const __m256i*)(frame + (z * 8)));
+        storeRowsAvx2(_mm256_shuffle_epi8(groups, reversed), 8, output + z, blocks);
+    }
+    if(z < blocks){
+        uint8_t lastQuad[32] = {0};
+        uint8_t lastRows[32];
+        memcpy(lastQuad, frame + (z * 8), (blocks - z) * 8);
+        __m256i groups = _mm256_loadu_si256((const __m256i*)lastQuad);
+        storeRowsAvx2(_mm256_shuffle_epi8(groups, reversed), 8, lastRows, 4);
+        for(unsigned bit = 0; bit < 8; bit++){
+            memcpy(output + (bit * blocks) + z, lastRows + (bit * 4), blocks - z);
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+void deinterleaveSecdedAvx2(const uint8_t* input, size_t blocks, uint8_t* frame){
+
+    // The byte "8k + w" gets the group "7 - w" of the block "k".
+    const __m256i reversed = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10,
+                                              9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11,
+                                              10, 9, 8);
+    size_t z = 0;
+    for( ; z + 4 <= blocks; z += 4){
+        __m256i groups = _mm256_shuffle_epi8(loadRowsAvx2(input + z, 8, blocks), reversed);
+        _mm256_storeu_si256((__m256i*)(frame + (z * 8)), groups);
+    }
+    if(z < blocks){
+        uint8_t lastRows[32] = {0};
+        uint8_t lastQuad[32];
+        for(unsigned bit = 0; bit < 8; bit++){
+            memcpy(lastRows + (bit * 4), input + (bit * blocks) + z, blocks - z);
+        }
+        __m256i groups = _mm256_shuffle_epi8(loadRowsAvx2(lastRows, 8, 4), reversed);
+        _mm256_storeu_si256((__m256i*)lastQuad, groups);
+        memcpy(frame + (z * 8), lastQuad, (blocks - z) * 8);
+    }
+}
+
+__attribute__((target("avx2")))
+void encodeBlocksInterleavedAvx2(const uint8_t* bytes, size_t frames, size_t blocks,
+                                 uint8_t* output){
+    encodeInterleavedAvx2(bytes, frames, blocks, output, 7);
+}
+
+__attribute__((target("avx2")))
+void encodeSecdedInterleavedAvx2(const uint8_t* bytes, size_t frames, size_t blocks,
+                                 uint8_t* output){
+    encodeInterleavedAvx2(bytes, frames, blocks, output, 8);
+}
+
+__attribute__((target("avx2")))
+void interleaveWordsAvx2(const uint64_t* words, size_t tiles, unsigned groupBits,
+                         uint8_t* output){
+    switch(groupBits){
+        case 15:
+            interleaveWordsOfAvx2<15>(words, tiles, output);
+            break;
+        case 31:
+            interleaveWordsOfAvx2<31>(words, tiles, output);
+            break;
+        case 63:
+            interleaveWordsOfAvx2<63>(words, tiles, output);
+            break;
+        default:
+            interleaveWordsOfAvx2<72>(words, tiles, output);
+    }
+}
+
+namespace {
+
+// Each CRC instruction waits for the one before, so 3 parts of this size are
+// computed at the same time and then joined.
+const size_t CRC_PART_BYTES = 4096;
+
+/**
+    @brief How "CRC_PART_BYTES" zero bytes change a CRC, for each byte of
+        it (the CRC is linear, so the changes of its bits are XORed).
+*/
+struct CrcShiftTable {
+    uint32_t shifts[4][256];
+
+    CrcShiftTable(){
+        std::vector<uint8_t> zeros(CRC_PART_BYTES, 0);
+        uint32_t bitShifts[32];
+        for(unsigned z = 0; z < 32; z++){
+            bitShifts[z] = crc32cTable(1u << z, zeros.data(), zeros.size());
+        }
+        for(unsigned y = 0; y < 4; y++){
+            for(unsigned z = 0; z < 256; z++){
+                uint32_t shift = 0;
+                for(unsigned x = 0; x < 8; x++){
+                    shift ^= ((z >> x) & 1) ? bitShifts[(y * 8) + x] : 0;
+                }
+                shifts[y][z] = shift;
+            }
+        }
+    }
+};
+
+/**
+    @brief CRC of some bytes followed by "CRC_PART_BYTES" zero bytes.
+
+    @param uint32_t crc: CRC of the bytes.
+    @return uint32_t: The CRC.
+*/
+inline uint32_t shiftCrc(uint32_t crc){
+    static const CrcShiftTable table;
+    return table.shifts[0][crc & 0xFF] ^ table.shifts[1][(crc >> 8) & 0xFF] ^
+           table.shifts[2][(crc >> 16) & 0xFF] ^ table.shifts[3][crc >> 24];
+}
+
+} // namespace
+
+bool sse42Supported(){
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2");
+}
+
+__attribute__((target("sse4.2")))
+uint32_t crc32cSse42(uint32_t crc, const uint8_t* bytes, size_t bytesCount){
+
+    // The CRC of A B C is the one of A shifted over B, XORed with the one of
+    // B alone, and so on.
+    for( ; bytesCount >= (CRC_PART_BYTES * 3); bytesCount -= CRC_PART_BYTES * 3){
+        uint64_t first = crc;
+        uint64_t second = 0;
+        uint64_t third = 0;
+        for(size_t z = 0; z < CRC_PART_BYTES; z += 8){
+            uint64_t words[3];
+            memcpy(&words[0], bytes + z, 8);
+            memcpy(&words[1], bytes + CRC_PART_BYTES + z, 8);
+            memcpy(&words[2], bytes + (CRC_PART_BYTES * 2) + z, 8);
+            first = _mm_crc32_u64(first, words[0]);
+            second = _mm_crc32_u64(second, words[1]);
+            third = _mm_crc32_u64(third, words[2]);
+        }
+        crc = shiftCrc(shiftCrc((uint32_t)first) ^ (uint32_t)second) ^ (uint32_t)third;
+        bytes += CRC_PART_BYTES * 3;
+    }
+    uint64_t crc64 = crc;
+    for( ; bytesCount >= 8; bytesCount -= 8){
+        uint64_t word;
+        memcpy(&word, bytes, 8);
+        crc64 = _mm_crc32_u64(crc64, word);
+        bytes += 8;
+    }
+    crc = (uint32_t)crc64;
+    for( ; bytesCount > 0; bytesCount--){
+        crc = _mm_crc32_u8(crc, *bytes++);
+    }
+    return crc;
+}
+
+#else
+
+bool bmi2Supported(){
+    return false;
+}
+
+void extractBlocksBmi2(const uint8_t* hammingBytes, size_t blocks, uint8_t* bytes){
+    extractBlocksBitwise(hammingBytes, blocks, bytes);
+}
+
+void extractSecdedBmi2(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes){
+    extractSecdedBitwise(hammingBytes, bytesCount, bytes);
+}
+
+void interleaveBlocksBmi2(const uint8_t* frame, size_t blocks, uint8_t* output){
+    interleaveBlocksBitwise(frame, blocks, output);
+}
+
+void deinterleaveBlocksBmi2(const uint8_t* input, size_t blocks, uint8_t* frame){
+    deinterleaveBlocksBitwise(input, blocks, frame);
+}
+
+void interleaveBlocksAvx2(const uint8_t* frame, size_t blocks, uint8_t* output){
+    interleaveBlocksBitwise(frame, blocks, output);
+}
+
+void deinterleaveBlocksAvx2(const uint8_t* input, size_t blocks, uint8_t* frame){
+    deinterleaveBlocksBitwise(input, blocks, frame);
+}
+
+void interleaveSecdedAvx2(const uint8_t* frame, size_t blocks, uint8_t* output){
+    interleaveSecdedBitwise(frame, blocks, output);
+}
+
+void deinterleaveSecdedAvx2(const uint8_t* input, size_t blocks, uint8_t* frame){
+    deinterleaveSecdedBitwise(input, blocks, frame);
+}
+
+void encodeBlocksInterleavedAvx2(const uint8_t* bytes, size_t frames, size_t blocks,
+                                 uint8_t* output){
+    std::vector<uint8_t> frame((blocks * BLOCK_HAMMING_BYTES) + 16);
+    for( ; frames > 0; frames--){
+        encodeBlocksTable(bytes, blocks, frame.data());
+        interleaveBlocksBitwise(frame.data(), blocks, output);
+        bytes += blocks * BLOCK_BYTES;
+        output += blocks * BLOCK_HAMMING_BYTES;
+    }
+}
+
+void encodeSecdedInterleavedAvx2(const uint8_t* bytes, size_t frames, size_t blocks,
+                                 uint8_t* output){
+    std::vector<uint8_t> frame(blocks * 8);
+    for( ; frames > 0; frames--){
+        encodeSecdedTable(bytes, blocks * 4, frame.data());
+        interleaveSecdedBitwise(frame.data(), blocks, output);
+        bytes += blocks * 4;
+        output += blocks * 8;
+    }
+}
+
+void interleaveWordsAvx2(const uint64_t* words, size_t tiles, unsigned groupBits,
+                         uint8_t* output){
+    interleaveWordsBitwise(words, tiles, groupBits, output);
+}
+
+bool sse42Supported(){
+    return false;
+}
+
+uint32_t crc32cSse42(uint32_t crc, const uint8_t* bytes, size_t bytesCount){
+    return crc32cTable(crc, bytes, bytesCount);
+}
+
+#endif
+
+#if HAMMING_NEON && defined(__ARM_FEATURE_CRC32)
+
+bool armCrcSupported(){
+    return true;
+}
+
+uint32_t crc32cArm(uint32_t crc, const uint8_t* bytes, size_t bytesCount){
+    for( ; bytesCount >= 8; bytesCount -= 8){
+        uint64_t word;
+        memcpy(&word, bytes, 8);
+        crc = __crc32cd(crc, word);
+        bytes += 8;
+    }
+    for( ; bytesCount > 0; bytesCount--){
+        crc = __crc32cb(crc, *bytes++);
+    }
+    return crc;
+}
+
+#else
+
+bool armCrcSupported(){
+    return false;
+}
+
+uint32_t crc32cArm(uint32_t crc, const uint8_t* bytes, size_t bytesCount){
+    return crc32cTable(crc, bytes, bytesCount);
+}
+
+#endif
+
+#if HAMMING_NEON
+
+bool neonSupported(){
+    return true;
+}
+
+void encodeBlocksNeon(const uint8_t* bytes, size_t blocks, uint8_t* hammingBytes){
+    static const uint8_t groupTable[16] = {
+        0x00, 0x07, 0x19, 0x1E, 0x2A, 0x2D, 0x33, 0x34,
+        0x4B, 0x4C, 0x52, 0x55, 0x61, 0x66, 0x78, 0x7F};
+    static const uint8_t storeOrder[16] = {
+        6, 5, 4, 3, 2, 1, 0, 14, 13, 12, 11, 10, 9, 8, 0xFF, 0xFF};
+    const uint8x16_t groups = vld1q_u8(groupTable);
+    const uint8x16_t order = vld1q_u8(storeOrder);
+
+    // Same steps as "joinGroupsSsse3", with shifts instead of multiplications.
+    for( ; blocks > 4; blocks -= 4){
+        uint8x16_t input = vld1q_u8(bytes);
+        uint8x16_t low = vqtbl1q_u8(groups, vandq_u8(input, vdupq_n_u8(0x0F)));
+        uint8x16_t high = vqtbl1q_u8(groups, vshrq_n_u8(input, 4));
+        uint16x8_t bits14[2] = {
+            vorrq_u16(vshll_n_u8(vget_low_u8(high), 7), vmovl_u8(vget_low_u8(low))),
+            vorrq_u16(vshll_n_u8(vget_high_u8(high), 7), vmovl_u8(vget_high_u8(low)))};
+        for(int z = 0; z < 2; z++){
+            uint32x4_t pairs = vreinterpretq_u32_u16(bits14[z]);
+            uint32x4_t bits28 = vorrq_u32(
+                vshlq_n_u32(vandq_u32(pairs, vdupq_n_u32(0xFFFF)), 14),
+                vshrq_n_u32(pairs, 16));
+            uint64x2_t quads = vreinterpretq_u64_u32(bits28);
+            uint64x2_t bits56 = vorrq_u64(
+                vshlq_n_u64(vandq_u64(quads, vdupq_n_u64(0xFFFFFFFF)), 28),
+                vshrq_n_u64(quads, 32));
+            vst1q_u8(hammingBytes + (z * 14), vqtbl1q_u8(vreinterpretq_u8_u64(bits56), order));
+        }
+        bytes += 4 * BLOCK_BYTES;
+        hammingBytes += 4 * BLOCK_HAMMING_BYTES;
+    }
+    encodeBlocksTable(bytes, blocks, hammingBytes);
+}
+
+uint64_t decodeBlocksNeon(const uint8_t* hammingBytes, size_t blocks, uint8_t* bytes){
+    static const uint8_t loadOrder[16] = {
+        6, 5, 4, 3, 2, 1, 0, 0xFF, 13, 12, 11, 10, 9, 8, 7, 0xFF};
+    static const uint8_t highTable[16] = {
+        0x00, 0x15, 0x26, 0x33, 0x47, 0x52, 0x61, 0x74,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    static const uint8_t lowTable[16] = {
+        0x00, 0x01, 0x02, 0x03, 0x0B, 0x0A, 0x09, 0x08,
+        0x04, 0x05, 0x06, 0x07, 0x0F, 0x0E, 0x0D, 0x0C};
+    static const uint8_t flipTable[16] = {
+        0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x04, 0x08,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    const uint8x16_t order = vld1q_u8(loadOrder);
+    const uint8x16_t high = vld1q_u8(highTable);
+    const uint8x16_t low = vld1q_u8(lowTable);
+    const uint8x16_t flip = vld1q_u8(flipTable);
+
+    // Same steps as "splitGroupsSsse3", counting the corrected groups in
+    // bytes that are summed before they overflow.
+    uint64_t corrected = 0;
+    uint8x16_t counts = vdupq_n_u8(0);
+    unsigned passes = 0;
+    for( ; blocks > 4; blocks -= 4){
+        uint8x8_t output[2];
+        for(int z = 0; z < 2; z++){
+            uint64x2_t bits56 = vreinterpretq_u64_u8(
+                vqtbl1q_u8(vld1q_u8(hammingBytes + (z * 14)), order));
+            uint32x4_t bits28 = vreinterpretq_u32_u64(vorrq_u64(
+                vshrq_n_u64(bits56, 28),
+                vandq_u64(vshlq_n_u64(bits56, 32), vdupq_n_u64(0x0FFFFFFF00000000ULL))));
+            uint16x8_t bits14 = vreinterpretq_u16_u32(vorrq_u32(
+                vshrq_n_u32(bits28, 14),
+                vandq_u32(vshlq_n_u32(bits28, 16), vdupq_n_u32(0x3FFF0000))));
+            uint8x16_t groups = vreinterpretq_u8_u16(vorrq_u16(
+                vshrq_n_u16(bits14, 7),
+                vandq_u16(vshlq_n_u16(bits14, 8), vdupq_n_u16(0x7F00))));
+            uint8x16_t syndromeData = veorq_u8(
+                vqtbl1q_u8(high, vshrq_n_u8(groups, 4)),
+                vqtbl1q_u8(low, vandq_u8(groups, vdupq_n_u8(0x0F))));
+            uint8x16_t syndrome = vandq_u8(syndromeData, vdupq_n_u8(0x07));
+            uint16x8_t nibbles = vreinterpretq_u16_u8(veorq_u8(
+                vshrq_n_u8(syndromeData, 3),
+                vqtbl1q_u8(flip, syndrome)));
+            output[z] = vmovn_u16(vorrq_u16(vshlq_n_u16(nibbles, 4), vshrq_n_u16(nibbles, 8)));
+            counts = vaddq_u8(counts, vminq_u8(syndrome, vdupq_n_u8(1)));
+        }
+        vst1q_u8(bytes, vcombine_u8(output[0], output[1]));
+        hammingBytes += 4 * BLOCK_HAMMING_BYTES;
+        bytes += 4 * BLOCK_BYTES;
+        if(++passes == 127){
+            corrected += vaddlvq_u8(counts);
+            counts = vdupq_n_u8(0);
+            passes = 0;
+        }
+    }
+    corrected += vaddlvq_u8(counts);
+    return corrected + decodeBlocksTable(hammingBytes, blocks, bytes);
+}
+
+void encodeSecdedNeon(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes){
+    static const uint8_t groupTable[16] = {
+        0x00, 0x0F, 0x33, 0x3C, 0x55, 0x5A, 0x66, 0x69,
+        0x96, 0x99, 0xA5, 0xAA, 0xC3, 0xCC, 0xF0, 0xFF};
+    const uint8x16_t groups = vld1q_u8(groupTable);
+
+    // "vst2q_u8" interleaves the groups of the high and low nibbles.
+    for( ; bytesCount >= 16; bytesCount -= 16){
+        uint8x16_t input = vld1q_u8(bytes);
+        uint8x16x2_t output;
+        output.val[0] = vqtbl1q_u8(groups, vshrq_n_u8(input, 4));
+        output.val[1] = vqtbl1q_u8(groups, vandq_u8(input, vdupq_n_u8(0x0F)));
+        vst2q_u8(hammingBytes, output);
+        bytes += 16;
+        hammingBytes += 32;
+    }
+    encodeSecdedTable(bytes, bytesCount, hammingBytes);
+}
+
+uint64_t decodeSecdedNeon(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes,
+                          uint64_t* detected){
+    static const uint8_t highTable[16] = {
+        0x00, 0xC0, 0xD2, 0x12, 0xE4, 0x24, 0x36, 0xF6,
+        0xF8, 0x38, 0x2A, 0xEA, 0x1C, 0xDC, 0xCE, 0x0E};
+    static const uint8_t lowTable[16] = {
+        0x00, 0x80, 0x90, 0x10, 0xA0, 0x20, 0x30, 0xB0,
+        0xB1, 0x31, 0x21, 0xA1, 0x11, 0x91, 0x81, 0x01};
+    static const uint8_t flipTable[16] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x04, 0x08};
+    static const uint8_t detectedTable[16] = {
+        0, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0};
+    const uint8x16_t high = vld1q_u8(highTable);
+    const uint8x16_t low = vld1q_u8(lowTable);
+    const uint8x16_t flip = vld1q_u8(flipTable);
+    const uint8x16_t detect = vld1q_u8(detectedTable);
+
+    // Same steps as "splitSecdedSsse3", with "vld2q_u8" splitting the groups
+    // of the high and low nibbles. A bit was corrected when P (bit 3 of the
+    // syndrome) is odd.
+    uint64_t corrected = 0;
+    uint8x16_t correctedCounts = vdupq_n_u8(0);
+    uint8x16_t detectedCounts = vdupq_n_u8(0);
+    unsigned passes = 0;
+    for( ; bytesCount >= 16; bytesCount -= 16){
+        uint8x16x2_t groups = vld2q_u8(hammingBytes);
+        uint8x16_t nibbles[2];
+        for(int z = 0; z < 2; z++){
+            uint8x16_t parts = veorq_u8(
+                vqtbl1q_u8(high, vshrq_n_u8(groups.val[z], 4)),
+                vqtbl1q_u8(low, vandq_u8(groups.val[z], vdupq_n_u8(0x0F))));
+            uint8x16_t syndrome = vshrq_n_u8(parts, 4);
+            nibbles[z] = veorq_u8(vandq_u8(parts, vdupq_n_u8(0x0F)), vqtbl1q_u8(flip, syndrome));
+            correctedCounts = vaddq_u8(correctedCounts, vshrq_n_u8(syndrome, 3));
+            detectedCounts = vaddq_u8(detectedCounts, vqtbl1q_u8(detect, syndrome));
+        }
+        vst1q_u8(bytes, vorrq_u8(vshlq_n_u8(nibbles[0], 4), nibbles[1]));
+        hammingBytes += 32;
+        bytes += 16;
+        if(++passes == 127){
+            corrected += vaddlvq_u8(correctedCounts);
+            *detected += vaddlvq_u8(detectedCounts);
+            correctedCounts = vdupq_n_u8(0);
+            detectedCounts = vdupq_n_u8(0);
+            passes = 0;
+        }
+    }
+    corrected += vaddlvq_u8(correctedCounts);
+    *detected += vaddlvq_u8(detectedCounts);
+    return corrected + decodeSecdedTable(hammingBytes, bytesCount, bytes, detected);
+}
+
+namespace {
+
+/**
+    @brief Swap the bits "mask" of a register with the bits "shift" higher of
+        another one, in both 64 bits lanes ("vshlq_u64" shifts right by a
+        negative count).
+
+    @param uint64x2_t* words: Registers.
+    @param unsigned masked: Index of the register of the bits "mask".
+    @param unsigned shifted: Index of the other register.
+    @param int shift: Distance between the bits swapped.
+    @param uint64_t mask: Bits of each lane of "masked" that are swapped.
+    @return void.
+*/
+inline void swapBitBlocksNeon(uint64x2_t* words, unsigned masked, unsigned shifted, int shift,
+                              uint64_t mask){
+    uint64x2_t swap = vandq_u64(veorq_u64(words[masked],
+                                          vshlq_u64(words[shifted], vdupq_n_s64(-shift))),
+                                vdupq_n_u64(mask));
+    words[masked] = veorq_u64(words[masked], swap);
+    words[shifted] = veorq_u64(words[shifted], vshlq_u64(swap, vdupq_n_s64(shift)));
+}
+
+/**
+    @brief Same as "exchangeWordBitsSsse3".
+
+    @param uint64x2_t* words: 8 registers, exchanged in place.
+    @param int unit: 1 for the bits of each byte, 8 for the bytes.
+    @return void.
+*/
+inline void exchangeWordBitsNeon(uint64x2_t* words, int unit){
+    uint64_t fours = unit == 1 ? 0x0F0F0F0F0F0F0F0FULL : 0x00000000FFFFFFFFULL;
+    uint64_t twos = unit == 1 ? 0x3333333333333333ULL : 0x0000FFFF0000FFFFULL;
+    uint64_t ones = unit == 1 ? 0x5555555555555555ULL : 0x00FF00FF00FF00FFULL;
+    swapBitBlocksNeon(words, 4, 0, unit * 4, fours);
+    swapBitBlocksNeon(words, 5, 1, unit * 4, fours);
+    swapBitBlocksNeon(words, 6, 2, unit * 4, fours);
+    swapBitBlocksNeon(words, 7, 3, unit * 4, fours);
+    swapBitBlocksNeon(words, 2, 0, unit * 2, twos);
+    swapBitBlocksNeon(words, 3, 1, unit * 2, twos);
+    swapBitBlocksNeon(words, 6, 4, unit * 2, twos);
+    swapBitBlocksNeon(words, 7, 5, unit * 2, twos);
+    swapBitBlocksNeon(words, 1, 0, unit, ones);
+    swapBitBlocksNeon(words, 3, 2, unit, ones);
+    swapBitBlocksNeon(words, 5, 4, unit, ones);
+    swapBitBlocksNeon(words, 7, 6, unit, ones);
+}
+
+/**
+    @brief Same as "sliceBytesSsse3".
+
+    @param const uint8_t* bytes: 128 bytes, a slab.
+    @param uint64x2_t* planes: Receives the bit "k" of the byte "i" of each
+        half as the bit "i" of the lane of the register "k".
+    @return void.
+*/
+inline void sliceBytesNeon(const uint8_t* bytes, uint64x2_t* planes){
+    for(unsigned z = 0; z < 8; z += 2){
+        uint64x2_t first = vreinterpretq_u64_u8(vld1q_u8(bytes + (z * 8)));
+        uint64x2_t second = vreinterpretq_u64_u8(vld1q_u8(bytes + 64 + (z * 8)));
+        planes[z] = vcombine_u64(vget_low_u64(first), vget_low_u64(second));
+        planes[z + 1] = vcombine_u64(vget_high_u64(first), vget_high_u64(second));
+    }
+    exchangeWordBitsNeon(planes, 8);
+    exchangeWordBitsNeon(planes, 1);
+}
+
+/**
+    @brief Inverse of "sliceBytesNeon".
+
+    @param uint64x2_t* planes: 8 registers, overwritten.
+    @param uint8_t* bytes: Receives the 128 bytes of the slab.
+    @return void.
+*/
+inline void unsliceBytesNeon(uint64x2_t* planes, uint8_t* bytes){
+    exchangeWordBitsNeon(planes, 1);
+    exchangeWordBitsNeon(planes, 8);
+    for(unsigned z = 0; z < 8; z += 2){
+        vst1q_u8(bytes + (z * 8), vreinterpretq_u8_u64(
+            vcombine_u64(vget_low_u64(planes[z]), vget_low_u64(planes[z + 1]))));
+        vst1q_u8(bytes + 64 + (z * 8), vreinterpretq_u8_u64(
+            vcombine_u64(vget_high_u64(planes[z]), vget_high_u64(planes[z + 1]))));
+    }
+}
+
+/**
+    @brief Same as "storeSlicedSsse3".
+
+    @param uint8_t* hammingBytes: The first of the 2 words of the plane D7.
+    @param const uint64x2_t* data: Bits 0~3 of the nibbles (D3 D5 D6 D7).
+    @return void.
+*/
+inline void storeSlicedNeon(uint8_t* hammingBytes, const uint64x2_t* data){
+    uint64x2_t d76 = veorq_u64(data[3], data[2]);
+    vst1q_u8(hammingBytes, vreinterpretq_u8_u64(data[3]));
+    vst1q_u8(hammingBytes + 32, vreinterpretq_u8_u64(data[2]));
+    vst1q_u8(hammingBytes + 64, vreinterpretq_u8_u64(data[1]));
+    vst1q_u8(hammingBytes + 96, vreinterpretq_u8_u64(veorq_u64(d76, data[1])));
+    vst1q_u8(hammingBytes + 128, vreinterpretq_u8_u64(data[0]));
+    vst1q_u8(hammingBytes + 160, vreinterpretq_u8_u64(veorq_u64(d76, data[0])));
+    vst1q_u8(hammingBytes + 192,
+             vreinterpretq_u8_u64(veorq_u64(veorq_u64(data[3], data[1]), data[0])));
+}
+
+/**
+    @brief Same as "loadSlicedSsse3".
+
+    @param const uint8_t* hammingBytes: The first of the 2 words of the plane
+        D7.
+    @param bool correct: false to take the data planes as they are.
+    @param uint64x2_t* data: Receives the bits 0~3 of the nibbles.
+    @return unsigned: Number of groups that had a bit corrected.
+*/
+inline unsigned loadSlicedNeon(const uint8_t* hammingBytes, bool correct, uint64x2_t* data){
+    uint64x2_t d7 = vreinterpretq_u64_u8(vld1q_u8(hammingBytes));
+    uint64x2_t d6 = vreinterpretq_u64_u8(vld1q_u8(hammingBytes + 32));
+    uint64x2_t d5 = vreinterpretq_u64_u8(vld1q_u8(hammingBytes + 64));
+    uint64x2_t d3 = vreinterpretq_u64_u8(vld1q_u8(hammingBytes + 128));
+    unsigned corrected = 0;
+    if(correct){
+        uint64x2_t s4 = veorq_u64(veorq_u64(d7, d6), veorq_u64(d5,
+            vreinterpretq_u64_u8(vld1q_u8(hammingBytes + 96))));
+        uint64x2_t s2 = veorq_u64(veorq_u64(d7, d6), veorq_u64(d3,
+            vreinterpretq_u64_u8(vld1q_u8(hammingBytes + 160))));
+        uint64x2_t s1 = veorq_u64(veorq_u64(d7, d5), veorq_u64(d3,
+            vreinterpretq_u64_u8(vld1q_u8(hammingBytes + 192))));
+        uint64x2_t s42 = vandq_u64(s4, s2);
+        d7 = veorq_u64(d7, vandq_u64(s42, s1));
+        d6 = veorq_u64(d6, vbicq_u64(s42, s1));
+        d5 = veorq_u64(d5, vbicq_u64(vandq_u64(s4, s1), s2));
+        d3 = veorq_u64(d3, vbicq_u64(vandq_u64(s2, s1), s4));
+        corrected = vaddlvq_u8(vcntq_u8(vreinterpretq_u8_u64(vorrq_u64(s4, vorrq_u64(s2, s1)))));
+    }
+    data[0] = d3;
+    data[1] = d5;
+    data[2] = d6;
+    data[3] = d7;
+    return corrected;
+}
+
+/**
+    @brief Same as "unsliceSsse3".
+
+    @param const uint8_t* hammingBytes: "slabs * 224" bytes in the hamming
+        format.
+    @param size_t slabs: Number of slabs.
+    @param uint8_t* bytes: Receives "slabs * 128" original bytes.
+    @param bool correct: false to take the data planes as they are.
+    @return uint64_t: Number of groups that had a bit corrected.
+*/
+inline uint64_t unsliceNeon(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes,
+                            bool correct){
+    uint64_t corrected = 0;
+    for( ; slabs > 0; slabs--){
+        uint64x2_t planes[8];
+        corrected += loadSlicedNeon(hammingBytes + 16, correct, planes);
+        corrected += loadSlicedNeon(hammingBytes, correct, planes + 4);
+        unsliceBytesNeon(planes, bytes);
+        hammingBytes += SLICED_HAMMING_BYTES;
+        bytes += SLICED_BYTES;
+    }
+    return corrected;
+}
+
+} // namespace
+
+void encodeSlicedNeon(const uint8_t* bytes, size_t slabs, uint8_t* hammingBytes){
+
+    // Same steps as "encodeSlicedSsse3".
+    for( ; slabs > 0; slabs--){
+        uint64x2_t planes[8];
+        sliceBytesNeon(bytes, planes);
+        storeSlicedNeon(hammingBytes, planes + 4);
+        storeSlicedNeon(hammingBytes + 16, planes);
+        bytes += SLICED_BYTES;
+        hammingBytes += SLICED_HAMMING_BYTES;
+    }
+}
+
+uint64_t decodeSlicedNeon(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes){
+    return unsliceNeon(hammingBytes, slabs, bytes, true);
+}
+
+void extractSlicedNeon(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes){
+    unsliceNeon(hammingBytes, slabs, bytes, false);
+}
+
+#else
+
+bool neonSupported(){
+    return false;
+}
+
+void encodeBlocksNeon(const uint8_t* bytes, size_t blocks, uint8_t* hammingBytes){
+    encodeBlocksTable(bytes, blocks, hammingBytes);
+}
+
+uint64_t decodeBlocksNeon(const uint8_t* hammingBytes, size_t blocks, uint8_t* bytes){
+    return decodeBlocksTable(hammingBytes, blocks, bytes);
+}
+
+void encodeSecdedNeon(const uint8_t* bytes, size_t bytesCount, uint8_t* hammingBytes){
+    encodeSecdedTable(bytes, bytesCount, hammingBytes);
+}
+
+uint64_t decodeSecdedNeon(const uint8_t* hammingBytes, size_t bytesCount, uint8_t* bytes,
+                          uint64_t* detected){
+    return decodeSecdedTable(hammingBytes, bytesCount, bytes, detected);
+}
+
+void encodeSlicedNeon(const uint8_t* bytes, size_t slabs, uint8_t* hammingBytes){
+    encodeSlicedBitwise(bytes, slabs, hammingBytes);
+}
+
+uint64_t decodeSlicedNeon(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes){
+    return decodeSlicedBitwise(hammingBytes, slabs, bytes);
+}
+
+void extractSlicedNeon(const uint8_t* hammingBytes, size_t slabs, uint8_t* bytes){
+    extractSlicedBitwise(hammingBytes, slabs, bytes);
+}
+
+#endif
+
+} // namespace kernels
+} // namespace hamming
@@ -0,0 +1,75 @@
+/**
+    @file    hamming_tables.h
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Tables filled in by the compiler (internal).
+
+    @section DESCRIPTION
+
+    A table is an aggregate whose entries are a "constexpr" function of their
+    index, listed by expanding an "IndexSequence" of all the indexes. So each
+    table is plain data in the program, checked when compiled, with nothing
+    to compute when it starts and no values written by hand.
+
+    C++11 has no "std::index_sequence", so "MakeIndexSequence" joins two
+    halves, which keeps the depth of the templates to the log of the size.
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#ifndef HAMMING_TABLES_H
+#define HAMMING_TABLES_H
+
+#include <stddef.h>
+
+namespace hamming {
+namespace tables {
+
+/**
+    @brief The indexes of a table as template arguments.
+*/
+template<size_t... INDEXES>
+struct IndexSequence {};
+
+/**
+    @brief The indexes of two halves as those of the whole table.
+*/
+template<typename FIRST, typename SECOND>
+struct JoinIndexSequences;
+
+template<size_t... FIRST, size_t... SECOND>
+struct JoinIndexSequences<IndexSequence<FIRST...>, IndexSequence<SECOND...> > {
+    typedef IndexSequence<FIRST..., (sizeof...(FIRST) + SECOND)...> Type;
+};
+
+/**
+    @brief The indexes 0 ~ "COUNT - 1".
+*/
+template<size_t COUNT>
+struct MakeIndexSequence {
+    typedef typename JoinIndexSequences<typename MakeIndexSequence<COUNT / 2>::Type,
+                                        typename MakeIndexSequence<COUNT - (COUNT / 2)>::Type
+                                       >::Type Type;
+};
+
+template<>
+struct MakeIndexSequence<0> {
+    typedef IndexSequence<> Type;
+};
+
+template<>
+struct MakeIndexSequence<1> {
+    typedef IndexSequence<0> Type;
+};
+
+} // namespace tables
+} // namespace hamming
+
+#endif
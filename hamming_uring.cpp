@@ -0,0 +1,299 @@
+/**
+    @file    hamming_uring.cpp
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Reads and writes that run while the blocks are converted
+        (internal).
+
+    @section DESCRIPTION
+
+    The queues of the ring are shared with the kernel through "mmap": the
+    submissions are written at the tail of one and the completions read at
+    the head of the other, each index being published with release and read
+    with acquire ordering. No more than "entries" operations are ever queued
+    or running, so the submission queue never fills and the completion
+    queue (twice as large) never overflows.
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#include <errno.h>
+#include <string.h>
+
+#include "hamming_uring.h"
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// "IORING_OP_READ" and "IORING_OP_WRITE" came with it (Linux 5.6).
+#if defined(IORING_FEAT_RW_CUR_POS) && defined(__NR_io_uring_setup)
+#define HAMMING_URING 1
+#endif
+#endif
+#endif
+
+namespace hamming {
+
+#if HAMMING_URING
+
+namespace {
+
+// Largest read or write queued at once.
+const size_t MAX_RING_BYTES = 1u << 30;
+
+} // namespace
+
+IoRing::IoRing(unsigned entries) :
+    ringFd(-1),
+    entries(entries),
+    queued(0),
+    running(0),
+    sqMap(MAP_FAILED),
+    sqMapSize(0),
+    cqMap(MAP_FAILED),
+    cqMapSize(0),
+    sqes(MAP_FAILED),
+    sqesSize(0),
+    sqTail(NULL),
+    sqMask(NULL),
+    sqArray(NULL),
+    cqHead(NULL),
+    cqTail(NULL),
+    cqMask(NULL),
+    cqes(NULL){
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ringFd = (int)syscall(__NR_io_uring_setup, entries, &params);
+    if(ringFd < 0){
+        return;
+    }
+    if((params.features & IORING_FEAT_RW_CUR_POS) == 0){
+        close(ringFd);
+        ringFd = -1;
+        errno = ENOSYS;
+        return;
+    }
+    this->entries = params.sq_entries < entries ? params.sq_entries : entries;
+
+    // Older kernels map the two queues apart.
+    sqMapSize = params.sq_off.array + (params.sq_entries * sizeof(unsigned));
+    cqMapSize = params.cq_off.cqes + (params.cq_entries * sizeof(io_uring_cqe));
+    bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if(singleMap){
+        sqMapSize = sqMapSize > cqMapSize ? sqMapSize : cqMapSize;
+    }
+    sqMap = mmap(NULL, sqMapSize, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, ringFd,
+                 IORING_OFF_SQ_RING);
+    if(sqMap != MAP_FAILED){
+        cqMap = singleMap ? sqMap :
+                mmap(NULL, cqMapSize, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, ringFd,
+                     IORING_OFF_CQ_RING);
+    }
+    if(cqMap != MAP_FAILED){
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        sqes = mmap(NULL, sqesSize, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, ringFd,
+                    IORING_OFF_SQES);
+    }
+    if(sqes == MAP_FAILED){
+        int mapErrno = errno;
+        release();
+        errno = mapErrno;
+        return;
+    }
+    uint8_t* sq = (uint8_t*)sqMap;
+    uint8_t* cq = (uint8_t*)cqMap;
+    sqTail = (unsigned*)(sq + params.sq_off.tail);
+    sqMask = (const unsigned*)(sq + params.sq_off.ring_mask);
+    sqArray = (unsigned*)(sq + params.sq_off.array);
+    cqHead = (unsigned*)(cq + params.cq_off.head);
+    cqTail = (const unsigned*)(cq + params.cq_off.tail);
+    cqMask = (const unsigned*)(cq + params.cq_off.ring_mask);
+    cqes = cq + params.cq_off.cqes;
+}
+
+IoRing::~IoRing(){
+    release();
+}
+
+void IoRing::release(){
+    if(sqes != MAP_FAILED){
+        munmap(sqes, sqesSize);
+        sqes = MAP_FAILED;
+    }
+    if((cqMap != MAP_FAILED) && (cqMap != sqMap)){
+        munmap(cqMap, cqMapSize);
+    }
+    cqMap = MAP_FAILED;
+    if(sqMap != MAP_FAILED){
+        munmap(sqMap, sqMapSize);
+        sqMap = MAP_FAILED;
+    }
+    if(ringFd >= 0){
+        close(ringFd);
+        ringFd = -1;
+    }
+}
+
+bool IoRing::ready() const{
+    return ringFd >= 0;
+}
+
+unsigned IoRing::busy() const{
+    return running;
+}
+
+bool IoRing::queue(unsigned opcode, int fd, const uint8_t* buffer, size_t size,
+                   uint64_t offset, uint64_t tag){
+    if(running >= entries){
+        errno = EBUSY;
+        return false;
+    }
+
+    // Only this thread writes the tail, and the kernel has taken every entry
+    // submitted before, so the one at the tail is free.
+    unsigned tail = *sqTail;
+    unsigned index = tail & *sqMask;
+    io_uring_sqe* sqe = (io_uring_sqe*)sqes + index;
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = (uint8_t)opcode;
+    sqe->fd = fd;
+    sqe->addr = (uint64_t)(uintptr_t)buffer;
+    sqe->len = (uint32_t)(size < MAX_RING_BYTES ? size : MAX_RING_BYTES);
+    sqe->off = offset;
+    sqe->user_data = tag;
+    sqArray[index] = index;
+    __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+    queued++;
+    running++;
+    return true;
+}
+
+bool IoRing::read(int fd, uint8_t* buffer, size_t size, uint64_t offset, uint64_t tag){
+    return queue(IORING_OP_READ, fd, buffer, size, offset, tag);
+}
+
+bool IoRing::write(int fd, const uint8_t* buffer, size_t size, uint64_t offset, uint64_t tag){
+    return queue(IORING_OP_WRITE, fd, buffer, size, offset, tag);
+}
+
+bool IoRing::enter(unsigned minComplete){
+    for(;;){
+        long count = syscall(__NR_io_uring_enter, ringFd, queued, minComplete,
+                             minComplete > 0 ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+        if(count < 0){
+            if(errno == EINTR){
+                continue;
+            }
+            return false;
+        }
+        queued -= (unsigned)count < queued ? (unsigned)count : queued;
+        return true;
+    }
+}
+
+bool IoRing::submit(){
+    return (queued == 0) || enter(0);
+}
+
+bool IoRing::wait(uint64_t* tag, int* result){
+    for(;;){
+        unsigned head = *cqHead;
+        if(head != __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)){
+            const io_uring_cqe* cqe = (const io_uring_cqe*)cqes + (head & *cqMask);
+            *tag = cqe->user_data;
+            *result = cqe->res;
+            __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+            running--;
+            return true;
+        }
+        if(running == 0){
+            errno = EINVAL;
+            return false;
+        }
+        if(!enter(1)){
+            return false;
+        }
+    }
+}
+
+#else
+
+IoRing::IoRing(unsigned entries) :
+    ringFd(-1),
+    entries(entries),
+    queued(0),
+    running(0),
+    sqMap(NULL),
+    sqMapSize(0),
+    cqMap(NULL),
+    cqMapSize(0),
+    sqes(NULL),
+    sqesSize(0),
+    sqTail(NULL),
+    sqMask(NULL),
+    sqArray(NULL),
+    cqHead(NULL),
+    cqTail(NULL),
+    cqMask(NULL),
+    cqes(NULL){
+    errno = ENOSYS;
+}
+
+IoRing::~IoRing(){
+}
+
+void IoRing::release(){
+}
+
+bool IoRing::ready() const{
+    return false;
+}
+
+unsigned IoRing::busy() const{
+    return 0;
+}
+
+bool IoRing::queue(unsigned, int, const uint8_t*, size_t, uint64_t, uint64_t){
+    errno = ENOSYS;
+    return false;
+}
+
+bool IoRing::read(int, uint8_t*, size_t, uint64_t, uint64_t){
+    errno = ENOSYS;
+    return false;
+}
+
+bool IoRing::write(int, const uint8_t*, size_t, uint64_t, uint64_t){
+    errno = ENOSYS;
+    return false;
+}
+
+bool IoRing::enter(unsigned){
+    errno = ENOSYS;
+    return false;
+}
+
+bool IoRing::submit(){
+    errno = ENOSYS;
+    return false;
+}
+
+bool IoRing::wait(uint64_t*, int*){
+    errno = ENOSYS;
+    return false;
+}
+
+#endif
+
+} // namespace hamming
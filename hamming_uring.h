@@ -0,0 +1,140 @@
+/**
+    @file    hamming_uring.h
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Reads and writes that run while the blocks are converted
+        (internal).
+
+    @section DESCRIPTION
+
+    "IoRing" is an io_uring of Linux used through its system calls: each
+    read or write is queued with the position of the file it is about and a
+    tag, submitted, and its result is waited for later, in any order. The
+    ring is only available on Linux 5.6 or later built with its header; on
+    the other systems (or where it is not allowed) "ready" is false and the
+    files are read and written as usual.
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#ifndef HAMMING_URING_H
+#define HAMMING_URING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace hamming {
+
+class IoRing {
+public:
+
+    /**
+        @brief Create the ring.
+
+        @param unsigned entries: Most reads and writes queued or running at
+            the same time.
+    */
+    explicit IoRing(unsigned entries);
+
+    /**
+        @brief Close the ring. Every read and write must have completed.
+    */
+    ~IoRing();
+
+    /**
+        @brief Whether the ring could be created.
+
+        @return bool: false if the system has no io_uring ("errno" was set
+            when it was created).
+    */
+    bool ready() const;
+
+    /**
+        @brief Reads and writes not completed yet.
+
+        @return unsigned: Number of them, queued or running.
+    */
+    unsigned busy() const;
+
+    /**
+        @brief Queue a read.
+
+        @param int fd: File to be read.
+        @param uint8_t* buffer: Receives the bytes (kept until it completes).
+        @param size_t size: Number of bytes (1 GiB at most per read, the
+            completion tells how many were read).
+        @param uint64_t offset: Position in the file.
+        @param uint64_t tag: Given back with its result.
+        @return bool: false if there are already "entries" queued or running.
+    */
+    bool read(int fd, uint8_t* buffer, size_t size, uint64_t offset, uint64_t tag);
+
+    /**
+        @brief Queue a write.
+
+        @param int fd: File to be written.
+        @param uint8_t* buffer: Bytes to be written (kept until it completes).
+        @param size_t size: Number of bytes (1 GiB at most per write, the
+            completion tells how many were written).
+        @param uint64_t offset: Position in the file.
+        @param uint64_t tag: Given back with its result.
+        @return bool: false if there are already "entries" queued or running.
+    */
+    bool write(int fd, const uint8_t* buffer, size_t size, uint64_t offset, uint64_t tag);
+
+    /**
+        @brief Start the reads and writes queued.
+
+        @return bool: false if they could not be submitted ("errno").
+    */
+    bool submit();
+
+    /**
+        @brief Start the reads and writes queued and wait for one of them to
+            complete.
+
+        @param uint64_t* tag: Receives its tag.
+        @param int* result: Receives the number of bytes read or written, or
+            "-errno" if it failed.
+        @return bool: false if the ring failed ("errno").
+    */
+    bool wait(uint64_t* tag, int* result);
+
+private:
+    IoRing(const IoRing&);
+    IoRing& operator=(const IoRing&);
+
+    bool queue(unsigned opcode, int fd, const uint8_t* buffer, size_t size, uint64_t offset,
+               uint64_t tag);
+    bool enter(unsigned minComplete);
+    void release();
+
+    int ringFd;
+    unsigned entries;  /**< Of the submission queue. */
+    unsigned queued;   /**< Queued and not submitted yet. */
+    unsigned running;  /**< Queued or running. */
+    void* sqMap;
+    size_t sqMapSize;
+    void* cqMap;
+    size_t cqMapSize;
+    void* sqes;
+    size_t sqesSize;
+    unsigned* sqTail;
+    const unsigned* sqMask;
+    unsigned* sqArray;
+    unsigned* cqHead;
+    const unsigned* cqTail;
+    const unsigned* cqMask;
+    const void* cqes;
+};
+
+} // namespace hamming
+
+#endif
@@ -0,0 +1,159 @@
+/**
+    @file    hamming_verify.cpp
+    @author  Eduardo Lúcio Amorim Costa (Questor)
+    @date    11/02/2016
+    @version 1.0
+
+    @brief Checks the hamming method over a file in a single pass.
+
+    @section DESCRIPTION
+
+    The file is encoded, gets errors and is decoded piece by piece in
+    memory, as "hamming_enc", "hamming_err" and "hamming_dec" would do
+    through two files in between, and each piece is compared with the
+    original, so no file is written. It reports the groups corrected, the
+    bytes that could not be recovered and how fast it went, and fails when
+    any byte differs from the original.
+
+    @section LICENSE
+
+    Apache License
+    Version 2.0, January 2004
+    http://www.apache.org/licenses/
+    Copyright 2016 Eduardo Lúcio Amorim Costa
+*/
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+#include "hamming.h"
+#include "hamming_io.h"
+
+int main(int argc, char *argv[]){
+
+    const char* flName = NULL;
+    hamming::FileOptions options;
+    hamming::Profile profile;
+    options.seed = hamming::randomSeed();
+    hamming::ErrorModel& model = options.errorModel;
+    bool hasRate = false;
+    int exactFlips = 0;
+    for(int argCount = 1; argCount < argc; argCount++){
+        if((strcmp(argv[argCount], "--kernel") == 0) && ((argCount + 1) < argc)){
+            hamming::Kernel kernel;
+            if(!hamming::parseKernel(argv[++argCount], &kernel)){
+                fprintf(stderr, "Unknown kernel \"%s\"!\n", argv[argCount]);
+                return 1;
+            }
+            if(!hamming::setKernel(kernel)){
+                fprintf(stderr, "Kernel \"%s\" is not supported by this CPU!\n", argv[argCount]);
+                return 1;
+            }
+        }else if((strcmp(argv[argCount], "--code") == 0) && ((argCount + 1) < argc)){
+            if(!hamming::parseCode(argv[++argCount], &options.code)){
+                fprintf(stderr, "Unknown code \"%s\"!\n", argv[argCount]);
+                return 1;
+            }
+        }else if((strcmp(argv[argCount], "--interleave") == 0) && ((argCount + 1) < argc)){
+            options.interleave = (unsigned)atoi(argv[++argCount]);
+        }else if((strcmp(argv[argCount], "--seed") == 0) && ((argCount + 1) < argc)){
+            options.seed = strtoull(argv[++argCount], NULL, 0);
+        }else if((strcmp(argv[argCount], "--rate") == 0) && ((argCount + 1) < argc)){
+            char* end;
+            model.rate = strtod(argv[++argCount], &end);
+            if((*end != '\0') || !(model.rate >= 0) || (model.rate > 1)){
+                fprintf(stderr, "The rate must be a number from 0 to 1!\n");
+                return 1;
+            }
+            hasRate = true;
+            if(model.kind == hamming::ERRORS_GROUP){
+                model.kind = hamming::ERRORS_RATE;
+            }
+        }else if((strcmp(argv[argCount], "--burst") == 0) && ((argCount + 1) < argc)){
+            int length = atoi(argv[++argCount]);
+            if(length < 1){
+                fprintf(stderr, "The length of a burst must be at least 1!\n");
+                return 1;
+            }
+            model.kind = hamming::ERRORS_BURST;
+            model.length = (unsigned)length;
+        }else if((strcmp(argv[argCount], "--exact") == 0) && ((argCount + 1) < argc)){
+            exactFlips = atoi(argv[++argCount]);
+            model.kind = hamming::ERRORS_EXACT;
+        }else if((strcmp(argv[argCount], "-j") == 0) && ((argCount + 1) < argc)){
+            options.threads = (unsigned)atoi(argv[++argCount]);
+        }else if(strcmp(argv[argCount], "--profile") == 0){
+            options.profile = &profile;
+        }else{
+            flName = argv[argCount];
+        }
+    }
+    if(flName == NULL){
+        fprintf(stderr, "Usage: %s [--kernel auto|bitwise|table|ssse3|avx2|neon] [--code 7,4|8,4|15,11|31,26|63,57|72,64|7,4-sliced] [--interleave depth] [--seed number] [--rate chance [--burst bits] | --exact bits] [-j threads] [--profile] <file>\n", argv[0]);
+        return 1;
+    }
+    if((model.kind == hamming::ERRORS_BURST) && !hasRate){
+        fprintf(stderr, "\"--burst\" needs \"--rate\", the chance of each bit starting a burst!\n");
+        return 1;
+    }
+    if((model.kind == hamming::ERRORS_EXACT) && hasRate){
+        fprintf(stderr, "\"--exact\" cannot be used with \"--rate\"!\n");
+        return 1;
+    }
+    if((options.interleave != 0) && !hamming::validInterleave(options.code, options.interleave)){
+        fprintf(stderr, "The depth of the interleaving must be a multiple of 8 from 8 to %u, "
+                        "and not with the code 7,4-sliced!\n", hamming::MAX_INTERLEAVE_DEPTH);
+        return 1;
+    }
+
+    // The groups (and their bits) of the code of the file.
+    model.groupBits = hamming::codeBlocks(options.code).groupBits;
+    model.sliced = options.code == hamming::CODE_7_4_SLICED;
+    if(model.kind == hamming::ERRORS_EXACT){
+        if((exactFlips < 0) || (exactFlips > (int)model.groupBits)){
+            fprintf(stderr, "The bits inverted in each group must be from 0 to %u!\n",
+                    model.groupBits);
+            return 1;
+        }
+        model.flips = (unsigned)exactFlips;
+    }
+
+    fprintf(stdout, "%s", "> ---------------------------------------------\n");
+    fprintf(stdout, "Verifying the hamming method!\n");
+
+    // Given again with "--seed" it generates exactly the same errors.
+    fprintf(stdout, "Seed: %" PRIu64 "\n", options.seed);
+    fflush(stdout);
+    hamming::VerifyStats stats;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if(!hamming::verifyFile(flName, options, &stats)){
+        fprintf(stderr, "Could not verify \"%s\": %s\n", flName, strerror(errno));
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                                   start).count();
+    fprintf(stdout, "Bytes: %" PRIu64 " in %.3f s (%.1f MB/s)\n", stats.bytes, seconds,
+            seconds > 0 ? stats.bytes / seconds / 1e6 : 0.0);
+    fprintf(stdout, "Bits inverted: %" PRIu64 "\n", stats.flips);
+    fprintf(stdout, "Groups: %" PRIu64 ", corrected %" PRIu64 ", detected %" PRIu64 "\n",
+            stats.decode.groups, stats.decode.corrected, stats.decode.detected);
+    fprintf(stdout, "Bytes recovered: %" PRIu64 " of %" PRIu64 " (%.9g)\n",
+            stats.bytes - stats.wrongBytes, stats.bytes,
+            stats.bytes > 0 ? (double)(stats.bytes - stats.wrongBytes) / stats.bytes : 1.0);
+    if(options.profile != NULL){
+        hamming::printProfile(stdout, profile);
+    }
+    fprintf(stdout, "%s", "\n< ---------------------------------------------\n");
+    fflush(stdout);
+    if(stats.wrongBytes > 0){
+        fprintf(stderr, "%" PRIu64 " bytes differ from the original, the first at %" PRIu64
+                        "!\n", stats.wrongBytes, stats.firstWrong);
+        return 1;
+    }
+
+    return 0;
+}